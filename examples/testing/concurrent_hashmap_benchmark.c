@@ -0,0 +1,180 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include <stdio.h>
+
+#include "anvil/containers/concurrenthashmap.h"
+#include "anvil/containers/hashmap.h"
+#include "anvil/system/mutex.h"
+#include "anvil/system/thread.h"
+#include "anvil/system/timing.h"
+
+#define MAX_THREADS 64
+#define KEYS 65536
+#define OPERATIONS_PER_THREAD 100000
+#define WRITE_PERCENT 5
+
+typedef struct Worker
+{
+    ANVThread thread;
+    uint32_t seed;
+    size_t found;
+} Worker;
+
+static size_t keys[KEYS];
+static Worker workers[MAX_THREADS];
+
+// The baseline: an ordinary hash map behind one global mutex
+static ANVHashMap* locked_map;
+static ANVMutex locked_map_lock;
+static ANVConcurrentHashMap* concurrent_map;
+
+static uint32_t next_random(uint32_t* state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/*
+ * Mostly lookups; a write removes a key and puts it back, so every key is
+ * present again once all workers have finished.
+ */
+static void* locked_worker(void* arg)
+{
+    Worker* worker = arg;
+    for (uint32_t i = 0; i < OPERATIONS_PER_THREAD; i++)
+    {
+        const uint32_t roll = next_random(&worker->seed);
+        size_t* key = &keys[roll % KEYS];
+
+        anv_mutex_lock(&locked_map_lock);
+        if (roll / KEYS % 100 < WRITE_PERCENT)
+        {
+            anv_hashmap_remove(locked_map, key, false, false);
+            anv_hashmap_put(locked_map, key, key);
+        }
+        else
+        {
+            worker->found += anv_hashmap_get(locked_map, key) != NULL;
+        }
+        anv_mutex_unlock(&locked_map_lock);
+    }
+    return NULL;
+}
+
+static void* concurrent_worker(void* arg)
+{
+    Worker* worker = arg;
+    for (uint32_t i = 0; i < OPERATIONS_PER_THREAD; i++)
+    {
+        const uint32_t roll = next_random(&worker->seed);
+        size_t* key = &keys[roll % KEYS];
+
+        if (roll / KEYS % 100 < WRITE_PERCENT)
+        {
+            anv_chm_remove(concurrent_map, key, false, false);
+            anv_chm_put(concurrent_map, key, key);
+        }
+        else
+        {
+            worker->found += anv_chm_get(concurrent_map, key) != NULL;
+        }
+    }
+    return NULL;
+}
+
+static double run_workload(const uint32_t threads, void* (*func)(void*))
+{
+    for (uint32_t i = 0; i < threads; i++)
+    {
+        workers[i].seed = 0x9E3779B9u * (i + 1);
+        workers[i].found = 0;
+    }
+
+    const uint64_t start = anv_time_get_ns();
+    for (uint32_t i = 0; i < threads; i++)
+    {
+        if (anv_thread_create(&workers[i].thread, func, &workers[i]) != 0)
+        {
+            for (uint32_t j = 0; j < i; j++)
+            {
+                anv_thread_join(workers[j].thread, NULL);
+            }
+            return -1.0;
+        }
+    }
+
+    for (uint32_t i = 0; i < threads; i++)
+    {
+        anv_thread_join(workers[i].thread, NULL);
+    }
+    return anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+}
+
+static bool all_keys_present(void)
+{
+    for (size_t i = 0; i < KEYS; i++)
+    {
+        if (anv_hashmap_get(locked_map, &keys[i]) != &keys[i] || anv_chm_get(concurrent_map, &keys[i]) != &keys[i])
+        {
+            return false;
+        }
+    }
+    return anv_hashmap_size(locked_map) == KEYS && anv_chm_size(concurrent_map) == KEYS;
+}
+
+int main(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    locked_map = anv_hashmap_create(&alloc, anv_hash_int64, anv_key_equals_pointer, KEYS);
+    concurrent_map = anv_chm_create(&alloc, anv_hash_int64, anv_key_equals_pointer, KEYS);
+    if (!locked_map || !concurrent_map)
+    {
+        printf("Failed to create maps\n");
+        return -1;
+    }
+    anv_mutex_init(&locked_map_lock);
+
+    for (size_t i = 0; i < KEYS; i++)
+    {
+        keys[i] = i;
+        anv_hashmap_put(locked_map, &keys[i], &keys[i]);
+        anv_chm_put(concurrent_map, &keys[i], &keys[i]);
+    }
+
+    printf("Mutex-wrapped hash map vs concurrent hash map (%d ops per thread, %d%% writes)\n",
+           OPERATIONS_PER_THREAD, WRITE_PERCENT);
+    printf("%8s %12s %12s %9s\n", "threads", "mutex ms", "chm ms", "speedup");
+
+    int result = 0;
+    for (uint32_t threads = 1; threads <= MAX_THREADS; threads *= 2)
+    {
+        const double locked_ms = run_workload(threads, locked_worker);
+        const double concurrent_ms = run_workload(threads, concurrent_worker);
+        if (locked_ms < 0.0 || concurrent_ms < 0.0)
+        {
+            printf("Failed to start %u threads\n", threads);
+            result = -1;
+            break;
+        }
+
+        printf("%8u %12.3f %12.3f %8.2fx\n", threads, locked_ms, concurrent_ms,
+               concurrent_ms > 0.0 ? locked_ms / concurrent_ms : 0.0);
+    }
+
+    if (result == 0 && !all_keys_present())
+    {
+        printf("Concurrent hash map lost entries\n");
+        result = -1;
+    }
+
+    anv_hashmap_destroy(locked_map, false, false);
+    anv_chm_destroy(concurrent_map, false, false);
+    anv_mutex_destroy(&locked_map_lock);
+    return result;
+}
@@ -0,0 +1,412 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "anvil/algorithms/hash.h"
+#include "anvil/containers/flatmap.h"
+#include "anvil/containers/frozenmap.h"
+#include "anvil/containers/hashmap.h"
+#include "anvil/containers/hashset.h"
+#include "anvil/containers/intset.h"
+#include "anvil/containers/typedhashmap.h"
+#include "anvil/system/timing.h"
+
+#define HASH_ITERATIONS 1000000
+#define MAP_KEYS 50000
+#define KEY_LENGTH 64
+#define TABLE_KEYS 200000
+#define BATCH_KEYS (1u << 21)
+
+ANV_HASHMAP_DEFINE(IdCounts, uint64_t, uint64_t, ANV_HASHMAP_HASH_SCALAR, ANV_HASHMAP_EQ_SCALAR)
+
+static char keys[MAP_KEYS][KEY_LENGTH + 1];
+static const ANVHashSeed bench_seed = {0x0706050403020100ull, 0x0f0e0d0c0b0a0908ull};
+
+// Keeps the compiler from discarding hash results
+static volatile size_t sink;
+
+static size_t siphash_bytes(const void* data, const size_t len)
+{
+    return (size_t)anv_siphash13(data, len, &bench_seed);
+}
+
+static size_t halfsiphash_bytes(const void* data, const size_t len)
+{
+    return anv_halfsiphash13(data, len, &bench_seed);
+}
+
+static size_t fast_bytes(const void* data, const size_t len)
+{
+    return anv_hash_bytes(data, len, 0);
+}
+
+static double ns_per_hash(size_t (*hash)(const void*, size_t), const size_t len)
+{
+    size_t total = 0;
+    const uint64_t start = anv_time_get_ns();
+    for (uint32_t i = 0; i < HASH_ITERATIONS; i++)
+    {
+        total += hash(keys[i % MAP_KEYS], len);
+    }
+    sink = total;
+    return (double)anv_time_diff_ns(start, anv_time_get_ns()) / HASH_ITERATIONS;
+}
+
+static void fill_keys(void)
+{
+    uint32_t state = 0x9E3779B9u;
+    for (size_t i = 0; i < MAP_KEYS; i++)
+    {
+        for (size_t j = 0; j < KEY_LENGTH; j++)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            keys[i][j] = (char)('a' + state % 26);
+        }
+        keys[i][KEY_LENGTH] = '\0';
+    }
+}
+
+/**
+ * Insert every key, then look each one up. Keys are cut to 16 bytes so the
+ * hash is a meaningful share of the work.
+ */
+static double run_map(ANVHashMap* map)
+{
+    for (size_t i = 0; i < MAP_KEYS; i++)
+    {
+        keys[i][16] = '\0';
+    }
+
+    const uint64_t start = anv_time_get_ns();
+    for (size_t i = 0; i < MAP_KEYS; i++)
+    {
+        anv_hashmap_put(map, keys[i], keys[i]);
+    }
+
+    size_t found = 0;
+    for (size_t i = 0; i < MAP_KEYS; i++)
+    {
+        found += anv_hashmap_get(map, keys[i]) != NULL;
+    }
+    const double ms = anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+
+    anv_hashmap_destroy(map, false, false);
+    return found == MAP_KEYS ? ms : -1.0;
+}
+
+static size_t int_keys[TABLE_KEYS];
+
+/**
+ * Time TABLE_KEYS successful lookups of integer keys, chained vs flat.
+ */
+static bool compare_tables(ANVAllocator* alloc)
+{
+    ANVHashMap* chained = anv_hashmap_create(alloc, anv_hash_int64, anv_key_equals_pointer, 0);
+    ANVFlatMap* flat = anv_flatmap_create(alloc, anv_hash_int64, anv_key_equals_pointer, 0);
+    if (!chained || !flat)
+    {
+        anv_hashmap_destroy(chained, false, false);
+        anv_flatmap_destroy(flat, false, false);
+        return false;
+    }
+
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        int_keys[i] = anv_hash_mix64(i);
+        anv_hashmap_put(chained, &int_keys[i], &int_keys[i]);
+        anv_flatmap_put(flat, &int_keys[i], &int_keys[i]);
+    }
+
+    size_t found = 0;
+    uint64_t start = anv_time_get_ns();
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        found += anv_hashmap_get(chained, &int_keys[(i * 7919) % TABLE_KEYS]) != NULL;
+    }
+    const double chained_ms = anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+
+    start = anv_time_get_ns();
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        found += anv_flatmap_get(flat, &int_keys[(i * 7919) % TABLE_KEYS]) != NULL;
+    }
+    const double flat_ms = anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+
+    printf("Lookup of %d integer keys: chained %.3f ms, flat %.3f ms\n", TABLE_KEYS, chained_ms, flat_ms);
+    anv_hashmap_destroy(chained, false, false);
+    anv_flatmap_destroy(flat, false, false);
+    return found == 2 * (size_t)TABLE_KEYS;
+}
+
+/**
+ * Freeze a map of TABLE_KEYS integer keys and compare lookup time and
+ * structure size against the chained map it was built from.
+ */
+static bool compare_frozen(ANVAllocator* alloc)
+{
+    ANVHashMap* chained = anv_hashmap_create(alloc, anv_hash_int64, anv_key_equals_pointer, 0);
+    if (!chained)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        int_keys[i] = anv_hash_mix64(i);
+        anv_hashmap_put(chained, &int_keys[i], &int_keys[i]);
+    }
+
+    uint64_t start = anv_time_get_ns();
+    ANVFrozenMap* frozen = anv_frozenmap_from_hashmap(chained);
+    const double build_ms = anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+    if (!frozen)
+    {
+        anv_hashmap_destroy(chained, false, false);
+        return false;
+    }
+
+    size_t found = 0;
+    start = anv_time_get_ns();
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        found += anv_hashmap_get(chained, &int_keys[(i * 7919) % TABLE_KEYS]) != NULL;
+    }
+    const double chained_ms = anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+
+    start = anv_time_get_ns();
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        found += anv_frozenmap_get(frozen, &int_keys[(i * 7919) % TABLE_KEYS]) != NULL;
+    }
+    const double frozen_ms = anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+
+    const size_t chained_bytes = sizeof(ANVHashMap) + chained->size * sizeof(ANVHashMapNode) +
+                                 chained->bucket_count * sizeof(ANVHashMapNode*);
+    printf("Lookup of %d integer keys: chained %.3f ms (%zu bytes), frozen %.3f ms (%zu bytes, built in %.3f ms)\n",
+           TABLE_KEYS, chained_ms, chained_bytes, frozen_ms, anv_frozenmap_memory_usage(frozen), build_ms);
+    anv_frozenmap_destroy(frozen, false, false);
+    anv_hashmap_destroy(chained, false, false);
+    return found == 2 * (size_t)TABLE_KEYS;
+}
+
+static int equals_u64(const void* a, const void* b)
+{
+    return *(const uint64_t*)a == *(const uint64_t*)b;
+}
+
+/**
+ * Deduplicate TABLE_KEYS ids drawn from TABLE_KEYS / 2 distinct values, then
+ * probe every id, with the pointer-keyed hash set vs the inline integer set.
+ */
+static bool compare_sets(ANVAllocator* alloc)
+{
+    ANVHashSet* hashset = anv_hashset_create(alloc, anv_hash_int64, equals_u64, 0);
+    ANVIntSet* intset = anv_intset_create(alloc, 0);
+    if (!hashset || !intset)
+    {
+        anv_hashset_destroy(hashset, false);
+        anv_intset_destroy(intset);
+        return false;
+    }
+
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        int_keys[i] = anv_hash_mix64(i % (TABLE_KEYS / 2));
+    }
+
+    size_t found = 0;
+    uint64_t start = anv_time_get_ns();
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        anv_hashset_add(hashset, &int_keys[i]);
+    }
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        found += anv_hashset_contains(hashset, &int_keys[(i * 7919) % TABLE_KEYS]);
+    }
+    const double hashset_ms = anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+
+    start = anv_time_get_ns();
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        anv_intset_add(intset, int_keys[i]);
+    }
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        found += anv_intset_contains(intset, int_keys[(i * 7919) % TABLE_KEYS]);
+    }
+    const double intset_ms = anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+
+    printf("Dedup + probe of %d integer ids: hash set %.3f ms, int set %.3f ms\n", TABLE_KEYS, hashset_ms,
+           intset_ms);
+    const bool sizes_match = anv_hashset_size(hashset) == TABLE_KEYS / 2 && anv_intset_size(intset) == TABLE_KEYS / 2;
+    anv_hashset_destroy(hashset, false);
+    anv_intset_destroy(intset);
+    return sizes_match && found == 2 * (size_t)TABLE_KEYS;
+}
+
+/**
+ * Count occurrences of TABLE_KEYS ids, with get followed by put vs a single
+ * anv_hashmap_entry per id, then with a generated map storing counts
+ * unboxed. ANVHashMap counts are stored directly in the value pointer.
+ */
+static bool compare_counting(ANVAllocator* alloc)
+{
+    ANVHashMap* two_lookups = anv_hashmap_create(alloc, anv_hash_int64, equals_u64, 0);
+    ANVHashMap* one_lookup = anv_hashmap_create(alloc, anv_hash_int64, equals_u64, 0);
+    if (!two_lookups || !one_lookup)
+    {
+        anv_hashmap_destroy(two_lookups, false, false);
+        anv_hashmap_destroy(one_lookup, false, false);
+        return false;
+    }
+
+    uint64_t start = anv_time_get_ns();
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        const uintptr_t count = (uintptr_t)anv_hashmap_get(two_lookups, &int_keys[i]);
+        anv_hashmap_put(two_lookups, &int_keys[i], (void*)(count + 1));
+    }
+    const double two_ms = anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+
+    start = anv_time_get_ns();
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        void** slot = anv_hashmap_entry(one_lookup, &int_keys[i], NULL);
+        *slot = (void*)((uintptr_t)*slot + 1);
+    }
+    const double one_ms = anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+
+    IdCounts* typed = IdCounts_create(alloc, 0);
+    if (!typed)
+    {
+        anv_hashmap_destroy(two_lookups, false, false);
+        anv_hashmap_destroy(one_lookup, false, false);
+        return false;
+    }
+
+    start = anv_time_get_ns();
+    for (size_t i = 0; i < TABLE_KEYS; i++)
+    {
+        (*IdCounts_entry(typed, int_keys[i], NULL))++;
+    }
+    const double typed_ms = anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+
+    printf("Counting %d integer ids: get + put %.3f ms, entry %.3f ms, typed %.3f ms\n", TABLE_KEYS, two_ms,
+           one_ms, typed_ms);
+    const bool counts_match = anv_hashmap_get(one_lookup, &int_keys[0]) == (void*)2 &&
+                              anv_hashmap_get(two_lookups, &int_keys[0]) == (void*)2 &&
+                              anv_hashmap_size(one_lookup) == TABLE_KEYS / 2 &&
+                              *IdCounts_get(typed, int_keys[0]) == 2 && IdCounts_size(typed) == TABLE_KEYS / 2;
+    anv_hashmap_destroy(two_lookups, false, false);
+    anv_hashmap_destroy(one_lookup, false, false);
+    IdCounts_destroy(typed);
+    return counts_match;
+}
+
+static size_t batch_keys[BATCH_KEYS];
+static const void* batch_lookups[BATCH_KEYS];
+static void* batch_values[BATCH_KEYS];
+
+/**
+ * Look up every key of a table too large for the cache in random order, one
+ * get at a time vs through anv_hashmap_get_batch.
+ */
+static bool compare_batch(ANVAllocator* alloc)
+{
+    ANVHashMap* map = anv_hashmap_create(alloc, anv_hash_int64, anv_key_equals_pointer, BATCH_KEYS);
+    if (!map)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < BATCH_KEYS; i++)
+    {
+        batch_keys[i] = i;
+        anv_hashmap_put(map, &batch_keys[i], &batch_keys[i]);
+    }
+    for (size_t i = 0; i < BATCH_KEYS; i++)
+    {
+        // Odd multiplier: a permutation of the keys with no locality
+        batch_lookups[i] = &batch_keys[(i * 0x9E3779B1u) & (BATCH_KEYS - 1)];
+    }
+
+    size_t found = 0;
+    uint64_t start = anv_time_get_ns();
+    for (size_t i = 0; i < BATCH_KEYS; i++)
+    {
+        found += anv_hashmap_get(map, batch_lookups[i]) != NULL;
+    }
+    const double single_ms = anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+
+    start = anv_time_get_ns();
+    found += anv_hashmap_get_batch(map, batch_lookups, BATCH_KEYS, batch_values);
+    const double batch_ms = anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+
+    printf("Lookup of %u keys in random order: one at a time %.3f ms, batched %.3f ms\n", BATCH_KEYS,
+           single_ms, batch_ms);
+    anv_hashmap_destroy(map, false, false);
+    return found == 2 * (size_t)BATCH_KEYS;
+}
+
+int main(void)
+{
+    fill_keys();
+
+    printf("Keyed vs unkeyed hashing (%d hashes per row)\n", HASH_ITERATIONS);
+    printf("%6s %12s %12s %14s\n", "bytes", "fast ns", "siphash ns", "halfsiphash ns");
+    for (size_t len = 8; len <= KEY_LENGTH; len *= 2)
+    {
+        printf("%6zu %12.2f %12.2f %14.2f\n", len, ns_per_hash(fast_bytes, len),
+               ns_per_hash(siphash_bytes, len), ns_per_hash(halfsiphash_bytes, len));
+    }
+
+    ANVAllocator alloc = anv_alloc_default();
+    const double fast_ms = run_map(anv_hashmap_create(&alloc, anv_hash_string, anv_key_equals_string, 0));
+    const double seeded_ms = run_map(anv_hashmap_create_seeded(&alloc, anv_hash_string_siphash,
+                                                               anv_key_equals_string, 0, NULL));
+    if (fast_ms < 0.0 || seeded_ms < 0.0)
+    {
+        printf("Hash map lookup failed\n");
+        return -1;
+    }
+
+    printf("Hash map insert + lookup of %d string keys: fast %.3f ms, seeded %.3f ms\n",
+           MAP_KEYS, fast_ms, seeded_ms);
+
+    if (!compare_tables(&alloc))
+    {
+        printf("Table lookup failed\n");
+        return -1;
+    }
+
+    if (!compare_frozen(&alloc))
+    {
+        printf("Frozen map lookup failed\n");
+        return -1;
+    }
+
+    if (!compare_sets(&alloc))
+    {
+        printf("Set lookup failed\n");
+        return -1;
+    }
+
+    if (!compare_counting(&alloc))
+    {
+        printf("Counting failed\n");
+        return -1;
+    }
+
+    if (!compare_batch(&alloc))
+    {
+        printf("Batched lookup failed\n");
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "anvil/containers/hashmap.h"
+#include "anvil/system/timing.h"
+
+#define INSERTS (1u << 21)
+
+static size_t keys[INSERTS];
+static uint64_t latencies[INSERTS];
+
+static int compare_u64(const void* a, const void* b)
+{
+    const uint64_t x = *(const uint64_t*)a;
+    const uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t percentile(const double fraction)
+{
+    return latencies[(size_t)(fraction * (INSERTS - 1))];
+}
+
+/**
+ * Time every put while the map grows from empty to INSERTS entries, then
+ * report the latency distribution.
+ */
+static int run(const char* label, const bool incremental)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVHashMap* map = anv_hashmap_create(&alloc, anv_hash_int64, anv_key_equals_pointer, 0);
+    if (!map)
+    {
+        return -1;
+    }
+    anv_hashmap_set_incremental_resize(map, incremental);
+
+    const uint64_t total_start = anv_time_get_ns();
+    for (size_t i = 0; i < INSERTS; i++)
+    {
+        const uint64_t start = anv_time_get_ns();
+        const int result = anv_hashmap_put(map, &keys[i], &keys[i]);
+        latencies[i] = anv_time_diff_ns(start, anv_time_get_ns());
+        if (result != 0)
+        {
+            anv_hashmap_destroy(map, false, false);
+            return -1;
+        }
+    }
+    const double total_ms = anv_time_ns_to_ms(anv_time_diff_ns(total_start, anv_time_get_ns()));
+
+    size_t found = 0;
+    for (size_t i = 0; i < INSERTS; i++)
+    {
+        found += anv_hashmap_get(map, &keys[i]) != NULL;
+    }
+    anv_hashmap_destroy(map, false, false);
+
+    qsort(latencies, INSERTS, sizeof(uint64_t), compare_u64);
+    printf("%-12s %10.1f %8llu %8llu %8llu %10.3f %10.1f\n", label, total_ms,
+           (unsigned long long)percentile(0.5), (unsigned long long)percentile(0.99),
+           (unsigned long long)percentile(0.999), anv_time_ns_to_ms(latencies[INSERTS - 1]),
+           (double)latencies[INSERTS - 1] / (double)percentile(0.999));
+    return found == INSERTS ? 0 : -1;
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < INSERTS; i++)
+    {
+        keys[i] = i;
+    }
+
+    printf("Hash map put latency while growing to %u entries\n", INSERTS);
+    printf("%-12s %10s %8s %8s %8s %10s %10s\n", "resize", "total ms", "p50 ns", "p99 ns", "p99.9 ns",
+           "max ms", "max/p99.9");
+    if (run("stop-world", false) != 0 || run("incremental", true) != 0)
+    {
+        printf("Hash map insert failed\n");
+        return -1;
+    }
+    return 0;
+}
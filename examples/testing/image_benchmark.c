@@ -0,0 +1,127 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include <stdio.h>
+
+#include "anvil/containers/hashmap.h"
+#include "anvil/io/image.h"
+#include "anvil/system/timing.h"
+
+#define RECORDS (1u << 20)
+#define KEY_LENGTH 16
+#define VALUE_LENGTH 32
+#define SAMPLE_LOOKUPS 1000
+#define IMAGE_PATH "anv_image_benchmark.bin"
+
+static char keys[RECORDS][KEY_LENGTH];
+static char values[RECORDS][VALUE_LENGTH];
+
+static volatile size_t sink;
+
+static double elapsed_ms(const uint64_t start)
+{
+    return anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+}
+
+static ANVHashMap* build_map(ANVAllocator* alloc)
+{
+    ANVHashMap* map = anv_hashmap_create(alloc, anv_hash_string, anv_key_equals_string, 0);
+    if (!map)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < RECORDS; i++)
+    {
+        if (anv_hashmap_put(map, keys[i], values[i]) != 0)
+        {
+            anv_hashmap_destroy(map, false, false);
+            return NULL;
+        }
+    }
+    return map;
+}
+
+/**
+ * Compare rebuilding a string map at startup with mapping an image of it:
+ * the cost of getting to the first lookups, then a full pass of lookups.
+ */
+int main(void)
+{
+    for (size_t i = 0; i < RECORDS; i++)
+    {
+        snprintf(keys[i], KEY_LENGTH, "record-%07zu", i);
+        snprintf(values[i], VALUE_LENGTH, "payload-%zu", i * 2654435761u);
+    }
+
+    ANVAllocator alloc = anv_alloc_default();
+    uint64_t start = anv_time_get_ns();
+    ANVHashMap* map = build_map(&alloc);
+    const double build_ms = elapsed_ms(start);
+    if (!map)
+    {
+        printf("Map build failed\n");
+        return -1;
+    }
+
+    start = anv_time_get_ns();
+    const ANVResult written = anv_image_write_hashmap(map, IMAGE_PATH, anv_image_size_string, anv_image_size_string);
+    const double write_ms = elapsed_ms(start);
+
+    ANVHashMapImage* image = NULL;
+    start = anv_time_get_ns();
+    const ANVResult opened = ANV_SUCCEEDED(written)
+                                 ? anv_image_open_hashmap(&alloc, IMAGE_PATH, anv_hash_string,
+                                                          anv_key_equals_string, false, &image)
+                                 : written;
+    size_t found = 0;
+    for (size_t i = 0; ANV_SUCCEEDED(opened) && i < SAMPLE_LOOKUPS; i++)
+    {
+        found += anv_image_hashmap_get(image, keys[(i * 7919) % RECORDS]) != NULL;
+    }
+    const double open_ms = elapsed_ms(start);
+    if (ANV_FAILED(opened) || found != SAMPLE_LOOKUPS)
+    {
+        printf("Image write or open failed\n");
+        anv_image_hashmap_close(image);
+        anv_hashmap_destroy(map, false, false);
+        remove(IMAGE_PATH);
+        return -1;
+    }
+
+    start = anv_time_get_ns();
+    ANVHashMapImage* verified = NULL;
+    const ANVResult checked = anv_image_open_hashmap(&alloc, IMAGE_PATH, anv_hash_string, anv_key_equals_string,
+                                                     true, &verified);
+    const double verify_ms = elapsed_ms(start);
+    anv_image_hashmap_close(verified);
+
+    found = 0;
+    start = anv_time_get_ns();
+    for (size_t i = 0; i < RECORDS; i++)
+    {
+        found += anv_hashmap_get(map, keys[(i * 7919) % RECORDS]) != NULL;
+    }
+    const double map_lookup_ms = elapsed_ms(start);
+
+    start = anv_time_get_ns();
+    for (size_t i = 0; i < RECORDS; i++)
+    {
+        const char* value = anv_image_hashmap_get(image, keys[(i * 7919) % RECORDS]);
+        found += value != NULL;
+        sink += value ? (size_t)value[0] : 0;
+    }
+    const double image_lookup_ms = elapsed_ms(start);
+
+    printf("Startup with %u string records: rebuild %.3f ms, open image + %d lookups %.3f ms "
+           "(write %.3f ms, open with checksum %.3f ms)\n",
+           RECORDS, build_ms, SAMPLE_LOOKUPS, open_ms, write_ms, verify_ms);
+    printf("Lookup of %u string keys: hash map %.3f ms, mapped image %.3f ms\n", RECORDS, map_lookup_ms,
+           image_lookup_ms);
+
+    anv_image_hashmap_close(image);
+    anv_hashmap_destroy(map, false, false);
+    remove(IMAGE_PATH);
+    return ANV_SUCCEEDED(checked) && found == 2 * (size_t)RECORDS ? 0 : -1;
+}
@@ -0,0 +1,161 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "anvil/memory/thread_cache.h"
+#include "anvil/system/thread.h"
+#include "anvil/system/timing.h"
+
+#define MAX_THREADS 64
+#define OPERATIONS_PER_THREAD 100000
+#define LIVE_BLOCKS 256
+#define MID_OPERATIONS_PER_THREAD 20000
+#define MID_LIVE_BLOCKS 16
+
+typedef struct Worker
+{
+    ANVThread thread;
+    const ANVAllocator* alloc;
+    void* blocks[LIVE_BLOCKS]; // Blocks still live after the churn phase
+    void** remote;             // Another worker's blocks to free in the handoff phase
+    uint32_t seed;
+    bool mid_size;             // Churn 8-256 KB buffers instead of node-sized blocks
+} Worker;
+
+static Worker workers[MAX_THREADS];
+
+static uint32_t next_random(uint32_t* state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static size_t random_size(uint32_t* state)
+{
+    // Mostly node-sized requests with an occasional larger buffer
+    const uint32_t roll = next_random(state);
+    if (roll % 16 == 0)
+    {
+        return 512 + roll % 3584;
+    }
+    return 16 + roll % 240;
+}
+
+static size_t random_mid_size(uint32_t* state)
+{
+    // Buffers above the small classes, up to the largest cached class
+    return 8 * 1024 + 1 + next_random(state) % (ANV_TCACHE_MAX_CLASS_SIZE - 8 * 1024);
+}
+
+static void* churn(void* arg)
+{
+    Worker* worker = arg;
+    memset(worker->blocks, 0, sizeof(worker->blocks));
+
+    const uint32_t operations = worker->mid_size ? MID_OPERATIONS_PER_THREAD : OPERATIONS_PER_THREAD;
+    const uint32_t live = worker->mid_size ? MID_LIVE_BLOCKS : LIVE_BLOCKS;
+    for (uint32_t i = 0; i < operations; i++)
+    {
+        const uint32_t slot = next_random(&worker->seed) % live;
+        anv_alloc_deallocate(worker->alloc, worker->blocks[slot]);
+
+        const size_t size = worker->mid_size ? random_mid_size(&worker->seed) : random_size(&worker->seed);
+        unsigned char* block = anv_alloc_allocate(worker->alloc, size);
+        if (block)
+        {
+            block[0] = (unsigned char)i;
+            block[size - 1] = (unsigned char)i;
+        }
+        worker->blocks[slot] = block;
+    }
+    return NULL;
+}
+
+static void* free_remote(void* arg)
+{
+    // Frees blocks allocated by a different thread
+    const Worker* worker = arg;
+    for (uint32_t i = 0; i < LIVE_BLOCKS; i++)
+    {
+        anv_alloc_deallocate(worker->alloc, worker->remote[i]);
+    }
+    return NULL;
+}
+
+static bool run_phase(const uint32_t threads, void* (*func)(void*))
+{
+    for (uint32_t i = 0; i < threads; i++)
+    {
+        if (anv_thread_create(&workers[i].thread, func, &workers[i]) != 0)
+        {
+            for (uint32_t j = 0; j < i; j++)
+            {
+                anv_thread_join(workers[j].thread, NULL);
+            }
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < threads; i++)
+    {
+        anv_thread_join(workers[i].thread, NULL);
+    }
+    return true;
+}
+
+static double run_workload(const ANVAllocator* alloc, const uint32_t threads, const bool mid_size)
+{
+    for (uint32_t i = 0; i < threads; i++)
+    {
+        workers[i].alloc = alloc;
+        workers[i].mid_size = mid_size;
+        workers[i].seed = 0x9E3779B9u * (i + 1);
+        workers[i].remote = workers[(i + 1) % threads].blocks;
+    }
+
+    const uint64_t start = anv_time_get_ns();
+    if (!run_phase(threads, churn) || !run_phase(threads, free_remote))
+    {
+        return -1.0;
+    }
+    return anv_time_ns_to_ms(anv_time_diff_ns(start, anv_time_get_ns()));
+}
+
+int main(void)
+{
+    const ANVAllocator system_alloc = anv_alloc_default();
+    const ANVAllocator cached_alloc = anv_tcache_allocator();
+
+    printf("Thread-caching allocator vs malloc (cross-thread frees)\n");
+    printf("%8s %10s %12s %12s %9s\n", "threads", "sizes", "malloc ms", "tcache ms", "speedup");
+
+    for (uint32_t threads = 1; threads <= MAX_THREADS; threads *= 2)
+    {
+        // Node-sized blocks, then buffers above the small classes
+        for (int mid_size = 0; mid_size <= 1; mid_size++)
+        {
+            const double system_ms = run_workload(&system_alloc, threads, mid_size);
+            const double cached_ms = run_workload(&cached_alloc, threads, mid_size);
+            if (system_ms < 0.0 || cached_ms < 0.0)
+            {
+                printf("Failed to start %u threads\n", threads);
+                return -1;
+            }
+
+            printf("%8u %10s %12.3f %12.3f %8.2fx\n", threads, mid_size ? "8-256 KB" : "16 B-4 KB", system_ms,
+                   cached_ms, cached_ms > 0.0 ? system_ms / cached_ms : 0.0);
+        }
+    }
+
+    const ANVThreadCacheStats stats = anv_tcache_stats();
+    printf("tcache: %zu spans, %zu objects on central lists, %zu large blocks live\n",
+           stats.spans, stats.central_objects, stats.large_blocks);
+    return stats.large_blocks == 0 ? 0 : -1;
+}
@@ -20,7 +20,53 @@ extern "C" {
 typedef size_t (*anv_hash_func)(const void* data);
 
 /**
- * Hash function for string keys.
+ * 128-bit secret key for keyed hashing.
+ */
+typedef struct ANVHashSeed
+{
+    uint64_t k0; // First half of the key
+    uint64_t k1; // Second half of the key
+} ANVHashSeed;
+
+/**
+ * Keyed hash function type. Without the seed, an attacker cannot predict
+ * which keys collide.
+ *
+ * @param data Data to hash
+ * @param seed Secret key
+ * @return Hash value
+ */
+typedef size_t (*anv_seeded_hash_func)(const void* data, const ANVHashSeed* seed);
+
+/**
+ * Hash an arbitrary byte range.
+ *
+ * A wyhash-style hash: input is consumed 48 bytes per step in three
+ * independent multiply-mix lanes, then 16 bytes at a time, and keys of up
+ * to 16 bytes are read with a few overlapping loads and no loop. Each mix
+ * is a 64x64->128-bit multiply folded to 64 bits. Input words are read
+ * little-endian, so results do not depend on the host byte order. Not
+ * suitable for untrusted keys.
+ *
+ * @param data Bytes to hash (may be NULL if len is 0)
+ * @param len Number of bytes
+ * @param seed Seed value; different seeds give independent hashes
+ * @return 64-bit hash value
+ */
+ANV_API uint64_t anv_hash_bytes(const void* data, size_t len, uint64_t seed);
+
+/**
+ * Mix a 64-bit integer into a hash value. The mix is a bijection, so
+ * distinct inputs never collide before the table index is taken.
+ *
+ * @param value Value to mix
+ * @return 64-bit hash value
+ */
+ANV_API uint64_t anv_hash_mix64(uint64_t value);
+
+/**
+ * Hash function for string keys. Hashes the string's bytes with
+ * anv_hash_bytes.
  *
  * @param key Pointer to null-terminated string
  * @return Hash value
@@ -35,6 +81,14 @@ ANV_API size_t anv_hash_string(const void* key);
  */
 ANV_API size_t anv_hash_int(const void* key);
 
+/**
+ * Hash function for 64-bit integer keys.
+ *
+ * @param key Pointer to int64_t (or uint64_t)
+ * @return Hash value
+ */
+ANV_API size_t anv_hash_int64(const void* key);
+
 /**
  * Hash function for pointer keys (uses memory address).
  *
@@ -43,6 +97,59 @@ ANV_API size_t anv_hash_int(const void* key);
  */
 ANV_API size_t anv_hash_pointer(const void* key);
 
+//==============================================================================
+// Keyed hashing
+//==============================================================================
+
+/**
+ * Generate a random seed from the operating system's entropy source.
+ *
+ * @return Random seed
+ */
+ANV_API ANVHashSeed anv_hash_random_seed(void);
+
+/**
+ * SipHash-1-3 keyed hash: one compression round per 8-byte word and three
+ * finalization rounds. Flood resistant for hash tables at a modest cost
+ * over anv_hash_bytes. Words are read little-endian, as in the reference
+ * implementation, so the output is the same on every host.
+ *
+ * @param data Bytes to hash (may be NULL if len is 0)
+ * @param len Number of bytes
+ * @param seed Secret key
+ * @return 64-bit hash value
+ */
+ANV_API uint64_t anv_siphash13(const void* data, size_t len, const ANVHashSeed* seed);
+
+/**
+ * HalfSipHash-1-3 keyed hash, operating on 32-bit words with a 64-bit key
+ * (the low halves of seed->k0 and seed->k1). Cheaper on 32-bit targets.
+ *
+ * @param data Bytes to hash (may be NULL if len is 0)
+ * @param len Number of bytes
+ * @param seed Secret key
+ * @return 32-bit hash value
+ */
+ANV_API uint32_t anv_halfsiphash13(const void* data, size_t len, const ANVHashSeed* seed);
+
+/**
+ * Keyed hash function for string keys using SipHash-1-3.
+ *
+ * @param key Pointer to null-terminated string
+ * @param seed Secret key
+ * @return Hash value
+ */
+ANV_API size_t anv_hash_string_siphash(const void* key, const ANVHashSeed* seed);
+
+/**
+ * Keyed hash function for string keys using HalfSipHash-1-3.
+ *
+ * @param key Pointer to null-terminated string
+ * @param seed Secret key
+ * @return Hash value
+ */
+ANV_API size_t anv_hash_string_halfsiphash(const void* key, const ANVHashSeed* seed);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,8 +12,25 @@
 extern "C" {
 #endif
 
+/**
+ * Allocator hint flags.
+ */
+#define ANV_ALLOC_POOL_NODES (1u << 0) // Node-based containers allocate nodes from a private slab pool
+
 /**
  * Struct containing Allocator function types for memory management.
+ *
+ * An allocator is either stateless (allocate/deallocate) or stateful
+ * (allocate_ctx/deallocate_ctx plus a context pointer). When the context
+ * hooks are set they take precedence over the stateless ones, which lets
+ * arenas and pools back any container without global state.
+ *
+ * The reallocate and allocate_aligned hooks are optional. When they are
+ * NULL, anv_alloc_reallocate and anv_alloc_allocate_aligned fall back to
+ * allocate + copy + deallocate and an over-allocating aligned wrapper.
+ *
+ * The flags field carries ANV_ALLOC_* hints for the containers that use
+ * the allocator.
  */
 typedef struct ANVAllocator
 {
@@ -21,6 +38,13 @@ typedef struct ANVAllocator
         void (*deallocate)(void* ptr);
         void (*data_free)(void* ptr);
         void* (*copy)(const void* data);
+
+        void* context;                                  // User context passed to the *_ctx hooks
+        anv_allocate_ctx_func allocate_ctx;             // Stateful allocation (optional)
+        anv_deallocate_ctx_func deallocate_ctx;         // Stateful deallocation (optional)
+        anv_reallocate_ctx_func reallocate;             // Resize a block (optional)
+        anv_allocate_aligned_ctx_func allocate_aligned; // Aligned allocation (optional)
+        uint32_t flags;                                 // ANV_ALLOC_* hints for containers
 } ANVAllocator;
 
 //==============================================================================
@@ -30,7 +54,9 @@ typedef struct ANVAllocator
 /**
  * Create a default allocator using standard library functions.
  * Uses malloc and free for allocation. The default copy function
- * just returns the pointer provided to it.
+ * just returns the pointer provided to it. Resizing goes through realloc,
+ * which can extend a block in place (and on glibc moves large mmap-backed
+ * blocks with mremap instead of copying).
  *
  * @return ANVAllocator struct with default functions
  */
@@ -48,6 +74,31 @@ ANV_API ANVAllocator anv_alloc_default(void);
 ANV_API ANVAllocator anv_alloc_custom(anv_allocate_func alloc_func, anv_deallocate_func dealloc_func,
                                       anv_deallocate_func data_free_func, anv_copy_func anv_copy_func);
 
+/**
+ * Create a stateful allocator whose hooks receive a user context pointer.
+ * The reallocate and allocate_aligned hooks start out NULL and can be
+ * assigned on the returned struct when the backing store supports them.
+ *
+ * @param context User context passed to every hook (arena, pool, ...)
+ * @param alloc_func Context-aware allocation function (required)
+ * @param dealloc_func Context-aware deallocation function (required)
+ * @param data_free_func User data cleanup function (can be NULL)
+ * @param anv_copy_func Data copying function (can be NULL)
+ * @return ANVAllocator struct with the context hooks installed
+ */
+ANV_API ANVAllocator anv_alloc_stateful(void* context, anv_allocate_ctx_func alloc_func,
+                                        anv_deallocate_ctx_func dealloc_func,
+                                        anv_deallocate_func data_free_func, anv_copy_func anv_copy_func);
+
+/**
+ * Check whether the allocator can allocate memory, through either the
+ * stateless or the context hooks.
+ *
+ * @param alloc Pointer to ANVAllocator struct
+ * @return true if an allocation function is available, false otherwise
+ */
+ANV_API bool anv_alloc_is_valid(const ANVAllocator* alloc);
+
 /**
  * Allocate memory using the allocator's allocation function.
  *
@@ -65,6 +116,39 @@ ANV_API void* anv_alloc_allocate(const ANVAllocator* alloc, size_t size);
  */
 ANV_API void anv_alloc_deallocate(const ANVAllocator* alloc, void* ptr);
 
+/**
+ * Resize a block previously obtained from this allocator.
+ * Uses the reallocate hook when present, otherwise allocates a new block,
+ * copies min(old_size, new_size) bytes and frees the old block.
+ *
+ * @param alloc Pointer to ANVAllocator struct
+ * @param ptr Pointer to the block to resize (NULL behaves like allocate)
+ * @param old_size Current size of the block in bytes
+ * @param new_size Requested size in bytes
+ * @return Pointer to the resized block, or NULL on failure (ptr stays valid)
+ */
+ANV_API void* anv_alloc_reallocate(const ANVAllocator* alloc, void* ptr, size_t old_size, size_t new_size);
+
+/**
+ * Allocate memory aligned to the given boundary.
+ * Blocks returned by this function must be released with
+ * anv_alloc_deallocate_aligned using the same allocator.
+ *
+ * @param alloc Pointer to ANVAllocator struct
+ * @param size Number of bytes to allocate
+ * @param alignment Required alignment in bytes (power of two)
+ * @return Pointer to aligned memory, or NULL on failure or invalid alignment
+ */
+ANV_API void* anv_alloc_allocate_aligned(const ANVAllocator* alloc, size_t size, size_t alignment);
+
+/**
+ * Free memory obtained from anv_alloc_allocate_aligned.
+ *
+ * @param alloc Pointer to ANVAllocator struct
+ * @param ptr Pointer to aligned memory to free
+ */
+ANV_API void anv_alloc_deallocate_aligned(const ANVAllocator* alloc, void* ptr);
+
 /**
  * Free user data using the allocator's data free function.
  * Does nothing if data_free is NULL.
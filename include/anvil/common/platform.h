@@ -36,6 +36,13 @@ extern "C" {
     #define ANV_API
 #endif
 
+// Thread-local storage
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define ANV_THREAD_LOCAL __declspec(thread)
+#else
+    #define ANV_THREAD_LOCAL _Thread_local
+#endif
+
 // Detect C23 for standard attributes
 #if __STDC_VERSION__ >= 202311L
     #define ANV_COMPAT_C23 1
@@ -31,6 +31,48 @@ typedef void* (*anv_allocate_func)(size_t size);
  */
 typedef void (*anv_deallocate_func)(void* data);
 
+/**
+ * Context-aware allocation function used by stateful allocators.
+ *
+ * @param context User context stored in the allocator (arena, pool, ...)
+ * @param size Number of bytes to allocate
+ * @return Pointer to allocated memory, or NULL on failure
+ */
+typedef void* (*anv_allocate_ctx_func)(void* context, size_t size);
+
+/**
+ * Context-aware deallocation function used by stateful allocators.
+ *
+ * @param context User context stored in the allocator
+ * @param ptr Pointer previously returned by the matching allocate function
+ */
+typedef void (*anv_deallocate_ctx_func)(void* context, void* ptr);
+
+/**
+ * Context-aware reallocation function.
+ * Must behave like realloc: the contents up to min(old_size, new_size) are
+ * preserved and the old pointer is invalid after a successful call.
+ *
+ * @param context User context stored in the allocator
+ * @param ptr Pointer to the existing block (may be NULL)
+ * @param old_size Size of the existing block in bytes
+ * @param new_size Requested size in bytes
+ * @return Pointer to the resized block, or NULL on failure (ptr stays valid)
+ */
+typedef void* (*anv_reallocate_ctx_func)(void* context, void* ptr, size_t old_size, size_t new_size);
+
+/**
+ * Context-aware aligned allocation function.
+ * Memory returned by this function must be releasable through the
+ * allocator's regular deallocation function.
+ *
+ * @param context User context stored in the allocator
+ * @param size Number of bytes to allocate
+ * @param alignment Required alignment in bytes (power of two)
+ * @return Pointer to aligned memory, or NULL on failure
+ */
+typedef void* (*anv_allocate_aligned_ctx_func)(void* context, size_t size, size_t alignment);
+
 /**
  * Copy function for deep copying element data.
  * Should return a pointer to a newly allocated copy of the data.
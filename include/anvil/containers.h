@@ -7,14 +7,20 @@
 
 #include "containers/arraylist.h"
 #include "containers/binarysearchtree.h"
+#include "containers/concurrenthashmap.h"
 #include "containers/doublylinkedlist.h"
 #include "containers/dynamicstring.h"
+#include "containers/flatmap.h"
+#include "containers/frozenmap.h"
 #include "containers/hashmap.h"
 #include "containers/hashset.h"
+#include "containers/intset.h"
 #include "containers/iterator.h"
 #include "containers/pair.h"
 #include "containers/queue.h"
 #include "containers/singlylinkedlist.h"
+#include "containers/slotmap.h"
 #include "containers/stack.h"
+#include "containers/typedhashmap.h"
 
 #endif //ANVIL_CONTAINERS_H
\ No newline at end of file
@@ -24,6 +24,7 @@ typedef struct ANVArrayList
         void** data;
         size_t size;
         size_t capacity;
+        size_t alignment; // Backing store alignment in bytes (0 for the allocator's default)
         ANVAllocator alloc;
 } ANVArrayList;
 
@@ -40,6 +41,19 @@ typedef struct ANVArrayList
  */
 ANV_API ANVArrayList* anv_arraylist_create(ANVAllocator* alloc, size_t initial_capacity);
 
+/**
+ * Create a new, empty ArrayList whose backing array is aligned to the given
+ * boundary, e.g. 64 bytes to keep it on its own cache lines. Copies, filters
+ * and transforms of the list keep the same alignment.
+ *
+ * @param alloc Custom allocator (required)
+ * @param initial_capacity Initial capacity (0 uses default)
+ * @param alignment Alignment of the backing array in bytes (power of two of at
+ *                  least sizeof(void*), or 0 for the allocator's default)
+ * @return Pointer to new ArrayList, or NULL on failure or invalid alignment
+ */
+ANV_API ANVArrayList* anv_arraylist_create_aligned(ANVAllocator* alloc, size_t initial_capacity, size_t alignment);
+
 /**
  * Destroy the ArrayList and free all elements.
  *
@@ -7,6 +7,7 @@
 
 #include "iterator.h"
 #include "anvil/common.h"
+#include "anvil/memory/slab.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,6 +33,7 @@ typedef struct ANVBinarySearchTree
         size_t size;                   // Number of nodes in tree
         anv_compare_func compare;      // Comparison function for ordering
         ANVAllocator alloc;            // Custom allocator
+        ANVSlabAllocator* node_pool;   // Node slab pool (NULL unless ANV_ALLOC_POOL_NODES is set)
 } ANVBinarySearchTree;
 
 //==============================================================================
@@ -40,6 +42,8 @@ typedef struct ANVBinarySearchTree
 
 /**
  * Create a new, empty binary search tree.
+ * Nodes come from a private slab pool when the allocator has
+ * ANV_ALLOC_POOL_NODES set.
  *
  * @param alloc Custom allocator
  * @param compare Comparison function for ordering elements
@@ -0,0 +1,209 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_CONCURRENTHASHMAP_H
+#define ANVIL_CONCURRENTHASHMAP_H
+
+#include "hashmap.h"
+#include "iterator.h"
+#include "pair.h"
+#include "anvil/common.h"
+#include "anvil/algorithms/hash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/**
+ * Number of independently locked segments. Writers to different segments
+ * never contend. Must be a power of two.
+ */
+#ifndef ANV_CHM_SEGMENTS
+#define ANV_CHM_SEGMENTS 64
+#endif
+
+/**
+ * Number of reader counters that concurrent readers are spread across.
+ */
+#ifndef ANV_CHM_READER_STRIPES
+#define ANV_CHM_READER_STRIPES 64
+#endif
+
+/**
+ * Retired nodes, tables and values allowed to accumulate before writers try
+ * to reclaim them.
+ */
+#ifndef ANV_CHM_RECLAIM_BATCH
+#define ANV_CHM_RECLAIM_BATCH 64
+#endif
+
+//==============================================================================
+// Type definitions
+//==============================================================================
+
+/**
+ * Thread-safe hash map.
+ *
+ * Keys are spread over ANV_CHM_SEGMENTS segments, each a separately chained
+ * table guarded by its own mutex, so writers only serialize with writers of
+ * the same segment. Readers take no locks: they announce themselves on a
+ * striped epoch counter, walk chains published with release stores, and
+ * leave. Unlinked nodes, replaced tables and freed keys or values are
+ * retired and only released once every reader that could still see them
+ * has left, so a reader never touches freed memory.
+ *
+ * The allocator must be thread-safe. The map only frees keys and values
+ * when asked to (should_free flags), and then only once no get, lookup or
+ * iterator that could still see them is in progress. A pointer returned by
+ * get is not protected after get returns, so if other threads free the data
+ * on replace or remove, callers must manage its lifetime themselves.
+ */
+typedef struct ANVConcurrentHashMap ANVConcurrentHashMap;
+
+/**
+ * Computes the value to insert for an absent key.
+ *
+ * @param key The key being inserted
+ * @param context User data passed to anv_chm_compute_if_absent
+ * @return Value to insert, or NULL to insert nothing
+ */
+typedef void* (*anv_chm_compute_func)(const void* key, void* context);
+
+//==============================================================================
+// Creation and destruction functions
+//==============================================================================
+
+/**
+ * Create a new concurrent hash map.
+ *
+ * @param alloc Thread-safe allocator (required)
+ * @param hash Hash function for keys (required)
+ * @param key_equals Key equality function (required)
+ * @param initial_capacity Expected number of entries (0 for default)
+ * @return Pointer to new map, or NULL on failure
+ */
+ANV_API ANVConcurrentHashMap* anv_chm_create(ANVAllocator* alloc, anv_hash_func hash,
+                                             key_equals_func key_equals, size_t initial_capacity);
+
+/**
+ * Destroy the map. No other thread may be using it.
+ *
+ * @param map The map to destroy
+ * @param should_free_keys Whether to free key data
+ * @param should_free_values Whether to free value data
+ */
+ANV_API void anv_chm_destroy(ANVConcurrentHashMap* map, bool should_free_keys, bool should_free_values);
+
+//==============================================================================
+// Information functions
+//==============================================================================
+
+/**
+ * Get the number of entries. Under concurrent writes the result is a
+ * snapshot that may already be stale.
+ *
+ * @param map The map to query
+ * @return Number of entries, or 0 if map is NULL
+ */
+ANV_API size_t anv_chm_size(const ANVConcurrentHashMap* map);
+
+/**
+ * Check if the map contains a key. Never blocks.
+ *
+ * @param map The map to search
+ * @param key The key to search for
+ * @return 1 if key exists, 0 if not found or on error
+ */
+ANV_API int anv_chm_contains_key(ANVConcurrentHashMap* map, const void* key);
+
+//==============================================================================
+// Map operations
+//==============================================================================
+
+/**
+ * Get the value associated with a key. Never blocks.
+ *
+ * @param map The map to search
+ * @param key The key to look up
+ * @return Pointer to associated value, or NULL if not found or on error
+ */
+ANV_API void* anv_chm_get(ANVConcurrentHashMap* map, const void* key);
+
+/**
+ * Insert or update a key-value pair. When the key exists its value is
+ * replaced and the passed key is not stored.
+ *
+ * @param map The map to modify
+ * @param key Pointer to key data (ownership transferred if inserted)
+ * @param value Pointer to value data (ownership transferred to map)
+ * @return 0 on success, -1 on error
+ */
+ANV_API int anv_chm_put(ANVConcurrentHashMap* map, void* key, void* value);
+
+/**
+ * Insert or update a key-value pair, freeing a replaced value once no
+ * reader can still hold it.
+ *
+ * @param map The map to modify
+ * @param key Pointer to key data (ownership transferred if inserted)
+ * @param value Pointer to value data (ownership transferred to map)
+ * @param should_free_old_value Whether to free the replaced value
+ * @return 0 on success, -1 on error
+ */
+ANV_API int anv_chm_put_with_free(ANVConcurrentHashMap* map, void* key, void* value, bool should_free_old_value);
+
+/**
+ * Atomically look up a key and, if it is absent, insert the value produced
+ * by compute. compute runs at most once, under the segment's lock, so it
+ * must not call back into the map. If compute returns a value but the entry
+ * cannot be allocated, the value is released with the map allocator's data
+ * deallocator; the key stays with the caller either way.
+ *
+ * @param map The map to modify
+ * @param key Pointer to key data (ownership transferred if inserted)
+ * @param compute Function producing the value for an absent key
+ * @param context User data passed to compute
+ * @param inserted_out Set to true if key was inserted (can be NULL)
+ * @return The existing or newly inserted value, or NULL if compute returned NULL or
+ *         the entry could not be allocated (inserted_out is false in both cases)
+ */
+ANV_API void* anv_chm_compute_if_absent(ANVConcurrentHashMap* map, void* key, anv_chm_compute_func compute,
+                                        void* context, bool* inserted_out);
+
+/**
+ * Remove a key-value pair. Key and value data are freed only after every
+ * reader that could still see them has finished.
+ *
+ * @param map The map to modify
+ * @param key The key to remove
+ * @param should_free_key Whether to free the key data
+ * @param should_free_value Whether to free the value data
+ * @return 0 on success, -1 if key not found or on error
+ */
+ANV_API int anv_chm_remove(ANVConcurrentHashMap* map, const void* key, bool should_free_key, bool should_free_value);
+
+//==============================================================================
+// Iterator functions
+//==============================================================================
+
+/**
+ * Create a weakly consistent iterator yielding ANVPair structures. It never
+ * blocks writers and never returns an entry twice, but may or may not
+ * reflect changes made after it was created. Memory reclamation is held
+ * back until the iterator is destroyed, so keep iterations short.
+ *
+ * @param map The map to iterate over
+ * @return An Iterator object for traversal
+ */
+ANV_API ANVIterator anv_chm_iterator(ANVConcurrentHashMap* map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ANVIL_CONCURRENTHASHMAP_H
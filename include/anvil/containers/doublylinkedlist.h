@@ -7,6 +7,7 @@
 
 #include "iterator.h"
 #include "../common.h"
+#include "../memory/slab.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,6 +33,7 @@ typedef struct ANVDoublyLinkedList
         size_t size;               // Number of nodes in list
 
         ANVAllocator alloc;
+        ANVSlabAllocator* node_pool; // Node slab pool (NULL unless ANV_ALLOC_POOL_NODES is set)
 } ANVDoublyLinkedList;
 
 //==============================================================================
@@ -40,6 +42,8 @@ typedef struct ANVDoublyLinkedList
 
 /**
  * Create a new, empty doubly linked list.
+ * Nodes come from a private slab pool when the allocator has
+ * ANV_ALLOC_POOL_NODES set.
  *
  * @param alloc Custom allocator
  * @return Pointer to new DoublyLinkedList, or NULL on failure.
@@ -0,0 +1,290 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_FLATMAP_H
+#define ANVIL_FLATMAP_H
+
+#include "hashmap.h"
+#include "iterator.h"
+#include "pair.h"
+#include "anvil/common.h"
+#include "anvil/algorithms/hash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// Type definitions
+//==============================================================================
+
+/**
+ * Key-value slot stored inline in a flat map's table.
+ */
+typedef struct ANVFlatMapSlot
+{
+        void* key;   // Pointer to key data
+        void* value; // Pointer to value data
+} ANVFlatMapSlot;
+
+/**
+ * Open-addressing hash map in the SwissTable layout.
+ *
+ * Entries live inline in a power-of-two slot array, with no per-entry
+ * allocation. A parallel array holds one control byte per slot: empty,
+ * deleted, or the low 7 bits of the key's hash. Lookups scan a group of
+ * control bytes at a time (16 with SSE2, 8 with the portable fallback),
+ * so key_equals only runs on slots whose 7-bit tag already matches and a
+ * miss usually stops at the first group. The table holds at most 7/8 of
+ * its capacity before it grows.
+ *
+ * Pointers to slots are invalidated by any insert that triggers a rehash.
+ */
+typedef struct ANVFlatMap
+{
+        int8_t* ctrl;                // Control bytes, plus a cloned first group for wraparound loads
+        ANVFlatMapSlot* slots;       // Slot array (same allocation as ctrl)
+        size_t capacity;             // Number of slots, a power of two
+        size_t size;                 // Number of key-value pairs
+        size_t growth_left;          // Inserts into empty slots before the next rehash
+        anv_hash_func hash;          // Hash function for keys
+        key_equals_func key_equals;  // Key equality function
+        ANVAllocator alloc;          // Custom allocator
+} ANVFlatMap;
+
+//==============================================================================
+// Creation and destruction functions
+//==============================================================================
+
+/**
+ * Create a new flat hash map.
+ *
+ * @param alloc Custom allocator (required)
+ * @param hash Hash function for keys (required)
+ * @param key_equals Key equality function (required)
+ * @param initial_capacity Number of entries to hold without rehashing (0 for default)
+ * @return Pointer to new flat map, or NULL on failure
+ */
+ANV_API ANVFlatMap* anv_flatmap_create(ANVAllocator* alloc, anv_hash_func hash,
+                                       key_equals_func key_equals, size_t initial_capacity);
+
+/**
+ * Destroy the flat map and its table.
+ *
+ * @param map The flat map to destroy
+ * @param should_free_keys Whether to free key data
+ * @param should_free_values Whether to free value data
+ */
+ANV_API void anv_flatmap_destroy(ANVFlatMap* map, bool should_free_keys, bool should_free_values);
+
+/**
+ * Remove all elements, keeping the table's capacity.
+ *
+ * @param map The flat map to clear
+ * @param should_free_keys Whether to free key data
+ * @param should_free_values Whether to free value data
+ */
+ANV_API void anv_flatmap_clear(ANVFlatMap* map, bool should_free_keys, bool should_free_values);
+
+/**
+ * Grow the table so it holds at least 'count' entries without rehashing.
+ *
+ * @param map The flat map to grow
+ * @param count Number of entries to make room for
+ * @return 0 on success, -1 on failure
+ */
+ANV_API int anv_flatmap_reserve(ANVFlatMap* map, size_t count);
+
+//==============================================================================
+// Information functions
+//==============================================================================
+
+/**
+ * Get the number of key-value pairs in the flat map.
+ *
+ * @param map The flat map to query
+ * @return Number of pairs, or 0 if map is NULL
+ */
+ANV_API size_t anv_flatmap_size(const ANVFlatMap* map);
+
+/**
+ * Check if the flat map is empty.
+ *
+ * @param map The flat map to check
+ * @return 1 if empty or NULL, 0 if it contains elements
+ */
+ANV_API int anv_flatmap_is_empty(const ANVFlatMap* map);
+
+/**
+ * Get the current load factor of the flat map.
+ *
+ * @param map The flat map to query
+ * @return Load factor (size / capacity), or 0.0 if map is NULL
+ */
+ANV_API double anv_flatmap_load_factor(const ANVFlatMap* map);
+
+/**
+ * Check if the flat map contains a key.
+ *
+ * @param map The flat map to search
+ * @param key The key to search for
+ * @return 1 if key exists, 0 if not found or on error
+ */
+ANV_API int anv_flatmap_contains_key(const ANVFlatMap* map, const void* key);
+
+//==============================================================================
+// Flat map operations
+//==============================================================================
+
+/**
+ * Insert or update a key-value pair.
+ *
+ * @param map The flat map to modify
+ * @param key Pointer to key data (ownership transferred to map)
+ * @param value Pointer to value data (ownership transferred to map)
+ * @return 0 on success, -1 on error
+ */
+ANV_API int anv_flatmap_put(ANVFlatMap* map, void* key, void* value);
+
+/**
+ * Insert or update a key-value pair, returning the old value if key exists.
+ *
+ * @param map The flat map to modify
+ * @param key Pointer to key data (ownership transferred to map)
+ * @param value Pointer to value data (ownership transferred to map)
+ * @param old_value_out Pointer to store the old value (NULL if key didn't exist)
+ * @return 0 on success, -1 on error
+ */
+ANV_API int anv_flatmap_put_replace(ANVFlatMap* map, void* key, void* value, void** old_value_out);
+
+/**
+ * Insert or update a key-value pair, optionally freeing the old value.
+ *
+ * @param map The flat map to modify
+ * @param key Pointer to key data (ownership transferred to map)
+ * @param value Pointer to value data (ownership transferred to map)
+ * @param should_free_old_value Whether to free the old value using the allocator
+ * @return 0 on success, -1 on error
+ */
+ANV_API int anv_flatmap_put_with_free(ANVFlatMap* map, void* key, void* value, bool should_free_old_value);
+
+/**
+ * Get the value associated with a key.
+ *
+ * @param map The flat map to search
+ * @param key The key to look up
+ * @return Pointer to associated value, or NULL if not found or on error
+ */
+ANV_API void* anv_flatmap_get(const ANVFlatMap* map, const void* key);
+
+/**
+ * Remove a key-value pair.
+ *
+ * @param map The flat map to modify
+ * @param key The key to remove
+ * @param should_free_key Whether to free the key data
+ * @param should_free_value Whether to free the value data
+ * @return 0 on success, -1 if key not found or on error
+ */
+ANV_API int anv_flatmap_remove(ANVFlatMap* map, const void* key,
+                               bool should_free_key, bool should_free_value);
+
+/**
+ * Remove a key-value pair and return the value.
+ *
+ * @param map The flat map to modify
+ * @param key The key to remove
+ * @param should_free_key Whether to free the key data
+ * @return Pointer to the removed value, or NULL if not found or on error
+ */
+ANV_API void* anv_flatmap_remove_get(ANVFlatMap* map, const void* key, bool should_free_key);
+
+//==============================================================================
+// Bulk operations
+//==============================================================================
+
+/**
+ * Get all keys in the flat map.
+ *
+ * @param map The flat map to query
+ * @param keys_out Pointer to array that will be filled with keys
+ * @param count_out Pointer to size_t that will receive the number of keys
+ * @return 0 on success, -1 on error
+ */
+ANV_API int anv_flatmap_get_keys(const ANVFlatMap* map, void*** keys_out, size_t* count_out);
+
+/**
+ * Get all values in the flat map.
+ *
+ * @param map The flat map to query
+ * @param values_out Pointer to array that will be filled with values
+ * @param count_out Pointer to size_t that will receive the number of values
+ * @return 0 on success, -1 on error
+ */
+ANV_API int anv_flatmap_get_values(const ANVFlatMap* map, void*** values_out, size_t* count_out);
+
+/**
+ * Apply an action function to each key-value pair in the flat map.
+ *
+ * @param map The flat map to process
+ * @param action Function applied to each key-value pair
+ */
+ANV_API void anv_flatmap_for_each(const ANVFlatMap* map, void (*action)(void* key, void* value));
+
+//==============================================================================
+// Flat map copying functions
+//==============================================================================
+
+/**
+ * Create a shallow copy of the flat map. The table is copied as is, without
+ * rehashing.
+ *
+ * @param map The flat map to copy
+ * @return A new flat map sharing key and value data, or NULL on error
+ */
+ANV_API ANVFlatMap* anv_flatmap_copy(const ANVFlatMap* map);
+
+/**
+ * Create a deep copy of the flat map.
+ *
+ * @param map The flat map to copy
+ * @param key_copy Function to copy key data (NULL for shallow copy of keys)
+ * @param value_copy Function to copy value data (NULL for shallow copy of values)
+ * @return A new flat map with copies of all data, or NULL on error
+ */
+ANV_API ANVFlatMap* anv_flatmap_copy_deep(const ANVFlatMap* map,
+                                          anv_copy_func key_copy, anv_copy_func value_copy);
+
+//==============================================================================
+// Iterator functions
+//==============================================================================
+
+/**
+ * Create an iterator over the flat map in slot order.
+ * Iterator yields ANVPair structures.
+ *
+ * @param map The flat map to iterate over
+ * @return An Iterator object for traversal
+ */
+ANV_API ANVIterator anv_flatmap_iterator(const ANVFlatMap* map);
+
+/**
+ * Create a new flat map from an iterator of key-value pairs.
+ * Behaves like anv_hashmap_from_iterator.
+ *
+ * @param it The source iterator (yields ANVPair*)
+ * @param alloc The custom allocator to use
+ * @param hash Hash function for keys
+ * @param key_equals Key equality function
+ * @param should_copy If true, copies each pair with alloc->copy
+ * @return A new flat map with elements from iterator, or NULL on error
+ */
+ANV_API ANVFlatMap* anv_flatmap_from_iterator(ANVIterator* it, ANVAllocator* alloc,
+                                              anv_hash_func hash, key_equals_func key_equals, bool should_copy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ANVIL_FLATMAP_H
@@ -0,0 +1,186 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_FROZENMAP_H
+#define ANVIL_FROZENMAP_H
+
+#include "hashmap.h"
+#include "iterator.h"
+#include "pair.h"
+#include "anvil/common.h"
+#include "anvil/algorithms/hash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/**
+ * Average number of keys per pilot bucket. Larger values shrink the pilot
+ * array but make building slower.
+ */
+#ifndef ANV_FROZENMAP_BUCKET_SIZE
+#define ANV_FROZENMAP_BUCKET_SIZE 4
+#endif
+
+//==============================================================================
+// Type definitions
+//==============================================================================
+
+/**
+ * Key-value slot stored inline in a frozen map's table.
+ */
+typedef struct ANVFrozenMapSlot
+{
+        void* key;   // Pointer to key data
+        void* value; // Pointer to value data
+} ANVFrozenMapSlot;
+
+/**
+ * Immutable hash map addressed by a minimal perfect hash (PTHash-style).
+ *
+ * Keys are split into buckets of about ANV_FROZENMAP_BUCKET_SIZE, and each
+ * bucket stores a 32-bit pilot chosen at build time so that every key lands
+ * on its own slot of an array exactly as long as the number of entries.
+ * A lookup hashes the key, reads one pilot, and checks one slot: no chains,
+ * no probing, and about 17 bytes per entry on 64-bit targets.
+ *
+ * The map keeps the hashing mode (plain or seeded) of the source map. Keys
+ * whose full hashes are identical cannot be separated by any pilot, so all
+ * but one key of each such group go to a small overflow list sorted by
+ * hash. A lookup searches it only after missing its slot; with a good hash
+ * function the list is empty.
+ */
+typedef struct ANVFrozenMap
+{
+        ANVFrozenMapSlot* slots;           // One slot per entry: perfect-hash slots, then overflow
+        uint32_t* pilots;                  // One pilot per bucket
+        uint64_t* overflow_hashes;         // Sorted hash of each overflow slot, or NULL
+        size_t size;                       // Number of entries (and slots)
+        size_t slot_count;                 // Slots addressed by the perfect hash
+        size_t bucket_count;               // Number of pilots
+        uint64_t seed;                     // Build seed mixed into every hash
+        anv_hash_func hash;                // Hash function for keys (NULL in seeded mode)
+        anv_seeded_hash_func seeded_hash;  // Keyed hash function (NULL unless seeded)
+        ANVHashSeed hash_seed;             // Key passed to seeded_hash
+        key_equals_func key_equals;        // Key equality function
+        ANVAllocator alloc;                // Custom allocator
+} ANVFrozenMap;
+
+//==============================================================================
+// Creation and destruction functions
+//==============================================================================
+
+/**
+ * Build a frozen map holding the entries of a hash map. The hash map is
+ * left unchanged; both share key and value data.
+ *
+ * @param map The hash map to freeze
+ * @return Pointer to new frozen map, or NULL on failure
+ */
+ANV_API ANVFrozenMap* anv_frozenmap_from_hashmap(const ANVHashMap* map);
+
+/**
+ * Build a frozen map from an iterator of key-value pairs. Behaves like
+ * anv_hashmap_from_iterator: later duplicates replace earlier ones.
+ *
+ * @param it The source iterator (yields ANVPair*)
+ * @param alloc The custom allocator to use
+ * @param hash Hash function for keys
+ * @param key_equals Key equality function
+ * @param should_copy If true, copies each pair with alloc->copy
+ * @return A new frozen map with elements from iterator, or NULL on error
+ */
+ANV_API ANVFrozenMap* anv_frozenmap_from_iterator(ANVIterator* it, ANVAllocator* alloc,
+                                                  anv_hash_func hash, key_equals_func key_equals, bool should_copy);
+
+/**
+ * Destroy the frozen map.
+ *
+ * @param map The frozen map to destroy
+ * @param should_free_keys Whether to free key data
+ * @param should_free_values Whether to free value data
+ */
+ANV_API void anv_frozenmap_destroy(ANVFrozenMap* map, bool should_free_keys, bool should_free_values);
+
+//==============================================================================
+// Information functions
+//==============================================================================
+
+/**
+ * Get the number of entries.
+ *
+ * @param map The frozen map to query
+ * @return Number of entries, or 0 if map is NULL
+ */
+ANV_API size_t anv_frozenmap_size(const ANVFrozenMap* map);
+
+/**
+ * Check if the frozen map is empty.
+ *
+ * @param map The frozen map to check
+ * @return 1 if empty or NULL, 0 if it contains entries
+ */
+ANV_API int anv_frozenmap_is_empty(const ANVFrozenMap* map);
+
+/**
+ * Get the bytes used by the map's structure, excluding key and value data.
+ *
+ * @param map The frozen map to query
+ * @return Bytes used, or 0 if map is NULL
+ */
+ANV_API size_t anv_frozenmap_memory_usage(const ANVFrozenMap* map);
+
+/**
+ * Check if the frozen map contains a key.
+ *
+ * @param map The frozen map to search
+ * @param key The key to search for
+ * @return 1 if key exists, 0 if not found or on error
+ */
+ANV_API int anv_frozenmap_contains_key(const ANVFrozenMap* map, const void* key);
+
+//==============================================================================
+// Frozen map operations
+//==============================================================================
+
+/**
+ * Get the value associated with a key. Reads one pilot and one slot, then
+ * searches the overflow list only if the slot holds another key.
+ *
+ * @param map The frozen map to search
+ * @param key The key to look up
+ * @return Pointer to associated value, or NULL if not found or on error
+ */
+ANV_API void* anv_frozenmap_get(const ANVFrozenMap* map, const void* key);
+
+/**
+ * Apply an action function to each key-value pair.
+ *
+ * @param map The frozen map to process
+ * @param action Function applied to each key and value
+ */
+ANV_API void anv_frozenmap_for_each(const ANVFrozenMap* map, void (*action)(void* key, void* value));
+
+//==============================================================================
+// Iterator functions
+//==============================================================================
+
+/**
+ * Create an iterator over the frozen map (unordered traversal).
+ * Iterator yields ANVPair structures.
+ *
+ * @param map The frozen map to iterate over
+ * @return An Iterator object for traversal
+ */
+ANV_API ANVIterator anv_frozenmap_iterator(const ANVFrozenMap* map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ANVIL_FROZENMAP_H
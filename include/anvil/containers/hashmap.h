@@ -8,12 +8,43 @@
 #include "iterator.h"
 #include "pair.h"
 #include "anvil/common.h"
+#include "anvil/memory/slab.h"
 #include "anvil/algorithms/hash.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+//==============================================================================
+// Constants
+//==============================================================================
+
+/**
+ * Entries moved into the new table by each put or remove while an
+ * incremental resize is in progress. Old buckets always move whole, so a
+ * step may move a few more.
+ */
+#ifndef ANV_HASHMAP_MIGRATE_NODES
+#define ANV_HASHMAP_MIGRATE_NODES 8
+#endif
+
+/**
+ * Buckets of the new table cleared by each put or remove before an
+ * incremental resize starts moving entries. Clearing in slices keeps the
+ * first-touch cost of a large table off any single operation.
+ */
+#ifndef ANV_HASHMAP_CLEAR_BUCKETS
+#define ANV_HASHMAP_CLEAR_BUCKETS 65536
+#endif
+
+/**
+ * Keys a batched lookup keeps in flight at once. Enough to overlap the cache
+ * misses of several chains without the prefetches evicting each other.
+ */
+#ifndef ANV_HASHMAP_BATCH_WINDOW
+#define ANV_HASHMAP_BATCH_WINDOW 16
+#endif
+
 //==============================================================================
 // Type definitions
 //==============================================================================
@@ -27,6 +58,25 @@ extern "C" {
  */
 typedef int (*key_equals_func)(const void* key1, const void* key2);
 
+/**
+ * Produces the value for a key that is absent from the map.
+ *
+ * @param key The key being inserted
+ * @param context User data passed through by the caller
+ * @return Value to insert, or NULL to insert nothing
+ */
+typedef void* (*anv_hashmap_compute_func)(const void* key, void* context);
+
+/**
+ * Combines a key's current value with a new one.
+ *
+ * @param old_value The value currently stored
+ * @param value The value passed to anv_hashmap_merge
+ * @param context User data passed through by the caller
+ * @return The value to store, or NULL to remove the key
+ */
+typedef void* (*anv_hashmap_merge_func)(void* old_value, void* value, void* context);
+
 /**
  * Node in a hash map bucket (chaining for collision resolution).
  */
@@ -34,6 +84,7 @@ typedef struct ANVHashMapNode
 {
         void* key;                   // Pointer to key data
         void* value;                 // Pointer to value data
+        size_t hash;                 // Full hash of key, reused on rehash and compared before key_equals
         struct ANVHashMapNode* next; // Next node in chain
 } ANVHashMapNode;
 
@@ -43,13 +94,21 @@ typedef struct ANVHashMapNode
  */
 typedef struct ANVHashMap
 {
-        ANVHashMapNode** buckets;   // Array of bucket heads
-        size_t bucket_count;        // Number of buckets
-        size_t size;                // Number of key-value pairs
-        double max_load_factor;     // Maximum load factor before resize
-        anv_hash_func hash;         // Hash function for keys
-        key_equals_func key_equals; // Key equality function
-        ANVAllocator alloc;         // Custom allocator
+        ANVHashMapNode** buckets;          // Array of bucket heads
+        size_t bucket_count;               // Number of buckets
+        size_t size;                       // Number of key-value pairs
+        double max_load_factor;            // Maximum load factor before resize
+        anv_hash_func hash;                // Hash function for keys (NULL in seeded mode)
+        anv_seeded_hash_func seeded_hash;  // Keyed hash function (NULL unless created seeded)
+        ANVHashSeed seed;                  // Key passed to seeded_hash
+        key_equals_func key_equals;        // Key equality function
+        ANVAllocator alloc;                // Custom allocator
+        ANVSlabAllocator* node_pool;       // Node slab pool (NULL unless ANV_ALLOC_POOL_NODES is set)
+        ANVHashMapNode** old_buckets;      // Table being drained by an incremental resize, or NULL
+        size_t old_bucket_count;           // Number of buckets in old_buckets
+        size_t migrate_index;              // Next old bucket to move
+        size_t clear_index;                // New buckets cleared so far; migration waits for all of them
+        bool incremental_resize;           // Spread resizes over later operations
 } ANVHashMap;
 
 //==============================================================================
@@ -58,6 +117,8 @@ typedef struct ANVHashMap
 
 /**
  * Create a new hash map with custom allocator and functions.
+ * Nodes come from a private slab pool when the allocator has
+ * ANV_ALLOC_POOL_NODES set.
  *
  * @param alloc Custom allocator (required)
  * @param hash Hash function for keys (required)
@@ -68,6 +129,23 @@ typedef struct ANVHashMap
 ANV_API ANVHashMap* anv_hashmap_create(ANVAllocator* alloc, anv_hash_func hash,
                                        key_equals_func key_equals, size_t initial_capacity);
 
+/**
+ * Create a hash map whose bucket index comes from a keyed hash, such as
+ * anv_hash_string_siphash. Without the seed an attacker cannot predict
+ * which keys collide, so untrusted keys cannot force long chains. Copies
+ * keep the same hash function and seed.
+ *
+ * @param alloc Custom allocator (required)
+ * @param hash Keyed hash function for keys (required)
+ * @param key_equals Key equality function (required)
+ * @param initial_capacity Initial number of buckets (0 for default)
+ * @param seed Hash key, or NULL for a fresh anv_hash_random_seed
+ * @return Pointer to new hash map, or NULL on failure
+ */
+ANV_API ANVHashMap* anv_hashmap_create_seeded(ANVAllocator* alloc, anv_seeded_hash_func hash,
+                                              key_equals_func key_equals, size_t initial_capacity,
+                                              const ANVHashSeed* seed);
+
 /**
  * Destroy the hash map and free all nodes.
  *
@@ -127,6 +205,20 @@ ANV_API int anv_hashmap_contains_key(const ANVHashMap* map, const void* key);
 // Hash map operations
 //==============================================================================
 
+/**
+ * Enable or disable incremental resizing. When enabled, a resize allocates
+ * the larger table but leaves the entries in the old one; each later put or
+ * remove moves about ANV_HASHMAP_MIGRATE_NODES entries across. Lookups,
+ * removal and iteration search both tables until the old one drains, so no
+ * single operation pays for moving the whole map. Disabling finishes any
+ * resize in progress.
+ *
+ * @param map The hash map to configure
+ * @param enabled Whether resizes should be incremental
+ * @return 0 on success, -1 if map is NULL
+ */
+ANV_API int anv_hashmap_set_incremental_resize(ANVHashMap* map, bool enabled);
+
 /**
  * Insert or update a key-value pair in the hash map.
  *
@@ -170,6 +262,22 @@ ANV_API int anv_hashmap_put_with_free(ANVHashMap* map, void* key, void* value, b
  */
 ANV_API void* anv_hashmap_get(const ANVHashMap* map, const void* key);
 
+/**
+ * Look up many keys at once. Keys are processed ANV_HASHMAP_BATCH_WINDOW at
+ * a time: all of them are hashed and their buckets prefetched, then their
+ * first nodes, then the keys of hash-matching nodes, before any chain is
+ * walked. The cache misses of independent lookups overlap instead of
+ * running back to back, which pays off once the table outgrows the cache.
+ *
+ * @param map The hash map to search
+ * @param keys Array of count keys to look up
+ * @param count Number of keys
+ * @param values_out Receives each key's value, or NULL where not found
+ * @return Number of keys found, or 0 on error
+ */
+ANV_API size_t anv_hashmap_get_batch(const ANVHashMap* map, const void* const* keys, size_t count,
+                                     void** values_out);
+
 /**
  * Remove a key-value pair from the hash map.
  *
@@ -192,6 +300,60 @@ ANV_API int anv_hashmap_remove(ANVHashMap* map, const void* key,
  */
 ANV_API void* anv_hashmap_remove_get(ANVHashMap* map, const void* key, bool should_free_key);
 
+//==============================================================================
+// Entry operations
+//==============================================================================
+
+/**
+ * Find a key's value slot, inserting the key with a NULL value if absent.
+ * Hashes once and walks the chain once, so a read-modify-write such as
+ * incrementing a counter costs a single lookup. Nodes never move, so the
+ * slot stays valid until the key is removed or the map is cleared or
+ * destroyed. Until a value is written through the slot, anv_hashmap_get
+ * returns NULL for the key and anv_hashmap_contains_key reports it absent,
+ * although it counts toward the size.
+ *
+ * @param map The hash map to modify
+ * @param key Pointer to key data (ownership transferred to map if inserted)
+ * @param inserted_out Set to true if key was inserted (can be NULL)
+ * @return Pointer to the value slot, or NULL on error
+ */
+ANV_API void** anv_hashmap_entry(ANVHashMap* map, void* key, bool* inserted_out);
+
+/**
+ * Return a key's value, inserting the value produced by compute if the key
+ * is absent. Hashes once and walks the chain once. compute must not modify
+ * the map. If compute returns a value but the entry cannot be allocated,
+ * the value is released with the map allocator's data deallocator; the key
+ * stays with the caller either way.
+ *
+ * @param map The hash map to modify
+ * @param key Pointer to key data (ownership transferred to map if inserted)
+ * @param compute Function producing the value for an absent key
+ * @param context User data passed to compute
+ * @param inserted_out Set to true if key was inserted (can be NULL)
+ * @return The existing or newly inserted value, or NULL if compute returned NULL or
+ *         the entry could not be allocated (inserted_out is false in both cases)
+ */
+ANV_API void* anv_hashmap_compute_if_absent(ANVHashMap* map, void* key, anv_hashmap_compute_func compute,
+                                            void* context, bool* inserted_out);
+
+/**
+ * Insert value if key is absent, otherwise replace the stored value with
+ * merge(old, value, context). Hashes once and walks the chain once. merge
+ * owns both values it is given and must not modify the map. If merge
+ * returns NULL the key is removed; the stored key is not freed.
+ *
+ * @param map The hash map to modify
+ * @param key Pointer to key data (ownership transferred to map if inserted)
+ * @param value Value to insert or merge
+ * @param merge Function combining the stored value with value
+ * @param context User data passed to merge
+ * @return 0 on success, -1 on error
+ */
+ANV_API int anv_hashmap_merge(ANVHashMap* map, void* key, void* value, anv_hashmap_merge_func merge,
+                              void* context);
+
 //==============================================================================
 // Bulk operations
 //==============================================================================
@@ -42,6 +42,21 @@ typedef struct ANVHashSet
 ANV_API ANVHashSet* anv_hashset_create(ANVAllocator* alloc, anv_hash_func hash,
                                        key_equals_func key_equals, size_t initial_capacity);
 
+/**
+ * Create a hash set that hashes keys with a keyed hash function, for sets
+ * filled from untrusted input. See anv_hashmap_create_seeded.
+ *
+ * @param alloc Custom allocator (required)
+ * @param hash Keyed hash function for keys (required)
+ * @param key_equals Key equality function (required)
+ * @param initial_capacity Initial number of buckets (0 for default)
+ * @param seed Hash key, or NULL for a fresh anv_hash_random_seed
+ * @return Pointer to new hash set, or NULL on failure
+ */
+ANV_API ANVHashSet* anv_hashset_create_seeded(ANVAllocator* alloc, anv_seeded_hash_func hash,
+                                              key_equals_func key_equals, size_t initial_capacity,
+                                              const ANVHashSeed* seed);
+
 /**
  * Destroy the hash set and free all nodes.
  *
@@ -119,6 +134,19 @@ ANV_API int anv_hashset_add_check(ANVHashSet* set, void* key, bool* was_added_ou
  */
 ANV_API int anv_hashset_contains(const ANVHashSet* set, const void* key);
 
+/**
+ * Check many elements at once, overlapping their cache misses as
+ * anv_hashmap_get_batch does.
+ *
+ * @param set The hash set to search
+ * @param keys Array of count keys to search for
+ * @param count Number of keys
+ * @param results_out Receives true for each key present, false otherwise
+ * @return Number of keys present, or 0 on error
+ */
+ANV_API size_t anv_hashset_contains_batch(const ANVHashSet* set, const void* const* keys, size_t count,
+                                          bool* results_out);
+
 /**
  * Remove an element from the hash set.
  *
@@ -0,0 +1,257 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_INTSET_H
+#define ANVIL_INTSET_H
+
+#include <stdint.h>
+
+#include "iterator.h"
+#include "anvil/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// Type definitions
+//==============================================================================
+
+/**
+ * Open-addressing set of 64-bit integers using Robin Hood hashing.
+ *
+ * Keys are stored inline in a power-of-two slot array, with one byte per
+ * slot recording how far the key sits from its home slot (0 for empty).
+ * Inserts keep every run of slots ordered by home slot, taking a slot from
+ * any key closer to home than the one being placed, which keeps probe
+ * lengths short and even. Lookups stop as soon as they pass where the key
+ * would have been. Removal shifts the rest of the run back one slot, so no
+ * tombstones are left. The table holds at most 7/8 of its capacity.
+ *
+ * Each set hashes with its own random seed, so inserting one set's keys
+ * into another in slot order does not cluster.
+ *
+ * Pointers to keys handed out by the iterator are invalidated by any
+ * insert or remove.
+ */
+typedef struct ANVIntSet
+{
+        uint64_t* keys;      // Slot array
+        uint8_t* distances;  // Probe distance + 1 per slot, 0 if empty (same allocation as keys)
+        size_t capacity;     // Number of slots, a power of two
+        size_t size;         // Number of keys
+        uint64_t seed;       // Mixed into every hash
+        ANVAllocator alloc;  // Custom allocator
+} ANVIntSet;
+
+//==============================================================================
+// Creation and destruction functions
+//==============================================================================
+
+/**
+ * Create a new integer set.
+ *
+ * @param alloc Custom allocator (required)
+ * @param initial_capacity Number of keys to hold without rehashing (0 for default)
+ * @return Pointer to new set, or NULL on failure
+ */
+ANV_API ANVIntSet* anv_intset_create(ANVAllocator* alloc, size_t initial_capacity);
+
+/**
+ * Destroy the set and free its table.
+ *
+ * @param set The set to destroy
+ */
+ANV_API void anv_intset_destroy(ANVIntSet* set);
+
+/**
+ * Remove all keys, keeping the table's capacity.
+ *
+ * @param set The set to clear
+ */
+ANV_API void anv_intset_clear(ANVIntSet* set);
+
+/**
+ * Grow the table so it holds at least count keys without rehashing.
+ *
+ * @param set The set to modify
+ * @param count Number of keys to make room for
+ * @return 0 on success, -1 on error
+ */
+ANV_API int anv_intset_reserve(ANVIntSet* set, size_t count);
+
+//==============================================================================
+// Information functions
+//==============================================================================
+
+/**
+ * Get the number of keys in the set.
+ *
+ * @param set The set to query
+ * @return Number of keys, or 0 if set is NULL
+ */
+ANV_API size_t anv_intset_size(const ANVIntSet* set);
+
+/**
+ * Check if the set is empty.
+ *
+ * @param set The set to check
+ * @return 1 if empty or NULL, 0 if it contains keys
+ */
+ANV_API int anv_intset_is_empty(const ANVIntSet* set);
+
+/**
+ * Get the current load factor of the set.
+ *
+ * @param set The set to query
+ * @return Load factor (size / capacity), or 0.0 if set is NULL
+ */
+ANV_API double anv_intset_load_factor(const ANVIntSet* set);
+
+//==============================================================================
+// Integer set operations
+//==============================================================================
+
+/**
+ * Add a key to the set. If the key already exists, this is a no-op.
+ *
+ * @param set The set to modify
+ * @param key The key to add
+ * @return 0 on success, -1 on error
+ */
+ANV_API int anv_intset_add(ANVIntSet* set, uint64_t key);
+
+/**
+ * Add a key to the set, returning whether it was newly added.
+ *
+ * @param set The set to modify
+ * @param key The key to add
+ * @param was_added_out Set to true if key was added, false if it already existed (can be NULL)
+ * @return 0 on success, -1 on error
+ */
+ANV_API int anv_intset_add_check(ANVIntSet* set, uint64_t key, bool* was_added_out);
+
+/**
+ * Check if the set contains a key.
+ *
+ * @param set The set to search
+ * @param key The key to search for
+ * @return 1 if key exists, 0 if not found or on error
+ */
+ANV_API int anv_intset_contains(const ANVIntSet* set, uint64_t key);
+
+/**
+ * Remove a key from the set.
+ *
+ * @param set The set to modify
+ * @param key The key to remove
+ * @return 0 on success, -1 if key not found or on error
+ */
+ANV_API int anv_intset_remove(ANVIntSet* set, uint64_t key);
+
+//==============================================================================
+// Set operations
+//==============================================================================
+
+/**
+ * Create the union of two sets (keys in either set).
+ *
+ * @param set1 First set
+ * @param set2 Second set
+ * @return New set containing union, or NULL on error
+ */
+ANV_API ANVIntSet* anv_intset_union(const ANVIntSet* set1, const ANVIntSet* set2);
+
+/**
+ * Create the intersection of two sets (keys in both sets).
+ *
+ * @param set1 First set
+ * @param set2 Second set
+ * @return New set containing intersection, or NULL on error
+ */
+ANV_API ANVIntSet* anv_intset_intersection(const ANVIntSet* set1, const ANVIntSet* set2);
+
+/**
+ * Create the difference of two sets (keys in first but not second).
+ *
+ * @param set1 First set
+ * @param set2 Second set
+ * @return New set containing difference, or NULL on error
+ */
+ANV_API ANVIntSet* anv_intset_difference(const ANVIntSet* set1, const ANVIntSet* set2);
+
+/**
+ * Check if one set is a subset of another.
+ *
+ * @param subset The potential subset
+ * @param superset The potential superset
+ * @return 1 if subset is contained in superset, 0 otherwise
+ */
+ANV_API int anv_intset_is_subset(const ANVIntSet* subset, const ANVIntSet* superset);
+
+//==============================================================================
+// Bulk operations
+//==============================================================================
+
+/**
+ * Get all keys in the set.
+ *
+ * @param set The set to query
+ * @param keys_out Pointer to array that will be allocated and filled with keys
+ * @param count_out Pointer to size_t that will receive the number of keys
+ * @return 0 on success, -1 on error
+ */
+ANV_API int anv_intset_get_elements(const ANVIntSet* set, uint64_t** keys_out, size_t* count_out);
+
+/**
+ * Apply an action function to each key in the set.
+ *
+ * @param set The set to process
+ * @param action Function applied to each key
+ */
+ANV_API void anv_intset_for_each(const ANVIntSet* set, void (*action)(uint64_t key));
+
+//==============================================================================
+// Integer set copying functions
+//==============================================================================
+
+/**
+ * Create a copy of the set. Keys are stored inline, so there is no separate
+ * deep copy.
+ *
+ * @param set The set to copy
+ * @return A new set with the same keys, or NULL on error
+ */
+ANV_API ANVIntSet* anv_intset_copy(const ANVIntSet* set);
+
+//==============================================================================
+// Iterator functions
+//==============================================================================
+
+/**
+ * Create an iterator for the set (unordered traversal).
+ * Iterator yields uint64_t pointers into the table.
+ *
+ * @param set The set to iterate over
+ * @return An Iterator object for traversal
+ */
+ANV_API ANVIterator anv_intset_iterator(const ANVIntSet* set);
+
+/**
+ * Create a new set from an iterator yielding uint64_t pointers.
+ *
+ * @param it The source iterator (must be valid and support has_next/get/next)
+ * @param alloc The custom allocator to use for the new set
+ * @return A new set with the iterator's keys, or NULL on error
+ *
+ * @note NULL elements from the iterator are filtered out.
+ * @note The iterator is consumed during this operation.
+ */
+ANV_API ANVIntSet* anv_intset_from_iterator(ANVIterator* it, ANVAllocator* alloc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ANVIL_INTSET_H
@@ -7,6 +7,7 @@
 
 #include "iterator.h"
 #include "anvil/common.h"
+#include "anvil/memory/slab.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -30,10 +31,11 @@ typedef struct ANVQueueNode
  */
 typedef struct ANVQueue
 {
-        ANVQueueNode* front; // Pointer to front node
-        ANVQueueNode* back;  // Pointer to back node
-        size_t size;         // Number of elements
-        ANVAllocator alloc;  // Custom allocator
+        ANVQueueNode* front;         // Pointer to front node
+        ANVQueueNode* back;          // Pointer to back node
+        size_t size;                 // Number of elements
+        ANVAllocator alloc;          // Custom allocator
+        ANVSlabAllocator* node_pool; // Node slab pool (NULL unless ANV_ALLOC_POOL_NODES is set)
 } ANVQueue;
 
 /**
@@ -50,6 +52,8 @@ typedef void (*anv_action_func)(void* data);
 
 /**
  * Create a new, empty queue with custom allocator.
+ * Nodes come from a private slab pool when the allocator has
+ * ANV_ALLOC_POOL_NODES set.
  *
  * @param alloc Custom allocator (required)
  * @return Pointer to new Queue, or NULL on failure
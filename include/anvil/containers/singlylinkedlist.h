@@ -7,6 +7,7 @@
 
 #include "iterator.h"
 #include "anvil/common.h"
+#include "anvil/memory/slab.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -34,6 +35,7 @@ typedef struct ANVSinglyLinkedList
         ANVSinglyLinkedNode* tail;      // Pointer to last node
         size_t size;                    // Number of nodes in list
         ANVAllocator alloc;             // Custom allocator
+        ANVSlabAllocator* node_pool;    // Node slab pool (NULL unless ANV_ALLOC_POOL_NODES is set)
 } ANVSinglyLinkedList;
 
 //==============================================================================
@@ -42,6 +44,8 @@ typedef struct ANVSinglyLinkedList
 
 /**
  * Create a new, empty singly linked list.
+ * Nodes come from a private slab pool when the allocator has
+ * ANV_ALLOC_POOL_NODES set.
  *
  * @param alloc Allocator to use.
  * @return Pointer to new list, or NULL on failure
@@ -0,0 +1,211 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_SLOTMAP_H
+#define ANVIL_SLOTMAP_H
+
+#include "anvil/common.h"
+#include "iterator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// Type definitions
+//==============================================================================
+
+/**
+ * Handle to an element of a slot map.
+ *
+ * A handle stays valid until its element is removed, however the element
+ * moves inside the map. Using a handle after its element was removed is
+ * detected by the generation check, even if the slot has been reused.
+ * A zero-initialized handle never refers to an element.
+ */
+typedef struct ANVSlotHandle
+{
+        uint32_t index;      // Slot in the sparse array
+        uint32_t generation; // Generation of the slot when the handle was issued
+} ANVSlotHandle;
+
+/**
+ * Sparse slot entry. An odd generation marks an occupied slot.
+ */
+typedef struct ANVSlot
+{
+        uint32_t dense_index; // Element position while occupied, next free slot otherwise
+        uint32_t generation;  // Incremented on every insert and remove
+} ANVSlot;
+
+/**
+ * Slot map storing fixed-size elements by value.
+ *
+ * Elements are packed contiguously in insertion order, with removals filled
+ * by moving the last element into the hole, so iteration is a linear scan
+ * over dense memory. A sparse slot array translates handles to dense
+ * positions, and freed slots are reused through an intrusive free list.
+ * Insert, lookup and remove are O(1).
+ *
+ * Pointers returned by the map are invalidated by any insert or remove;
+ * hold handles instead.
+ */
+typedef struct ANVSlotMap
+{
+        uint8_t* dense;          // Elements, element_size bytes each
+        uint32_t* dense_slots;   // Slot owning each dense element
+        ANVSlot* slots;          // Sparse handle table
+        size_t element_size;     // Size of each element in bytes
+        size_t size;             // Number of elements
+        size_t capacity;         // Elements the dense arrays can hold
+        size_t slot_count;       // Slots handed out so far (occupied or free)
+        size_t slot_capacity;    // Slots the sparse array can hold
+        uint32_t free_head;      // First free slot, or UINT32_MAX if none
+        ANVAllocator alloc;      // Custom allocator
+} ANVSlotMap;
+
+//==============================================================================
+// Creation and destruction functions
+//==============================================================================
+
+/**
+ * Create a new, empty slot map.
+ *
+ * @param alloc Custom allocator (required)
+ * @param element_size Size of each element in bytes (must be greater than 0)
+ * @param initial_capacity Initial capacity (0 uses default)
+ * @return Pointer to new slot map, or NULL on failure
+ */
+ANV_API ANVSlotMap* anv_slotmap_create(ANVAllocator* alloc, size_t element_size, size_t initial_capacity);
+
+/**
+ * Destroy the slot map and its storage.
+ *
+ * @param map The slot map to destroy
+ */
+ANV_API void anv_slotmap_destroy(ANVSlotMap* map);
+
+/**
+ * Remove every element. All outstanding handles become stale.
+ *
+ * @param map The slot map to clear
+ */
+ANV_API void anv_slotmap_clear(ANVSlotMap* map);
+
+/**
+ * Reserve room for at least 'capacity' elements.
+ *
+ * @param map The slot map to grow
+ * @param capacity Number of elements to make room for
+ * @return 0 on success, -1 on failure
+ */
+ANV_API int anv_slotmap_reserve(ANVSlotMap* map, size_t capacity);
+
+//==============================================================================
+// Information functions
+//==============================================================================
+
+/**
+ * Get the number of elements in the slot map.
+ *
+ * @param map The slot map to query
+ * @return Number of elements, or 0 if map is NULL
+ */
+ANV_API size_t anv_slotmap_size(const ANVSlotMap* map);
+
+/**
+ * Check if the slot map is empty.
+ *
+ * @param map The slot map to check
+ * @return 1 if the slot map is empty or NULL, 0 if it contains elements
+ */
+ANV_API int anv_slotmap_is_empty(const ANVSlotMap* map);
+
+/**
+ * Check whether a handle refers to a live element.
+ *
+ * @param map The slot map to query
+ * @param handle Handle to check
+ * @return 1 if the handle is live, 0 if it is stale, null or map is NULL
+ */
+ANV_API int anv_slotmap_contains(const ANVSlotMap* map, ANVSlotHandle handle);
+
+//==============================================================================
+// Element access functions
+//==============================================================================
+
+/**
+ * Insert a copy of an element.
+ *
+ * @param map The slot map to insert into
+ * @param element Element to copy (element_size bytes), or NULL to zero the new element
+ * @return Handle to the new element, or a zero handle on failure
+ */
+ANV_API ANVSlotHandle anv_slotmap_insert(ANVSlotMap* map, const void* element);
+
+/**
+ * Insert a zeroed element and return a pointer to it for in-place
+ * initialization.
+ *
+ * @param map The slot map to insert into
+ * @param handle_out Receives the handle to the new element
+ * @return Pointer to the new element, or NULL on failure
+ */
+ANV_API void* anv_slotmap_emplace(ANVSlotMap* map, ANVSlotHandle* handle_out);
+
+/**
+ * Get a pointer to the element a handle refers to.
+ *
+ * @param map The slot map to access
+ * @param handle Handle to look up
+ * @return Pointer to the element, or NULL if the handle is stale
+ */
+ANV_API void* anv_slotmap_get(const ANVSlotMap* map, ANVSlotHandle handle);
+
+/**
+ * Remove an element. The last element moves into its place.
+ *
+ * @param map The slot map to remove from
+ * @param handle Handle of the element to remove
+ * @param element_out Receives a copy of the removed element (can be NULL)
+ * @return 0 on success, -1 if the handle is stale or on error
+ */
+ANV_API int anv_slotmap_remove(ANVSlotMap* map, ANVSlotHandle handle, void* element_out);
+
+//==============================================================================
+// Dense iteration functions
+//==============================================================================
+
+/**
+ * Get the dense element array, holding anv_slotmap_size elements of
+ * element_size bytes each.
+ *
+ * @param map The slot map to access
+ * @return Pointer to the first element, or NULL if map is NULL
+ */
+ANV_API void* anv_slotmap_data(const ANVSlotMap* map);
+
+/**
+ * Get the handle of the element at a dense position.
+ *
+ * @param map The slot map to access
+ * @param dense_index Position in the dense array
+ * @return Handle to the element, or a zero handle if dense_index is out of range
+ */
+ANV_API ANVSlotHandle anv_slotmap_handle_at(const ANVSlotMap* map, size_t dense_index);
+
+/**
+ * Create an iterator over the elements in dense order. get returns a
+ * pointer to each element.
+ *
+ * @param map The slot map to iterate
+ * @return Iterator over the slot map
+ */
+ANV_API ANVIterator anv_slotmap_iterator(const ANVSlotMap* map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ANVIL_SLOTMAP_H
@@ -6,6 +6,7 @@
 #define ANVIL_STACK_H
 
 #include "anvil/common.h"
+#include "anvil/memory/slab.h"
 #include "iterator.h"
 
 #ifdef __cplusplus
@@ -30,9 +31,10 @@ typedef struct ANVStackNode
  */
 typedef struct ANVStack
 {
-        ANVStackNode* top;   // Pointer to top node
-        size_t size;         // Number of elements in stack
-        ANVAllocator alloc;  // Custom allocator
+        ANVStackNode* top;           // Pointer to top node
+        size_t size;                 // Number of elements in stack
+        ANVAllocator alloc;          // Custom allocator
+        ANVSlabAllocator* node_pool; // Node slab pool (NULL unless ANV_ALLOC_POOL_NODES is set)
 } ANVStack;
 
 //==============================================================================
@@ -41,6 +43,8 @@ typedef struct ANVStack
 
 /**
  * Create a new, empty stack with custom allocator.
+ * Nodes come from a private slab pool when the allocator has
+ * ANV_ALLOC_POOL_NODES set.
  *
  * @param alloc Custom allocator (required)
  * @return Pointer to new Stack, or NULL on failure
@@ -0,0 +1,462 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_TYPEDHASHMAP_H
+#define ANVIL_TYPEDHASHMAP_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "anvil/common.h"
+#include "anvil/algorithms/hash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Type-specialized hash maps generated at compile time.
+ *
+ *     ANV_HASHMAP_DEFINE(IdCounts, uint64_t, uint32_t, ANV_HASHMAP_HASH_SCALAR, ANV_HASHMAP_EQ_SCALAR)
+ *
+ * defines the map type IdCounts and static inline functions IdCounts_create,
+ * IdCounts_put, IdCounts_get and so on, mirroring anv_hashmap_*. Keys and
+ * values are stored unboxed in one slot array, and hash and eq are expanded
+ * in place rather than called through pointers, so they inline.
+ *
+ * hash(key) must yield an integer; it is XORed with a per-map random seed
+ * and finalized with a SplitMix64 mix, so the identity is fine for scalar
+ * keys, and copying one map into another in slot order does not cluster.
+ * eq(a, b) must be nonzero for equal keys. Both receive keys by value.
+ *
+ * The table uses the same Robin Hood layout as ANVIntSet: one byte per slot
+ * holds the probe distance, runs stay ordered by home slot, misses stop
+ * early, and removal shifts back without tombstones. Pointers returned by
+ * get and entry are invalidated by any later put, entry or remove.
+ */
+
+//==============================================================================
+// Key helpers
+//==============================================================================
+
+/**
+ * Hash for integer, enum and pointer keys; the map mixes it afterwards.
+ * Converts through uintptr_t so pointer keys need no cast of a different
+ * width, which means keys wider than a pointer keep only their low bits on
+ * 32-bit targets. Pass the key itself as the hash there instead; the map
+ * widens it to 64 bits.
+ */
+#define ANV_HASHMAP_HASH_SCALAR(key) ((uint64_t)(uintptr_t)(key))
+
+/**
+ * Equality for scalar keys.
+ */
+#define ANV_HASHMAP_EQ_SCALAR(a, b) ((a) == (b))
+
+/**
+ * SplitMix64 finalizer, identical to anv_hash_mix64 but inlinable.
+ *
+ * @param value Value to mix
+ * @return 64-bit hash value
+ */
+static inline uint64_t anv_hashmap_mix_inline(uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ull;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebull;
+    value ^= value >> 31;
+    return value;
+}
+
+//==============================================================================
+// Generator
+//==============================================================================
+
+/**
+ * Define map type 'name' from K to V and its functions:
+ *
+ *   name* name_create(ANVAllocator* alloc, size_t initial_capacity)
+ *   void name_destroy(name* map)
+ *   void name_clear(name* map)
+ *   int name_reserve(name* map, size_t count)
+ *   size_t name_size(const name* map)
+ *   int name_is_empty(const name* map)
+ *   double name_load_factor(const name* map)
+ *   int name_contains_key(const name* map, K key)
+ *   int name_put(name* map, K key, V value)
+ *   V* name_get(const name* map, K key)
+ *   V* name_entry(name* map, K key, bool* inserted_out)
+ *   int name_remove(name* map, K key)
+ *   void name_for_each(const name* map, void (*action)(K key, V value))
+ *
+ * Return conventions match anv_hashmap_*: 0/-1 for status, NULL when a key
+ * is missing. entry inserts an absent key with a zeroed value.
+ */
+#define ANV_HASHMAP_DEFINE(name, K, V, hash, eq)                                                               \
+typedef struct name##_slot                                                                                     \
+{                                                                                                              \
+    K key;                                                                                                     \
+    V value;                                                                                                   \
+} name##_slot;                                                                                                 \
+                                                                                                               \
+typedef struct name                                                                                            \
+{                                                                                                              \
+    name##_slot* slots;                                                                                        \
+    uint8_t* distances;                                                                                        \
+    size_t capacity;                                                                                           \
+    size_t size;                                                                                               \
+    uint64_t seed;                                                                                             \
+    ANVAllocator alloc;                                                                                        \
+} name;                                                                                                        \
+                                                                                                               \
+static inline size_t name##_home_slot(const name* map, K key)                                                  \
+{                                                                                                              \
+    return (size_t)anv_hashmap_mix_inline((uint64_t)(hash(key)) ^ map->seed) & (map->capacity - 1);            \
+}                                                                                                              \
+                                                                                                               \
+static inline size_t name##_max_entries(const size_t capacity)                                                 \
+{                                                                                                              \
+    return capacity - capacity / 8;                                                                            \
+}                                                                                                              \
+                                                                                                               \
+static inline size_t name##_capacity_for(const size_t count)                                                   \
+{                                                                                                              \
+    size_t capacity = 8;                                                                                       \
+    while (name##_max_entries(capacity) < count)                                                               \
+    {                                                                                                          \
+        if (capacity > SIZE_MAX / 2)                                                                           \
+        {                                                                                                      \
+            return 0;                                                                                          \
+        }                                                                                                      \
+        capacity *= 2;                                                                                         \
+    }                                                                                                          \
+    return capacity;                                                                                           \
+}                                                                                                              \
+                                                                                                               \
+static inline int name##_allocate_table(name* map, const size_t capacity)                                      \
+{                                                                                                              \
+    if (capacity == 0 || capacity > SIZE_MAX / (sizeof(name##_slot) + 1))                                      \
+    {                                                                                                          \
+        return -1;                                                                                             \
+    }                                                                                                          \
+                                                                                                               \
+    name##_slot* slots = (name##_slot*)anv_alloc_allocate(&map->alloc, capacity * (sizeof(name##_slot) + 1));  \
+    if (!slots)                                                                                                \
+    {                                                                                                          \
+        return -1;                                                                                             \
+    }                                                                                                          \
+                                                                                                               \
+    map->slots = slots;                                                                                        \
+    map->distances = (uint8_t*)(slots + capacity);                                                             \
+    map->capacity = capacity;                                                                                  \
+    memset(map->distances, 0, capacity);                                                                       \
+    return 0;                                                                                                  \
+}                                                                                                              \
+                                                                                                               \
+static inline bool name##_locate(const name* map, K key, size_t* index_out, size_t* distance_out)              \
+{                                                                                                              \
+    const size_t mask = map->capacity - 1;                                                                     \
+    size_t index = name##_home_slot(map, key);                                                                 \
+    size_t distance = 1;                                                                                       \
+                                                                                                               \
+    for (;;)                                                                                                   \
+    {                                                                                                          \
+        const uint8_t existing = map->distances[index];                                                        \
+        if (existing < distance)                                                                               \
+        {                                                                                                      \
+            *index_out = index;                                                                                \
+            *distance_out = distance;                                                                          \
+            return false;                                                                                      \
+        }                                                                                                      \
+        if (existing == distance && (eq(map->slots[index].key, key)))                                          \
+        {                                                                                                      \
+            *index_out = index;                                                                                \
+            *distance_out = distance;                                                                          \
+            return true;                                                                                       \
+        }                                                                                                      \
+        index = (index + 1) & mask;                                                                            \
+        distance++;                                                                                            \
+    }                                                                                                          \
+}                                                                                                              \
+                                                                                                               \
+static inline V* name##_insert_at(name* map, K key, V value, const size_t index, const size_t distance)        \
+{                                                                                                              \
+    if (distance > UINT8_MAX)                                                                                  \
+    {                                                                                                          \
+        return NULL;                                                                                           \
+    }                                                                                                          \
+                                                                                                               \
+    const size_t mask = map->capacity - 1;                                                                     \
+    size_t empty = index;                                                                                      \
+    while (map->distances[empty] != 0)                                                                         \
+    {                                                                                                          \
+        if (map->distances[empty] == UINT8_MAX)                                                                \
+        {                                                                                                      \
+            return NULL;                                                                                       \
+        }                                                                                                      \
+        empty = (empty + 1) & mask;                                                                            \
+    }                                                                                                          \
+                                                                                                               \
+    while (empty != index)                                                                                     \
+    {                                                                                                          \
+        const size_t previous = (empty - 1) & mask;                                                            \
+        map->slots[empty] = map->slots[previous];                                                              \
+        map->distances[empty] = (uint8_t)(map->distances[previous] + 1);                                       \
+        empty = previous;                                                                                      \
+    }                                                                                                          \
+                                                                                                               \
+    map->slots[index].key = key;                                                                               \
+    map->slots[index].value = value;                                                                           \
+    map->distances[index] = (uint8_t)distance;                                                                 \
+    map->size++;                                                                                               \
+    return &map->slots[index].value;                                                                           \
+}                                                                                                              \
+                                                                                                               \
+static inline int name##_rehash(name* map, size_t new_capacity)                                                \
+{                                                                                                              \
+    const name old = *map;                                                                                     \
+                                                                                                               \
+    for (;;)                                                                                                   \
+    {                                                                                                          \
+        if (name##_allocate_table(map, new_capacity) != 0)                                                     \
+        {                                                                                                      \
+            *map = old;                                                                                        \
+            return -1;                                                                                         \
+        }                                                                                                      \
+        map->size = 0;                                                                                         \
+                                                                                                               \
+        bool placed = true;                                                                                    \
+        for (size_t i = 0; i < old.capacity && placed; i++)                                                    \
+        {                                                                                                      \
+            if (old.distances[i] == 0)                                                                         \
+            {                                                                                                  \
+                continue;                                                                                      \
+            }                                                                                                  \
+                                                                                                               \
+            size_t index;                                                                                      \
+            size_t distance;                                                                                   \
+            name##_locate(map, old.slots[i].key, &index, &distance);                                           \
+            placed = name##_insert_at(map, old.slots[i].key, old.slots[i].value, index, distance) != NULL;     \
+        }                                                                                                      \
+                                                                                                               \
+        if (placed)                                                                                            \
+        {                                                                                                      \
+            anv_alloc_deallocate(&map->alloc, old.slots);                                                      \
+            return 0;                                                                                          \
+        }                                                                                                      \
+                                                                                                               \
+        anv_alloc_deallocate(&map->alloc, map->slots);                                                         \
+        if (new_capacity > SIZE_MAX / 2 || new_capacity / 8 > old.size)                                        \
+        {                                                                                                      \
+            *map = old;                                                                                        \
+            return -1;                                                                                         \
+        }                                                                                                      \
+        new_capacity *= 2;                                                                                     \
+    }                                                                                                          \
+}                                                                                                              \
+                                                                                                               \
+static inline name* name##_create(ANVAllocator* alloc, const size_t initial_capacity)                          \
+{                                                                                                              \
+    if (!alloc)                                                                                                \
+    {                                                                                                          \
+        return NULL;                                                                                           \
+    }                                                                                                          \
+                                                                                                               \
+    name* map = (name*)anv_alloc_allocate(alloc, sizeof(name));                                                \
+    if (!map)                                                                                                  \
+    {                                                                                                          \
+        return NULL;                                                                                           \
+    }                                                                                                          \
+                                                                                                               \
+    memset(map, 0, sizeof(name));                                                                              \
+    map->alloc = *alloc;                                                                                       \
+    map->seed = anv_hash_random_seed().k0;                                                                     \
+    if (name##_allocate_table(map, name##_capacity_for(initial_capacity > 0 ? initial_capacity                 \
+                                                                          : ANV_DEFAULT_CAPACITY)) != 0)       \
+    {                                                                                                          \
+        anv_alloc_deallocate(alloc, map);                                                                      \
+        return NULL;                                                                                           \
+    }                                                                                                          \
+    return map;                                                                                                \
+}                                                                                                              \
+                                                                                                               \
+static inline void name##_destroy(name* map)                                                                   \
+{                                                                                                              \
+    if (!map)                                                                                                  \
+    {                                                                                                          \
+        return;                                                                                                \
+    }                                                                                                          \
+                                                                                                               \
+    anv_alloc_deallocate(&map->alloc, map->slots);                                                             \
+    anv_alloc_deallocate(&map->alloc, map);                                                                    \
+}                                                                                                              \
+                                                                                                               \
+static inline void name##_clear(name* map)                                                                     \
+{                                                                                                              \
+    if (!map)                                                                                                  \
+    {                                                                                                          \
+        return;                                                                                                \
+    }                                                                                                          \
+                                                                                                               \
+    memset(map->distances, 0, map->capacity);                                                                  \
+    map->size = 0;                                                                                             \
+}                                                                                                              \
+                                                                                                               \
+static inline int name##_reserve(name* map, const size_t count)                                                \
+{                                                                                                              \
+    if (!map)                                                                                                  \
+    {                                                                                                          \
+        return -1;                                                                                             \
+    }                                                                                                          \
+    if (count <= name##_max_entries(map->capacity))                                                            \
+    {                                                                                                          \
+        return 0;                                                                                              \
+    }                                                                                                          \
+                                                                                                               \
+    const size_t capacity = name##_capacity_for(count);                                                        \
+    return capacity ? name##_rehash(map, capacity) : -1;                                                       \
+}                                                                                                              \
+                                                                                                               \
+static inline size_t name##_size(const name* map)                                                              \
+{                                                                                                              \
+    return map ? map->size : 0;                                                                                \
+}                                                                                                              \
+                                                                                                               \
+static inline int name##_is_empty(const name* map)                                                             \
+{                                                                                                              \
+    return !map || map->size == 0;                                                                             \
+}                                                                                                              \
+                                                                                                               \
+static inline double name##_load_factor(const name* map)                                                       \
+{                                                                                                              \
+    if (!map || map->capacity == 0)                                                                            \
+    {                                                                                                          \
+        return 0.0;                                                                                            \
+    }                                                                                                          \
+    return (double)map->size / (double)map->capacity;                                                          \
+}                                                                                                              \
+                                                                                                               \
+static inline V* name##_get(const name* map, K key)                                                            \
+{                                                                                                              \
+    if (!map)                                                                                                  \
+    {                                                                                                          \
+        return NULL;                                                                                           \
+    }                                                                                                          \
+                                                                                                               \
+    size_t index;                                                                                              \
+    size_t distance;                                                                                           \
+    return name##_locate(map, key, &index, &distance) ? &map->slots[index].value : NULL;                       \
+}                                                                                                              \
+                                                                                                               \
+static inline int name##_contains_key(const name* map, K key)                                                  \
+{                                                                                                              \
+    return name##_get(map, key) != NULL;                                                                       \
+}                                                                                                              \
+                                                                                                               \
+static inline V* name##_entry(name* map, K key, bool* inserted_out)                                            \
+{                                                                                                              \
+    if (inserted_out)                                                                                          \
+    {                                                                                                          \
+        *inserted_out = false;                                                                                 \
+    }                                                                                                          \
+    if (!map)                                                                                                  \
+    {                                                                                                          \
+        return NULL;                                                                                           \
+    }                                                                                                          \
+                                                                                                               \
+    for (;;)                                                                                                   \
+    {                                                                                                          \
+        size_t index;                                                                                          \
+        size_t distance;                                                                                       \
+        if (name##_locate(map, key, &index, &distance))                                                        \
+        {                                                                                                      \
+            return &map->slots[index].value;                                                                   \
+        }                                                                                                      \
+                                                                                                               \
+        if (map->size < name##_max_entries(map->capacity))                                                     \
+        {                                                                                                      \
+            V zero;                                                                                            \
+            memset(&zero, 0, sizeof(zero));                                                                    \
+            V* slot = name##_insert_at(map, key, zero, index, distance);                                       \
+            if (slot)                                                                                          \
+            {                                                                                                  \
+                if (inserted_out)                                                                              \
+                {                                                                                              \
+                    *inserted_out = true;                                                                      \
+                }                                                                                              \
+                return slot;                                                                                   \
+            }                                                                                                  \
+        }                                                                                                      \
+                                                                                                               \
+        if (map->size < map->capacity / 8 || map->capacity > SIZE_MAX / 2 ||                                   \
+            name##_rehash(map, map->capacity * 2) != 0)                                                        \
+        {                                                                                                      \
+            return NULL;                                                                                       \
+        }                                                                                                      \
+    }                                                                                                          \
+}                                                                                                              \
+                                                                                                               \
+static inline int name##_put(name* map, K key, V value)                                                        \
+{                                                                                                              \
+    V* slot = name##_entry(map, key, NULL);                                                                    \
+    if (!slot)                                                                                                 \
+    {                                                                                                          \
+        return -1;                                                                                             \
+    }                                                                                                          \
+                                                                                                               \
+    *slot = value;                                                                                             \
+    return 0;                                                                                                  \
+}                                                                                                              \
+                                                                                                               \
+static inline int name##_remove(name* map, K key)                                                              \
+{                                                                                                              \
+    if (!map)                                                                                                  \
+    {                                                                                                          \
+        return -1;                                                                                             \
+    }                                                                                                          \
+                                                                                                               \
+    size_t index;                                                                                              \
+    size_t distance;                                                                                           \
+    if (!name##_locate(map, key, &index, &distance))                                                           \
+    {                                                                                                          \
+        return -1;                                                                                             \
+    }                                                                                                          \
+                                                                                                               \
+    const size_t mask = map->capacity - 1;                                                                     \
+    size_t next = (index + 1) & mask;                                                                          \
+    while (map->distances[next] > 1)                                                                           \
+    {                                                                                                          \
+        map->slots[index] = map->slots[next];                                                                  \
+        map->distances[index] = (uint8_t)(map->distances[next] - 1);                                           \
+        index = next;                                                                                          \
+        next = (next + 1) & mask;                                                                              \
+    }                                                                                                          \
+                                                                                                               \
+    map->distances[index] = 0;                                                                                 \
+    map->size--;                                                                                               \
+    return 0;                                                                                                  \
+}                                                                                                              \
+                                                                                                               \
+static inline void name##_for_each(const name* map, void (*action)(K key, V value))                            \
+{                                                                                                              \
+    if (!map || !action)                                                                                       \
+    {                                                                                                          \
+        return;                                                                                                \
+    }                                                                                                          \
+                                                                                                               \
+    for (size_t i = 0; i < map->capacity; i++)                                                                 \
+    {                                                                                                          \
+        if (map->distances[i])                                                                                 \
+        {                                                                                                      \
+            action(map->slots[i].key, map->slots[i].value);                                                    \
+        }                                                                                                      \
+    }                                                                                                          \
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ANVIL_TYPEDHASHMAP_H
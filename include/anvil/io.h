@@ -6,5 +6,6 @@
 #define ANVIL_IO_H
 
 #include "io/file.h"
+#include "io/image.h"
 
 #endif //ANVIL_IO_H
\ No newline at end of file
@@ -25,8 +25,9 @@ typedef struct ANVFile
 {
     FILE *handle;           // Internal file handle (NULL when not actively reading/writing)
     ANVString path;         // Path to the file
-    uint8_t *contents;      // Buffer containing file contents (populated by anv_file_read)
+    uint8_t *contents;      // Buffer containing file contents (populated by anv_file_read or anv_file_map)
     size_t size;            // Size of file contents in bytes
+    bool is_mapped;         // Whether contents is a read-only mapping rather than an allocation
     ANVAllocator allocator; // Custom allocator for memory management
 } ANVFile;
 
@@ -109,6 +110,24 @@ ANV_API ANVResult anv_file_write(ANVFile* file, const uint8_t* data, size_t size
  */
 ANV_API ANVResult anv_file_write_append(ANVFile* file, const uint8_t* data, size_t size);
 
+/**
+ * Map the entire file into memory read-only instead of reading it.
+ *
+ * The file's pages are loaded on first access, so opening a large file costs
+ * no more than the pages actually touched. The mapping replaces any previous
+ * contents and is exposed through file->contents and file->size, which must
+ * not be written to. It stays valid until the file is destroyed, read or
+ * mapped again. An empty file maps to NULL contents with size 0.
+ *
+ * @param file The file object to map (must not be NULL)
+ * @return ANV_RESULT_SUCCESS on success
+ *         ANV_RESULT_INVALID_ARGUMENT if file is NULL
+ *         ANV_RESULT_NOT_FOUND if file cannot be opened
+ *         ANV_RESULT_OUT_OF_BOUNDS if file size cannot be determined
+ *         ANV_RESULT_OUT_OF_MEMORY if the mapping fails
+ */
+ANV_API ANVResult anv_file_map(ANVFile* file);
+
 #ifdef __cplusplus
 }
 #endif
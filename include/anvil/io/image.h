@@ -0,0 +1,246 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_IMAGE_H
+#define ANVIL_IMAGE_H
+
+#include "anvil/common.h"
+#include "anvil/algorithms/hash.h"
+#include "anvil/containers/arraylist.h"
+#include "anvil/containers/hashmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/**
+ * Format version written into every image. Images with another version are
+ * rejected when opened.
+ */
+#define ANV_IMAGE_VERSION 2
+
+//==============================================================================
+// Type definitions
+//==============================================================================
+
+/**
+ * Returns the number of bytes of flat data an element points to, which is
+ * copied into the image as is. Elements must not contain pointers.
+ *
+ * @param data The element (never NULL)
+ * @return Size of the element's data in bytes
+ */
+typedef size_t (*anv_image_size_func)(const void* data);
+
+/**
+ * Read-only hash map served directly from a memory-mapped image file.
+ *
+ * An image is a single relocatable block: a versioned header followed by a
+ * bucket offset table, a fixed-size entry array and the key and value bytes,
+ * all addressed by offsets from the start of the file and aligned to
+ * 8 bytes. Opening maps the file and validates the header; lookups then
+ * read the bucket table, the entries and the key bytes straight from the
+ * mapped pages, so only the pages a lookup touches are ever loaded.
+ *
+ * Keys are located with the hash function given when opening, which must
+ * produce the same values as the function the source map used. For seeded
+ * maps the seed is stored in the image. Images use the writer's byte order
+ * and are rejected on a machine with a different one.
+ */
+typedef struct ANVHashMapImage ANVHashMapImage;
+
+/**
+ * Read-only array list served directly from a memory-mapped image file.
+ * Uses the same header and layout rules as ANVHashMapImage.
+ */
+typedef struct ANVArrayListImage ANVArrayListImage;
+
+//==============================================================================
+// Writing functions
+//==============================================================================
+
+/**
+ * Size function for NUL-terminated string data, including the terminator.
+ *
+ * @param data The string
+ * @return strlen(data) + 1
+ */
+ANV_API size_t anv_image_size_string(const void* data);
+
+/**
+ * Write a hash map to an image file, replacing any existing file. Each key
+ * and value is copied by the bytes its size function reports. NULL values
+ * are stored as NULL. The image is written to path.tmp and renamed over
+ * path, so images already open on the old file stay valid.
+ *
+ * @param map The hash map to write
+ * @param path Path of the image file
+ * @param key_size Size function for keys
+ * @param value_size Size function for values
+ * @return ANV_RESULT_SUCCESS on success
+ *         ANV_RESULT_INVALID_ARGUMENT if any argument is NULL
+ *         ANV_RESULT_OUT_OF_MEMORY if the image buffer cannot be allocated
+ *         ANV_RESULT_NOT_FOUND if the file cannot be created or renamed into place
+ *         Any error from anv_file_write
+ */
+ANV_API ANVResult anv_image_write_hashmap(const ANVHashMap* map, const char* path,
+                                          anv_image_size_func key_size, anv_image_size_func value_size);
+
+/**
+ * Write an array list to an image file, replacing any existing file. Each
+ * element is copied by the bytes its size function reports. NULL elements
+ * are stored as NULL. Replaces the file the same way as
+ * anv_image_write_hashmap.
+ *
+ * @param list The array list to write
+ * @param path Path of the image file
+ * @param element_size Size function for elements
+ * @return ANV_RESULT_SUCCESS on success
+ *         ANV_RESULT_INVALID_ARGUMENT if any argument is NULL
+ *         ANV_RESULT_OUT_OF_MEMORY if the image buffer cannot be allocated
+ *         ANV_RESULT_NOT_FOUND if the file cannot be created or renamed into place
+ *         Any error from anv_file_write
+ */
+ANV_API ANVResult anv_image_write_arraylist(const ANVArrayList* list, const char* path,
+                                            anv_image_size_func element_size);
+
+//==============================================================================
+// Hash map image functions
+//==============================================================================
+
+/**
+ * Map a hash map image written from an unseeded map.
+ *
+ * Verifying the checksum reads every page of the file, which is exactly
+ * the cost mapping avoids. Without it, open still checks the header and
+ * table bounds, and each lookup checks that the key and value offsets it
+ * touches start inside the image, treating damaged entries as absent. The
+ * bytes of a key are still passed to key_equals unchecked, so skip the
+ * checksum only for files from a trusted writer.
+ *
+ * @param alloc Custom allocator (required)
+ * @param path Path of the image file
+ * @param hash Hash function the source map used (required)
+ * @param key_equals Key equality function (required)
+ * @param verify_checksum Whether to check the image's checksum before use
+ * @param image_out Receives the opened image
+ * @return ANV_RESULT_SUCCESS on success
+ *         ANV_RESULT_INVALID_ARGUMENT if any argument is NULL
+ *         ANV_RESULT_INVALID_STATE if the file is not a valid image of this kind,
+ *         version and byte order, or fails its checksum
+ *         Any error from anv_file_map
+ */
+ANV_API ANVResult anv_image_open_hashmap(ANVAllocator* alloc, const char* path, anv_hash_func hash,
+                                         key_equals_func key_equals, bool verify_checksum,
+                                         ANVHashMapImage** image_out);
+
+/**
+ * Map a hash map image written from a seeded map. The stored seed is used.
+ *
+ * @param alloc Custom allocator (required)
+ * @param path Path of the image file
+ * @param hash Keyed hash function the source map used (required)
+ * @param key_equals Key equality function (required)
+ * @param verify_checksum Whether to check the image's checksum before use
+ * @param image_out Receives the opened image
+ * @return Same as anv_image_open_hashmap
+ */
+ANV_API ANVResult anv_image_open_hashmap_seeded(ANVAllocator* alloc, const char* path, anv_seeded_hash_func hash,
+                                                key_equals_func key_equals, bool verify_checksum,
+                                                ANVHashMapImage** image_out);
+
+/**
+ * Unmap and free a hash map image. Pointers into it become invalid.
+ *
+ * @param image The image to close
+ */
+ANV_API void anv_image_hashmap_close(ANVHashMapImage* image);
+
+/**
+ * Get the number of entries in a hash map image.
+ *
+ * @param image The image to query
+ * @return Number of entries, or 0 if image is NULL
+ */
+ANV_API size_t anv_image_hashmap_size(const ANVHashMapImage* image);
+
+/**
+ * Get the value stored for a key, pointing into the mapped file.
+ *
+ * @param image The image to search
+ * @param key The key to look up
+ * @return Pointer to the value's bytes, or NULL if not found or on error
+ */
+ANV_API const void* anv_image_hashmap_get(const ANVHashMapImage* image, const void* key);
+
+/**
+ * Check if a hash map image contains a key.
+ *
+ * @param image The image to search
+ * @param key The key to search for
+ * @return 1 if key exists, 0 if not found or on error
+ */
+ANV_API int anv_image_hashmap_contains_key(const ANVHashMapImage* image, const void* key);
+
+/**
+ * Apply an action function to each key-value pair, in bucket order.
+ * Entries whose offsets point outside the image are skipped.
+ *
+ * @param image The image to process
+ * @param action Function applied to each key and value
+ */
+ANV_API void anv_image_hashmap_for_each(const ANVHashMapImage* image,
+                                        void (*action)(const void* key, const void* value));
+
+//==============================================================================
+// Array list image functions
+//==============================================================================
+
+/**
+ * Map an array list image.
+ *
+ * @param alloc Custom allocator (required)
+ * @param path Path of the image file
+ * @param verify_checksum Whether to check the image's checksum before use
+ * @param image_out Receives the opened image
+ * @return Same as anv_image_open_hashmap
+ */
+ANV_API ANVResult anv_image_open_arraylist(ANVAllocator* alloc, const char* path, bool verify_checksum,
+                                           ANVArrayListImage** image_out);
+
+/**
+ * Unmap and free an array list image. Pointers into it become invalid.
+ *
+ * @param image The image to close
+ */
+ANV_API void anv_image_arraylist_close(ANVArrayListImage* image);
+
+/**
+ * Get the number of elements in an array list image.
+ *
+ * @param image The image to query
+ * @return Number of elements, or 0 if image is NULL
+ */
+ANV_API size_t anv_image_arraylist_size(const ANVArrayListImage* image);
+
+/**
+ * Get an element, pointing into the mapped file.
+ *
+ * @param image The image to access
+ * @param index Index of the element
+ * @param size_out Receives the element's size in bytes (can be NULL)
+ * @return Pointer to the element's bytes, or NULL if stored as NULL, out of range, if its
+ *         bytes do not lie inside the image, or on error
+ */
+ANV_API const void* anv_image_arraylist_get(const ANVArrayListImage* image, size_t index, size_t* size_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ANVIL_IMAGE_H
@@ -6,6 +6,13 @@
 #define ANVIL_MEMORY_H
 
 #include "memory/arena.h"
+#include "memory/buddy.h"
+#include "memory/instrument.h"
+#include "memory/scratch.h"
+#include "memory/slab.h"
 #include "memory/stack_frame.h"
+#include "memory/thread_cache.h"
+#include "memory/tlsf.h"
+#include "memory/virtual_memory.h"
 
 #endif //ANVIL_MEMORY_H
\ No newline at end of file
@@ -11,25 +11,99 @@
 extern "C" {
 #endif
 
+//==============================================================================
+// Constants
+//==============================================================================
+
+/**
+ * Arena behaviour flags.
+ */
+#define ANV_ARENA_FIXED      0u        // Single block, allocations fail when it is full
+#define ANV_ARENA_GROWABLE   (1u << 0) // Chain new blocks when the current block is full
+#define ANV_ARENA_VIRTUAL    (1u << 1) // Reserved address range, pages committed on demand
+#define ANV_ARENA_HUGE_PAGES (1u << 2) // Request transparent huge pages (virtual arenas only)
+
+/**
+ * Alignment of allocations made with anv_arena_allocate.
+ */
+#define ANV_ARENA_DEFAULT_ALIGNMENT ((size_t)8)
+
+/**
+ * Granularity used when a virtual arena commits more pages.
+ */
+#define ANV_ARENA_COMMIT_SIZE ((size_t)64 * 1024)
+
 //==============================================================================
 // Type definitions
 //==============================================================================
 
+/**
+ * Header placed in front of every block of arena memory.
+ *
+ * Blocks in use form a chain from the current block back to the first one.
+ * Blocks released by anv_arena_reset are kept on a free list for reuse.
+ */
+typedef struct ANVArenaBlock
+{
+    struct ANVArenaBlock *next; // Older block in the chain, or next block on the free list
+    size_t size;                // Usable bytes following this header
+    size_t used;                // Live bytes when the block was retired from being current
+    size_t touched;             // Bytes written since the block was last cleared (restored as high_water)
+} ANVArenaBlock;
+
 /**
  * Arena allocator structure for bump-pointer allocation.
  *
  * This structure manages a contiguous block of memory for fast allocation.
  * Allocations are made by bumping a pointer forward (increasing 'used').
- * Memory is reclaimed only when the arena is reset or destroyed. All
- * allocations are 8-byte aligned.
+ * Memory is reclaimed only when the arena is reset or destroyed.
+ * Allocations are 8-byte aligned unless anv_arena_allocate_aligned asks
+ * for more.
+ *
+ * A growable arena chains a new block (at least twice the size of the
+ * previous one) when the current block is full, so 'memory', 'size' and
+ * 'used' always describe the current block.
+ *
+ * A virtual arena reserves 'size' bytes of address space up front and
+ * commits pages as 'used' grows, so only touched memory costs RSS.
+ *
+ * Every block starts out zeroed and is cleared again when it is released
+ * to the free list or reset, so memory handed out after a reset reads as
+ * zero. Space given back by anv_arena_deallocate or anv_arena_restore
+ * within the current block is not cleared until the next reset.
  */
 typedef struct ANVArena
 {
-    uint8_t *memory;        // Pointer to the arena's memory block
-    size_t size;            // Total size of the arena in bytes
-    size_t used;            // Number of bytes currently allocated
+    uint8_t *memory;            // Pointer to the current block's memory
+    size_t size;                // Size of the current block in bytes
+    size_t used;                // Number of bytes currently allocated in the current block
+    size_t committed;           // Bytes of the current block that are accessible
+    size_t high_water;          // Highest 'used' seen in the current block since it became current
+    ANVArenaBlock *current;     // Header of the current block (NULL for virtual arenas)
+    ANVArenaBlock *free_blocks; // Blocks kept across resets for reuse
+    size_t reserved;            // Bytes held by all blocks, including the free list
+    size_t retain_size;         // Bytes kept across anv_arena_reset (0 keeps everything)
+    size_t chain_used;          // Bytes consumed by the blocks chained before the current one
+    size_t peak_used;           // Highest total usage since the arena was created
+    size_t scope_peak;          // Highest total usage since the innermost marker was saved
+    uint32_t flags;             // ANV_ARENA_* behaviour flags
 } ANVArena;
 
+/**
+ * Saved arena position used to release a group of allocations at once.
+ *
+ * Markers nest in LIFO order: restoring a marker releases everything
+ * allocated after it was saved, including allocations made under markers
+ * saved later.
+ */
+typedef struct ANVArenaMarker
+{
+    ANVArenaBlock *block;       // Block that was current when the marker was saved
+    size_t used;                // Offset inside that block
+    size_t total_used;          // Total arena usage when the marker was saved
+    size_t outer_scope_peak;    // Enclosing scope's peak, restored with the marker
+} ANVArenaMarker;
+
 //==============================================================================
 // Creation and destruction functions
 //==============================================================================
@@ -46,10 +120,43 @@ typedef struct ANVArena
  */
 ANV_API ANVArena anv_arena_create(size_t size);
 
+/**
+ * Create a growable arena.
+ *
+ * The arena starts with a single block of initial_size bytes. When an
+ * allocation does not fit, a block is taken from the free list or a new
+ * block of at least twice the current size is chained in, so allocations
+ * never fail for lack of space while memory is available.
+ *
+ * @param initial_size Size of the first block in bytes (must be greater than 0)
+ * @param retain_size Bytes of blocks to keep across anv_arena_reset; blocks
+ *                    above this mark are returned to the system (0 keeps all)
+ * @return New ANVArena structure (check memory field for NULL to detect failure)
+ */
+ANV_API ANVArena anv_arena_create_growable(size_t initial_size, size_t retain_size);
+
+/**
+ * Create a virtual-memory arena.
+ *
+ * Reserves reserve_size bytes of address space without committing physical
+ * memory. Pages are committed in ANV_ARENA_COMMIT_SIZE steps (or huge page
+ * steps with ANV_ARENA_HUGE_PAGES) as allocations advance, so very large
+ * scratch arenas only cost what they touch. Allocations fail once the
+ * reservation is exhausted.
+ *
+ * @param reserve_size Bytes of address space to reserve (must be greater than 0)
+ * @param retain_size Bytes kept committed across anv_arena_reset; touched pages
+ *                    above this mark are decommitted (0 keeps everything committed)
+ * @param flags ANV_ARENA_HUGE_PAGES or 0
+ * @return New ANVArena structure (check memory field for NULL to detect failure)
+ */
+ANV_API ANVArena anv_arena_create_virtual(size_t reserve_size, size_t retain_size, uint32_t flags);
+
 /**
  * Destroy the arena and free all associated memory.
  *
- * Frees the entire arena memory block and resets all fields to zero.
+ * Frees every block owned by the arena (including blocks kept on the free
+ * list) and resets all fields to zero.
  * After destruction, the arena cannot be used for allocation.
  *
  * @param arena The arena to destroy (must not be NULL, arena->memory must not be NULL)
@@ -66,7 +173,7 @@ ANV_API ANVResult anv_arena_destroy(ANVArena *arena);
  *
  * Allocates the requested size (rounded up to 8-byte alignment) from the arena's
  * memory pool by advancing the 'used' pointer. Returns NULL if there is insufficient
- * space remaining in the arena.
+ * space remaining in a fixed arena. A growable arena moves to a new block instead.
  *
  * @param arena The arena to allocate from (must not be NULL, arena->memory must not be NULL)
  * @param size Number of bytes to allocate (must be greater than 0)
@@ -74,15 +181,48 @@ ANV_API ANVResult anv_arena_destroy(ANVArena *arena);
  */
 ANV_API void *anv_arena_allocate(ANVArena *arena, size_t size);
 
+/**
+ * Allocate memory from the arena aligned to the given boundary.
+ *
+ * Padding needed to reach the alignment is consumed from the arena, so
+ * interleaving differently aligned allocations costs some space. A growable
+ * arena sizes a new block so the aligned request always fits.
+ *
+ * @param arena The arena to allocate from (must not be NULL, arena->memory must not be NULL)
+ * @param size Number of bytes to allocate (must be greater than 0)
+ * @param alignment Required alignment in bytes (power of two, e.g. 32/64 for SIMD or cache lines)
+ * @return Pointer to aligned memory, or NULL if allocation fails or alignment is invalid
+ */
+ANV_API void *anv_arena_allocate_aligned(ANVArena *arena, size_t size, size_t alignment);
+
+/**
+ * Resize an allocation made from the arena.
+ *
+ * If ptr is the most recent allocation in the current block it grows or
+ * shrinks in place when the block has room (a virtual arena commits more
+ * pages as needed). Otherwise growing allocates a new region and copies
+ * the old contents; the old region is reclaimed with the rest of the arena.
+ *
+ * @param arena The arena that owns ptr (must not be NULL)
+ * @param ptr Allocation to resize (NULL behaves like anv_arena_allocate)
+ * @param old_size Size ptr was allocated or last resized with
+ * @param new_size Requested size in bytes (must be greater than 0)
+ * @return Pointer to the resized allocation, or NULL on failure (ptr stays valid)
+ */
+ANV_API void *anv_arena_reallocate(ANVArena *arena, void *ptr, size_t old_size, size_t new_size);
+
 /**
  * Deallocate memory from the arena.
  *
  * This function implements stack-based (LIFO) deallocation. When a pointer
  * is freed, the arena's 'used' counter is reset to that pointer's offset,
  * effectively freeing that allocation and all allocations made after it.
- * This allows freeing the most recent allocations in reverse order.
+ * This allows freeing the most recent allocations in reverse order. In a
+ * growable arena, blocks chained after the one containing ptr are moved
+ * to the free list.
  *
- * Note: Only pointers obtained from anv_arena_allocate should be passed to
+ * Note: Only pointers obtained from anv_arena_allocate or
+ * anv_arena_allocate_aligned should be passed to
  * this function. Freeing a pointer will also free any allocations made after it.
  *
  * @param arena The arena to deallocate from (must not be NULL, arena->memory must not be NULL)
@@ -94,14 +234,129 @@ ANV_API void anv_arena_deallocate(ANVArena *arena, const void *ptr);
  * Reset the arena to its initial empty state.
  *
  * Resets the 'used' counter to zero, effectively freeing all allocations
- * made from the arena. The memory block remains allocated and is zeroed out.
- * After reset, the arena can be reused for new allocations.
+ * made from the arena. The memory block remains allocated and the bytes
+ * touched since the last reset are zeroed out, so the cost is proportional
+ * to what was used rather than to the arena's capacity. After reset, the
+ * arena can be reused for new allocations.
+ *
+ * In a growable arena the first block becomes current again and the other
+ * blocks are cleared and moved to the free list, which is then trimmed to
+ * retain_size.
+ * In a virtual arena touched pages above retain_size are decommitted
+ * instead of being zeroed.
  *
  * @param arena The arena to reset (must not be NULL, arena->memory must not be NULL)
  * @return ANV_RESULT_SUCCESS on success, ANV_RESULT_INVALID_ARGUMENT if arena or arena->memory is NULL
  */
 ANV_API ANVResult anv_arena_reset(ANVArena *arena);
 
+/**
+ * Return free-list blocks to the system until at most retain_size bytes
+ * are held by the arena. Blocks in use are never released. A virtual arena
+ * decommits the pages above both retain_size and the bytes in use.
+ *
+ * @param arena The arena to trim (must not be NULL, arena->memory must not be NULL)
+ * @param retain_size Number of bytes to keep reserved
+ * @return ANV_RESULT_SUCCESS on success, ANV_RESULT_INVALID_ARGUMENT if arena or arena->memory is NULL
+ */
+ANV_API ANVResult anv_arena_trim(ANVArena *arena, size_t retain_size);
+
+//==============================================================================
+// Markers and statistics
+//==============================================================================
+
+/**
+ * Save the current arena position.
+ *
+ * Starts a new scope for peak tracking; anv_arena_restore reports the
+ * highest usage reached inside the scope.
+ *
+ * @param arena The arena to mark (must not be NULL, arena->memory must not be NULL)
+ * @return Marker for the current position (zeroed if arena is invalid)
+ */
+ANV_API ANVArenaMarker anv_arena_save(ANVArena *arena);
+
+/**
+ * Release every allocation made since the marker was saved.
+ *
+ * Works like anv_arena_deallocate on the first allocation made after the
+ * marker, so blocks chained after the marker move to the free list. Does
+ * nothing if the arena was rewound past the marker or reset since.
+ *
+ * @param arena The arena to restore (must not be NULL, arena->memory must not be NULL)
+ * @param marker Marker previously returned by anv_arena_save on this arena
+ * @return Peak number of bytes allocated inside the scope, or 0 on error
+ */
+ANV_API size_t anv_arena_restore(ANVArena *arena, const ANVArenaMarker *marker);
+
+/**
+ * Get the peak number of bytes allocated since the marker was saved.
+ *
+ * @param arena The arena to query
+ * @param marker The innermost marker saved on this arena
+ * @return Peak usage inside the scope so far, or 0 on error
+ */
+ANV_API size_t anv_arena_scope_peak(ANVArena *arena, const ANVArenaMarker *marker);
+
+/**
+ * Get the number of bytes consumed across all blocks in use.
+ *
+ * @param arena The arena to query
+ * @return Bytes in use, or 0 if arena is NULL
+ */
+ANV_API size_t anv_arena_total_used(const ANVArena *arena);
+
+/**
+ * Get the highest total usage since the arena was created.
+ *
+ * @param arena The arena to query
+ * @return Peak bytes in use, or 0 if arena is NULL
+ */
+ANV_API size_t anv_arena_peak_used(ANVArena *arena);
+
+/**
+ * Run the following statement or block inside an arena scope.
+ *
+ * A marker is saved before the body runs and restored after it completes,
+ * so temporary buffers allocated inside are released in one step. Leaving
+ * the body with break, return or goto skips the restore; use
+ * anv_arena_save/anv_arena_restore directly in that case or when the scope
+ * peak is needed.
+ *
+ * Example:
+ *     ANV_ARENA_SCOPE(&arena)
+ *     {
+ *         char* buffer = anv_arena_allocate(&arena, 256);
+ *         ...
+ *     }
+ */
+#define ANV_ARENA_SCOPE(arena)                                                  \
+    for (ANVArenaMarker anv_scope_marker_ = anv_arena_save(arena),              \
+                        *anv_scope_once_ = &anv_scope_marker_;                  \
+         anv_scope_once_;                                                       \
+         anv_arena_restore((arena), &anv_scope_marker_), anv_scope_once_ = NULL)
+
+//==============================================================================
+// Allocator integration
+//==============================================================================
+
+/**
+ * Create an ANVAllocator that allocates from the given arena.
+ *
+ * The returned allocator stores the arena as its context, so containers
+ * created with it place their nodes and buffers in the arena. Individual
+ * deallocations are no-ops; all memory is reclaimed at once with
+ * anv_arena_reset or anv_arena_destroy. The arena must outlive every
+ * container that uses the allocator. User data is not freed by the
+ * allocator (data_free is NULL). The reallocate and allocate_aligned hooks
+ * are set, so a growing buffer that was allocated last is extended in place
+ * and aligned requests need no over-allocation.
+ *
+ * @param arena The arena to allocate from (must not be NULL)
+ * @return ANVAllocator backed by the arena
+ */
+ANV_API ANVAllocator anv_arena_allocator(ANVArena *arena);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,171 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_BUDDY_H
+#define ANVIL_BUDDY_H
+
+#include "anvil/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/**
+ * Maximum number of block orders, so a region holds at most
+ * 2^(ANV_BUDDY_MAX_ORDERS - 1) minimum-size blocks.
+ */
+#define ANV_BUDDY_MAX_ORDERS 32
+
+/**
+ * Smallest minimum block size accepted by anv_buddy_create.
+ */
+#define ANV_BUDDY_MIN_BLOCK_SIZE ((size_t)16)
+
+//==============================================================================
+// Type definitions
+//==============================================================================
+
+/**
+ * Free block header, stored in the first bytes of every free block.
+ */
+typedef struct ANVBuddyBlock
+{
+    struct ANVBuddyBlock *next; // Next free block of the same order
+    struct ANVBuddyBlock *prev; // Previous free block of the same order
+} ANVBuddyBlock;
+
+/**
+ * Buddy allocator over a single reserved region.
+ *
+ * The region is a power of two in size and is split into blocks whose sizes
+ * are min_block times a power of two (the block's order). A request takes
+ * the smallest order that fits, splitting larger blocks in half as needed.
+ * A freed block merges with its buddy, the other half of the block it was
+ * split from, whenever that buddy is also free, so the region never
+ * fragments into unusable slivers. Every block is aligned to its own size.
+ *
+ * Block orders live in a side table indexed by min_block, so frees need no
+ * size argument and allocated memory carries no header. The allocator is
+ * not thread-safe.
+ */
+typedef struct ANVBuddyAllocator
+{
+    uint8_t *memory;                                  // Start of the managed region
+    size_t size;                                      // Region size in bytes, a power of two
+    size_t min_block;                                 // Size of an order-0 block, a power of two
+    uint32_t min_shift;                               // log2(min_block)
+    uint32_t order_count;                             // Orders from min_block up to size
+    uint8_t *block_orders;                            // Order and free flag of the block at each min_block
+    size_t *block_requests;                           // Bytes requested for the block at each min_block
+    size_t metadata_size;                             // Bytes mapped for the side tables
+    uint32_t free_mask;                               // Orders with a non-empty free list
+    ANVBuddyBlock *free_lists[ANV_BUDDY_MAX_ORDERS];  // Free blocks of each order
+    size_t free_counts[ANV_BUDDY_MAX_ORDERS];         // Length of each free list
+    size_t used_bytes;                                // Bytes in allocated blocks
+    size_t requested_bytes;                           // Bytes requested by live allocations
+    size_t live_blocks;                               // Number of allocated blocks
+} ANVBuddyAllocator;
+
+/**
+ * Snapshot of a buddy allocator's usage and fragmentation.
+ */
+typedef struct ANVBuddyStats
+{
+    size_t total_bytes;             // Size of the region
+    size_t used_bytes;              // Bytes in allocated blocks
+    size_t requested_bytes;         // Bytes requested by live allocations
+    size_t free_bytes;              // Bytes in free blocks
+    size_t free_blocks;             // Number of free blocks
+    size_t largest_free_block;      // Largest request that can currently succeed
+    double internal_fragmentation;  // 1 - requested_bytes / used_bytes
+    double external_fragmentation;  // 1 - largest_free_block / free_bytes
+} ANVBuddyStats;
+
+//==============================================================================
+// Buddy allocator functions
+//==============================================================================
+
+/**
+ * Create a buddy allocator over a newly reserved region.
+ *
+ * The whole region is committed up front, but pages are only backed once
+ * touched; anv_buddy_trim returns the pages of free blocks.
+ *
+ * @param size Region size in bytes (rounded up to a power of two)
+ * @param min_block Smallest block size (power of two, at least ANV_BUDDY_MIN_BLOCK_SIZE)
+ * @return New allocator (memory is NULL on failure or invalid arguments)
+ */
+ANV_API ANVBuddyAllocator anv_buddy_create(size_t size, size_t min_block);
+
+/**
+ * Release the region and side tables. All blocks become invalid.
+ *
+ * @param buddy Allocator to destroy
+ */
+ANV_API void anv_buddy_destroy(ANVBuddyAllocator *buddy);
+
+/**
+ * Allocate a block of at least size bytes, rounded up to min_block times a
+ * power of two.
+ *
+ * @param buddy Allocator to allocate from
+ * @param size Number of bytes to allocate
+ * @return Pointer to the block, or NULL if no block is large enough
+ */
+ANV_API void *anv_buddy_allocate(ANVBuddyAllocator *buddy, size_t size);
+
+/**
+ * Free a block and merge it with its free buddies.
+ *
+ * @param buddy Allocator the block came from
+ * @param ptr Pointer to the block (NULL is ignored)
+ */
+ANV_API void anv_buddy_deallocate(ANVBuddyAllocator *buddy, void *ptr);
+
+/**
+ * Resize a block. Shrinking splits off the unused halves, and growing
+ * absorbs free buddies above the block, both in place; otherwise a new
+ * block is allocated and the contents are copied.
+ *
+ * @param buddy Allocator the block came from
+ * @param ptr Pointer to the block (NULL behaves like allocate)
+ * @param size Requested size in bytes
+ * @return Pointer to the resized block, or NULL on failure (ptr stays valid)
+ */
+ANV_API void *anv_buddy_reallocate(ANVBuddyAllocator *buddy, void *ptr, size_t size);
+
+/**
+ * Return the pages of free blocks to the operating system. Each free block
+ * keeps the page holding its header.
+ *
+ * @param buddy Allocator to trim
+ */
+ANV_API void anv_buddy_trim(ANVBuddyAllocator *buddy);
+
+/**
+ * Take a snapshot of the allocator's usage and fragmentation.
+ *
+ * @param buddy Allocator to query
+ * @return Statistics snapshot (zeroed if buddy is NULL or invalid)
+ */
+ANV_API ANVBuddyStats anv_buddy_stats(const ANVBuddyAllocator *buddy);
+
+/**
+ * Create an ANVAllocator backed by a buddy allocator, including a
+ * reallocate hook that resizes in place when it can.
+ *
+ * @param buddy Allocator to allocate from
+ * @return ANVAllocator using the buddy allocator
+ */
+ANV_API ANVAllocator anv_buddy_allocator(ANVBuddyAllocator *buddy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ANVIL_BUDDY_H
@@ -0,0 +1,125 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_INSTRUMENT_H
+#define ANVIL_INSTRUMENT_H
+
+#include "anvil/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/**
+ * Number of counter shards per instrument. Threads are spread over the
+ * shards so concurrent allocations rarely touch the same cache line.
+ */
+#define ANV_INSTRUMENT_SHARDS 16
+
+/**
+ * Live-byte changes a shard accumulates before folding them into the shared
+ * total. The peak counts the calling shard's pending bytes, so it is exact
+ * for a single thread and within this many bytes per other active shard.
+ */
+#define ANV_INSTRUMENT_FLUSH_BYTES ((size_t)16 * 1024)
+
+/**
+ * Number of size histogram buckets. Bucket 0 counts requests of up to 16
+ * bytes, bucket i counts requests in (8 << i, 16 << i], and the last bucket
+ * also takes everything larger.
+ */
+#define ANV_INSTRUMENT_HISTOGRAM_BUCKETS 16
+
+//==============================================================================
+// Type definitions
+//==============================================================================
+
+/**
+ * Allocator wrapper that counts the traffic passing through it. Opaque;
+ * create with anv_instrument_create.
+ */
+typedef struct ANVInstrument ANVInstrument;
+
+/**
+ * Snapshot of an instrument's counters.
+ */
+typedef struct ANVAllocStats
+{
+    const char* tag;                                    // Tag given at creation (may be NULL)
+    size_t allocations;                                 // Successful allocate calls
+    size_t deallocations;                               // Deallocate calls
+    size_t reallocations;                               // Successful reallocate calls
+    size_t requested_bytes;                             // Bytes requested by allocate and reallocate
+    size_t live_bytes;                                  // Bytes currently allocated
+    size_t peak_bytes;                                  // Highest live_bytes observed
+    size_t histogram[ANV_INSTRUMENT_HISTOGRAM_BUCKETS]; // Request sizes, see ANV_INSTRUMENT_HISTOGRAM_BUCKETS
+} ANVAllocStats;
+
+//==============================================================================
+// Instrumented allocator functions
+//==============================================================================
+
+/**
+ * Create an instrument that forwards to a backing allocator.
+ *
+ * Every block carries a small header recording its size, so frees are
+ * accounted without a size argument. Counters are sharded per thread and
+ * updated with relaxed atomics, which keeps the overhead low enough to
+ * leave on in production. Wrapping one instrument's allocator in another
+ * instrument gives a per-call-site breakdown under a shared total.
+ *
+ * Memory a container maps directly (such as node pool slabs) bypasses the
+ * allocator and is not counted.
+ *
+ * @param backing Allocator that provides the memory (copied)
+ * @param tag Name reported in the statistics, e.g. a call site (may be NULL, not copied)
+ * @return Pointer to the new instrument, or NULL on failure
+ */
+ANV_API ANVInstrument* anv_instrument_create(const ANVAllocator* backing, const char* tag);
+
+/**
+ * Destroy an instrument. Blocks still allocated through it must not be
+ * freed afterwards.
+ *
+ * @param instrument Instrument to destroy (NULL is ignored)
+ */
+ANV_API void anv_instrument_destroy(ANVInstrument* instrument);
+
+/**
+ * Create an ANVAllocator that allocates through the instrument. The
+ * backing allocator's data_free, copy and flags are carried over, so it
+ * can be passed to any container in place of the backing allocator.
+ *
+ * @param instrument Instrument to allocate through
+ * @return ANVAllocator wrapping the backing allocator
+ */
+ANV_API ANVAllocator anv_instrument_allocator(ANVInstrument* instrument);
+
+/**
+ * Take a snapshot of the instrument's counters. Counters updated by other
+ * threads while the snapshot is taken may be partially included.
+ *
+ * @param instrument Instrument to query
+ * @return Statistics snapshot (zeroed if instrument is NULL)
+ */
+ANV_API ANVAllocStats anv_instrument_stats(const ANVInstrument* instrument);
+
+/**
+ * Zero the call counters, requested bytes and histogram, and restart peak
+ * tracking from the current live bytes. Taking stats before and after an
+ * operation is usually simpler; reset suits long-running sampling.
+ *
+ * @param instrument Instrument to reset
+ */
+ANV_API void anv_instrument_reset(ANVInstrument* instrument);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ANVIL_INSTRUMENT_H
@@ -0,0 +1,111 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_SCRATCH_H
+#define ANVIL_SCRATCH_H
+
+#include "anvil/common.h"
+#include "anvil/memory/arena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/**
+ * Size of the first block of each thread's scratch region, unless changed
+ * with anv_scratch_configure. Define before including to override.
+ */
+#ifndef ANV_SCRATCH_DEFAULT_SIZE
+#define ANV_SCRATCH_DEFAULT_SIZE ((size_t)64 * 1024)
+#endif
+
+//==============================================================================
+// Type definitions
+//==============================================================================
+
+/**
+ * A scope of temporary allocations on the calling thread's scratch region.
+ *
+ * Frames nest in LIFO order. Ending a frame releases everything allocated
+ * since it began, including allocations made in frames begun later.
+ */
+typedef struct ANVScratchFrame
+{
+    ANVArena *arena;       // Calling thread's scratch region (NULL if it could not be created)
+    ANVArenaMarker marker; // Position restored by anv_scratch_end
+} ANVScratchFrame;
+
+//==============================================================================
+// Scratch allocator functions
+//==============================================================================
+
+/**
+ * Set the size of the calling thread's scratch region.
+ *
+ * The region is a growable arena created on first use with a first block
+ * of this size. When a frame outgrows it, further blocks are chained in,
+ * and they are released again when the outermost frame ends. Calling this
+ * with no frame open discards the current region so the new size applies
+ * from the next anv_scratch_begin.
+ *
+ * @param size Size of the first block in bytes (must be greater than 0)
+ * @return ANV_RESULT_SUCCESS, ANV_RESULT_INVALID_ARGUMENT if size is 0, or
+ *         ANV_RESULT_INVALID_STATE if a frame is open on this thread
+ */
+ANV_API ANVResult anv_scratch_configure(size_t size);
+
+/**
+ * Begin a scratch frame on the calling thread, creating the thread's
+ * scratch region on first use. The region is freed when the thread exits.
+ *
+ * Memory from the frame must not outlive it or be passed to another
+ * thread's frames.
+ *
+ * @return New frame (frame.arena is NULL if the region could not be created)
+ */
+ANV_API ANVScratchFrame anv_scratch_begin(void);
+
+/**
+ * End a scratch frame, releasing every allocation made since it began.
+ * Frames must be ended in the reverse order they were begun.
+ *
+ * @param frame Frame returned by anv_scratch_begin
+ */
+ANV_API void anv_scratch_end(ANVScratchFrame *frame);
+
+/**
+ * Allocate temporary memory inside a frame. Blocks are 8-byte aligned and
+ * are released by anv_scratch_end; there is no individual free.
+ *
+ * @param frame Frame returned by anv_scratch_begin
+ * @param size Number of bytes to allocate
+ * @return Pointer to the block, or NULL on failure
+ */
+ANV_API void *anv_scratch_allocate(ANVScratchFrame *frame, size_t size);
+
+/**
+ * Create an ANVAllocator that allocates inside a frame, for containers
+ * that only live as long as the frame.
+ *
+ * @param frame Frame returned by anv_scratch_begin
+ * @return ANVAllocator backed by the thread's scratch region
+ */
+ANV_API ANVAllocator anv_scratch_allocator(ANVScratchFrame *frame);
+
+/**
+ * Free the calling thread's scratch region now rather than at thread exit.
+ *
+ * @return ANV_RESULT_SUCCESS, or ANV_RESULT_INVALID_STATE if a frame is open
+ */
+ANV_API ANVResult anv_scratch_release(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ANVIL_SCRATCH_H
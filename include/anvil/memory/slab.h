@@ -0,0 +1,184 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_SLAB_H
+#define ANVIL_SLAB_H
+
+#include "anvil/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/**
+ * Minimum number of objects a slab holds. Slabs start at one page and are
+ * doubled until at least this many objects fit.
+ */
+#define ANV_SLAB_MIN_OBJECTS 16
+
+/**
+ * Largest object size accepted by anv_slab_create.
+ */
+#define ANV_SLAB_MAX_OBJECT_SIZE ((size_t)8 * 1024)
+
+/**
+ * Default number of empty slabs kept for reuse before further empty slabs
+ * are returned to the operating system.
+ */
+#define ANV_SLAB_DEFAULT_MAX_EMPTY 1
+
+//==============================================================================
+// Type definitions
+//==============================================================================
+
+/**
+ * Header at the start of every slab.
+ *
+ * Slabs are aligned to their own size, so the slab owning an object is found
+ * by masking the object's address. Freed objects are linked through their
+ * first word, and objects that were never handed out are carved lazily from
+ * the bump pointer so creating a slab does not touch all of its pages.
+ */
+typedef struct ANVSlab
+{
+    struct ANVSlab *next; // Next slab in the same list
+    struct ANVSlab *prev; // Previous slab in the same list
+    void *free_list;      // Objects freed back into this slab
+    uint8_t *bump;        // Next object that has never been handed out
+    size_t used;          // Objects currently allocated from this slab
+} ANVSlab;
+
+/**
+ * Slab allocator for objects of a single fixed size.
+ *
+ * Allocation and deallocation are O(1): objects come from the intrusive free
+ * list of a partially used slab, and a freed object is pushed back onto the
+ * free list of the slab it came from. Slabs are page-sized (or a power-of-two
+ * multiple of the page size for larger objects) and are mapped directly from
+ * the operating system. Slabs that become empty are returned to the
+ * operating system once more than 'max_empty' of them are cached.
+ *
+ * The allocator is not thread-safe.
+ */
+typedef struct ANVSlabAllocator
+{
+    size_t object_size;      // Size of each object (rounded up to 8 bytes)
+    size_t slab_size;        // Bytes per slab, a power of two
+    size_t objects_per_slab; // Objects that fit in one slab
+    ANVSlab *partial;        // Slabs with free objects (allocation source)
+    ANVSlab *full;           // Slabs with no free objects
+    ANVSlab *empty;          // Empty slabs cached for reuse
+    size_t empty_count;      // Number of slabs on the empty list
+    size_t max_empty;        // Empty slabs kept before they are released
+    size_t slab_count;       // Slabs currently mapped, including cached ones
+    size_t live_objects;     // Objects currently allocated
+} ANVSlabAllocator;
+
+//==============================================================================
+// Slab allocator functions
+//==============================================================================
+
+/**
+ * Create a slab allocator for objects of the given size.
+ * No memory is mapped until the first allocation.
+ *
+ * @param object_size Size of each object in bytes (1 to ANV_SLAB_MAX_OBJECT_SIZE)
+ * @return Initialized ANVSlabAllocator (object_size is 0 if the size is invalid)
+ */
+ANV_API ANVSlabAllocator anv_slab_create(size_t object_size);
+
+/**
+ * Release every slab back to the operating system. All objects allocated
+ * from the slab allocator become invalid.
+ *
+ * @param slab Pointer to the ANVSlabAllocator
+ */
+ANV_API void anv_slab_destroy(ANVSlabAllocator* slab);
+
+/**
+ * Allocate one object. The contents of the object are unspecified.
+ *
+ * @param slab Pointer to the ANVSlabAllocator
+ * @return Pointer to an 8-byte aligned object, or NULL on failure
+ */
+ANV_API void* anv_slab_allocate(ANVSlabAllocator* slab);
+
+/**
+ * Return an object to the slab it was allocated from.
+ *
+ * @param slab Pointer to the ANVSlabAllocator that allocated ptr
+ * @param ptr Pointer to the object (NULL is ignored)
+ */
+ANV_API void anv_slab_deallocate(ANVSlabAllocator* slab, void* ptr);
+
+/**
+ * Return every cached empty slab to the operating system.
+ *
+ * @param slab Pointer to the ANVSlabAllocator
+ */
+ANV_API void anv_slab_trim(ANVSlabAllocator* slab);
+
+/**
+ * Create an ANVAllocator that serves requests from a slab allocator.
+ * Requests larger than the slab's object size fail and return NULL.
+ * The caller must keep the slab allocator alive while the ANVAllocator is
+ * in use.
+ *
+ * @param slab Pointer to the ANVSlabAllocator
+ * @return ANVAllocator backed by the slab allocator
+ */
+ANV_API ANVAllocator anv_slab_allocator(ANVSlabAllocator* slab);
+
+//==============================================================================
+// Container node pools
+//==============================================================================
+
+/**
+ * Create a node pool for a container when the container's allocator has
+ * ANV_ALLOC_POOL_NODES set. The ANVSlabAllocator itself is allocated with
+ * the container's allocator.
+ *
+ * @param alloc Allocator of the container
+ * @param node_size Size of the container's node type
+ * @return Node pool, or NULL if pooling is disabled or creation failed
+ */
+ANV_API ANVSlabAllocator* anv_slab_pool_create(const ANVAllocator* alloc, size_t node_size);
+
+/**
+ * Destroy a node pool created by anv_slab_pool_create.
+ *
+ * @param alloc Allocator of the container
+ * @param pool Node pool to destroy (NULL is ignored)
+ */
+ANV_API void anv_slab_pool_destroy(const ANVAllocator* alloc, ANVSlabAllocator* pool);
+
+/**
+ * Allocate a container node from the pool, or from the allocator when the
+ * container has no pool.
+ *
+ * @param pool Node pool of the container (can be NULL)
+ * @param alloc Allocator of the container
+ * @param node_size Size of the node in bytes
+ * @return Pointer to the node, or NULL on failure
+ */
+ANV_API void* anv_slab_pool_allocate(ANVSlabAllocator* pool, const ANVAllocator* alloc, size_t node_size);
+
+/**
+ * Free a container node allocated with anv_slab_pool_allocate.
+ *
+ * @param pool Node pool of the container (can be NULL)
+ * @param alloc Allocator of the container
+ * @param node Node to free (NULL is ignored)
+ */
+ANV_API void anv_slab_pool_deallocate(ANVSlabAllocator* pool, const ANVAllocator* alloc, void* node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ANVIL_SLAB_H
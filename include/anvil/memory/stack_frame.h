@@ -16,9 +16,18 @@ extern "C" {
 //==============================================================================
 
 /**
- * Size of the stack frame buffer in bytes.
+ * Size of the stack frame buffer in bytes. Define before including to
+ * override; for larger or growable temporaries use the per-thread scratch
+ * allocator in scratch.h instead of embedding a bigger frame.
  */
+#ifndef ANV_STACK_FRAME_SIZE
 #define ANV_STACK_FRAME_SIZE 4096
+#endif
+
+/**
+ * Alignment of allocations made with anv_stackframe_allocate.
+ */
+#define ANV_STACK_FRAME_DEFAULT_ALIGNMENT ((size_t)8)
 
 //==============================================================================
 // Type definitions
@@ -30,7 +39,8 @@ extern "C" {
  * This structure manages a fixed-size stack-based memory buffer for fast
  * temporary allocations. Memory is allocated by advancing the 'top' pointer.
  * Deallocations must follow LIFO order - only the most recent allocation
- * can be freed. All allocations are 8-byte aligned.
+ * can be freed. Allocations are 8-byte aligned unless
+ * anv_stackframe_allocate_aligned asks for more.
  */
 typedef struct ANVStackFrame
 {
@@ -55,6 +65,20 @@ typedef struct ANVStackFrame
  */
 ANV_API void *anv_stackframe_allocate(ANVStackFrame* frame, size_t size);
 
+/**
+ * Allocate memory from the stack frame aligned to the given boundary.
+ *
+ * Padding needed to reach the alignment is taken from the frame. Freeing
+ * the returned pointer with anv_stackframe_deallocate releases the
+ * allocation but keeps the padding until an earlier allocation is freed.
+ *
+ * @param frame The stack frame to allocate from (must not be NULL)
+ * @param size Number of bytes to allocate (must be greater than 0)
+ * @param alignment Required alignment in bytes (power of two)
+ * @return Pointer to aligned memory, or NULL if allocation fails or alignment is invalid
+ */
+ANV_API void *anv_stackframe_allocate_aligned(ANVStackFrame* frame, size_t size, size_t alignment);
+
 /**
  * Deallocate memory from the stack frame (LIFO only).
  *
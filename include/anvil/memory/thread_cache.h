@@ -0,0 +1,115 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_THREAD_CACHE_H
+#define ANVIL_THREAD_CACHE_H
+
+#include "anvil/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/**
+ * Size and alignment of the spans size-class objects are carved from. The
+ * span header records the size class, so freeing a block needs no size
+ * argument. Classes too large to fit twice get one object per span, mapped
+ * at the page-rounded object size.
+ */
+#define ANV_TCACHE_SPAN_SIZE ((size_t)64 * 1024)
+
+/**
+ * Largest request served from the size-class caches. Larger requests are
+ * mapped directly from the operating system and unmapped when freed.
+ */
+#define ANV_TCACHE_MAX_CLASS_SIZE ((size_t)256 * 1024)
+
+/**
+ * Number of size classes: 16-byte steps up to 128 bytes, then four classes
+ * per power of two up to ANV_TCACHE_MAX_CLASS_SIZE.
+ */
+#define ANV_TCACHE_CLASS_COUNT 52
+
+//==============================================================================
+// Type definitions
+//==============================================================================
+
+/**
+ * Snapshot of the thread-caching allocator's shared state.
+ */
+typedef struct ANVThreadCacheStats
+{
+    size_t spans;           // Spans currently mapped for size-class objects
+    size_t central_objects; // Freed objects parked on the central span lists
+    size_t large_blocks;    // Live blocks larger than ANV_TCACHE_MAX_CLASS_SIZE
+} ANVThreadCacheStats;
+
+//==============================================================================
+// Thread-caching allocator
+//==============================================================================
+
+/**
+ * Allocate a block from the calling thread's cache.
+ *
+ * Each thread keeps a free list per size class and only touches the shared
+ * central lists to move objects in batches, so the common path takes no
+ * lock. Blocks are 16-byte aligned.
+ *
+ * @param size Number of bytes to allocate
+ * @return Pointer to the block, or NULL on failure
+ */
+ANV_API void* anv_tcache_allocate(size_t size);
+
+/**
+ * Free a block from anv_tcache_allocate. Any thread may free any block; the
+ * block joins the freeing thread's cache and overflows to the central list.
+ * Once every object of a span is back on the central list the span is kept
+ * for reuse, up to a couple per size class, and unmapped beyond that.
+ *
+ * @param ptr Pointer to the block (NULL is ignored)
+ */
+ANV_API void anv_tcache_deallocate(void* ptr);
+
+/**
+ * Resize a block from anv_tcache_allocate. Shrinking, or growing within the
+ * block's size class, returns the same pointer.
+ *
+ * @param ptr Pointer to the block (NULL behaves like allocate)
+ * @param old_size Current size of the block in bytes
+ * @param new_size Requested size in bytes
+ * @return Pointer to the resized block, or NULL on failure (ptr stays valid)
+ */
+ANV_API void* anv_tcache_reallocate(void* ptr, size_t old_size, size_t new_size);
+
+/**
+ * Move every object cached by the calling thread to the central lists.
+ * This happens automatically when a thread exits.
+ */
+ANV_API void anv_tcache_flush(void);
+
+/**
+ * Take a snapshot of the shared allocator state.
+ *
+ * @return Statistics snapshot
+ */
+ANV_API ANVThreadCacheStats anv_tcache_stats(void);
+
+/**
+ * Create an ANVAllocator backed by the process-wide thread-caching
+ * allocator. Any number of allocators may be created; they share the same
+ * caches. data_free is set to anv_tcache_deallocate.
+ *
+ * @return ANVAllocator using the thread caches
+ */
+ANV_API ANVAllocator anv_tcache_allocator(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ANVIL_THREAD_CACHE_H
@@ -0,0 +1,124 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_TLSF_H
+#define ANVIL_TLSF_H
+
+#include "anvil/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/**
+ * Alignment of every block returned by the TLSF allocator.
+ */
+#define ANV_TLSF_ALIGNMENT ((size_t)8)
+
+/**
+ * Upper bound (exclusive) on the size of a single block. Regions larger
+ * than this are truncated.
+ */
+#define ANV_TLSF_MAX_BLOCK_SIZE ((size_t)1 << 38)
+
+//==============================================================================
+// Type definitions
+//==============================================================================
+
+/**
+ * Two-Level Segregated Fit allocator over a caller-provided region. Opaque;
+ * the control structure lives at the start of the region itself.
+ */
+typedef struct ANVTlsf ANVTlsf;
+
+/**
+ * Snapshot of a TLSF allocator's usage.
+ */
+typedef struct ANVTlsfStats
+{
+    size_t pool_bytes;  // Bytes available for blocks after the control structure
+    size_t used_bytes;  // Bytes in allocated blocks, excluding headers
+    size_t used_blocks; // Number of allocated blocks
+} ANVTlsfStats;
+
+//==============================================================================
+// TLSF allocator functions
+//==============================================================================
+
+/**
+ * Create a TLSF allocator inside a caller-provided region.
+ *
+ * Free blocks are kept in segregated lists indexed by a two-level bitmap
+ * (power of two, then 32 linear steps within it), so allocation and
+ * deallocation run in constant time with no searching. Freed blocks are
+ * coalesced with free neighbours immediately. This gives bounded latency
+ * for threads that cannot tolerate malloc's tail, and arbitrary-order frees
+ * that ANVArena and ANVStackFrame cannot offer.
+ *
+ * The region can come from anywhere, such as anv_arena_allocate or a static
+ * buffer, and must outlive the allocator. Nothing needs to be destroyed;
+ * releasing the region releases everything. The allocator is not
+ * thread-safe.
+ *
+ * @param memory Start of the region (aligned to ANV_TLSF_ALIGNMENT)
+ * @param size Size of the region in bytes
+ * @return Pointer to the allocator at the start of the region, or NULL if
+ *         the region is misaligned or too small
+ */
+ANV_API ANVTlsf* anv_tlsf_create(void* memory, size_t size);
+
+/**
+ * Allocate a block in constant time.
+ *
+ * @param tlsf Pointer to the allocator
+ * @param size Number of bytes to allocate
+ * @return Pointer to the block (aligned to ANV_TLSF_ALIGNMENT), or NULL on failure
+ */
+ANV_API void* anv_tlsf_allocate(ANVTlsf* tlsf, size_t size);
+
+/**
+ * Free a block in constant time, merging it with free neighbours.
+ *
+ * @param tlsf Pointer to the allocator
+ * @param ptr Pointer to the block (NULL is ignored)
+ */
+ANV_API void anv_tlsf_deallocate(ANVTlsf* tlsf, void* ptr);
+
+/**
+ * Resize a block. Shrinking, or growing into a free neighbour, happens in
+ * place; otherwise a new block is allocated and the contents are copied.
+ *
+ * @param tlsf Pointer to the allocator
+ * @param ptr Pointer to the block (NULL behaves like allocate)
+ * @param size Requested size in bytes
+ * @return Pointer to the resized block, or NULL on failure (ptr stays valid)
+ */
+ANV_API void* anv_tlsf_reallocate(ANVTlsf* tlsf, void* ptr, size_t size);
+
+/**
+ * Take a snapshot of the allocator's usage.
+ *
+ * @param tlsf Pointer to the allocator
+ * @return Usage snapshot (zeroed if tlsf is NULL)
+ */
+ANV_API ANVTlsfStats anv_tlsf_stats(const ANVTlsf* tlsf);
+
+/**
+ * Create an ANVAllocator backed by a TLSF allocator, including a
+ * reallocate hook that resizes in place when it can.
+ *
+ * @param tlsf Pointer to the allocator
+ * @return ANVAllocator using the TLSF allocator
+ */
+ANV_API ANVAllocator anv_tlsf_allocator(ANVTlsf* tlsf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ANVIL_TLSF_H
@@ -0,0 +1,87 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef ANVIL_VIRTUAL_MEMORY_H
+#define ANVIL_VIRTUAL_MEMORY_H
+
+#include "anvil/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/**
+ * Size of a transparent huge page on the platforms that support them.
+ */
+#define ANV_VMEM_HUGE_PAGE_SIZE ((size_t)2 * 1024 * 1024)
+
+//==============================================================================
+// Virtual memory operations
+//==============================================================================
+
+/**
+ * Get the system page size in bytes.
+ *
+ * @return Page size (cached after the first call)
+ */
+ANV_API size_t anv_vmem_page_size(void);
+
+/**
+ * Reserve a range of address space without committing physical memory.
+ *
+ * The range is inaccessible until it is committed with anv_vmem_commit.
+ * Sizes are rounded up to the page size.
+ *
+ * @param size Number of bytes to reserve (must be greater than 0)
+ * @param alignment Required alignment of the returned address (power of two,
+ *                  0 for page alignment)
+ * @return Start of the reserved range, or NULL on failure
+ */
+ANV_API void* anv_vmem_reserve(size_t size, size_t alignment);
+
+/**
+ * Commit pages inside a reserved range so they can be read and written.
+ * Newly committed pages are zero-filled by the operating system.
+ *
+ * @param ptr Page-aligned address inside a reserved range
+ * @param size Number of bytes to commit (rounded up to the page size)
+ * @param huge_pages Request transparent huge pages for the range (hint only)
+ * @return ANV_RESULT_SUCCESS on success
+ *         ANV_RESULT_INVALID_ARGUMENT if ptr is NULL or size is 0
+ *         ANV_RESULT_OUT_OF_MEMORY if the pages could not be committed
+ */
+ANV_API ANVResult anv_vmem_commit(void* ptr, size_t size, bool huge_pages);
+
+/**
+ * Return committed pages to the operating system while keeping the address
+ * range reserved. The pages read as zero once committed again.
+ *
+ * @param ptr Page-aligned address inside a reserved range
+ * @param size Number of bytes to decommit (rounded up to the page size)
+ * @return ANV_RESULT_SUCCESS on success
+ *         ANV_RESULT_INVALID_ARGUMENT if ptr is NULL or size is 0
+ *         ANV_RESULT_INVALID_STATE if the operating system rejected the request
+ */
+ANV_API ANVResult anv_vmem_decommit(void* ptr, size_t size);
+
+/**
+ * Release a range obtained from anv_vmem_reserve.
+ *
+ * @param ptr Start of the reserved range
+ * @param size Size passed to anv_vmem_reserve
+ * @return ANV_RESULT_SUCCESS on success
+ *         ANV_RESULT_INVALID_ARGUMENT if ptr is NULL
+ *         ANV_RESULT_INVALID_STATE if the operating system rejected the request
+ */
+ANV_API ANVResult anv_vmem_release(void* ptr, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ANVIL_VIRTUAL_MEMORY_H
@@ -2,8 +2,157 @@
 // Created by zack on 9/26/25.
 //
 
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
 #include "hash.h"
 
+#ifdef ANV_PLATFORM_WINDOWS
+    #include <Windows.h>
+    #include <bcrypt.h>
+#elif defined(ANV_PLATFORM_LINUX)
+    #include <sys/random.h>
+#endif
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+// Default secret for the byte hash: odd 64-bit constants with balanced bits
+static const uint64_t HASH_SECRET[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+// Full 128-bit product of a and b, returned as low and high halves
+static void multiply_128(uint64_t* a, uint64_t* b)
+{
+#if defined(__SIZEOF_INT128__)
+    const __uint128_t product = (__uint128_t)*a * *b;
+    *a = (uint64_t)product;
+    *b = (uint64_t)(product >> 64);
+#else
+    const uint64_t ha = *a >> 32, hb = *b >> 32;
+    const uint64_t la = (uint32_t)*a, lb = (uint32_t)*b;
+    const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    const uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+static uint64_t mix(uint64_t a, uint64_t b)
+{
+    multiply_128(&a, &b);
+    return a ^ b;
+}
+
+// Little-endian loads, so hashes and SipHash outputs match on every host
+static uint64_t read64(const uint8_t* p)
+{
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+static uint64_t read32(const uint8_t* p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
+
+// First, middle and last byte of a 1-3 byte key
+static uint64_t read_small(const uint8_t* p, const size_t len)
+{
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+}
+
+//==============================================================================
+// Hash functions
+//==============================================================================
+
+ANV_API uint64_t anv_hash_bytes(const void* data, const size_t len, uint64_t seed)
+{
+    const uint8_t* p = data;
+    seed ^= mix(seed ^ HASH_SECRET[0], HASH_SECRET[1]);
+
+    uint64_t a, b;
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            // Two overlapping pairs of 4-byte reads cover every byte
+            const size_t mid = (len >> 3) << 2;
+            a = (read32(p) << 32) | read32(p + mid);
+            b = (read32(p + len - 4) << 32) | read32(p + len - 4 - mid);
+        }
+        else if (len > 0)
+        {
+            a = read_small(p, len);
+            b = 0;
+        }
+        else
+        {
+            a = 0;
+            b = 0;
+        }
+    }
+    else
+    {
+        size_t remaining = len;
+        if (remaining >= 48)
+        {
+            uint64_t lane1 = seed, lane2 = seed;
+            do
+            {
+                seed = mix(read64(p) ^ HASH_SECRET[1], read64(p + 8) ^ seed);
+                lane1 = mix(read64(p + 16) ^ HASH_SECRET[2], read64(p + 24) ^ lane1);
+                lane2 = mix(read64(p + 32) ^ HASH_SECRET[3], read64(p + 40) ^ lane2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining >= 48);
+            seed ^= lane1 ^ lane2;
+        }
+
+        while (remaining > 16)
+        {
+            seed = mix(read64(p) ^ HASH_SECRET[1], read64(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+
+        // The last 16 bytes, overlapping the previous step if needed
+        a = read64(p + remaining - 16);
+        b = read64(p + remaining - 8);
+    }
+
+    a ^= HASH_SECRET[1];
+    b ^= seed;
+    multiply_128(&a, &b);
+    return mix(a ^ HASH_SECRET[0] ^ len, b ^ HASH_SECRET[1]);
+}
+
+ANV_API uint64_t anv_hash_mix64(uint64_t value)
+{
+    // SplitMix64 finalizer
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ull;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebull;
+    value ^= value >> 31;
+    return value;
+}
+
 ANV_API size_t anv_hash_string(const void* key)
 {
     if (!key)
@@ -11,40 +160,178 @@ ANV_API size_t anv_hash_string(const void* key)
         return 0;
     }
 
-    const char* str = key;
-    size_t hash = 5381;
-    int c;
+    return (size_t)anv_hash_bytes(key, strlen(key), 0);
+}
 
-    while ((c = (unsigned char)*str++))
+ANV_API size_t anv_hash_int(const void* key)
+{
+    if (!key)
     {
-        hash = ((hash << 5) + hash) + c; // hash * 33 + c
+        return 0;
     }
 
-    return hash;
+    return (size_t)anv_hash_mix64((uint32_t)*(const int*)key);
 }
 
-ANV_API size_t anv_hash_int(const void* key)
+ANV_API size_t anv_hash_int64(const void* key)
 {
     if (!key)
     {
         return 0;
     }
 
-    const int value = *(const int*)key;
-
-    size_t hash = (size_t)value;
-    hash = ((hash >> 16) ^ hash) * 0x45d9f3b;
-    hash = ((hash >> 16) ^ hash) * 0x45d9f3b;
-    hash = (hash >> 16) ^ hash;
-    return hash;
+    uint64_t value;
+    memcpy(&value, key, sizeof(value));
+    return (size_t)anv_hash_mix64(value);
 }
 
 ANV_API size_t anv_hash_pointer(const void* key)
 {
-    const uintptr_t addr = (uintptr_t)key;
-    size_t hash = addr;
-    hash = ((hash >> 16) ^ hash) * 0x45d9f3b;
-    hash = ((hash >> 16) ^ hash) * 0x45d9f3b;
-    hash = (hash >> 16) ^ hash;
-    return hash;
-}
\ No newline at end of file
+    return (size_t)anv_hash_mix64((uintptr_t)key);
+}
+
+//==============================================================================
+// Keyed hashing
+//==============================================================================
+
+#define ROTL64(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+#define ROTL32(x, b) (uint32_t)(((x) << (b)) | ((x) >> (32 - (b))))
+
+#define SIP_ROUND(v0, v1, v2, v3)                                                         \
+    do                                                                                    \
+    {                                                                                     \
+        v0 += v1; v1 = ROTL64(v1, 13); v1 ^= v0; v0 = ROTL64(v0, 32);                     \
+        v2 += v3; v3 = ROTL64(v3, 16); v3 ^= v2;                                          \
+        v0 += v3; v3 = ROTL64(v3, 21); v3 ^= v0;                                          \
+        v2 += v1; v1 = ROTL64(v1, 17); v1 ^= v2; v2 = ROTL64(v2, 32);                     \
+    } while (0)
+
+#define HALF_SIP_ROUND(v0, v1, v2, v3)                                                    \
+    do                                                                                    \
+    {                                                                                     \
+        v0 += v1; v1 = ROTL32(v1, 5); v1 ^= v0; v0 = ROTL32(v0, 16);                      \
+        v2 += v3; v3 = ROTL32(v3, 8); v3 ^= v2;                                           \
+        v0 += v3; v3 = ROTL32(v3, 7); v3 ^= v0;                                           \
+        v2 += v1; v1 = ROTL32(v1, 13); v1 ^= v2; v2 = ROTL32(v2, 16);                     \
+    } while (0)
+
+static bool fill_random(void* buffer, const size_t size)
+{
+#ifdef ANV_PLATFORM_WINDOWS
+    return BCRYPT_SUCCESS(BCryptGenRandom(NULL, buffer, (ULONG)size, BCRYPT_USE_SYSTEM_PREFERRED_RNG));
+#elif defined(ANV_PLATFORM_MACOS)
+    arc4random_buf(buffer, size);
+    return true;
+#elif defined(ANV_PLATFORM_LINUX)
+    return getrandom(buffer, size, 0) == (ssize_t)size;
+#else
+    (void)buffer;
+    (void)size;
+    return false;
+#endif
+}
+
+ANV_API ANVHashSeed anv_hash_random_seed(void)
+{
+    ANVHashSeed seed;
+    if (fill_random(&seed, sizeof(seed)))
+    {
+        return seed;
+    }
+
+    // Last resort: clock, address-space layout and a counter, well mixed
+    static uint64_t counter;
+    const uint64_t noise = (uint64_t)time(NULL) ^ (uint64_t)clock() ^ (uint64_t)(uintptr_t)&seed;
+    seed.k0 = anv_hash_mix64(noise ^ ++counter);
+    seed.k1 = anv_hash_mix64(seed.k0 ^ (uint64_t)(uintptr_t)&counter);
+    return seed;
+}
+
+ANV_API uint64_t anv_siphash13(const void* data, const size_t len, const ANVHashSeed* seed)
+{
+    const uint8_t* p = data;
+    uint64_t v0 = 0x736f6d6570736575ull ^ seed->k0;
+    uint64_t v1 = 0x646f72616e646f6dull ^ seed->k1;
+    uint64_t v2 = 0x6c7967656e657261ull ^ seed->k0;
+    uint64_t v3 = 0x7465646279746573ull ^ seed->k1;
+
+    const size_t whole = len & ~(size_t)7;
+    for (size_t i = 0; i < whole; i += 8)
+    {
+        const uint64_t m = read64(p + i);
+        v3 ^= m;
+        SIP_ROUND(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    // Remaining bytes, little-endian, with the length in the top byte
+    uint64_t b = (uint64_t)len << 56;
+    for (size_t i = 0; i < (len & 7); i++)
+    {
+        b |= (uint64_t)p[whole + i] << (8 * i);
+    }
+
+    v3 ^= b;
+    SIP_ROUND(v0, v1, v2, v3);
+    v0 ^= b;
+
+    v2 ^= 0xff;
+    SIP_ROUND(v0, v1, v2, v3);
+    SIP_ROUND(v0, v1, v2, v3);
+    SIP_ROUND(v0, v1, v2, v3);
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+ANV_API uint32_t anv_halfsiphash13(const void* data, const size_t len, const ANVHashSeed* seed)
+{
+    const uint8_t* p = data;
+    const uint32_t k0 = (uint32_t)seed->k0;
+    const uint32_t k1 = (uint32_t)seed->k1;
+    uint32_t v0 = k0;
+    uint32_t v1 = k1;
+    uint32_t v2 = 0x6c796765u ^ k0;
+    uint32_t v3 = 0x74656462u ^ k1;
+
+    const size_t whole = len & ~(size_t)3;
+    for (size_t i = 0; i < whole; i += 4)
+    {
+        const uint32_t m = (uint32_t)read32(p + i);
+        v3 ^= m;
+        HALF_SIP_ROUND(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    uint32_t b = (uint32_t)len << 24;
+    for (size_t i = 0; i < (len & 3); i++)
+    {
+        b |= (uint32_t)p[whole + i] << (8 * i);
+    }
+
+    v3 ^= b;
+    HALF_SIP_ROUND(v0, v1, v2, v3);
+    v0 ^= b;
+
+    v2 ^= 0xff;
+    HALF_SIP_ROUND(v0, v1, v2, v3);
+    HALF_SIP_ROUND(v0, v1, v2, v3);
+    HALF_SIP_ROUND(v0, v1, v2, v3);
+    return v1 ^ v3;
+}
+
+ANV_API size_t anv_hash_string_siphash(const void* key, const ANVHashSeed* seed)
+{
+    if (!key || !seed)
+    {
+        return 0;
+    }
+    return (size_t)anv_siphash13(key, strlen(key), seed);
+}
+
+ANV_API size_t anv_hash_string_halfsiphash(const void* key, const ANVHashSeed* seed)
+{
+    if (!key || !seed)
+    {
+        return 0;
+    }
+    return anv_halfsiphash13(key, strlen(key), seed);
+}
@@ -3,6 +3,7 @@
 //
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "allocator.h"
 
@@ -19,6 +20,37 @@ static void* default_copy(const void* data)
     return (void*)data;
 }
 
+//==============================================================================
+// Default resize and alignment hooks
+//==============================================================================
+
+static void* default_reallocate(void* context, void* ptr, const size_t old_size, const size_t new_size)
+{
+    (void)context;
+    (void)old_size;
+    return realloc(ptr, new_size);
+}
+
+#ifndef ANV_PLATFORM_WINDOWS
+static void* default_allocate_aligned(void* context, const size_t size, const size_t alignment)
+{
+    (void)context;
+
+    // aligned_alloc requires the size to be a multiple of the alignment
+    const size_t rounded = (size + alignment - 1) & ~(alignment - 1);
+    if (rounded < size)
+    {
+        return NULL;
+    }
+    return aligned_alloc(alignment, rounded);
+}
+#endif
+
+static bool is_power_of_two(const size_t value)
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
 //==============================================================================
 // Utility function implementations
 //==============================================================================
@@ -29,7 +61,11 @@ ANV_API ANVAllocator anv_alloc_default(void)
         .allocate = malloc,
         .deallocate = free,
         .data_free = free,
-        .copy = default_copy
+        .copy = default_copy,
+        .reallocate = default_reallocate,
+#ifndef ANV_PLATFORM_WINDOWS
+        .allocate_aligned = default_allocate_aligned
+#endif
     };
     return alloc;
 }
@@ -46,9 +82,38 @@ ANV_API ANVAllocator anv_alloc_custom(const anv_allocate_func alloc_func, const
     return alloc;
 }
 
+ANV_API ANVAllocator anv_alloc_stateful(void* context, const anv_allocate_ctx_func alloc_func,
+                                        const anv_deallocate_ctx_func dealloc_func,
+                                        const anv_deallocate_func data_free_func, const anv_copy_func anv_copy_func)
+{
+    const ANVAllocator alloc = {
+        .data_free = data_free_func,
+        .copy = anv_copy_func ? anv_copy_func : default_copy,
+        .context = context,
+        .allocate_ctx = alloc_func,
+        .deallocate_ctx = dealloc_func
+    };
+    return alloc;
+}
+
+ANV_API bool anv_alloc_is_valid(const ANVAllocator* alloc)
+{
+    return alloc && (alloc->allocate_ctx || alloc->allocate);
+}
+
 ANV_API void* anv_alloc_allocate(const ANVAllocator* alloc, const size_t size)
 {
-    if (!alloc || !alloc->allocate)
+    if (!alloc)
+    {
+        return NULL;
+    }
+
+    if (alloc->allocate_ctx)
+    {
+        return alloc->allocate_ctx(alloc->context, size);
+    }
+
+    if (!alloc->allocate)
     {
         return NULL;
     }
@@ -57,12 +122,96 @@ ANV_API void* anv_alloc_allocate(const ANVAllocator* alloc, const size_t size)
 
 ANV_API void anv_alloc_deallocate(const ANVAllocator* alloc, void* ptr)
 {
-    if (alloc && alloc->deallocate && ptr)
+    if (!alloc || !ptr)
+    {
+        return;
+    }
+
+    if (alloc->deallocate_ctx)
+    {
+        alloc->deallocate_ctx(alloc->context, ptr);
+    }
+    else if (alloc->deallocate)
     {
         alloc->deallocate(ptr);
     }
 }
 
+ANV_API void* anv_alloc_reallocate(const ANVAllocator* alloc, void* ptr, const size_t old_size, const size_t new_size)
+{
+    if (!alloc || new_size == 0)
+    {
+        return NULL;
+    }
+
+    if (alloc->reallocate)
+    {
+        return alloc->reallocate(alloc->context, ptr, old_size, new_size);
+    }
+
+    void* new_ptr = anv_alloc_allocate(alloc, new_size);
+    if (!new_ptr)
+    {
+        return NULL;
+    }
+
+    if (ptr)
+    {
+        memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+        anv_alloc_deallocate(alloc, ptr);
+    }
+    return new_ptr;
+}
+
+ANV_API void* anv_alloc_allocate_aligned(const ANVAllocator* alloc, const size_t size, const size_t alignment)
+{
+    if (!alloc || size == 0 || !is_power_of_two(alignment))
+    {
+        return NULL;
+    }
+
+    if (alloc->allocate_aligned)
+    {
+        return alloc->allocate_aligned(alloc->context, size, alignment);
+    }
+
+    // Over-allocate and stash the original pointer just before the aligned block
+    const size_t padding = alignment - 1 + sizeof(void*);
+    if (size > SIZE_MAX - padding)
+    {
+        return NULL;
+    }
+
+    uint8_t* raw = anv_alloc_allocate(alloc, size + padding);
+    if (!raw)
+    {
+        return NULL;
+    }
+
+    const uintptr_t start = (uintptr_t)(raw + sizeof(void*));
+    uint8_t* aligned = (uint8_t*)((start + alignment - 1) & ~(uintptr_t)(alignment - 1));
+    memcpy(aligned - sizeof(void*), &raw, sizeof(void*));
+    return aligned;
+}
+
+ANV_API void anv_alloc_deallocate_aligned(const ANVAllocator* alloc, void* ptr)
+{
+    if (!alloc || !ptr)
+    {
+        return;
+    }
+
+    if (alloc->allocate_aligned)
+    {
+        anv_alloc_deallocate(alloc, ptr);
+        return;
+    }
+
+    void* raw;
+    memcpy(&raw, (uint8_t*)ptr - sizeof(void*), sizeof(void*));
+    anv_alloc_deallocate(alloc, raw);
+}
+
 ANV_API void anv_alloc_data_deallocate(const ANVAllocator* alloc, void* ptr)
 {
     if (alloc && alloc->data_free && ptr)
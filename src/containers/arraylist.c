@@ -16,6 +16,62 @@
 // Private helper functions
 //==============================================================================
 
+/**
+ * Allocate a backing array, honouring the list's alignment if it has one.
+ */
+static void** allocate_data(const ANVArrayList* list, const size_t capacity)
+{
+    if (capacity > SIZE_MAX / sizeof(void*))
+    {
+        return NULL;
+    }
+
+    if (list->alignment > 0)
+    {
+        return anv_alloc_allocate_aligned(&list->alloc, capacity * sizeof(void*), list->alignment);
+    }
+    return anv_alloc_allocate(&list->alloc, capacity * sizeof(void*));
+}
+
+static void free_data(const ANVArrayList* list, void** data)
+{
+    if (list->alignment > 0)
+    {
+        anv_alloc_deallocate_aligned(&list->alloc, data);
+    }
+    else
+    {
+        anv_alloc_deallocate(&list->alloc, data);
+    }
+}
+
+/**
+ * Resize the backing array to new_capacity, keeping the first 'size' elements.
+ * Unaligned lists go through the allocator's reallocate hook so the block can
+ * be extended in place; aligned lists always move to a new aligned block.
+ */
+static void** resize_data(const ANVArrayList* list, const size_t new_capacity)
+{
+    if (list->alignment > 0 || !list->data)
+    {
+        void** new_data = allocate_data(list, new_capacity);
+        if (new_data && list->data)
+        {
+            memcpy(new_data, list->data, list->size * sizeof(void*));
+            free_data(list, list->data);
+        }
+        return new_data;
+    }
+
+    if (new_capacity > SIZE_MAX / sizeof(void*))
+    {
+        return NULL;
+    }
+
+    return anv_alloc_reallocate(&list->alloc, list->data, list->capacity * sizeof(void*),
+                                new_capacity * sizeof(void*));
+}
+
 /**
  * Ensure the ArrayList has at least the specified capacity.
  * Grows the array if needed using the growth factor.
@@ -51,22 +107,13 @@ static int ensure_capacity(ANVArrayList* list, const size_t min_capacity)
         new_capacity = next_capacity;
     }
 
-    // Reallocate the data array
-    void** new_data = anv_alloc_allocate(&list->alloc, new_capacity * sizeof(void*));
+    // Grow the data array, in place when the allocator can
+    void** new_data = resize_data(list, new_capacity);
     if (!new_data)
     {
         return -1;
     }
 
-    // Copy existing data
-    if (list->data && list->size > 0)
-    {
-        memcpy(new_data, list->data, list->size * sizeof(void*));
-    }
-
-    // Free old data array
-    anv_alloc_deallocate(&list->alloc, list->data);
-
     list->data = new_data;
     list->capacity = new_capacity;
     return 0;
@@ -123,12 +170,22 @@ static void merge_sort_recursive(void** arr, void** temp, const size_t left, con
 //==============================================================================
 
 ANV_API ANVArrayList* anv_arraylist_create(ANVAllocator* alloc, const size_t initial_capacity)
+{
+    return anv_arraylist_create_aligned(alloc, initial_capacity, 0);
+}
+
+ANV_API ANVArrayList* anv_arraylist_create_aligned(ANVAllocator* alloc, const size_t initial_capacity, const size_t alignment)
 {
     if (!alloc)
     {
         return NULL;
     }
 
+    if (alignment != 0 && ((alignment & (alignment - 1)) != 0 || alignment < sizeof(void*)))
+    {
+        return NULL;
+    }
+
     ANVArrayList* list = anv_alloc_allocate(alloc, sizeof(ANVArrayList));
     if (!list)
     {
@@ -138,6 +195,7 @@ ANV_API ANVArrayList* anv_arraylist_create(ANVAllocator* alloc, const size_t ini
     list->alloc = *alloc;
     list->size = 0;
     list->capacity = 0;
+    list->alignment = alignment;
     list->data = NULL;
 
     if (initial_capacity > 0)
@@ -161,7 +219,7 @@ ANV_API void anv_arraylist_destroy(ANVArrayList* list, const bool should_free_da
 
     anv_arraylist_clear(list, should_free_data);
 
-    anv_alloc_deallocate(&list->alloc, list->data);
+    free_data(list, list->data);
     anv_alloc_deallocate(&list->alloc, list);
 }
 
@@ -407,7 +465,7 @@ ANV_API int anv_arraylist_reserve(ANVArrayList* list, const size_t new_capacity)
 
 ANV_API int anv_arraylist_shrink_to_fit(ANVArrayList* list)
 {
-    if (!list || !list->alloc.allocate)
+    if (!list || !anv_alloc_is_valid(&list->alloc))
     {
         return -1;
     }
@@ -422,26 +480,19 @@ ANV_API int anv_arraylist_shrink_to_fit(ANVArrayList* list)
         // Free the data array if empty
         if (list->data)
         {
-            anv_alloc_deallocate(&list->alloc, list->data);
+            free_data(list, list->data);
         }
         list->data = NULL;
         list->capacity = 0;
         return 0;
     }
 
-    void** new_data = anv_alloc_allocate(&list->alloc, list->size * sizeof(void*));
+    void** new_data = resize_data(list, list->size);
     if (!new_data)
     {
         return -1;
     }
 
-    memcpy(new_data, list->data, list->size * sizeof(void*));
-
-    if (list->data)
-    {
-        anv_alloc_deallocate(&list->alloc, list->data);
-    }
-
     list->data = new_data;
     list->capacity = list->size;
     return 0;
@@ -547,7 +598,7 @@ ANV_API ANVArrayList* anv_arraylist_filter(ANVArrayList* list, const anv_filter_
         return NULL;
     }
 
-    ANVArrayList* filtered = anv_arraylist_create(&list->alloc, 0);
+    ANVArrayList* filtered = anv_arraylist_create_aligned(&list->alloc, 0, list->alignment);
     if (!filtered)
     {
         return NULL;
@@ -575,7 +626,7 @@ ANV_API ANVArrayList* anv_arraylist_filter_deep(ANVArrayList* list, const anv_fi
         return NULL;
     }
 
-    ANVArrayList* filtered = anv_arraylist_create(&list->alloc, 0);
+    ANVArrayList* filtered = anv_arraylist_create_aligned(&list->alloc, 0, list->alignment);
     if (!filtered)
     {
         return NULL;
@@ -608,7 +659,7 @@ ANV_API ANVArrayList* anv_arraylist_transform(ANVArrayList* list, const anv_tran
         return NULL;
     }
 
-    ANVArrayList* transformed = anv_arraylist_create(&list->alloc, list->size);
+    ANVArrayList* transformed = anv_arraylist_create_aligned(&list->alloc, list->size, list->alignment);
     if (!transformed)
     {
         return NULL;
@@ -655,7 +706,7 @@ ANV_API ANVArrayList* anv_arraylist_copy(ANVArrayList* list)
         return NULL;
     }
 
-    ANVArrayList* copy = anv_arraylist_create(&list->alloc, list->capacity);
+    ANVArrayList* copy = anv_arraylist_create_aligned(&list->alloc, list->capacity, list->alignment);
     if (!copy)
     {
         return NULL;
@@ -680,7 +731,7 @@ ANV_API ANVArrayList* anv_arraylist_copy_deep(ANVArrayList* list, const bool sho
         return NULL;
     }
 
-    ANVArrayList* copy = anv_arraylist_create(&list->alloc, list->capacity);
+    ANVArrayList* copy = anv_arraylist_create_aligned(&list->alloc, list->capacity, list->alignment);
     if (!copy)
     {
         return NULL;
@@ -887,7 +938,7 @@ ANV_API ANVIterator anv_arraylist_iterator(const ANVArrayList* list)
     iter.is_valid = arraylist_iter_is_valid;
     iter.destroy = arraylist_iter_destroy;
 
-    if (!list || !list->alloc.allocate)
+    if (!list || !anv_alloc_is_valid(&list->alloc))
     {
         return iter;
     }
@@ -921,7 +972,7 @@ ANV_API ANVIterator anv_arraylist_iterator_reverse(const ANVArrayList* list)
     it.is_valid = arraylist_iter_is_valid;
     it.destroy = arraylist_iter_destroy;
 
-    if (!list || !list->alloc.allocate)
+    if (!list || !anv_alloc_is_valid(&list->alloc))
     {
         return it;
     }
@@ -10,9 +10,9 @@
 // Helpers
 //==============================================================================
 
-static ANVBinarySearchTreeNode* anv_bst_node_create(const ANVAllocator* alloc, void* data)
+static ANVBinarySearchTreeNode* anv_bst_node_create(const ANVBinarySearchTree* tree, void* data)
 {
-    ANVBinarySearchTreeNode* node = anv_alloc_allocate(alloc, sizeof(ANVBinarySearchTreeNode));
+    ANVBinarySearchTreeNode* node = anv_slab_pool_allocate(tree->node_pool, &tree->alloc, sizeof(ANVBinarySearchTreeNode));
 
     if (!node)
     {
@@ -27,22 +27,22 @@ static ANVBinarySearchTreeNode* anv_bst_node_create(const ANVAllocator* alloc, v
     return node;
 }
 
-static void anv_bst_node_destroy_recursive(ANVBinarySearchTreeNode* node, ANVAllocator* alloc, const bool should_free_data)
+static void anv_bst_node_destroy_recursive(ANVBinarySearchTreeNode* node, const ANVBinarySearchTree* tree, const bool should_free_data)
 {
     if (!node)
     {
         return;
     }
 
-    anv_bst_node_destroy_recursive(node->left, alloc, should_free_data);
-    anv_bst_node_destroy_recursive(node->right, alloc, should_free_data);
+    anv_bst_node_destroy_recursive(node->left, tree, should_free_data);
+    anv_bst_node_destroy_recursive(node->right, tree, should_free_data);
 
     if (should_free_data && node->data)
     {
-        anv_alloc_data_deallocate(alloc, node->data);
+        anv_alloc_data_deallocate(&tree->alloc, node->data);
     }
 
-    anv_alloc_deallocate(alloc, node);
+    anv_slab_pool_deallocate(tree->node_pool, &tree->alloc, node);
 }
 
 static size_t anv_bst_node_height(const ANVBinarySearchTreeNode* node)
@@ -144,7 +144,7 @@ static void anv_bst_node_remove_with_parent(ANVBinarySearchTree* tree, ANVBinary
         anv_alloc_data_deallocate(&tree->alloc, node->data);
     }
 
-    anv_alloc_deallocate(&tree->alloc, node);
+    anv_slab_pool_deallocate(tree->node_pool, &tree->alloc, node);
 }
 
 static void anv_bst_node_inorder(const ANVBinarySearchTreeNode* node, const anv_action_func action)
@@ -209,6 +209,7 @@ ANV_API ANVBinarySearchTree* anv_bst_create(ANVAllocator* alloc, const anv_compa
     tree->size = 0;
     tree->compare = compare;
     tree->alloc = *alloc;
+    tree->node_pool = anv_slab_pool_create(alloc, sizeof(ANVBinarySearchTreeNode));
 
     return tree;
 }
@@ -220,7 +221,8 @@ ANV_API void anv_bst_destroy(ANVBinarySearchTree* tree, const bool should_free_d
         return;
     }
 
-    anv_bst_node_destroy_recursive(tree->root, &tree->alloc, should_free_data);
+    anv_bst_node_destroy_recursive(tree->root, tree, should_free_data);
+    anv_slab_pool_destroy(&tree->alloc, tree->node_pool);
     anv_alloc_deallocate(&tree->alloc, tree);
 }
 
@@ -231,7 +233,7 @@ ANV_API void anv_bst_clear(ANVBinarySearchTree* tree, const bool should_free_dat
         return;
     }
 
-    anv_bst_node_destroy_recursive(tree->root, &tree->alloc, should_free_data);
+    anv_bst_node_destroy_recursive(tree->root, tree, should_free_data);
     tree->root = NULL;
     tree->size = 0;
 }
@@ -313,7 +315,7 @@ ANV_API int anv_bst_insert(ANVBinarySearchTree* tree, void* data)
 
     if (!tree->root)
     {
-        tree->root = anv_bst_node_create(&tree->alloc, data);
+        tree->root = anv_bst_node_create(tree, data);
         if (!tree->root)
         {
             return -1;
@@ -345,7 +347,7 @@ ANV_API int anv_bst_insert(ANVBinarySearchTree* tree, void* data)
         }
     }
 
-    ANVBinarySearchTreeNode* new_node = anv_bst_node_create(&tree->alloc, data);
+    ANVBinarySearchTreeNode* new_node = anv_bst_node_create(tree, data);
     if (!new_node || !parent)
     {
         return -1;
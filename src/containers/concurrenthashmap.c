@@ -0,0 +1,838 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "concurrenthashmap.h"
+#include "anvil/system/mutex.h"
+
+static_assert((ANV_CHM_SEGMENTS & (ANV_CHM_SEGMENTS - 1)) == 0, "ANV_CHM_SEGMENTS must be a power of two");
+
+//==============================================================================
+// Internal types
+//==============================================================================
+
+#define MIN_SEGMENT_BUCKETS ((size_t)4)
+
+// What a retired object is, and which user data goes with it
+enum
+{
+    RETIRE_NODE,  // Unlinked node
+    RETIRE_TABLE, // Replaced bucket array, along with the nodes still chained in it
+    RETIRE_VALUE  // Replaced value
+};
+
+#define RETIRE_FREE_KEY   0x1u
+#define RETIRE_FREE_VALUE 0x2u
+
+// Header of everything waiting for readers to drain
+typedef struct Retired
+{
+    struct Retired* next;
+    uint8_t kind;
+    uint8_t flags;
+} Retired;
+
+typedef struct CHMNode
+{
+    Retired retired;              // Used once the node is unlinked
+    void* key;                    // Pointer to key data
+    _Atomic(void*) value;         // Pointer to value data, replaced in place by put
+    uint64_t hash;                // Mixed hash of key
+    _Atomic(struct CHMNode*) next; // Next node in chain
+} CHMNode;
+
+typedef struct CHMTable
+{
+    Retired retired;                // Used once the table is replaced
+    size_t bucket_count;            // Power of two
+    _Atomic(CHMNode*) buckets[];    // Chain heads
+} CHMTable;
+
+typedef struct RetiredValue
+{
+    Retired retired;
+    void* value;
+} RetiredValue;
+
+typedef struct Segment
+{
+    _Alignas(64) ANVMutex lock;     // Serializes writers of this segment
+    _Atomic(CHMTable*) table;       // Current bucket array
+    atomic_size_t size;             // Entries in this segment
+} Segment;
+
+/**
+ * Readers currently inside a read-side section, split by the parity of the
+ * epoch they entered under. Aligned so threads on different stripes never
+ * share a cache line.
+ */
+typedef struct ReaderStripe
+{
+    _Alignas(64) atomic_size_t active[2];
+} ReaderStripe;
+
+struct ANVConcurrentHashMap
+{
+    anv_hash_func hash;             // Hash function for keys
+    key_equals_func key_equals;     // Key equality function
+    ANVAllocator alloc;             // Thread-safe allocator
+    _Alignas(64) atomic_size_t epoch; // Reclamation epoch
+    ANVMutex reclaim_lock;          // Guards the retire lists
+    Retired* current;               // Retired during the current epoch
+    Retired* waiting;               // Retired during the previous epoch
+    size_t current_count;           // Length of current
+    ReaderStripe readers[ANV_CHM_READER_STRIPES];
+    Segment segments[ANV_CHM_SEGMENTS];
+};
+
+// Read-side section handle: which counter was bumped
+typedef struct ReadGuard
+{
+    size_t stripe;
+    size_t epoch;
+} ReadGuard;
+
+static atomic_uint next_reader_stripe;
+static ANV_THREAD_LOCAL unsigned reader_stripe; // Stripe index + 1, 0 until first use
+
+//==============================================================================
+// Epoch-based reclamation
+//==============================================================================
+
+/*
+ * Readers increment the counter for the current epoch's parity and then
+ * re-check the epoch, so a reader either is seen by a writer checking that
+ * counter or sees the writer's new epoch and retries. Objects retired
+ * during epoch e - 1 are freed when advancing from e to e + 1, which is only
+ * allowed once no reader from epoch e - 1 remains. All operations here are
+ * sequentially consistent, which this argument relies on.
+ */
+static ReadGuard read_begin(ANVConcurrentHashMap* map)
+{
+    if (reader_stripe == 0)
+    {
+        const unsigned stripe = atomic_fetch_add_explicit(&next_reader_stripe, 1, memory_order_relaxed);
+        reader_stripe = stripe % ANV_CHM_READER_STRIPES + 1;
+    }
+
+    ReadGuard guard;
+    guard.stripe = reader_stripe - 1;
+    for (;;)
+    {
+        guard.epoch = atomic_load(&map->epoch);
+        atomic_fetch_add(&map->readers[guard.stripe].active[guard.epoch & 1], 1);
+        if (atomic_load(&map->epoch) == guard.epoch)
+        {
+            return guard;
+        }
+        atomic_fetch_sub(&map->readers[guard.stripe].active[guard.epoch & 1], 1);
+    }
+}
+
+static void read_end(ANVConcurrentHashMap* map, const ReadGuard guard)
+{
+    atomic_fetch_sub(&map->readers[guard.stripe].active[guard.epoch & 1], 1);
+}
+
+static void free_chain(const ANVConcurrentHashMap* map, CHMNode* node, const bool should_free_keys,
+                       const bool should_free_values)
+{
+    while (node)
+    {
+        CHMNode* next = atomic_load_explicit(&node->next, memory_order_relaxed);
+        void* value = atomic_load_explicit(&node->value, memory_order_relaxed);
+        if (should_free_keys && node->key)
+        {
+            anv_alloc_data_deallocate(&map->alloc, node->key);
+        }
+        if (should_free_values && value)
+        {
+            anv_alloc_data_deallocate(&map->alloc, value);
+        }
+        anv_alloc_deallocate(&map->alloc, node);
+        node = next;
+    }
+}
+
+static void free_retired(const ANVConcurrentHashMap* map, Retired* item)
+{
+    while (item)
+    {
+        Retired* next = item->next;
+        if (item->kind == RETIRE_NODE)
+        {
+            CHMNode* node = (CHMNode*)item;
+            atomic_store_explicit(&node->next, NULL, memory_order_relaxed);
+            free_chain(map, node, item->flags & RETIRE_FREE_KEY, item->flags & RETIRE_FREE_VALUE);
+        }
+        else if (item->kind == RETIRE_TABLE)
+        {
+            // The nodes were copied into the new table; only the old copies go
+            CHMTable* table = (CHMTable*)item;
+            for (size_t i = 0; i < table->bucket_count; i++)
+            {
+                free_chain(map, atomic_load_explicit(&table->buckets[i], memory_order_relaxed), false, false);
+            }
+            anv_alloc_deallocate(&map->alloc, table);
+        }
+        else
+        {
+            RetiredValue* retired = (RetiredValue*)item;
+            anv_alloc_data_deallocate(&map->alloc, retired->value);
+            anv_alloc_deallocate(&map->alloc, retired);
+        }
+        item = next;
+    }
+}
+
+/**
+ * Advance the epoch if no reader from the previous one remains, freeing
+ * what was retired during it. Never waits. Call with reclaim_lock held.
+ */
+static void try_advance(ANVConcurrentHashMap* map)
+{
+    const size_t epoch = atomic_load(&map->epoch);
+    const size_t previous = (epoch - 1) & 1;
+    for (size_t i = 0; i < ANV_CHM_READER_STRIPES; i++)
+    {
+        if (atomic_load(&map->readers[i].active[previous]) != 0)
+        {
+            return;
+        }
+    }
+
+    free_retired(map, map->waiting);
+    map->waiting = map->current;
+    map->current = NULL;
+    map->current_count = 0;
+    atomic_store(&map->epoch, epoch + 1);
+}
+
+/**
+ * Hand an unlinked object over for freeing once readers are done with it.
+ * Call without holding a segment lock.
+ */
+static void retire(ANVConcurrentHashMap* map, Retired* item, const uint8_t kind, const uint8_t flags)
+{
+    item->kind = kind;
+    item->flags = flags;
+
+    anv_mutex_lock(&map->reclaim_lock);
+    item->next = map->current;
+    map->current = item;
+    if (++map->current_count >= ANV_CHM_RECLAIM_BATCH)
+    {
+        try_advance(map);
+    }
+    anv_mutex_unlock(&map->reclaim_lock);
+}
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+static uint64_t hash_key(const ANVConcurrentHashMap* map, const void* key)
+{
+    return anv_hash_mix64((uint64_t)map->hash(key));
+}
+
+// High bits pick the segment, low bits the bucket, so the two stay independent
+static Segment* segment_for(ANVConcurrentHashMap* map, const uint64_t hash)
+{
+    return &map->segments[(size_t)(hash >> 32) & (ANV_CHM_SEGMENTS - 1)];
+}
+
+static _Atomic(CHMNode*)* bucket_for(CHMTable* table, const uint64_t hash)
+{
+    return &table->buckets[(size_t)hash & (table->bucket_count - 1)];
+}
+
+static CHMTable* allocate_table(const ANVConcurrentHashMap* map, const size_t bucket_count)
+{
+    CHMTable* table = anv_alloc_allocate(&map->alloc, sizeof(CHMTable) + bucket_count * sizeof(_Atomic(CHMNode*)));
+    if (!table)
+    {
+        return NULL;
+    }
+
+    table->bucket_count = bucket_count;
+    for (size_t i = 0; i < bucket_count; i++)
+    {
+        atomic_init(&table->buckets[i], NULL);
+    }
+    return table;
+}
+
+// Safe for readers and for writers holding the segment lock
+static CHMNode* find_node(const ANVConcurrentHashMap* map, CHMTable* table, const void* key, const uint64_t hash)
+{
+    CHMNode* node = atomic_load_explicit(bucket_for(table, hash), memory_order_acquire);
+    while (node)
+    {
+        if (node->hash == hash && map->key_equals(node->key, key))
+        {
+            return node;
+        }
+        node = atomic_load_explicit(&node->next, memory_order_acquire);
+    }
+    return NULL;
+}
+
+static CHMNode* create_node(const ANVConcurrentHashMap* map, void* key, void* value, const uint64_t hash)
+{
+    CHMNode* node = anv_alloc_allocate(&map->alloc, sizeof(CHMNode));
+    if (!node)
+    {
+        return NULL;
+    }
+
+    node->key = key;
+    atomic_init(&node->value, value);
+    node->hash = hash;
+    atomic_init(&node->next, NULL);
+    return node;
+}
+
+/**
+ * Publish a new node at the head of its chain. Readers see either the old
+ * head or the fully initialized node. Call with the segment lock held.
+ */
+static void link_node(CHMTable* table, CHMNode* node)
+{
+    _Atomic(CHMNode*)* bucket = bucket_for(table, node->hash);
+    atomic_store_explicit(&node->next, atomic_load_explicit(bucket, memory_order_relaxed), memory_order_relaxed);
+    atomic_store_explicit(bucket, node, memory_order_release);
+}
+
+/**
+ * Double a segment's table. Readers may still be walking the old chains, so
+ * the nodes are copied rather than relinked, and the old table is retired.
+ * Call with the segment lock held. Returns the table to retire, or NULL.
+ */
+static CHMTable* grow_segment(ANVConcurrentHashMap* map, Segment* segment)
+{
+    CHMTable* old_table = atomic_load_explicit(&segment->table, memory_order_relaxed);
+    if (old_table->bucket_count > SIZE_MAX / 2)
+    {
+        return NULL;
+    }
+
+    CHMTable* new_table = allocate_table(map, old_table->bucket_count * 2);
+    if (!new_table)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < old_table->bucket_count; i++)
+    {
+        for (CHMNode* node = atomic_load_explicit(&old_table->buckets[i], memory_order_relaxed); node;
+             node = atomic_load_explicit(&node->next, memory_order_relaxed))
+        {
+            CHMNode* copy = create_node(map, node->key,
+                                        atomic_load_explicit(&node->value, memory_order_relaxed), node->hash);
+            if (!copy)
+            {
+                // Growing is an optimization; keep the old table
+                for (size_t j = 0; j < new_table->bucket_count; j++)
+                {
+                    free_chain(map, atomic_load_explicit(&new_table->buckets[j], memory_order_relaxed), false, false);
+                }
+                anv_alloc_deallocate(&map->alloc, new_table);
+                return NULL;
+            }
+            link_node(new_table, copy);
+        }
+    }
+
+    atomic_store_explicit(&segment->table, new_table, memory_order_release);
+    return old_table;
+}
+
+/**
+ * Insert a key known to be absent from the segment. Call with the segment
+ * lock held; *retired_out receives a replaced table to retire after unlocking.
+ */
+static int insert_locked(ANVConcurrentHashMap* map, Segment* segment, void* key, void* value,
+                         const uint64_t hash, CHMTable** retired_out)
+{
+    CHMNode* node = create_node(map, key, value, hash);
+    if (!node)
+    {
+        return -1;
+    }
+
+    CHMTable* table = atomic_load_explicit(&segment->table, memory_order_relaxed);
+    link_node(table, node);
+
+    const size_t size = atomic_fetch_add_explicit(&segment->size, 1, memory_order_relaxed) + 1;
+    if (size > table->bucket_count - table->bucket_count / 4)
+    {
+        *retired_out = grow_segment(map, segment);
+    }
+    return 0;
+}
+
+static int put_entry(ANVConcurrentHashMap* map, void* key, void* value, const bool should_free_old_value)
+{
+    if (!map || !key)
+    {
+        return -1;
+    }
+
+    // Reserved up front so a failed allocation leaves the map untouched
+    RetiredValue* old_record = NULL;
+    if (should_free_old_value)
+    {
+        old_record = anv_alloc_allocate(&map->alloc, sizeof(RetiredValue));
+        if (!old_record)
+        {
+            return -1;
+        }
+    }
+
+    const uint64_t hash = hash_key(map, key);
+    Segment* segment = segment_for(map, hash);
+    CHMTable* retired_table = NULL;
+    void* old_value = NULL;
+    int result = 0;
+
+    anv_mutex_lock(&segment->lock);
+    CHMNode* node = find_node(map, atomic_load_explicit(&segment->table, memory_order_relaxed), key, hash);
+    if (node)
+    {
+        old_value = atomic_exchange_explicit(&node->value, value, memory_order_acq_rel);
+    }
+    else
+    {
+        result = insert_locked(map, segment, key, value, hash, &retired_table);
+    }
+    anv_mutex_unlock(&segment->lock);
+
+    if (retired_table)
+    {
+        retire(map, &retired_table->retired, RETIRE_TABLE, 0);
+    }
+    if (old_record && old_value)
+    {
+        old_record->value = old_value;
+        retire(map, &old_record->retired, RETIRE_VALUE, 0);
+    }
+    else
+    {
+        anv_alloc_deallocate(&map->alloc, old_record);
+    }
+    return result;
+}
+
+//==============================================================================
+// Creation and destruction functions
+//==============================================================================
+
+ANV_API ANVConcurrentHashMap* anv_chm_create(ANVAllocator* alloc, const anv_hash_func hash,
+                                             const key_equals_func key_equals, const size_t initial_capacity)
+{
+    if (!alloc || !hash || !key_equals)
+    {
+        return NULL;
+    }
+
+    ANVConcurrentHashMap* map = anv_alloc_allocate_aligned(alloc, sizeof(ANVConcurrentHashMap),
+                                                           _Alignof(ANVConcurrentHashMap));
+    if (!map)
+    {
+        return NULL;
+    }
+
+    memset(map, 0, sizeof(*map));
+    map->hash = hash;
+    map->key_equals = key_equals;
+    map->alloc = *alloc;
+    atomic_init(&map->epoch, 2);
+    anv_mutex_init(&map->reclaim_lock);
+
+    // Size each segment for its share of the expected entries at 3/4 load
+    const size_t per_segment = (initial_capacity / ANV_CHM_SEGMENTS) * 4 / 3 + 1;
+    size_t bucket_count = MIN_SEGMENT_BUCKETS;
+    while (bucket_count < per_segment && bucket_count <= SIZE_MAX / 2)
+    {
+        bucket_count *= 2;
+    }
+
+    for (size_t i = 0; i < ANV_CHM_SEGMENTS; i++)
+    {
+        Segment* segment = &map->segments[i];
+        CHMTable* table = allocate_table(map, bucket_count);
+        if (!table)
+        {
+            for (size_t j = 0; j < i; j++)
+            {
+                anv_alloc_deallocate(&map->alloc, atomic_load(&map->segments[j].table));
+                anv_mutex_destroy(&map->segments[j].lock);
+            }
+            anv_mutex_destroy(&map->reclaim_lock);
+            anv_alloc_deallocate_aligned(alloc, map);
+            return NULL;
+        }
+
+        anv_mutex_init(&segment->lock);
+        atomic_init(&segment->table, table);
+        atomic_init(&segment->size, 0);
+    }
+    return map;
+}
+
+ANV_API void anv_chm_destroy(ANVConcurrentHashMap* map, const bool should_free_keys, const bool should_free_values)
+{
+    if (!map)
+    {
+        return;
+    }
+
+    free_retired(map, map->waiting);
+    free_retired(map, map->current);
+
+    for (size_t i = 0; i < ANV_CHM_SEGMENTS; i++)
+    {
+        Segment* segment = &map->segments[i];
+        CHMTable* table = atomic_load(&segment->table);
+        for (size_t j = 0; j < table->bucket_count; j++)
+        {
+            free_chain(map, atomic_load(&table->buckets[j]), should_free_keys, should_free_values);
+        }
+        anv_alloc_deallocate(&map->alloc, table);
+        anv_mutex_destroy(&segment->lock);
+    }
+
+    anv_mutex_destroy(&map->reclaim_lock);
+    const ANVAllocator alloc = map->alloc;
+    anv_alloc_deallocate_aligned(&alloc, map);
+}
+
+//==============================================================================
+// Information functions
+//==============================================================================
+
+ANV_API size_t anv_chm_size(const ANVConcurrentHashMap* map)
+{
+    if (!map)
+    {
+        return 0;
+    }
+
+    size_t size = 0;
+    for (size_t i = 0; i < ANV_CHM_SEGMENTS; i++)
+    {
+        size += atomic_load_explicit(&map->segments[i].size, memory_order_relaxed);
+    }
+    return size;
+}
+
+ANV_API int anv_chm_contains_key(ANVConcurrentHashMap* map, const void* key)
+{
+    if (!map || !key)
+    {
+        return 0;
+    }
+
+    const uint64_t hash = hash_key(map, key);
+    const ReadGuard guard = read_begin(map);
+    CHMTable* table = atomic_load_explicit(&segment_for(map, hash)->table, memory_order_acquire);
+    const bool found = find_node(map, table, key, hash) != NULL;
+    read_end(map, guard);
+    return found;
+}
+
+//==============================================================================
+// Map operations
+//==============================================================================
+
+ANV_API void* anv_chm_get(ANVConcurrentHashMap* map, const void* key)
+{
+    if (!map || !key)
+    {
+        return NULL;
+    }
+
+    const uint64_t hash = hash_key(map, key);
+    const ReadGuard guard = read_begin(map);
+    CHMTable* table = atomic_load_explicit(&segment_for(map, hash)->table, memory_order_acquire);
+    const CHMNode* node = find_node(map, table, key, hash);
+    void* value = node ? atomic_load_explicit(&((CHMNode*)node)->value, memory_order_acquire) : NULL;
+    read_end(map, guard);
+    return value;
+}
+
+ANV_API int anv_chm_put(ANVConcurrentHashMap* map, void* key, void* value)
+{
+    return put_entry(map, key, value, false);
+}
+
+ANV_API int anv_chm_put_with_free(ANVConcurrentHashMap* map, void* key, void* value, const bool should_free_old_value)
+{
+    return put_entry(map, key, value, should_free_old_value);
+}
+
+ANV_API void* anv_chm_compute_if_absent(ANVConcurrentHashMap* map, void* key, const anv_chm_compute_func compute,
+                                        void* context, bool* inserted_out)
+{
+    if (inserted_out)
+    {
+        *inserted_out = false;
+    }
+    if (!map || !key || !compute)
+    {
+        return NULL;
+    }
+
+    // Common case: the key is already there and no lock is needed
+    void* existing = anv_chm_get(map, key);
+    if (existing)
+    {
+        return existing;
+    }
+
+    const uint64_t hash = hash_key(map, key);
+    Segment* segment = segment_for(map, hash);
+    CHMTable* retired_table = NULL;
+    void* value = NULL;
+
+    anv_mutex_lock(&segment->lock);
+    const CHMNode* node = find_node(map, atomic_load_explicit(&segment->table, memory_order_relaxed), key, hash);
+    if (node)
+    {
+        value = atomic_load_explicit(&((CHMNode*)node)->value, memory_order_relaxed);
+    }
+    else
+    {
+        value = compute(key, context);
+        if (value && insert_locked(map, segment, key, value, hash, &retired_table) != 0)
+        {
+            // Never published, so no reader can hold it and it need not be retired
+            anv_alloc_data_deallocate(&map->alloc, value);
+            value = NULL;
+        }
+        else if (value && inserted_out)
+        {
+            *inserted_out = true;
+        }
+    }
+    anv_mutex_unlock(&segment->lock);
+
+    if (retired_table)
+    {
+        retire(map, &retired_table->retired, RETIRE_TABLE, 0);
+    }
+    return value;
+}
+
+ANV_API int anv_chm_remove(ANVConcurrentHashMap* map, const void* key, const bool should_free_key,
+                           const bool should_free_value)
+{
+    if (!map || !key)
+    {
+        return -1;
+    }
+
+    const uint64_t hash = hash_key(map, key);
+    Segment* segment = segment_for(map, hash);
+    CHMNode* removed = NULL;
+
+    anv_mutex_lock(&segment->lock);
+    _Atomic(CHMNode*)* link = bucket_for(atomic_load_explicit(&segment->table, memory_order_relaxed), hash);
+    for (CHMNode* node = atomic_load_explicit(link, memory_order_relaxed); node;
+         node = atomic_load_explicit(link, memory_order_relaxed))
+    {
+        if (node->hash == hash && map->key_equals(node->key, key))
+        {
+            // Readers already on the node still see its next pointer
+            atomic_store_explicit(link, atomic_load_explicit(&node->next, memory_order_relaxed),
+                                  memory_order_release);
+            atomic_fetch_sub_explicit(&segment->size, 1, memory_order_relaxed);
+            removed = node;
+            break;
+        }
+        link = &node->next;
+    }
+    anv_mutex_unlock(&segment->lock);
+
+    if (!removed)
+    {
+        return -1;
+    }
+
+    const uint8_t flags = (uint8_t)((should_free_key ? RETIRE_FREE_KEY : 0) | (should_free_value ? RETIRE_FREE_VALUE : 0));
+    retire(map, &removed->retired, RETIRE_NODE, flags);
+    return 0;
+}
+
+//==============================================================================
+// Iterator implementation
+//==============================================================================
+
+typedef struct CHMIteratorState
+{
+    ANVConcurrentHashMap* map;
+    ReadGuard guard;        // Held for the iterator's lifetime
+    size_t segment;         // Segment being walked
+    CHMTable* table;        // That segment's table when the walk reached it
+    size_t bucket;          // Bucket being walked
+    CHMNode* node;          // Current node, NULL at the end
+    ANVPair current_pair;
+} CHMIteratorState;
+
+// Move to the first node at or after the state's bucket, crossing segments
+static void chm_iterator_settle(CHMIteratorState* state)
+{
+    while (!state->node)
+    {
+        if (state->bucket >= state->table->bucket_count)
+        {
+            if (++state->segment >= ANV_CHM_SEGMENTS)
+            {
+                return;
+            }
+            state->table = atomic_load_explicit(&state->map->segments[state->segment].table, memory_order_acquire);
+            state->bucket = 0;
+            continue;
+        }
+        state->node = atomic_load_explicit(&state->table->buckets[state->bucket++], memory_order_acquire);
+    }
+}
+
+static void chm_iterator_start(CHMIteratorState* state)
+{
+    state->segment = 0;
+    state->table = atomic_load_explicit(&state->map->segments[0].table, memory_order_acquire);
+    state->bucket = 0;
+    state->node = NULL;
+    chm_iterator_settle(state);
+}
+
+static void* chm_iterator_get(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return NULL;
+    }
+
+    CHMIteratorState* state = it->data_state;
+    if (!state->node)
+    {
+        return NULL;
+    }
+
+    state->current_pair = (ANVPair)
+    {
+        .first = state->node->key,
+        .second = atomic_load_explicit(&state->node->value, memory_order_acquire),
+        .alloc = state->map->alloc
+    };
+
+    return &state->current_pair;
+}
+
+static int chm_iterator_has_next(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return 0;
+    }
+
+    const CHMIteratorState* state = it->data_state;
+    return state->node != NULL;
+}
+
+static int chm_iterator_next(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return -1;
+    }
+
+    CHMIteratorState* state = it->data_state;
+    if (!state->node)
+    {
+        return -1;
+    }
+
+    state->node = atomic_load_explicit(&state->node->next, memory_order_acquire);
+    chm_iterator_settle(state);
+    return 0;
+}
+
+static int chm_iterator_has_prev(const ANVIterator* it)
+{
+    (void)it;
+    return 0;
+}
+
+static int chm_iterator_prev(const ANVIterator* it)
+{
+    (void)it;
+    return -1;
+}
+
+static void chm_iterator_reset(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return;
+    }
+
+    chm_iterator_start(it->data_state);
+}
+
+static int chm_iterator_is_valid(const ANVIterator* it)
+{
+    return it && it->data_state != NULL;
+}
+
+static void chm_iterator_destroy(ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return;
+    }
+
+    CHMIteratorState* state = it->data_state;
+    read_end(state->map, state->guard);
+    anv_alloc_deallocate(&state->map->alloc, state);
+    it->data_state = NULL;
+}
+
+ANV_API ANVIterator anv_chm_iterator(ANVConcurrentHashMap* map)
+{
+    ANVIterator it = {0};
+
+    it.get = chm_iterator_get;
+    it.has_next = chm_iterator_has_next;
+    it.next = chm_iterator_next;
+    it.has_prev = chm_iterator_has_prev;
+    it.prev = chm_iterator_prev;
+    it.reset = chm_iterator_reset;
+    it.is_valid = chm_iterator_is_valid;
+    it.destroy = chm_iterator_destroy;
+
+    if (!map)
+    {
+        return it;
+    }
+
+    CHMIteratorState* state = anv_alloc_allocate(&map->alloc, sizeof(CHMIteratorState));
+    if (!state)
+    {
+        return it;
+    }
+
+    state->map = map;
+    state->guard = read_begin(map);
+    chm_iterator_start(state);
+
+    it.alloc = map->alloc;
+    it.data_state = state;
+    return it;
+}
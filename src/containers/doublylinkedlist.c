@@ -113,6 +113,58 @@ static ANVDoublyLinkedNode* anv_dll_merge_sort(ANVDoublyLinkedNode* head, const
     return anv_dll_sort_helper_merge(left_sorted, right_sorted, compare);
 }
 
+// Nodes linked into dest must come from dest's pool, so when either list
+// pools its nodes they are copied over instead of being relinked
+static int adopt_nodes(ANVDoublyLinkedList* dest, ANVDoublyLinkedList* src)
+{
+    if (!dest->node_pool && !src->node_pool)
+    {
+        return 0;
+    }
+
+    ANVDoublyLinkedNode* head = NULL;
+    ANVDoublyLinkedNode* tail = NULL;
+    for (const ANVDoublyLinkedNode* node = src->head; node; node = node->next)
+    {
+        ANVDoublyLinkedNode* copy = anv_slab_pool_allocate(dest->node_pool, &dest->alloc, sizeof(ANVDoublyLinkedNode));
+        if (!copy)
+        {
+            while (head)
+            {
+                ANVDoublyLinkedNode* next = head->next;
+                anv_slab_pool_deallocate(dest->node_pool, &dest->alloc, head);
+                head = next;
+            }
+            return -1;
+        }
+
+        copy->data = node->data;
+        copy->next = NULL;
+        copy->prev = tail;
+        if (tail)
+        {
+            tail->next = copy;
+        }
+        else
+        {
+            head = copy;
+        }
+        tail = copy;
+    }
+
+    ANVDoublyLinkedNode* node = src->head;
+    while (node)
+    {
+        ANVDoublyLinkedNode* next = node->next;
+        anv_slab_pool_deallocate(src->node_pool, &src->alloc, node);
+        node = next;
+    }
+
+    src->head = head;
+    src->tail = tail;
+    return 0;
+}
+
 //==============================================================================
 // Creation and destruction functions
 //==============================================================================
@@ -134,6 +186,7 @@ ANV_API ANVDoublyLinkedList* anv_dll_create(ANVAllocator* alloc)
     list->tail = NULL;
     list->size = 0;
     list->alloc = *alloc;
+    list->node_pool = anv_slab_pool_create(alloc, sizeof(ANVDoublyLinkedNode));
 
     return list;
 }
@@ -143,6 +196,7 @@ ANV_API void anv_dll_destroy(ANVDoublyLinkedList* list, const bool should_free_d
     if (list)
     {
         anv_dll_clear(list, should_free_data);
+        anv_slab_pool_destroy(&list->alloc, list->node_pool);
         anv_alloc_deallocate(&list->alloc, list);
     }
 }
@@ -163,7 +217,7 @@ ANV_API void anv_dll_clear(ANVDoublyLinkedList* list, const bool should_free_dat
             anv_alloc_data_deallocate(&list->alloc, node->data);
         }
 
-        anv_alloc_deallocate(&list->alloc, node);
+        anv_slab_pool_deallocate(list->node_pool, &list->alloc, node);
         node = next;
     }
 
@@ -257,7 +311,7 @@ ANV_API int anv_dll_push_front(ANVDoublyLinkedList* list, void* data)
         return -1;
     }
 
-    ANVDoublyLinkedNode* node = anv_alloc_allocate(&list->alloc, sizeof(ANVDoublyLinkedNode));
+    ANVDoublyLinkedNode* node = anv_slab_pool_allocate(list->node_pool, &list->alloc, sizeof(ANVDoublyLinkedNode));
     if (!node)
     {
         return -1;
@@ -289,7 +343,7 @@ ANV_API int anv_dll_push_back(ANVDoublyLinkedList* list, void* data)
         return -1;
     }
 
-    ANVDoublyLinkedNode* node = anv_alloc_allocate(&list->alloc, sizeof(ANVDoublyLinkedNode));
+    ANVDoublyLinkedNode* node = anv_slab_pool_allocate(list->node_pool, &list->alloc, sizeof(ANVDoublyLinkedNode));
     if (!node)
     {
         return -1;
@@ -331,7 +385,7 @@ ANV_API int anv_dll_insert_at(ANVDoublyLinkedList* list, const size_t pos, void*
         return anv_dll_push_back(list, data);
     }
 
-    ANVDoublyLinkedNode* node = anv_alloc_allocate(&list->alloc, sizeof(ANVDoublyLinkedNode));
+    ANVDoublyLinkedNode* node = anv_slab_pool_allocate(list->node_pool, &list->alloc, sizeof(ANVDoublyLinkedNode));
     if (!node)
     {
         return -1;
@@ -410,7 +464,7 @@ ANV_API int anv_dll_remove(ANVDoublyLinkedList* list, const void* data, const an
             {
                 anv_alloc_data_deallocate(&list->alloc, curr->data);
             }
-            anv_alloc_deallocate(&list->alloc, curr);
+            anv_slab_pool_deallocate(list->node_pool, &list->alloc, curr);
             list->size--;
 
             return 0;
@@ -465,7 +519,7 @@ ANV_API int anv_dll_remove_at(ANVDoublyLinkedList* list, const size_t pos, const
     {
         anv_alloc_data_deallocate(&list->alloc, node_to_remove->data);
     }
-    anv_alloc_deallocate(&list->alloc, node_to_remove);
+    anv_slab_pool_deallocate(list->node_pool, &list->alloc, node_to_remove);
     list->size--;
 
     return 0;
@@ -495,7 +549,7 @@ ANV_API int anv_dll_pop_front(ANVDoublyLinkedList* list, const bool should_free_
         anv_alloc_data_deallocate(&list->alloc, node_to_remove->data);
     }
 
-    anv_alloc_deallocate(&list->alloc, node_to_remove);
+    anv_slab_pool_deallocate(list->node_pool, &list->alloc, node_to_remove);
     list->size--;
 
     return 0;
@@ -525,7 +579,7 @@ ANV_API int anv_dll_pop_back(ANVDoublyLinkedList* list, const bool should_free_d
         anv_alloc_data_deallocate(&list->alloc, node_to_remove->data);
     }
 
-    anv_alloc_deallocate(&list->alloc, node_to_remove);
+    anv_slab_pool_deallocate(list->node_pool, &list->alloc, node_to_remove);
     list->size--;
     return 0;
 }
@@ -596,6 +650,11 @@ ANV_API int anv_dll_merge(ANVDoublyLinkedList* dest, ANVDoublyLinkedList* src)
         return 0;
     }
 
+    if (adopt_nodes(dest, src) != 0)
+    {
+        return -1;
+    }
+
     if (dest->size == 0)
     {
         dest->head = src->head;
@@ -631,6 +690,11 @@ ANV_API int anv_dll_splice(ANVDoublyLinkedList* dest, ANVDoublyLinkedList* src,
         return 0;
     }
 
+    if (adopt_nodes(dest, src) != 0)
+    {
+        return -1;
+    }
+
     if (pos == 0)
     {
         if (dest->size == 0)
@@ -8,16 +8,7 @@
 #include <string.h>
 
 #include "dynamicstring.h"
-
-#define SAFE_FREE(ptr)    \
-    do                    \
-    {                     \
-        if ((ptr))        \
-        {                 \
-            free((ptr));  \
-            (ptr) = NULL; \
-        }                 \
-    } while (0)
+#include "anvil/memory/scratch.h"
 
 #define GROW_CAPACITY(cap) ((cap) + ((cap) >> 1))
 
@@ -31,42 +22,48 @@ static char* mem_calloc(const size_t num_elements)
 
 static bool anv_str_realloc(ANVString* str, const size_t new_capacity)
 {
-    const char* old_data = STR_DATA(str);
     const size_t copy_size = str->size;
 
     if (new_capacity <= STR_MIN_INIT_CAP)
     {
-        char* temp = calloc(copy_size + 1, sizeof(char));
-        if (!temp && copy_size > 0)
+        if (str->capacity == STR_MIN_INIT_CAP)
         {
-            return false;
+            return true;
         }
 
-        memcpy(temp, old_data, copy_size);
-        SAFE_FREE(str->data);
-
+        // The inline buffer shares storage with the data pointer, so save it first
+        char* heap_data = str->data;
         ZERO_MEM(str->small_data, STR_MIN_INIT_CAP);
-        memcpy(str->small_data, temp, copy_size);
+        memcpy(str->small_data, heap_data, copy_size);
+        free(heap_data);
         str->capacity = STR_MIN_INIT_CAP;
-        free(temp);
+        return true;
     }
-    else
+
+    char* new_data;
+    if (str->capacity == STR_MIN_INIT_CAP)
     {
-        char* new_data = mem_calloc(new_capacity);
+        new_data = malloc(new_capacity);
         if (!new_data)
         {
             return false;
         }
-
-        memcpy(new_data, old_data, copy_size);
-        if (str->capacity > STR_MIN_INIT_CAP && str->data)
+        memcpy(new_data, str->small_data, copy_size);
+    }
+    else
+    {
+        // realloc can extend the block in place, or remap it for large buffers
+        new_data = realloc(str->data, new_capacity);
+        if (!new_data)
         {
-            SAFE_FREE(str->data);
+            return false;
         }
-
-        str->data = new_data;
-        str->capacity = new_capacity;
     }
+
+    // Everything past the contents must read as zero to keep the string terminated
+    ZERO_MEM(new_data + copy_size, new_capacity - copy_size);
+    str->data = new_data;
+    str->capacity = new_capacity;
     return true;
 }
 
@@ -230,7 +227,7 @@ ANV_API void anv_str_push_back(ANVString* str, const char value)
         return;
     }
 
-    anv_str_ensure_capacity(str, str->size + 1);
+    anv_str_ensure_capacity(str, str->size + 2);
 
     if (str->capacity == STR_MIN_INIT_CAP)
     {
@@ -742,57 +739,68 @@ ANV_API char* anv_str_substr_string(const ANVString* str, const size_t pos, cons
 
 ANV_API size_t anv_str_split_cstring(const char* str, const char* delim, ANVString** out)
 {
-    if (!str || !delim)
+    if (!out)
     {
         return 0;
     }
 
-    const size_t str_size = strlen(str);
-    if (str_size == 0)
+    // Every early return below leaves the caller with no array to free
+    *out = NULL;
+    if (!str || !delim)
     {
         return 0;
     }
 
-    ANVString *parts = malloc(sizeof(ANVString));
-    if (!parts)
+    const size_t str_size = strlen(str);
+    if (str_size == 0)
     {
         return 0;
     }
 
-    char *buffer = mem_calloc(str_size + 1);
-    if (!buffer)
+    // Tokenize a scratch copy, then allocate the result array once
+    ANVScratchFrame frame = anv_scratch_begin();
+    char *buffer = anv_scratch_allocate(&frame, str_size + 1);
+    const char **tokens = anv_scratch_allocate(&frame, sizeof(char*) * (str_size / 2 + 1));
+    if (!buffer || !tokens)
     {
-        free(parts);
+        anv_scratch_end(&frame);
         return 0;
     }
 
-    memcpy(buffer, str, str_size);
+    memcpy(buffer, str, str_size + 1);
     size_t num_strings = 0;
     const char* token = strtok(buffer, delim);
     while (token != NULL)
     {
-        ANVString* temp = realloc(parts, sizeof(ANVString) * (num_strings + 1));
-        if (!temp)
-        {
-            free(parts);
-            return 0;
-        }
-
-        parts = temp;
-        parts[num_strings] = anv_str_create_from_cstring(token);
-        num_strings++;
+        tokens[num_strings++] = token;
         token = strtok(NULL, delim);
     }
+
+    ANVString *parts = num_strings > 0 ? malloc(sizeof(ANVString) * num_strings) : NULL;
+    if (!parts)
+    {
+        anv_scratch_end(&frame);
+        return 0;
+    }
+
+    for (size_t i = 0; i < num_strings; i++)
+    {
+        parts[i] = anv_str_create_from_cstring(tokens[i]);
+    }
     *out = parts;
-    free(buffer);
+    anv_scratch_end(&frame);
 
     return num_strings;
 }
 
 ANV_API size_t anv_str_split(const ANVString* str, const char* delim, ANVString** out)
 {
-    if (!str || !delim)
+    if (!str)
     {
+        if (out)
+        {
+            *out = NULL;
+        }
         return 0;
     }
 
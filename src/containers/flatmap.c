@@ -0,0 +1,991 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include <stdint.h>
+#include <string.h>
+
+#include "flatmap.h"
+
+// Define ANV_FLATMAP_NO_SSE2 to use the portable 8-byte groups even where SSE2 exists
+#if !defined(ANV_FLATMAP_NO_SSE2) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define FLATMAP_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+//==============================================================================
+// Control bytes and groups
+//==============================================================================
+
+#define DEFAULT_CAPACITY ANV_DEFAULT_CAPACITY
+#define NOT_FOUND SIZE_MAX
+
+// Full slots hold the low 7 bits of their hash (0..127); special bytes are negative
+#define CTRL_EMPTY   ((int8_t)-128)
+#define CTRL_DELETED ((int8_t)-2)
+
+// A group mask has one bit per matching control byte; MASK_SHIFT turns a bit index into a byte index
+#ifdef FLATMAP_SSE2
+    #define GROUP_WIDTH 16
+    #define MASK_SHIFT 0
+#else
+    #define GROUP_WIDTH 8
+    #define MASK_SHIFT 3
+    #define LSBS 0x0101010101010101ull
+    #define MSBS 0x8080808080808080ull
+#endif
+
+typedef uint64_t GroupMask;
+
+static int lowest_bit(const GroupMask mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#else
+    int bit = 0;
+    while (!(mask & ((GroupMask)1 << bit)))
+    {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+static int highest_bit(const GroupMask mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(mask);
+#else
+    int bit = 63;
+    while (!(mask & ((GroupMask)1 << bit)))
+    {
+        bit--;
+    }
+    return bit;
+#endif
+}
+
+#ifdef FLATMAP_SSE2
+static __m128i load_group(const int8_t* ctrl)
+{
+    return _mm_loadu_si128((const __m128i*)ctrl);
+}
+
+static GroupMask match_tag(const int8_t* ctrl, const int8_t tag)
+{
+    return (GroupMask)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), load_group(ctrl)));
+}
+
+static GroupMask match_empty(const int8_t* ctrl)
+{
+    return match_tag(ctrl, CTRL_EMPTY);
+}
+
+static GroupMask match_empty_or_deleted(const int8_t* ctrl)
+{
+    // Both special bytes have the sign bit set
+    return (GroupMask)_mm_movemask_epi8(load_group(ctrl));
+}
+#else
+static uint64_t load_group(const int8_t* ctrl)
+{
+    uint64_t word;
+    memcpy(&word, ctrl, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+// May report a false match in the byte after a real one; key_equals filters those out
+static GroupMask match_tag(const int8_t* ctrl, const int8_t tag)
+{
+    const uint64_t x = load_group(ctrl) ^ (LSBS * (uint8_t)tag);
+    return (x - LSBS) & ~x & MSBS;
+}
+
+static GroupMask match_empty(const int8_t* ctrl)
+{
+    // Empty is the only byte with bit 7 set and bit 1 clear
+    const uint64_t word = load_group(ctrl);
+    return word & ~(word << 6) & MSBS;
+}
+
+static GroupMask match_empty_or_deleted(const int8_t* ctrl)
+{
+    // Empty and deleted are the only bytes with bit 7 set and bit 0 clear
+    const uint64_t word = load_group(ctrl);
+    return word & ~(word << 7) & MSBS;
+}
+#endif
+
+static size_t lowest_index(const GroupMask mask)
+{
+    return (size_t)lowest_bit(mask) >> MASK_SHIFT;
+}
+
+static size_t highest_index(const GroupMask mask)
+{
+    return (size_t)highest_bit(mask) >> MASK_SHIFT;
+}
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+static size_t hash_key(const ANVFlatMap* map, const void* key)
+{
+    // Remix so weak user hashes still spread over both the probe start and the tag
+    return (size_t)anv_hash_mix64((uint64_t)map->hash(key));
+}
+
+static size_t probe_start(const size_t hash)
+{
+    return hash >> 7;
+}
+
+static int8_t hash_tag(const size_t hash)
+{
+    return (int8_t)(hash & 0x7F);
+}
+
+static bool is_full(const int8_t ctrl)
+{
+    return ctrl >= 0;
+}
+
+// Entries a table of 'capacity' slots holds before it must grow (7/8 load)
+static size_t max_entries(const size_t capacity)
+{
+    return capacity - capacity / 8;
+}
+
+static size_t capacity_for(const size_t count)
+{
+    size_t capacity = GROUP_WIDTH;
+    while (max_entries(capacity) < count)
+    {
+        if (capacity > SIZE_MAX / 2)
+        {
+            return 0;
+        }
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static size_t ctrl_bytes(const size_t capacity)
+{
+    // Round up so the slot array that follows is pointer aligned
+    const size_t bytes = capacity + GROUP_WIDTH;
+    return (bytes + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+}
+
+static size_t table_bytes(const size_t capacity)
+{
+    return ctrl_bytes(capacity) + capacity * sizeof(ANVFlatMapSlot);
+}
+
+// The first GROUP_WIDTH bytes are mirrored past the end so any group load stays in bounds
+static void set_ctrl(const ANVFlatMap* map, const size_t index, const int8_t value)
+{
+    map->ctrl[index] = value;
+    if (index < GROUP_WIDTH)
+    {
+        map->ctrl[map->capacity + index] = value;
+    }
+}
+
+static int allocate_table(ANVFlatMap* map, const size_t capacity)
+{
+    if (capacity == 0 || capacity > (SIZE_MAX - ctrl_bytes(capacity)) / sizeof(ANVFlatMapSlot))
+    {
+        return -1;
+    }
+
+    int8_t* ctrl = anv_alloc_allocate(&map->alloc, table_bytes(capacity));
+    if (!ctrl)
+    {
+        return -1;
+    }
+
+    memset(ctrl, CTRL_EMPTY, capacity + GROUP_WIDTH);
+    map->ctrl = ctrl;
+    map->slots = (ANVFlatMapSlot*)(void*)((uint8_t*)ctrl + ctrl_bytes(capacity));
+    map->capacity = capacity;
+    map->growth_left = max_entries(capacity) - map->size;
+    return 0;
+}
+
+/**
+ * Find the slot holding key, or NOT_FOUND. Probing moves a whole group at a
+ * time with triangular steps, which visits every group of a power-of-two
+ * table, and stops at the first group containing an empty slot.
+ */
+static size_t find_slot(const ANVFlatMap* map, const void* key, const size_t hash)
+{
+    const size_t mask = map->capacity - 1;
+    const int8_t tag = hash_tag(hash);
+    size_t pos = probe_start(hash) & mask;
+
+    for (size_t step = GROUP_WIDTH;; step += GROUP_WIDTH)
+    {
+        const int8_t* group = map->ctrl + pos;
+        for (GroupMask match = match_tag(group, tag); match; match &= match - 1)
+        {
+            const size_t index = (pos + lowest_index(match)) & mask;
+            if (map->key_equals(map->slots[index].key, key))
+            {
+                return index;
+            }
+        }
+
+        if (match_empty(group))
+        {
+            return NOT_FOUND;
+        }
+        pos = (pos + step) & mask;
+    }
+}
+
+// First empty or deleted slot on the key's probe sequence; the load limit guarantees one exists
+static size_t find_insert_slot(const ANVFlatMap* map, const size_t hash)
+{
+    const size_t mask = map->capacity - 1;
+    size_t pos = probe_start(hash) & mask;
+
+    for (size_t step = GROUP_WIDTH;; step += GROUP_WIDTH)
+    {
+        const GroupMask free_slots = match_empty_or_deleted(map->ctrl + pos);
+        if (free_slots)
+        {
+            return (pos + lowest_index(free_slots)) & mask;
+        }
+        pos = (pos + step) & mask;
+    }
+}
+
+/**
+ * Move every entry into a fresh table of new_capacity slots, dropping
+ * tombstones. Entries are known to be distinct, so no keys are compared.
+ */
+static int rehash(ANVFlatMap* map, const size_t new_capacity)
+{
+    int8_t* old_ctrl = map->ctrl;
+    ANVFlatMapSlot* old_slots = map->slots;
+    const size_t old_capacity = map->capacity;
+
+    if (allocate_table(map, new_capacity) != 0)
+    {
+        return -1;
+    }
+
+    for (size_t i = 0; i < old_capacity; i++)
+    {
+        if (is_full(old_ctrl[i]))
+        {
+            const size_t hash = hash_key(map, old_slots[i].key);
+            const size_t index = find_insert_slot(map, hash);
+            set_ctrl(map, index, hash_tag(hash));
+            map->slots[index] = old_slots[i];
+        }
+    }
+
+    anv_alloc_deallocate(&map->alloc, old_ctrl);
+    return 0;
+}
+
+/**
+ * Make room for one more entry in an empty slot. A table clogged with
+ * tombstones is rebuilt at the same size instead of doubling.
+ */
+static int prepare_growth(ANVFlatMap* map)
+{
+    if (map->size + 1 <= max_entries(map->capacity) / 2)
+    {
+        return rehash(map, map->capacity);
+    }
+    if (map->capacity > SIZE_MAX / 2)
+    {
+        return -1;
+    }
+    return rehash(map, map->capacity * 2);
+}
+
+/**
+ * Insert key with the given hash, known to be absent.
+ */
+static int insert_new(ANVFlatMap* map, void* key, void* value, const size_t hash)
+{
+    size_t index = find_insert_slot(map, hash);
+    if (map->growth_left == 0 && map->ctrl[index] == CTRL_EMPTY)
+    {
+        if (prepare_growth(map) != 0)
+        {
+            return -1;
+        }
+        index = find_insert_slot(map, hash);
+    }
+
+    if (map->ctrl[index] == CTRL_EMPTY)
+    {
+        map->growth_left--;
+    }
+    set_ctrl(map, index, hash_tag(hash));
+    map->slots[index].key = key;
+    map->slots[index].value = value;
+    map->size++;
+    return 0;
+}
+
+/**
+ * Free a slot. It can go straight back to empty when no probe sequence can
+ * have passed over it: the empties around it leave no full window of
+ * GROUP_WIDTH slots that includes it.
+ */
+static void erase_slot(ANVFlatMap* map, const size_t index)
+{
+    const size_t mask = map->capacity - 1;
+    const GroupMask empty_after = match_empty(map->ctrl + index);
+    const GroupMask empty_before = match_empty(map->ctrl + ((index - GROUP_WIDTH) & mask));
+
+    const bool never_full = empty_after && empty_before &&
+                            lowest_index(empty_after) + (GROUP_WIDTH - 1 - highest_index(empty_before)) < GROUP_WIDTH;
+    if (never_full)
+    {
+        set_ctrl(map, index, CTRL_EMPTY);
+        map->growth_left++;
+    }
+    else
+    {
+        set_ctrl(map, index, CTRL_DELETED);
+    }
+    map->size--;
+}
+
+static void free_entries(const ANVFlatMap* map, const bool should_free_keys, const bool should_free_values)
+{
+    if (!should_free_keys && !should_free_values)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < map->capacity; i++)
+    {
+        if (!is_full(map->ctrl[i]))
+        {
+            continue;
+        }
+        if (should_free_keys && map->slots[i].key)
+        {
+            anv_alloc_data_deallocate(&map->alloc, map->slots[i].key);
+        }
+        if (should_free_values && map->slots[i].value)
+        {
+            anv_alloc_data_deallocate(&map->alloc, map->slots[i].value);
+        }
+    }
+}
+
+//==============================================================================
+// Creation and destruction functions
+//==============================================================================
+
+ANV_API ANVFlatMap* anv_flatmap_create(ANVAllocator* alloc, const anv_hash_func hash,
+                                       const key_equals_func key_equals, const size_t initial_capacity)
+{
+    if (!alloc || !hash || !key_equals)
+    {
+        return NULL;
+    }
+
+    ANVFlatMap* map = anv_alloc_allocate(alloc, sizeof(ANVFlatMap));
+    if (!map)
+    {
+        return NULL;
+    }
+
+    memset(map, 0, sizeof(ANVFlatMap));
+    map->hash = hash;
+    map->key_equals = key_equals;
+    map->alloc = *alloc;
+
+    if (allocate_table(map, capacity_for(initial_capacity > 0 ? initial_capacity : DEFAULT_CAPACITY)) != 0)
+    {
+        anv_alloc_deallocate(alloc, map);
+        return NULL;
+    }
+    return map;
+}
+
+ANV_API void anv_flatmap_destroy(ANVFlatMap* map, const bool should_free_keys, const bool should_free_values)
+{
+    if (!map)
+    {
+        return;
+    }
+
+    free_entries(map, should_free_keys, should_free_values);
+    anv_alloc_deallocate(&map->alloc, map->ctrl);
+    anv_alloc_deallocate(&map->alloc, map);
+}
+
+ANV_API void anv_flatmap_clear(ANVFlatMap* map, const bool should_free_keys, const bool should_free_values)
+{
+    if (!map)
+    {
+        return;
+    }
+
+    free_entries(map, should_free_keys, should_free_values);
+    memset(map->ctrl, CTRL_EMPTY, map->capacity + GROUP_WIDTH);
+    map->size = 0;
+    map->growth_left = max_entries(map->capacity);
+}
+
+ANV_API int anv_flatmap_reserve(ANVFlatMap* map, const size_t count)
+{
+    if (!map)
+    {
+        return -1;
+    }
+    if (count <= map->size + map->growth_left)
+    {
+        return 0;
+    }
+
+    const size_t capacity = capacity_for(count);
+    return capacity ? rehash(map, capacity) : -1;
+}
+
+//==============================================================================
+// Information functions
+//==============================================================================
+
+ANV_API size_t anv_flatmap_size(const ANVFlatMap* map)
+{
+    return map ? map->size : 0;
+}
+
+ANV_API int anv_flatmap_is_empty(const ANVFlatMap* map)
+{
+    return !map || map->size == 0;
+}
+
+ANV_API double anv_flatmap_load_factor(const ANVFlatMap* map)
+{
+    if (!map || map->capacity == 0)
+    {
+        return 0.0;
+    }
+    return (double)map->size / (double)map->capacity;
+}
+
+ANV_API int anv_flatmap_contains_key(const ANVFlatMap* map, const void* key)
+{
+    if (!map || !key)
+    {
+        return 0;
+    }
+    return find_slot(map, key, hash_key(map, key)) != NOT_FOUND;
+}
+
+//==============================================================================
+// Flat map operations
+//==============================================================================
+
+ANV_API int anv_flatmap_put(ANVFlatMap* map, void* key, void* value)
+{
+    if (!map || !key)
+    {
+        return -1;
+    }
+
+    const size_t hash = hash_key(map, key);
+    const size_t index = find_slot(map, key, hash);
+    if (index != NOT_FOUND)
+    {
+        map->slots[index].value = value;
+        return 0;
+    }
+    return insert_new(map, key, value, hash);
+}
+
+ANV_API int anv_flatmap_put_replace(ANVFlatMap* map, void* key, void* value, void** old_value_out)
+{
+    if (!map || !key || !old_value_out)
+    {
+        return -1;
+    }
+
+    *old_value_out = NULL;
+
+    const size_t hash = hash_key(map, key);
+    const size_t index = find_slot(map, key, hash);
+    if (index != NOT_FOUND)
+    {
+        *old_value_out = map->slots[index].value;
+        map->slots[index].value = value;
+        return 0;
+    }
+    return insert_new(map, key, value, hash);
+}
+
+ANV_API int anv_flatmap_put_with_free(ANVFlatMap* map, void* key, void* value, const bool should_free_old_value)
+{
+    if (!map || !key)
+    {
+        return -1;
+    }
+
+    const size_t hash = hash_key(map, key);
+    const size_t index = find_slot(map, key, hash);
+    if (index != NOT_FOUND)
+    {
+        if (should_free_old_value && map->slots[index].value)
+        {
+            anv_alloc_data_deallocate(&map->alloc, map->slots[index].value);
+        }
+        map->slots[index].value = value;
+        return 0;
+    }
+    return insert_new(map, key, value, hash);
+}
+
+ANV_API void* anv_flatmap_get(const ANVFlatMap* map, const void* key)
+{
+    if (!map || !key)
+    {
+        return NULL;
+    }
+
+    const size_t index = find_slot(map, key, hash_key(map, key));
+    return index != NOT_FOUND ? map->slots[index].value : NULL;
+}
+
+ANV_API int anv_flatmap_remove(ANVFlatMap* map, const void* key,
+                               const bool should_free_key, const bool should_free_value)
+{
+    if (!map || !key)
+    {
+        return -1;
+    }
+
+    const size_t index = find_slot(map, key, hash_key(map, key));
+    if (index == NOT_FOUND)
+    {
+        return -1;
+    }
+
+    if (should_free_key && map->slots[index].key)
+    {
+        anv_alloc_data_deallocate(&map->alloc, map->slots[index].key);
+    }
+    if (should_free_value && map->slots[index].value)
+    {
+        anv_alloc_data_deallocate(&map->alloc, map->slots[index].value);
+    }
+    erase_slot(map, index);
+    return 0;
+}
+
+ANV_API void* anv_flatmap_remove_get(ANVFlatMap* map, const void* key, const bool should_free_key)
+{
+    if (!map || !key)
+    {
+        return NULL;
+    }
+
+    const size_t index = find_slot(map, key, hash_key(map, key));
+    if (index == NOT_FOUND)
+    {
+        return NULL;
+    }
+
+    void* value = map->slots[index].value;
+    if (should_free_key && map->slots[index].key)
+    {
+        anv_alloc_data_deallocate(&map->alloc, map->slots[index].key);
+    }
+    erase_slot(map, index);
+    return value;
+}
+
+//==============================================================================
+// Bulk operations
+//==============================================================================
+
+/**
+ * Collect the keys (or values) of every entry into a new array.
+ */
+static int collect_entries(const ANVFlatMap* map, const bool want_values, void*** items_out, size_t* count_out)
+{
+    if (!map || !items_out || !count_out)
+    {
+        return -1;
+    }
+
+    if (map->size == 0)
+    {
+        *items_out = NULL;
+        *count_out = 0;
+        return 0;
+    }
+
+    void** items = anv_alloc_allocate(&map->alloc, map->size * sizeof(void*));
+    if (!items)
+    {
+        return -1;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < map->capacity; i++)
+    {
+        if (is_full(map->ctrl[i]))
+        {
+            items[count++] = want_values ? map->slots[i].value : map->slots[i].key;
+        }
+    }
+
+    *items_out = items;
+    *count_out = count;
+    return 0;
+}
+
+ANV_API int anv_flatmap_get_keys(const ANVFlatMap* map, void*** keys_out, size_t* count_out)
+{
+    return collect_entries(map, false, keys_out, count_out);
+}
+
+ANV_API int anv_flatmap_get_values(const ANVFlatMap* map, void*** values_out, size_t* count_out)
+{
+    return collect_entries(map, true, values_out, count_out);
+}
+
+ANV_API void anv_flatmap_for_each(const ANVFlatMap* map, void (*action)(void* key, void* value))
+{
+    if (!map || !action)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < map->capacity; i++)
+    {
+        if (is_full(map->ctrl[i]))
+        {
+            action(map->slots[i].key, map->slots[i].value);
+        }
+    }
+}
+
+//==============================================================================
+// Flat map copying functions
+//==============================================================================
+
+// Allocate a map with the same functions and a byte-for-byte copy of the table
+static ANVFlatMap* clone_table(const ANVFlatMap* map)
+{
+    ANVFlatMap* copy = anv_alloc_allocate(&map->alloc, sizeof(ANVFlatMap));
+    if (!copy)
+    {
+        return NULL;
+    }
+
+    *copy = *map;
+    copy->ctrl = anv_alloc_allocate(&copy->alloc, table_bytes(map->capacity));
+    if (!copy->ctrl)
+    {
+        anv_alloc_deallocate(&copy->alloc, copy);
+        return NULL;
+    }
+
+    memcpy(copy->ctrl, map->ctrl, table_bytes(map->capacity));
+    copy->slots = (ANVFlatMapSlot*)(void*)((uint8_t*)copy->ctrl + ctrl_bytes(map->capacity));
+    return copy;
+}
+
+ANV_API ANVFlatMap* anv_flatmap_copy(const ANVFlatMap* map)
+{
+    if (!map)
+    {
+        return NULL;
+    }
+    return clone_table(map);
+}
+
+ANV_API ANVFlatMap* anv_flatmap_copy_deep(const ANVFlatMap* map,
+                                          const anv_copy_func key_copy, const anv_copy_func value_copy)
+{
+    if (!map)
+    {
+        return NULL;
+    }
+
+    ANVFlatMap* copy = clone_table(map);
+    if (!copy)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < copy->capacity; i++)
+    {
+        if (!is_full(copy->ctrl[i]))
+        {
+            continue;
+        }
+
+        ANVFlatMapSlot* slot = &copy->slots[i];
+        void* copied_key = key_copy ? key_copy(slot->key) : slot->key;
+        void* copied_value = value_copy ? value_copy(slot->value) : slot->value;
+
+        if ((key_copy && !copied_key) || (value_copy && !copied_value))
+        {
+            if (key_copy && copied_key)
+            {
+                anv_alloc_data_deallocate(&map->alloc, copied_key);
+            }
+            if (value_copy && copied_value)
+            {
+                anv_alloc_data_deallocate(&map->alloc, copied_value);
+            }
+
+            // Slots from i onward still point at the source's data; drop them before cleanup
+            for (size_t j = i; j < copy->capacity; j++)
+            {
+                copy->ctrl[j] = CTRL_EMPTY;
+            }
+            anv_flatmap_destroy(copy, key_copy != NULL, value_copy != NULL);
+            return NULL;
+        }
+
+        slot->key = copied_key;
+        slot->value = copied_value;
+    }
+
+    return copy;
+}
+
+//==============================================================================
+// Iterator implementation
+//==============================================================================
+
+typedef struct FlatMapIteratorState
+{
+    const ANVFlatMap* map;
+    size_t current_index; // Next full slot, or capacity at the end
+    ANVPair current_pair;
+} FlatMapIteratorState;
+
+static size_t next_full(const ANVFlatMap* map, size_t index)
+{
+    while (index < map->capacity && !is_full(map->ctrl[index]))
+    {
+        index++;
+    }
+    return index;
+}
+
+static void* flatmap_iterator_get(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return NULL;
+    }
+
+    FlatMapIteratorState* state = it->data_state;
+    if (state->current_index >= state->map->capacity)
+    {
+        return NULL;
+    }
+
+    const ANVFlatMapSlot* slot = &state->map->slots[state->current_index];
+    state->current_pair = (ANVPair)
+    {
+        .first = slot->key,
+        .second = slot->value,
+        .alloc = state->map->alloc
+    };
+
+    return &state->current_pair;
+}
+
+static int flatmap_iterator_has_next(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return 0;
+    }
+
+    const FlatMapIteratorState* state = it->data_state;
+    return state->current_index < state->map->capacity;
+}
+
+static int flatmap_iterator_next(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return -1;
+    }
+
+    FlatMapIteratorState* state = it->data_state;
+    if (state->current_index >= state->map->capacity)
+    {
+        return -1;
+    }
+
+    state->current_index = next_full(state->map, state->current_index + 1);
+    return 0;
+}
+
+static int flatmap_iterator_has_prev(const ANVIterator* it)
+{
+    (void)it;
+    return 0;
+}
+
+static int flatmap_iterator_prev(const ANVIterator* it)
+{
+    (void)it;
+    return -1;
+}
+
+static void flatmap_iterator_reset(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return;
+    }
+
+    FlatMapIteratorState* state = it->data_state;
+    state->current_index = next_full(state->map, 0);
+}
+
+static int flatmap_iterator_is_valid(const ANVIterator* it)
+{
+    return it && it->data_state != NULL;
+}
+
+static void flatmap_iterator_destroy(ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return;
+    }
+
+    const FlatMapIteratorState* state = it->data_state;
+    anv_alloc_deallocate(&state->map->alloc, it->data_state);
+    it->data_state = NULL;
+}
+
+ANV_API ANVIterator anv_flatmap_iterator(const ANVFlatMap* map)
+{
+    ANVIterator it = {0};
+
+    it.get = flatmap_iterator_get;
+    it.has_next = flatmap_iterator_has_next;
+    it.next = flatmap_iterator_next;
+    it.has_prev = flatmap_iterator_has_prev;
+    it.prev = flatmap_iterator_prev;
+    it.reset = flatmap_iterator_reset;
+    it.is_valid = flatmap_iterator_is_valid;
+    it.destroy = flatmap_iterator_destroy;
+
+    if (!map)
+    {
+        return it;
+    }
+
+    FlatMapIteratorState* state = anv_alloc_allocate(&map->alloc, sizeof(FlatMapIteratorState));
+    if (!state)
+    {
+        return it;
+    }
+
+    state->map = map;
+    state->current_index = next_full(map, 0);
+
+    it.alloc = map->alloc;
+    it.data_state = state;
+    return it;
+}
+
+ANV_API ANVFlatMap* anv_flatmap_from_iterator(ANVIterator* it, ANVAllocator* alloc,
+                                              const anv_hash_func hash, const key_equals_func key_equals, const bool should_copy)
+{
+    if (!it || !alloc || !hash || !key_equals)
+    {
+        return NULL;
+    }
+
+    if (should_copy && !alloc->copy)
+    {
+        return NULL;
+    }
+
+    if (!it->is_valid || !it->is_valid(it))
+    {
+        return NULL;
+    }
+
+    ANVFlatMap* map = anv_flatmap_create(alloc, hash, key_equals, 0);
+    if (!map)
+    {
+        return NULL;
+    }
+
+    while (it->has_next(it))
+    {
+        ANVPair* pair = it->get(it);
+
+        if (!pair)
+        {
+            if (it->next(it) != 0)
+            {
+                break;
+            }
+            continue;
+        }
+
+        void* key_to_insert;
+        void* value_to_insert;
+
+        if (should_copy)
+        {
+            ANVPair* copied_pair = alloc->copy(pair);
+            if (!copied_pair)
+            {
+                anv_flatmap_destroy(map, true, true);
+                return NULL;
+            }
+
+            key_to_insert = anv_pair_first(copied_pair);
+            value_to_insert = anv_pair_second(copied_pair);
+
+            anv_pair_destroy(copied_pair, false, false);
+        }
+        else
+        {
+            key_to_insert = anv_pair_first(pair);
+            value_to_insert = anv_pair_second(pair);
+        }
+
+        if (anv_flatmap_put(map, key_to_insert, value_to_insert) != 0)
+        {
+            if (should_copy)
+            {
+                anv_alloc_data_deallocate(alloc, key_to_insert);
+                anv_alloc_data_deallocate(alloc, value_to_insert);
+            }
+            anv_flatmap_destroy(map, should_copy, should_copy);
+            return NULL;
+        }
+
+        if (it->next(it) != 0)
+        {
+            break;
+        }
+    }
+
+    return map;
+}
@@ -0,0 +1,670 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "frozenmap.h"
+
+//==============================================================================
+// Build constants
+//==============================================================================
+
+#define PILOT_MULTIPLIER 0x9E3779B97F4A7C15ull
+
+// Fresh seeds tried before giving up on a key set
+#define MAX_BUILD_ATTEMPTS 8
+
+// Pilots tried for one bucket before starting over with another seed
+#define PILOT_SEARCH_LIMIT (1u << 24)
+
+typedef enum BuildResult
+{
+    BUILD_OK,
+    BUILD_RETRY, // Some bucket found no pilot; another seed may work
+    BUILD_FAILED // Out of memory
+} BuildResult;
+
+typedef struct BuildEntry
+{
+    uint64_t hash; // Hash from the map's hash function, before the build seed
+    void* key;
+    void* value;
+} BuildEntry;
+
+// Working arrays for one build, all sized from the entry and bucket counts
+typedef struct BuildScratch
+{
+    uint64_t* hashes;     // Seeded hash per entry
+    size_t* bucket_start; // Offset of each bucket's run in members, plus an end marker
+    size_t* members;      // Entry indices grouped by bucket
+    size_t* order;        // Bucket indices, largest bucket first
+    size_t* positions;    // Slots claimed so far by the bucket being placed
+    uint8_t* taken;       // Whether each slot is claimed
+} BuildScratch;
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+static uint64_t raw_hash(const ANVFrozenMap* map, const void* key)
+{
+    if (map->seeded_hash)
+    {
+        return (uint64_t)map->seeded_hash(key, &map->hash_seed);
+    }
+    return (uint64_t)map->hash(key);
+}
+
+static uint64_t seeded_hash(const ANVFrozenMap* map, const uint64_t raw)
+{
+    return anv_hash_mix64(raw ^ map->seed);
+}
+
+// High bits pick the bucket; the slot comes from a remix, so the two are independent
+static size_t bucket_of(const ANVFrozenMap* map, const uint64_t hash)
+{
+    return (size_t)((hash >> 32) % map->bucket_count);
+}
+
+static size_t slot_of(const ANVFrozenMap* map, const uint64_t hash, const uint32_t pilot)
+{
+    return (size_t)(anv_hash_mix64(hash ^ (pilot * PILOT_MULTIPLIER)) % map->slot_count);
+}
+
+static int compare_entry_hashes(const void* a, const void* b)
+{
+    const uint64_t ha = ((const BuildEntry*)a)->hash;
+    const uint64_t hb = ((const BuildEntry*)b)->hash;
+    return (ha > hb) - (ha < hb);
+}
+
+/**
+ * Search the overflow slots, which hold keys whose raw hash equals that of
+ * a key already placed by the perfect hash. Only reached on a slot miss.
+ */
+static void* find_overflow(const ANVFrozenMap* map, const uint64_t raw, const void* key)
+{
+    const size_t overflow_count = map->size - map->slot_count;
+    size_t low = 0;
+    size_t high = overflow_count;
+    while (low < high)
+    {
+        const size_t mid = low + (high - low) / 2;
+        if (map->overflow_hashes[mid] < raw)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    for (size_t i = low; i < overflow_count && map->overflow_hashes[i] == raw; i++)
+    {
+        const ANVFrozenMapSlot* slot = &map->slots[map->slot_count + i];
+        if (map->key_equals(slot->key, key))
+        {
+            return slot->value;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Sort entries by raw hash and move every key that repeats an earlier key's
+ * raw hash into the overflow slots at the end of the slot array. No seed can
+ * separate such keys, so only the first of each run goes through the perfect
+ * hash. The remaining entries are compacted to the front of 'entries'.
+ */
+static int split_overflow(ANVFrozenMap* map, BuildEntry* entries)
+{
+    qsort(entries, map->size, sizeof(BuildEntry), compare_entry_hashes);
+
+    size_t overflow_count = 0;
+    for (size_t i = 1; i < map->size; i++)
+    {
+        overflow_count += entries[i].hash == entries[i - 1].hash;
+    }
+
+    map->slot_count = map->size - overflow_count;
+    if (overflow_count == 0)
+    {
+        return 0;
+    }
+
+    map->overflow_hashes = anv_alloc_allocate(&map->alloc, overflow_count * sizeof(uint64_t));
+    if (!map->overflow_hashes)
+    {
+        return -1;
+    }
+
+    size_t primary = 1;
+    size_t overflow = 0;
+    for (size_t i = 1; i < map->size; i++)
+    {
+        if (entries[i].hash == entries[primary - 1].hash)
+        {
+            map->overflow_hashes[overflow] = entries[i].hash;
+            map->slots[map->slot_count + overflow].key = entries[i].key;
+            map->slots[map->slot_count + overflow].value = entries[i].value;
+            overflow++;
+        }
+        else
+        {
+            entries[primary++] = entries[i];
+        }
+    }
+    return 0;
+}
+
+static void free_scratch(const ANVAllocator* alloc, const BuildScratch* scratch)
+{
+    anv_alloc_deallocate(alloc, scratch->hashes);
+    anv_alloc_deallocate(alloc, scratch->bucket_start);
+    anv_alloc_deallocate(alloc, scratch->members);
+    anv_alloc_deallocate(alloc, scratch->order);
+    anv_alloc_deallocate(alloc, scratch->positions);
+    anv_alloc_deallocate(alloc, scratch->taken);
+}
+
+static int allocate_scratch(const ANVAllocator* alloc, const size_t count, const size_t bucket_count,
+                            BuildScratch* scratch)
+{
+    memset(scratch, 0, sizeof(*scratch));
+    scratch->hashes = anv_alloc_allocate(alloc, count * sizeof(uint64_t));
+    scratch->bucket_start = anv_alloc_allocate(alloc, (bucket_count + 1) * sizeof(size_t));
+    scratch->members = anv_alloc_allocate(alloc, count * sizeof(size_t));
+    scratch->order = anv_alloc_allocate(alloc, bucket_count * sizeof(size_t));
+    scratch->positions = anv_alloc_allocate(alloc, count * sizeof(size_t));
+    scratch->taken = anv_alloc_allocate(alloc, count);
+
+    if (!scratch->hashes || !scratch->bucket_start || !scratch->members || !scratch->order ||
+        !scratch->positions || !scratch->taken)
+    {
+        free_scratch(alloc, scratch);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Group entries by bucket and list the buckets largest first, so the
+ * hardest buckets are placed while the table is still mostly empty.
+ */
+static int group_buckets(const ANVFrozenMap* map, const BuildEntry* entries, const BuildScratch* scratch)
+{
+    size_t* start = scratch->bucket_start;
+    memset(start, 0, (map->bucket_count + 1) * sizeof(size_t));
+
+    for (size_t i = 0; i < map->slot_count; i++)
+    {
+        scratch->hashes[i] = seeded_hash(map, entries[i].hash);
+        start[bucket_of(map, scratch->hashes[i]) + 1]++;
+    }
+
+    size_t largest = 0;
+    for (size_t b = 0; b < map->bucket_count; b++)
+    {
+        largest = start[b + 1] > largest ? start[b + 1] : largest;
+        start[b + 1] += start[b];
+    }
+
+    // Fill each bucket's run, using positions as per-bucket cursors
+    memcpy(scratch->positions, start, map->bucket_count * sizeof(size_t));
+    for (size_t i = 0; i < map->slot_count; i++)
+    {
+        scratch->members[scratch->positions[bucket_of(map, scratch->hashes[i])]++] = i;
+    }
+
+    // Counting sort of bucket indices by size, descending
+    size_t* by_size = anv_alloc_allocate(&map->alloc, (largest + 2) * sizeof(size_t));
+    if (!by_size)
+    {
+        return -1;
+    }
+
+    memset(by_size, 0, (largest + 2) * sizeof(size_t));
+    for (size_t b = 0; b < map->bucket_count; b++)
+    {
+        by_size[largest - (start[b + 1] - start[b]) + 1]++;
+    }
+    for (size_t s = 0; s <= largest; s++)
+    {
+        by_size[s + 1] += by_size[s];
+    }
+    for (size_t b = 0; b < map->bucket_count; b++)
+    {
+        scratch->order[by_size[largest - (start[b + 1] - start[b])]++] = b;
+    }
+
+    anv_alloc_deallocate(&map->alloc, by_size);
+    return 0;
+}
+
+/**
+ * Find a pilot for every bucket such that its keys land on distinct free
+ * slots. Pilots are tried in order from 0, so most stay small. Raw hashes
+ * are distinct after split_overflow and the seeded mix is a bijection, so
+ * every bucket can in principle be placed.
+ */
+static BuildResult place_buckets(ANVFrozenMap* map, const BuildScratch* scratch)
+{
+    memset(scratch->taken, 0, map->slot_count);
+
+    for (size_t o = 0; o < map->bucket_count; o++)
+    {
+        const size_t bucket = scratch->order[o];
+        const size_t* members = &scratch->members[scratch->bucket_start[bucket]];
+        const size_t count = scratch->bucket_start[bucket + 1] - scratch->bucket_start[bucket];
+        if (count == 0)
+        {
+            break; // Buckets are sorted by size; the rest are empty
+        }
+
+        uint32_t pilot = 0;
+        for (;;)
+        {
+            size_t placed = 0;
+            while (placed < count)
+            {
+                const size_t slot = slot_of(map, scratch->hashes[members[placed]], pilot);
+                if (scratch->taken[slot])
+                {
+                    break;
+                }
+                scratch->taken[slot] = 1;
+                scratch->positions[placed++] = slot;
+            }
+
+            if (placed == count)
+            {
+                break;
+            }
+
+            // Release this attempt's slots and try the next pilot
+            for (size_t j = 0; j < placed; j++)
+            {
+                scratch->taken[scratch->positions[j]] = 0;
+            }
+            if (++pilot == PILOT_SEARCH_LIMIT)
+            {
+                return BUILD_RETRY;
+            }
+        }
+
+        map->pilots[bucket] = pilot;
+    }
+    return BUILD_OK;
+}
+
+/**
+ * Compute pilots for the entries and fill the slot array, retrying with new
+ * seeds if a bucket cannot be placed.
+ */
+static int build(ANVFrozenMap* map, const BuildEntry* entries)
+{
+    BuildScratch scratch;
+    if (allocate_scratch(&map->alloc, map->slot_count, map->bucket_count, &scratch) != 0)
+    {
+        return -1;
+    }
+
+    BuildResult result = BUILD_RETRY;
+    for (uint64_t attempt = 0; attempt < MAX_BUILD_ATTEMPTS && result == BUILD_RETRY; attempt++)
+    {
+        map->seed = anv_hash_mix64(attempt + 1);
+        if (group_buckets(map, entries, &scratch) != 0)
+        {
+            result = BUILD_FAILED;
+            break;
+        }
+        result = place_buckets(map, &scratch);
+    }
+
+    if (result == BUILD_OK)
+    {
+        for (size_t i = 0; i < map->slot_count; i++)
+        {
+            const uint64_t hash = scratch.hashes[i];
+            ANVFrozenMapSlot* slot = &map->slots[slot_of(map, hash, map->pilots[bucket_of(map, hash)])];
+            slot->key = entries[i].key;
+            slot->value = entries[i].value;
+        }
+    }
+
+    free_scratch(&map->alloc, &scratch);
+    return result == BUILD_OK ? 0 : -1;
+}
+
+//==============================================================================
+// Creation and destruction functions
+//==============================================================================
+
+ANV_API ANVFrozenMap* anv_frozenmap_from_hashmap(const ANVHashMap* source)
+{
+    if (!source || !source->key_equals || (!source->hash && !source->seeded_hash))
+    {
+        return NULL;
+    }
+
+    ANVFrozenMap* map = anv_alloc_allocate(&source->alloc, sizeof(ANVFrozenMap));
+    if (!map)
+    {
+        return NULL;
+    }
+
+    memset(map, 0, sizeof(ANVFrozenMap));
+    map->hash = source->hash;
+    map->seeded_hash = source->seeded_hash;
+    map->hash_seed = source->seed;
+    map->key_equals = source->key_equals;
+    map->alloc = source->alloc;
+    map->size = source->size;
+    if (map->size == 0)
+    {
+        return map;
+    }
+
+    map->slots = anv_alloc_allocate(&map->alloc, map->size * sizeof(ANVFrozenMapSlot));
+    BuildEntry* entries = anv_alloc_allocate(&map->alloc, map->size * sizeof(BuildEntry));
+    if (!map->slots || !entries)
+    {
+        anv_alloc_deallocate(&map->alloc, entries);
+        anv_frozenmap_destroy(map, false, false);
+        return NULL;
+    }
+
+    size_t count = 0;
+    ANVIterator it = anv_hashmap_iterator(source);
+    while (it.has_next(&it) && count < map->size)
+    {
+        const ANVPair* pair = it.get(&it);
+        if (pair)
+        {
+            entries[count].hash = raw_hash(map, pair->first);
+            entries[count].key = pair->first;
+            entries[count].value = pair->second;
+            count++;
+        }
+        it.next(&it);
+    }
+    it.destroy(&it);
+
+    int result = count == map->size ? split_overflow(map, entries) : -1;
+    if (result == 0)
+    {
+        map->bucket_count = map->slot_count / ANV_FROZENMAP_BUCKET_SIZE + 1;
+        map->pilots = anv_alloc_allocate(&map->alloc, map->bucket_count * sizeof(uint32_t));
+        result = map->pilots ? build(map, entries) : -1;
+    }
+    anv_alloc_deallocate(&map->alloc, entries);
+    if (result != 0)
+    {
+        anv_frozenmap_destroy(map, false, false);
+        return NULL;
+    }
+    return map;
+}
+
+ANV_API ANVFrozenMap* anv_frozenmap_from_iterator(ANVIterator* it, ANVAllocator* alloc,
+                                                  const anv_hash_func hash, const key_equals_func key_equals,
+                                                  const bool should_copy)
+{
+    // Collecting into a hash map first gives duplicates the usual semantics
+    ANVHashMap* source = anv_hashmap_from_iterator(it, alloc, hash, key_equals, should_copy);
+    if (!source)
+    {
+        return NULL;
+    }
+
+    ANVFrozenMap* map = anv_frozenmap_from_hashmap(source);
+    const bool owns_copies = should_copy && !map;
+    anv_hashmap_destroy(source, owns_copies, owns_copies);
+    return map;
+}
+
+ANV_API void anv_frozenmap_destroy(ANVFrozenMap* map, const bool should_free_keys, const bool should_free_values)
+{
+    if (!map)
+    {
+        return;
+    }
+
+    if (map->slots)
+    {
+        for (size_t i = 0; i < map->size; i++)
+        {
+            if (should_free_keys && map->slots[i].key)
+            {
+                anv_alloc_data_deallocate(&map->alloc, map->slots[i].key);
+            }
+            if (should_free_values && map->slots[i].value)
+            {
+                anv_alloc_data_deallocate(&map->alloc, map->slots[i].value);
+            }
+        }
+    }
+
+    anv_alloc_deallocate(&map->alloc, map->slots);
+    anv_alloc_deallocate(&map->alloc, map->pilots);
+    anv_alloc_deallocate(&map->alloc, map->overflow_hashes);
+    anv_alloc_deallocate(&map->alloc, map);
+}
+
+//==============================================================================
+// Information functions
+//==============================================================================
+
+ANV_API size_t anv_frozenmap_size(const ANVFrozenMap* map)
+{
+    return map ? map->size : 0;
+}
+
+ANV_API int anv_frozenmap_is_empty(const ANVFrozenMap* map)
+{
+    return !map || map->size == 0;
+}
+
+ANV_API size_t anv_frozenmap_memory_usage(const ANVFrozenMap* map)
+{
+    if (!map)
+    {
+        return 0;
+    }
+    return sizeof(ANVFrozenMap) + map->size * sizeof(ANVFrozenMapSlot) + map->bucket_count * sizeof(uint32_t) +
+           (map->size - map->slot_count) * sizeof(uint64_t);
+}
+
+ANV_API int anv_frozenmap_contains_key(const ANVFrozenMap* map, const void* key)
+{
+    return anv_frozenmap_get(map, key) != NULL;
+}
+
+//==============================================================================
+// Frozen map operations
+//==============================================================================
+
+ANV_API void* anv_frozenmap_get(const ANVFrozenMap* map, const void* key)
+{
+    if (!map || !key || map->size == 0)
+    {
+        return NULL;
+    }
+
+    const uint64_t raw = raw_hash(map, key);
+    const uint64_t hash = seeded_hash(map, raw);
+    const ANVFrozenMapSlot* slot = &map->slots[slot_of(map, hash, map->pilots[bucket_of(map, hash)])];
+    if (map->key_equals(slot->key, key))
+    {
+        return slot->value;
+    }
+    return map->slot_count < map->size ? find_overflow(map, raw, key) : NULL;
+}
+
+ANV_API void anv_frozenmap_for_each(const ANVFrozenMap* map, void (*action)(void* key, void* value))
+{
+    if (!map || !action)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < map->size; i++)
+    {
+        action(map->slots[i].key, map->slots[i].value);
+    }
+}
+
+//==============================================================================
+// Iterator implementation
+//==============================================================================
+
+typedef struct FrozenMapIteratorState
+{
+    const ANVFrozenMap* map;
+    size_t current_index; // Every slot, overflow included, is full, so this is a plain index
+    ANVPair current_pair;
+} FrozenMapIteratorState;
+
+static void* frozenmap_iterator_get(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return NULL;
+    }
+
+    FrozenMapIteratorState* state = it->data_state;
+    if (state->current_index >= state->map->size)
+    {
+        return NULL;
+    }
+
+    const ANVFrozenMapSlot* slot = &state->map->slots[state->current_index];
+    state->current_pair = (ANVPair)
+    {
+        .first = slot->key,
+        .second = slot->value,
+        .alloc = state->map->alloc
+    };
+
+    return &state->current_pair;
+}
+
+static int frozenmap_iterator_has_next(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return 0;
+    }
+
+    const FrozenMapIteratorState* state = it->data_state;
+    return state->current_index < state->map->size;
+}
+
+static int frozenmap_iterator_next(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return -1;
+    }
+
+    FrozenMapIteratorState* state = it->data_state;
+    if (state->current_index >= state->map->size)
+    {
+        return -1;
+    }
+
+    state->current_index++;
+    return 0;
+}
+
+static int frozenmap_iterator_has_prev(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return 0;
+    }
+
+    const FrozenMapIteratorState* state = it->data_state;
+    return state->current_index > 0;
+}
+
+static int frozenmap_iterator_prev(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return -1;
+    }
+
+    FrozenMapIteratorState* state = it->data_state;
+    if (state->current_index == 0)
+    {
+        return -1;
+    }
+
+    state->current_index--;
+    return 0;
+}
+
+static void frozenmap_iterator_reset(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return;
+    }
+
+    FrozenMapIteratorState* state = it->data_state;
+    state->current_index = 0;
+}
+
+static int frozenmap_iterator_is_valid(const ANVIterator* it)
+{
+    return it && it->data_state != NULL;
+}
+
+static void frozenmap_iterator_destroy(ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return;
+    }
+
+    const FrozenMapIteratorState* state = it->data_state;
+    anv_alloc_deallocate(&state->map->alloc, it->data_state);
+    it->data_state = NULL;
+}
+
+ANV_API ANVIterator anv_frozenmap_iterator(const ANVFrozenMap* map)
+{
+    ANVIterator it = {0};
+
+    it.get = frozenmap_iterator_get;
+    it.has_next = frozenmap_iterator_has_next;
+    it.next = frozenmap_iterator_next;
+    it.has_prev = frozenmap_iterator_has_prev;
+    it.prev = frozenmap_iterator_prev;
+    it.reset = frozenmap_iterator_reset;
+    it.is_valid = frozenmap_iterator_is_valid;
+    it.destroy = frozenmap_iterator_destroy;
+
+    if (!map)
+    {
+        return it;
+    }
+
+    FrozenMapIteratorState* state = anv_alloc_allocate(&map->alloc, sizeof(FrozenMapIteratorState));
+    if (!state)
+    {
+        return it;
+    }
+
+    state->map = map;
+    state->current_index = 0;
+
+    it.alloc = map->alloc;
+    it.data_state = state;
+    return it;
+}
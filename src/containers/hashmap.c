@@ -15,13 +15,22 @@
 #define DEFAULT_INITIAL_CAPACITY ANV_DEFAULT_CAPACITY
 #define DEFAULT_MAX_LOAD_FACTOR 0.75
 
+#if defined(__GNUC__) || defined(__clang__)
+    #define PREFETCH(address) __builtin_prefetch(address)
+#elif defined(_M_X64) || defined(_M_IX86)
+    #include <xmmintrin.h>
+    #define PREFETCH(address) _mm_prefetch((const char*)(address), _MM_HINT_T0)
+#else
+    #define PREFETCH(address) ((void)(address))
+#endif
+
 //==============================================================================
 // Helper functions
 //==============================================================================
 
-static ANVHashMapNode* create_node(const ANVHashMap* map, void* key, void* value)
+static ANVHashMapNode* create_node(const ANVHashMap* map, void* key, void* value, const size_t hash)
 {
-    ANVHashMapNode* node = anv_alloc_allocate(&map->alloc, sizeof(ANVHashMapNode));
+    ANVHashMapNode* node = anv_slab_pool_allocate(map->node_pool, &map->alloc, sizeof(ANVHashMapNode));
     if (!node)
     {
         return NULL;
@@ -29,6 +38,7 @@ static ANVHashMapNode* create_node(const ANVHashMap* map, void* key, void* value
 
     node->key = key;
     node->value = value;
+    node->hash = hash;
     node->next = NULL;
     return node;
 }
@@ -51,16 +61,99 @@ static void free_node(const ANVHashMap* map, ANVHashMapNode* node,
         anv_alloc_data_deallocate(&map->alloc, node->value);
     }
 
-    anv_alloc_deallocate(&map->alloc, node);
+    anv_slab_pool_deallocate(map->node_pool, &map->alloc, node);
 }
 
-static size_t get_bucket_index(const ANVHashMap* map, const void* key)
+static size_t hash_key(const ANVHashMap* map, const void* key)
 {
-    if (!map->hash || map->bucket_count == 0)
+    if (map->seeded_hash)
     {
-        return 0;
+        return map->seeded_hash(key, &map->seed);
+    }
+    return map->hash ? map->hash(key) : 0;
+}
+
+static size_t get_bucket_index(const ANVHashMap* map, const size_t hash)
+{
+    return map->bucket_count ? hash % map->bucket_count : 0;
+}
+
+// Stored hashes filter out almost every non-matching node before key_equals runs
+static bool node_matches(const ANVHashMap* map, const ANVHashMapNode* node, const void* key, const size_t hash)
+{
+    return node->hash == hash && map->key_equals(node->key, key);
+}
+
+/*
+ * Incremental resizes always double the table, so old bucket j splits into
+ * new buckets j and j + old_bucket_count. Until old bucket j migrates, every
+ * key that hashes to those two new buckets lives in old bucket j, so each
+ * key has exactly one home chain. The new array is cleared in slices before
+ * the first bucket migrates; see migrate_step.
+ */
+static ANVHashMapNode** home_bucket(const ANVHashMap* map, const size_t hash)
+{
+    if (map->old_buckets)
+    {
+        const size_t old_index = hash % map->old_bucket_count;
+        if (old_index >= map->migrate_index)
+        {
+            return &map->old_buckets[old_index];
+        }
+    }
+    return &map->buckets[get_bucket_index(map, hash)];
+}
+
+// Chains of the current table come first, then the unmigrated chains of the old one
+static size_t total_bucket_count(const ANVHashMap* map)
+{
+    return map->bucket_count + map->old_bucket_count;
+}
+
+static ANVHashMapNode* chain_at(const ANVHashMap* map, const size_t i)
+{
+    if (i >= map->bucket_count)
+    {
+        return map->old_buckets[i - map->bucket_count];
+    }
+    if (map->old_buckets && i % map->old_bucket_count >= map->migrate_index)
+    {
+        return NULL; // Not migrated yet, and possibly not cleared either
+    }
+    return map->buckets[i];
+}
+
+// Find the link pointing at the node holding key, or NULL
+static ANVHashMapNode** find_link(const ANVHashMap* map, const void* key, const size_t hash)
+{
+    for (ANVHashMapNode** link = home_bucket(map, hash); *link; link = &(*link)->next)
+    {
+        if (node_matches(map, *link, key, hash))
+        {
+            return link;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Link a node for a key known to be absent into its home chain, without
+ * resizing. Used directly by the copy functions, which reuse the source's
+ * stored hashes.
+ */
+static int insert_new(ANVHashMap* map, void* key, void* value, const size_t hash)
+{
+    ANVHashMapNode* node = create_node(map, key, value, hash);
+    if (!node)
+    {
+        return -1;
     }
-    return map->hash(key) % map->bucket_count;
+
+    ANVHashMapNode** bucket = home_bucket(map, hash);
+    node->next = *bucket;
+    *bucket = node;
+    map->size++;
+    return 0;
 }
 
 static int resize_map(ANVHashMap* map, const size_t new_bucket_count)
@@ -95,7 +188,7 @@ static int resize_map(ANVHashMap* map, const size_t new_bucket_count)
         {
             ANVHashMapNode* next = node->next;
 
-            const size_t new_index = get_bucket_index(map, node->key);
+            const size_t new_index = get_bucket_index(map, node->hash);
             node->next = map->buckets[new_index];
             map->buckets[new_index] = node;
 
@@ -107,6 +200,83 @@ static int resize_map(ANVHashMap* map, const size_t new_bucket_count)
     return 0;
 }
 
+/**
+ * Clear up to 'limit' more buckets of the new table.
+ */
+static void clear_buckets(ANVHashMap* map, const size_t limit)
+{
+    const size_t remaining = map->bucket_count - map->clear_index;
+    const size_t count = remaining < limit ? remaining : limit;
+    memset(map->buckets + map->clear_index, 0, count * sizeof(ANVHashMapNode*));
+    map->clear_index += count;
+}
+
+/**
+ * Move whole old buckets into the current table until at least 'node_limit'
+ * nodes have moved or 'bucket_limit' buckets have been visited, releasing
+ * the old array once every bucket has moved. The new table must be fully
+ * cleared first.
+ */
+static void migrate_buckets(ANVHashMap* map, const size_t node_limit, size_t bucket_limit)
+{
+    if (map->old_buckets)
+    {
+        clear_buckets(map, SIZE_MAX);
+    }
+
+    size_t moved = 0;
+    while (map->old_buckets && moved < node_limit && bucket_limit-- > 0)
+    {
+        const size_t index = map->migrate_index;
+        ANVHashMapNode* node = map->old_buckets[index];
+        map->old_buckets[index] = NULL;
+        while (node)
+        {
+            ANVHashMapNode* next = node->next;
+            const size_t new_index = get_bucket_index(map, node->hash);
+            node->next = map->buckets[new_index];
+            map->buckets[new_index] = node;
+            node = next;
+            moved++;
+        }
+
+        if (++map->migrate_index == map->old_bucket_count)
+        {
+            anv_alloc_deallocate(&map->alloc, map->old_buckets);
+            map->old_buckets = NULL;
+            map->old_bucket_count = 0;
+            map->migrate_index = 0;
+            map->clear_index = 0;
+        }
+    }
+}
+
+/**
+ * Swap in a table of twice as many buckets and keep the current one as the
+ * old table, to be drained by later operations. The new array is left
+ * uncleared; see migrate_step.
+ */
+static int begin_incremental_resize(ANVHashMap* map, const size_t new_bucket_count)
+{
+    // A resize still in flight is finished first; only two tables ever exist
+    migrate_buckets(map, SIZE_MAX, SIZE_MAX);
+
+    ANVHashMapNode** new_buckets = anv_alloc_allocate(&map->alloc,
+                                                    new_bucket_count * sizeof(ANVHashMapNode*));
+    if (!new_buckets)
+    {
+        return -1;
+    }
+
+    map->old_buckets = map->buckets;
+    map->old_bucket_count = map->bucket_count;
+    map->migrate_index = 0;
+    map->clear_index = 0;
+    map->buckets = new_buckets;
+    map->bucket_count = new_bucket_count;
+    return 0;
+}
+
 static int check_and_resize(ANVHashMap* map)
 {
     const double current_load_factor = anv_hashmap_load_factor(map);
@@ -117,23 +287,50 @@ static int check_and_resize(ANVHashMap* map)
         {
             return -1;
         }
+        if (map->incremental_resize)
+        {
+            return begin_incremental_resize(map, new_size);
+        }
         return resize_map(map, new_size);
     }
     return 0;
 }
 
+/*
+ * Mutating operations pay for a bounded slice of any resize in progress:
+ * first a slice of clearing the new table, then a slice of migration. Doing
+ * the clearing in large slices up front, rather than touching fresh pages
+ * during every migration step, keeps page faults out of most operations.
+ * The bucket cap bounds the scan over runs of empty buckets. Each migration
+ * step moves ANV_HASHMAP_MIGRATE_NODES nodes or visits four times as many
+ * buckets, so an old table of n buckets drains within
+ * n / ANV_HASHMAP_MIGRATE_NODES steps plus the clearing steps, well before
+ * the 3n / 4 inserts that trigger the next resize.
+ */
+static void migrate_step(ANVHashMap* map)
+{
+    if (!map->old_buckets)
+    {
+        return;
+    }
+    if (map->clear_index < map->bucket_count)
+    {
+        clear_buckets(map, ANV_HASHMAP_CLEAR_BUCKETS);
+        return;
+    }
+    migrate_buckets(map, ANV_HASHMAP_MIGRATE_NODES, ANV_HASHMAP_MIGRATE_NODES * 4);
+}
+
 //==============================================================================
 // Creation and destruction functions
 //==============================================================================
 
-ANV_API ANVHashMap* anv_hashmap_create(ANVAllocator* alloc, const anv_hash_func hash,
-                                       const key_equals_func key_equals, const size_t initial_capacity)
+/**
+ * Allocate an empty map; exactly one of hash and seeded_hash is set.
+ */
+static ANVHashMap* create_map(ANVAllocator* alloc, const anv_hash_func hash, const anv_seeded_hash_func seeded_hash,
+                              const ANVHashSeed* seed, const key_equals_func key_equals, const size_t initial_capacity)
 {
-    if (!alloc || !hash || !key_equals)
-    {
-        return NULL;
-    }
-
     ANVHashMap* map = anv_alloc_allocate(alloc, sizeof(ANVHashMap));
     if (!map)
     {
@@ -158,12 +355,58 @@ ANV_API ANVHashMap* anv_hashmap_create(ANVAllocator* alloc, const anv_hash_func
     map->size = 0;
     map->max_load_factor = DEFAULT_MAX_LOAD_FACTOR;
     map->hash = hash;
+    map->seeded_hash = seeded_hash;
+    map->seed = seed ? *seed : (ANVHashSeed){0};
     map->key_equals = key_equals;
     map->alloc = *alloc;
+    map->node_pool = anv_slab_pool_create(alloc, sizeof(ANVHashMapNode));
+    map->old_buckets = NULL;
+    map->old_bucket_count = 0;
+    map->migrate_index = 0;
+    map->clear_index = 0;
+    map->incremental_resize = false;
 
     return map;
 }
 
+/**
+ * Create an empty map with the same hashing mode, seed and load factor.
+ */
+static ANVHashMap* create_like(ANVHashMap* map)
+{
+    ANVHashMap* copy = create_map(&map->alloc, map->hash, map->seeded_hash, &map->seed,
+                                  map->key_equals, map->bucket_count);
+    if (copy)
+    {
+        copy->max_load_factor = map->max_load_factor;
+        copy->incremental_resize = map->incremental_resize;
+    }
+    return copy;
+}
+
+ANV_API ANVHashMap* anv_hashmap_create(ANVAllocator* alloc, const anv_hash_func hash,
+                                       const key_equals_func key_equals, const size_t initial_capacity)
+{
+    if (!alloc || !hash || !key_equals)
+    {
+        return NULL;
+    }
+    return create_map(alloc, hash, NULL, NULL, key_equals, initial_capacity);
+}
+
+ANV_API ANVHashMap* anv_hashmap_create_seeded(ANVAllocator* alloc, const anv_seeded_hash_func hash,
+                                              const key_equals_func key_equals, const size_t initial_capacity,
+                                              const ANVHashSeed* seed)
+{
+    if (!alloc || !hash || !key_equals)
+    {
+        return NULL;
+    }
+
+    const ANVHashSeed key = seed ? *seed : anv_hash_random_seed();
+    return create_map(alloc, NULL, hash, &key, key_equals, initial_capacity);
+}
+
 ANV_API void anv_hashmap_destroy(ANVHashMap* map, const bool should_free_keys, const bool should_free_values)
 {
     if (!map)
@@ -173,6 +416,7 @@ ANV_API void anv_hashmap_destroy(ANVHashMap* map, const bool should_free_keys, c
 
     anv_hashmap_clear(map, should_free_keys, should_free_values);
 
+    anv_slab_pool_destroy(&map->alloc, map->node_pool);
     anv_alloc_deallocate(&map->alloc, map->buckets);
     anv_alloc_deallocate(&map->alloc, map);
 }
@@ -184,15 +428,25 @@ ANV_API void anv_hashmap_clear(ANVHashMap* map, const bool should_free_keys, con
         return;
     }
 
-    for (size_t i = 0; i < map->bucket_count; i++)
+    for (size_t i = 0; i < total_bucket_count(map); i++)
     {
-        ANVHashMapNode* node = map->buckets[i];
+        ANVHashMapNode* node = chain_at(map, i);
         while (node)
         {
             ANVHashMapNode* next = node->next;
             free_node(map, node, should_free_keys, should_free_values);
             node = next;
         }
+    }
+
+    // Every chain is gone, so any resize in progress is complete
+    anv_alloc_deallocate(&map->alloc, map->old_buckets);
+    map->old_buckets = NULL;
+    map->old_bucket_count = 0;
+    map->migrate_index = 0;
+    map->clear_index = 0;
+    for (size_t i = 0; i < map->bucket_count; i++)
+    {
         map->buckets[i] = NULL;
     }
 
@@ -231,37 +485,51 @@ ANV_API int anv_hashmap_contains_key(const ANVHashMap* map, const void* key)
 // Hash map operations
 //==============================================================================
 
-ANV_API int anv_hashmap_put(ANVHashMap* map, void* key, void* value)
+ANV_API int anv_hashmap_set_incremental_resize(ANVHashMap* map, const bool enabled)
 {
-    if (!map || !key)
+    if (!map)
     {
         return -1;
     }
 
-    const size_t index = get_bucket_index(map, key);
-    ANVHashMapNode* node = map->buckets[index];
+    map->incremental_resize = enabled;
+    if (!enabled)
+    {
+        migrate_buckets(map, SIZE_MAX, SIZE_MAX);
+    }
+    return 0;
+}
 
-    while (node)
+/**
+ * Insert a key known to be absent, then grow the table if needed.
+ */
+static int insert_absent(ANVHashMap* map, void* key, void* value, const size_t hash)
+{
+    if (insert_new(map, key, value, hash) != 0)
     {
-        if (map->key_equals(node->key, key))
-        {
-            node->value = value;
-            return 0;
-        }
-        node = node->next;
+        return -1;
     }
+    return check_and_resize(map);
+}
 
-    ANVHashMapNode* new_node = create_node(map, key, value);
-    if (!new_node)
+ANV_API int anv_hashmap_put(ANVHashMap* map, void* key, void* value)
+{
+    if (!map || !key)
     {
         return -1;
     }
 
-    new_node->next = map->buckets[index];
-    map->buckets[index] = new_node;
-    map->size++;
+    migrate_step(map);
 
-    return check_and_resize(map);
+    const size_t hash = hash_key(map, key);
+    ANVHashMapNode** link = find_link(map, key, hash);
+    if (link)
+    {
+        (*link)->value = value;
+        return 0;
+    }
+
+    return insert_absent(map, key, value, hash);
 }
 
 ANV_API int anv_hashmap_put_replace(ANVHashMap* map, void* key, void* value, void** old_value_out)
@@ -272,164 +540,312 @@ ANV_API int anv_hashmap_put_replace(ANVHashMap* map, void* key, void* value, voi
     }
 
     *old_value_out = NULL;
+    migrate_step(map);
 
-    const size_t index = get_bucket_index(map, key);
-    ANVHashMapNode* node = map->buckets[index];
-
-    while (node)
+    const size_t hash = hash_key(map, key);
+    ANVHashMapNode** link = find_link(map, key, hash);
+    if (link)
     {
-        if (map->key_equals(node->key, key))
-        {
-            *old_value_out = node->value;
-            node->value = value;
-            return 0;
-        }
-        node = node->next;
+        *old_value_out = (*link)->value;
+        (*link)->value = value;
+        return 0;
     }
 
-    ANVHashMapNode* new_node = create_node(map, key, value);
-    if (!new_node)
+    return insert_absent(map, key, value, hash);
+}
+
+ANV_API int anv_hashmap_put_with_free(ANVHashMap* map, void* key, void* value, const bool should_free_old_value)
+{
+    if (!map || !key)
     {
         return -1;
     }
 
-    new_node->next = map->buckets[index];
-    map->buckets[index] = new_node;
-    map->size++;
+    migrate_step(map);
 
-    return check_and_resize(map);
+    const size_t hash = hash_key(map, key);
+    ANVHashMapNode** link = find_link(map, key, hash);
+    if (link)
+    {
+        ANVHashMapNode* node = *link;
+        if (should_free_old_value && node->value)
+        {
+            anv_alloc_data_deallocate(&map->alloc, node->value);
+        }
+
+        node->value = value;
+        return 0;
+    }
+
+    return insert_absent(map, key, value, hash);
 }
 
-ANV_API int anv_hashmap_put_with_free(ANVHashMap* map, void* key, void* value, const bool should_free_old_value)
+ANV_API void* anv_hashmap_get(const ANVHashMap* map, const void* key)
 {
     if (!map || !key)
     {
-        return -1;
+        return NULL;
+    }
+
+    ANVHashMapNode** link = find_link(map, key, hash_key(map, key));
+    return link ? (*link)->value : NULL;
+}
+
+/*
+ * Each stage only touches memory the previous stage prefetched, so by the
+ * time a chain is walked its bucket, first node and key are usually cached.
+ */
+static size_t get_window(const ANVHashMap* map, const void* const* keys, const size_t count, void** values_out)
+{
+    size_t hashes[ANV_HASHMAP_BATCH_WINDOW];
+    ANVHashMapNode** buckets[ANV_HASHMAP_BATCH_WINDOW];
+    const ANVHashMapNode* heads[ANV_HASHMAP_BATCH_WINDOW];
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!keys[i])
+        {
+            buckets[i] = NULL; // Never found, as with anv_hashmap_get
+            continue;
+        }
+        hashes[i] = hash_key(map, keys[i]);
+        buckets[i] = home_bucket(map, hashes[i]);
+        PREFETCH(buckets[i]);
     }
 
-    const size_t index = get_bucket_index(map, key);
-    ANVHashMapNode* node = map->buckets[index];
+    for (size_t i = 0; i < count; i++)
+    {
+        heads[i] = buckets[i] ? *buckets[i] : NULL;
+        if (heads[i])
+        {
+            PREFETCH(heads[i]);
+        }
+    }
 
-    while (node)
+    for (size_t i = 0; i < count; i++)
     {
-        if (map->key_equals(node->key, key))
+        if (heads[i] && heads[i]->hash == hashes[i])
         {
-            if (should_free_old_value && node->value)
+            PREFETCH(heads[i]->key);
+        }
+    }
+
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        values_out[i] = NULL;
+        for (const ANVHashMapNode* node = heads[i]; node; node = node->next)
+        {
+            if (node_matches(map, node, keys[i], hashes[i]))
             {
-                anv_alloc_data_deallocate(&map->alloc, node->value);
+                values_out[i] = node->value;
+                found++;
+                break;
             }
-
-            node->value = value;
-            return 0;
         }
-        node = node->next;
+    }
+    return found;
+}
+
+ANV_API size_t anv_hashmap_get_batch(const ANVHashMap* map, const void* const* keys, const size_t count,
+                                     void** values_out)
+{
+    if (!map || !keys || !values_out)
+    {
+        return 0;
     }
 
-    ANVHashMapNode* new_node = create_node(map, key, value);
-    if (!new_node)
+    size_t found = 0;
+    for (size_t start = 0; start < count; start += ANV_HASHMAP_BATCH_WINDOW)
+    {
+        const size_t window = count - start < ANV_HASHMAP_BATCH_WINDOW ? count - start : ANV_HASHMAP_BATCH_WINDOW;
+        found += get_window(map, keys + start, window, values_out + start);
+    }
+    return found;
+}
+
+ANV_API int anv_hashmap_remove(ANVHashMap* map, const void* key,
+                               const bool should_free_key, const bool should_free_value)
+{
+    if (!map || !key)
     {
         return -1;
     }
 
-    new_node->next = map->buckets[index];
-    map->buckets[index] = new_node;
-    map->size++;
+    migrate_step(map);
 
-    return check_and_resize(map);
+    ANVHashMapNode** link = find_link(map, key, hash_key(map, key));
+    if (!link)
+    {
+        return -1;
+    }
+
+    ANVHashMapNode* node = *link;
+    *link = node->next;
+    free_node(map, node, should_free_key, should_free_value);
+    map->size--;
+    return 0;
 }
 
-ANV_API void* anv_hashmap_get(const ANVHashMap* map, const void* key)
+ANV_API void* anv_hashmap_remove_get(ANVHashMap* map, const void* key, const bool should_free_key)
 {
     if (!map || !key)
     {
         return NULL;
     }
 
-    const size_t index = get_bucket_index(map, key);
-    const ANVHashMapNode* node = map->buckets[index];
+    migrate_step(map);
 
-    while (node)
+    ANVHashMapNode** link = find_link(map, key, hash_key(map, key));
+    if (!link)
     {
-        if (map->key_equals(node->key, key))
-        {
-            return node->value;
-        }
-        node = node->next;
+        return NULL;
     }
 
-    return NULL;
+    ANVHashMapNode* node = *link;
+    void* value = node->value;
+    *link = node->next;
+    free_node(map, node, should_free_key, false);
+    map->size--;
+    return value;
 }
 
-ANV_API int anv_hashmap_remove(ANVHashMap* map, const void* key,
-                               const bool should_free_key, const bool should_free_value)
+//==============================================================================
+// Entry operations
+//==============================================================================
+
+/**
+ * Walk key's home chain once. Returns the link pointing at the node holding
+ * key, or on a miss the chain's terminating link, where a new node for key
+ * belongs.
+ */
+static ANVHashMapNode** probe_chain(const ANVHashMap* map, const void* key, const size_t hash)
+{
+    ANVHashMapNode** link = home_bucket(map, hash);
+    while (*link && !node_matches(map, *link, key, hash))
+    {
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+/**
+ * Link a new node at the link probe_chain returned, then grow the table if
+ * needed. Nodes never move on resize, so the node stays valid; a failed
+ * grow only leaves the table fuller than intended.
+ */
+static ANVHashMapNode* link_at(ANVHashMap* map, ANVHashMapNode** link, void* key, void* value, const size_t hash)
 {
+    ANVHashMapNode* node = create_node(map, key, value, hash);
+    if (!node)
+    {
+        return NULL;
+    }
+
+    node->next = *link;
+    *link = node;
+    map->size++;
+    (void)check_and_resize(map);
+    return node;
+}
+
+ANV_API void** anv_hashmap_entry(ANVHashMap* map, void* key, bool* inserted_out)
+{
+    if (inserted_out)
+    {
+        *inserted_out = false;
+    }
     if (!map || !key)
     {
-        return -1;
+        return NULL;
     }
 
-    const size_t index = get_bucket_index(map, key);
-    ANVHashMapNode* node = map->buckets[index];
-    ANVHashMapNode* prev = NULL;
+    migrate_step(map);
 
-    while (node)
+    const size_t hash = hash_key(map, key);
+    ANVHashMapNode** link = probe_chain(map, key, hash);
+    ANVHashMapNode* node = *link;
+    if (!node)
     {
-        if (map->key_equals(node->key, key))
+        node = link_at(map, link, key, NULL, hash);
+        if (!node)
         {
-            if (prev)
-            {
-                prev->next = node->next;
-            }
-            else
-            {
-                map->buckets[index] = node->next;
-            }
-
-            free_node(map, node, should_free_key, should_free_value);
-            map->size--;
-            return 0;
+            return NULL;
+        }
+        if (inserted_out)
+        {
+            *inserted_out = true;
         }
-        prev = node;
-        node = node->next;
     }
-
-    return -1;
+    return &node->value;
 }
 
-ANV_API void* anv_hashmap_remove_get(ANVHashMap* map, const void* key, const bool should_free_key)
+ANV_API void* anv_hashmap_compute_if_absent(ANVHashMap* map, void* key, const anv_hashmap_compute_func compute,
+                                            void* context, bool* inserted_out)
 {
-    if (!map || !key)
+    if (inserted_out)
+    {
+        *inserted_out = false;
+    }
+    if (!map || !key || !compute)
     {
         return NULL;
     }
 
-    const size_t index = get_bucket_index(map, key);
-    ANVHashMapNode* node = map->buckets[index];
-    ANVHashMapNode* prev = NULL;
+    migrate_step(map);
 
-    while (node)
+    const size_t hash = hash_key(map, key);
+    ANVHashMapNode** link = probe_chain(map, key, hash);
+    if (*link)
     {
-        if (map->key_equals(node->key, key))
-        {
-            if (prev)
-            {
-                prev->next = node->next;
-            }
-            else
-            {
-                map->buckets[index] = node->next;
-            }
+        return (*link)->value;
+    }
 
-            void* value = node->value;
-            free_node(map, node, should_free_key, false);
-            map->size--;
-            return value;
-        }
-        prev = node;
-        node = node->next;
+    void* value = compute(key, context);
+    if (!value)
+    {
+        return NULL;
+    }
+    if (!link_at(map, link, key, value, hash))
+    {
+        // The caller never saw the value, so nobody else could free it
+        anv_alloc_data_deallocate(&map->alloc, value);
+        return NULL;
     }
 
-    return NULL;
+    if (inserted_out)
+    {
+        *inserted_out = true;
+    }
+    return value;
+}
+
+ANV_API int anv_hashmap_merge(ANVHashMap* map, void* key, void* value, const anv_hashmap_merge_func merge,
+                              void* context)
+{
+    if (!map || !key || !merge)
+    {
+        return -1;
+    }
+
+    migrate_step(map);
+
+    const size_t hash = hash_key(map, key);
+    ANVHashMapNode** link = probe_chain(map, key, hash);
+    ANVHashMapNode* node = *link;
+    if (!node)
+    {
+        return link_at(map, link, key, value, hash) ? 0 : -1;
+    }
+
+    node->value = merge(node->value, value, context);
+    if (!node->value)
+    {
+        *link = node->next;
+        free_node(map, node, false, false);
+        map->size--;
+    }
+    return 0;
 }
 
 //==============================================================================
@@ -457,9 +873,9 @@ ANV_API int anv_hashmap_get_keys(const ANVHashMap* map, void*** keys_out, size_t
     }
 
     size_t key_index = 0;
-    for (size_t i = 0; i < map->bucket_count; i++)
+    for (size_t i = 0; i < total_bucket_count(map); i++)
     {
-        const ANVHashMapNode* node = map->buckets[i];
+        const ANVHashMapNode* node = chain_at(map, i);
         while (node)
         {
             keys[key_index++] = node->key;
@@ -493,9 +909,9 @@ ANV_API int anv_hashmap_get_values(const ANVHashMap* map, void*** values_out, si
     }
 
     size_t value_index = 0;
-    for (size_t i = 0; i < map->bucket_count; i++)
+    for (size_t i = 0; i < total_bucket_count(map); i++)
     {
-        const ANVHashMapNode* node = map->buckets[i];
+        const ANVHashMapNode* node = chain_at(map, i);
         while (node)
         {
             values[value_index++] = node->value;
@@ -515,9 +931,9 @@ ANV_API void anv_hashmap_for_each(const ANVHashMap* map, void (*action)(void* ke
         return;
     }
 
-    for (size_t i = 0; i < map->bucket_count; i++)
+    for (size_t i = 0; i < total_bucket_count(map); i++)
     {
-        const ANVHashMapNode* node = map->buckets[i];
+        const ANVHashMapNode* node = chain_at(map, i);
         while (node)
         {
             action(node->key, node->value);
@@ -537,21 +953,18 @@ ANV_API ANVHashMap* anv_hashmap_copy(ANVHashMap* map)
         return NULL;
     }
 
-    ANVHashMap* copy = anv_hashmap_create(&map->alloc, map->hash,
-                                          map->key_equals, map->bucket_count);
+    ANVHashMap* copy = create_like(map);
     if (!copy)
     {
         return NULL;
     }
 
-    copy->max_load_factor = map->max_load_factor;
-
-    for (size_t i = 0; i < map->bucket_count; i++)
+    for (size_t i = 0; i < total_bucket_count(map); i++)
     {
-        const ANVHashMapNode* node = map->buckets[i];
+        const ANVHashMapNode* node = chain_at(map, i);
         while (node)
         {
-            if (anv_hashmap_put(copy, node->key, node->value) != 0)
+            if (insert_new(copy, node->key, node->value, node->hash) != 0)
             {
                 anv_hashmap_destroy(copy, false, false);
                 return NULL;
@@ -571,18 +984,15 @@ ANV_API ANVHashMap* anv_hashmap_copy_deep(ANVHashMap* map,
         return NULL;
     }
 
-    ANVHashMap* copy = anv_hashmap_create(&map->alloc, map->hash,
-                                          map->key_equals, map->bucket_count);
+    ANVHashMap* copy = create_like(map);
     if (!copy)
     {
         return NULL;
     }
 
-    copy->max_load_factor = map->max_load_factor;
-
-    for (size_t i = 0; i < map->bucket_count; i++)
+    for (size_t i = 0; i < total_bucket_count(map); i++)
     {
-        const ANVHashMapNode* node = map->buckets[i];
+        const ANVHashMapNode* node = chain_at(map, i);
         while (node)
         {
             void* copied_key = key_copy ? key_copy(node->key) : node->key;
@@ -602,7 +1012,7 @@ ANV_API ANVHashMap* anv_hashmap_copy_deep(ANVHashMap* map,
                 return NULL;
             }
 
-            if (anv_hashmap_put(copy, copied_key, copied_value) != 0)
+            if (insert_new(copy, copied_key, copied_value, node->hash) != 0)
             {
                 if (key_copy)
                 {
@@ -678,10 +1088,10 @@ static int hashmap_iterator_next(const ANVIterator* it)
 
     state->current_node = state->current_node->next;
 
-    while (!state->current_node && state->current_bucket < state->map->bucket_count - 1)
+    while (!state->current_node && state->current_bucket < total_bucket_count(state->map) - 1)
     {
         state->current_bucket++;
-        state->current_node = state->map->buckets[state->current_bucket];
+        state->current_node = chain_at(state->map, state->current_bucket);
     }
 
     return 0;
@@ -710,12 +1120,12 @@ static void hashmap_iterator_reset(const ANVIterator* it)
     state->current_bucket = 0;
     state->current_node = NULL;
 
-    for (size_t i = 0; i < state->map->bucket_count; i++)
+    for (size_t i = 0; i < total_bucket_count(state->map); i++)
     {
-        if (state->map->buckets[i])
+        if (chain_at(state->map, i))
         {
             state->current_bucket = i;
-            state->current_node = state->map->buckets[i];
+            state->current_node = chain_at(state->map, i);
             break;
         }
     }
@@ -769,12 +1179,12 @@ ANV_API ANVIterator anv_hashmap_iterator(const ANVHashMap* map)
     state->current_bucket = 0;
     state->current_node = NULL;
 
-    for (size_t i = 0; i < map->bucket_count; i++)
+    for (size_t i = 0; i < total_bucket_count(map); i++)
     {
-        if (map->buckets[i])
+        if (chain_at(map, i))
         {
             state->current_bucket = i;
-            state->current_node = map->buckets[i];
+            state->current_node = chain_at(map, i);
             break;
         }
     }
@@ -10,6 +10,7 @@
 
 #include "hashset.h"
 #include "pair.h"
+#include "anvil/memory/scratch.h"
 
 //==============================================================================
 // Helper functions
@@ -28,6 +29,75 @@ static void hashset_action_wrapper(void* key, void* value)
     }
 }
 
+// Chain i of the map, counting the current table's buckets first and then the
+// old table's; unmigrated buckets of the current table are skipped, as in hashmap.c
+static const ANVHashMapNode* chain_at(const ANVHashMap* map, const size_t i)
+{
+    if (i >= map->bucket_count)
+    {
+        return map->old_buckets[i - map->bucket_count];
+    }
+    if (map->old_buckets && i % map->old_bucket_count >= map->migrate_index)
+    {
+        return NULL;
+    }
+    return map->buckets[i];
+}
+
+// Collect the keys of 'set' into 'keys'. With a filter set, only keys whose
+// presence in the filter matches 'keep_present' are collected.
+static size_t gather_keys(const ANVHashSet* set, const ANVHashSet* filter, const bool keep_present, void** keys)
+{
+    const ANVHashMap* map = set->map;
+    size_t count = 0;
+    for (size_t i = 0; i < map->bucket_count + map->old_bucket_count; i++)
+    {
+        for (const ANVHashMapNode* node = chain_at(map, i); node; node = node->next)
+        {
+            if (!filter || (anv_hashset_contains(filter, node->key) != 0) == keep_present)
+            {
+                keys[count++] = node->key;
+            }
+        }
+    }
+    return count;
+}
+
+// Create an empty set with the same functions and hashing and resize modes as 'like'
+static ANVHashSet* create_like(const ANVHashSet* like, const size_t capacity)
+{
+    ANVHashMap* map = like->map;
+    ANVHashSet* set = map->seeded_hash
+                          ? anv_hashset_create_seeded(&map->alloc, map->seeded_hash, map->key_equals, capacity, &map->seed)
+                          : anv_hashset_create(&map->alloc, map->hash, map->key_equals, capacity);
+    if (set)
+    {
+        set->map->incremental_resize = map->incremental_resize;
+    }
+    return set;
+}
+
+// Create a set shaped like 'like', sized so adding 'count' keys never rehashes
+static ANVHashSet* build_result(const ANVHashSet* like, void** keys, const size_t count)
+{
+    const size_t capacity = count > 0 ? (size_t)((double)count / like->map->max_load_factor) + 1 : 0;
+    ANVHashSet* result = create_like(like, capacity);
+    if (!result)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (anv_hashset_add(result, keys[i]) != 0)
+        {
+            anv_hashset_destroy(result, false);
+            return NULL;
+        }
+    }
+    return result;
+}
+
 //==============================================================================
 // Constants
 //==============================================================================
@@ -63,6 +133,31 @@ ANV_API ANVHashSet* anv_hashset_create(ANVAllocator* alloc, const anv_hash_func
     return set;
 }
 
+ANV_API ANVHashSet* anv_hashset_create_seeded(ANVAllocator* alloc, const anv_seeded_hash_func hash,
+                                              const key_equals_func key_equals, const size_t initial_capacity,
+                                              const ANVHashSeed* seed)
+{
+    if (!alloc || !hash || !key_equals)
+    {
+        return NULL;
+    }
+
+    ANVHashSet* set = anv_alloc_allocate(alloc, sizeof(ANVHashSet));
+    if (!set)
+    {
+        return NULL;
+    }
+
+    set->map = anv_hashmap_create_seeded(alloc, hash, key_equals, initial_capacity, seed);
+    if (!set->map)
+    {
+        anv_alloc_deallocate(alloc, set);
+        return NULL;
+    }
+
+    return set;
+}
+
 ANV_API void anv_hashset_destroy(ANVHashSet* set, const bool should_free_keys)
 {
     if (!set)
@@ -153,6 +248,29 @@ ANV_API int anv_hashset_contains(const ANVHashSet* set, const void* key)
     return anv_hashmap_contains_key(set->map, key);
 }
 
+ANV_API size_t anv_hashset_contains_batch(const ANVHashSet* set, const void* const* keys, const size_t count,
+                                          bool* results_out)
+{
+    if (!set || !set->map || !keys || !results_out)
+    {
+        return 0;
+    }
+
+    // Every stored value is HASHSET_PRESENT, so a non-NULL value means present
+    void* values[ANV_HASHMAP_BATCH_WINDOW];
+    size_t found = 0;
+    for (size_t start = 0; start < count; start += ANV_HASHMAP_BATCH_WINDOW)
+    {
+        const size_t window = count - start < ANV_HASHMAP_BATCH_WINDOW ? count - start : ANV_HASHMAP_BATCH_WINDOW;
+        found += anv_hashmap_get_batch(set->map, keys + start, window, values);
+        for (size_t i = 0; i < window; i++)
+        {
+            results_out[start + i] = values[i] != NULL;
+        }
+    }
+    return found;
+}
+
 ANV_API int anv_hashset_remove(ANVHashSet* set, const void* key, const bool should_free_key)
 {
     if (!set || !set->map || !key)
@@ -213,40 +331,19 @@ ANV_API ANVHashSet* anv_hashset_union(const ANVHashSet* set1, const ANVHashSet*
         return NULL;
     }
 
-    ANVHashSet* result = anv_hashset_create(&set1->map->alloc, set1->map->hash,
-                                            set1->map->key_equals, 0);
-    if (!result)
+    ANVScratchFrame frame = anv_scratch_begin();
+    void** keys = anv_scratch_allocate(&frame, sizeof(void*) * (set1->map->size + set2->map->size + 1));
+    if (!keys)
     {
+        anv_scratch_end(&frame);
         return NULL;
     }
 
-    ANVIterator it1 = anv_hashmap_iterator(set1->map);
-    while (it1.has_next(&it1))
-    {
-        const ANVPair* pair = it1.get(&it1);
-
-        if (pair && anv_hashset_add(result, pair->first) != 0)
-        {
-            it1.destroy(&it1);
-            anv_hashset_destroy(result, false);
-            return NULL;
-        }
-        it1.next(&it1);
-    }
-    it1.destroy(&it1);
-
-    ANVIterator it2 = anv_hashmap_iterator(set2->map);
-    while (it2.has_next(&it2))
-    {
-        const ANVPair* pair = it2.get(&it2);
-        if (pair)
-        {
-            anv_hashset_add(result, pair->first);
-        }
-        it2.next(&it2);
-    }
-    it2.destroy(&it2);
+    size_t count = gather_keys(set1, NULL, false, keys);
+    count += gather_keys(set2, set1, false, keys + count);
 
+    ANVHashSet* result = build_result(set1, keys, count);
+    anv_scratch_end(&frame);
     return result;
 }
 
@@ -257,34 +354,20 @@ ANV_API ANVHashSet* anv_hashset_intersection(const ANVHashSet* set1, const ANVHa
         return NULL;
     }
 
-    ANVHashSet* result = anv_hashset_create(&set1->map->alloc, set1->map->hash,
-                                            set1->map->key_equals, 0);
-    if (!result)
-    {
-        return NULL;
-    }
-
     const ANVHashSet* smaller = anv_hashset_size(set1) <= anv_hashset_size(set2) ? set1 : set2;
     const ANVHashSet* larger = (smaller == set1) ? set2 : set1;
 
-    ANVIterator it = anv_hashmap_iterator(smaller->map);
-    while (it.has_next(&it))
+    ANVScratchFrame frame = anv_scratch_begin();
+    void** keys = anv_scratch_allocate(&frame, sizeof(void*) * (smaller->map->size + 1));
+    if (!keys)
     {
-        const ANVPair* pair = it.get(&it);
-
-        if (pair && anv_hashset_contains(larger, pair->first))
-        {
-            if (anv_hashset_add(result, pair->first) != 0)
-            {
-                it.destroy(&it);
-                anv_hashset_destroy(result, false);
-                return NULL;
-            }
-        }
-        it.next(&it);
+        anv_scratch_end(&frame);
+        return NULL;
     }
-    it.destroy(&it);
 
+    const size_t count = gather_keys(smaller, larger, true, keys);
+    ANVHashSet* result = build_result(set1, keys, count);
+    anv_scratch_end(&frame);
     return result;
 }
 
@@ -295,30 +378,18 @@ ANV_API ANVHashSet* anv_hashset_difference(const ANVHashSet* set1, const ANVHash
         return NULL;
     }
 
-    ANVHashSet* result = anv_hashset_create(&set1->map->alloc, set1->map->hash,
-                                            set1->map->key_equals, 0);
-    if (!result)
+    ANVScratchFrame frame = anv_scratch_begin();
+    void** keys = anv_scratch_allocate(&frame, sizeof(void*) * (set1->map->size + 1));
+    if (!keys)
     {
+        anv_scratch_end(&frame);
         return NULL;
     }
 
-    ANVIterator it = anv_hashmap_iterator(set1->map);
-    while (it.has_next(&it))
-    {
-        const ANVPair* pair = it.get(&it);
-        if (pair && (!set2 || !set2->map || !anv_hashset_contains(set2, pair->first)))
-        {
-            if (anv_hashset_add(result, pair->first) != 0)
-            {
-                it.destroy(&it);
-                anv_hashset_destroy(result, false);
-                return NULL;
-            }
-        }
-        it.next(&it);
-    }
-    it.destroy(&it);
-
+    const ANVHashSet* filter = set2 && set2->map ? set2 : NULL;
+    const size_t count = gather_keys(set1, filter, false, keys);
+    ANVHashSet* result = build_result(set1, keys, count);
+    anv_scratch_end(&frame);
     return result;
 }
 
@@ -388,8 +459,7 @@ ANV_API ANVHashSet* anv_hashset_copy(const ANVHashSet* set)
         return NULL;
     }
 
-    ANVHashSet* copy = anv_hashset_create(&set->map->alloc, set->map->hash,
-                                          set->map->key_equals, set->map->bucket_count);
+    ANVHashSet* copy = create_like(set, set->map->bucket_count);
     if (!copy)
     {
         return NULL;
@@ -420,8 +490,7 @@ ANV_API ANVHashSet* anv_hashset_copy_deep(const ANVHashSet* set, const anv_copy_
         return NULL;
     }
 
-    ANVHashSet* copy = anv_hashset_create(&set->map->alloc, set->map->hash,
-                                          set->map->key_equals, set->map->bucket_count);
+    ANVHashSet* copy = create_like(set, set->map->bucket_count);
     if (!copy)
     {
         return NULL;
@@ -576,6 +645,11 @@ ANV_API ANVIterator anv_hashset_iterator(const ANVHashSet* set)
     it.is_valid = hashset_iterator_is_valid;
     it.destroy = hashset_iterator_destroy;
 
+    if (!set || !set->map)
+    {
+        return it;
+    }
+
     HashSetIteratorState* state = anv_alloc_allocate(&set->map->alloc, sizeof(HashSetIteratorState));
     if (!state)
     {
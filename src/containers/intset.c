@@ -0,0 +1,732 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include <string.h>
+
+#include "intset.h"
+#include "anvil/algorithms/hash.h"
+
+//==============================================================================
+// Default constants
+//==============================================================================
+
+#define DEFAULT_CAPACITY ANV_DEFAULT_CAPACITY
+#define MIN_CAPACITY ((size_t)8)
+
+// Largest probe distance + 1 a slot can record
+#define MAX_DISTANCE UINT8_MAX
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+static size_t home_slot(const ANVIntSet* set, const uint64_t key)
+{
+    return (size_t)anv_hash_mix64(key ^ set->seed) & (set->capacity - 1);
+}
+
+// Keys a table of 'capacity' slots holds before it must grow (7/8 load)
+static size_t max_entries(const size_t capacity)
+{
+    return capacity - capacity / 8;
+}
+
+static size_t capacity_for(const size_t count)
+{
+    size_t capacity = MIN_CAPACITY;
+    while (max_entries(capacity) < count)
+    {
+        if (capacity > SIZE_MAX / 2)
+        {
+            return 0;
+        }
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static int allocate_table(ANVIntSet* set, const size_t capacity)
+{
+    if (capacity == 0 || capacity > SIZE_MAX / (sizeof(uint64_t) + 1))
+    {
+        return -1;
+    }
+
+    uint64_t* keys = anv_alloc_allocate(&set->alloc, capacity * (sizeof(uint64_t) + 1));
+    if (!keys)
+    {
+        return -1;
+    }
+
+    set->keys = keys;
+    set->distances = (uint8_t*)(keys + capacity);
+    set->capacity = capacity;
+    memset(set->distances, 0, capacity);
+    return 0;
+}
+
+/**
+ * Probe for key. Returns true with *index_out at its slot if present.
+ * Otherwise *index_out is the slot it belongs in: the first slot whose key
+ * is closer to home than key would be there. Either way *distance_out is
+ * key's probe distance + 1 at *index_out.
+ */
+static bool locate(const ANVIntSet* set, const uint64_t key, size_t* index_out, size_t* distance_out)
+{
+    const size_t mask = set->capacity - 1;
+    size_t index = home_slot(set, key);
+    size_t distance = 1;
+
+    for (;;)
+    {
+        const uint8_t existing = set->distances[index];
+        if (existing < distance)
+        {
+            *index_out = index;
+            *distance_out = distance;
+            return false;
+        }
+        if (existing == distance && set->keys[index] == key)
+        {
+            *index_out = index;
+            *distance_out = distance;
+            return true;
+        }
+        index = (index + 1) & mask;
+        distance++;
+    }
+}
+
+/**
+ * Place an absent key at the slot locate chose, shifting the rest of the run
+ * forward one slot. Every shifted key moves one further from home, so fail
+ * without changing anything if that would overflow a distance byte. The
+ * caller guarantees an empty slot exists.
+ */
+static int insert_at(ANVIntSet* set, const uint64_t key, const size_t index, const size_t distance)
+{
+    if (distance > MAX_DISTANCE)
+    {
+        return -1;
+    }
+
+    const size_t mask = set->capacity - 1;
+    size_t empty = index;
+    while (set->distances[empty] != 0)
+    {
+        if (set->distances[empty] == MAX_DISTANCE)
+        {
+            return -1;
+        }
+        empty = (empty + 1) & mask;
+    }
+
+    while (empty != index)
+    {
+        const size_t previous = (empty - 1) & mask;
+        set->keys[empty] = set->keys[previous];
+        set->distances[empty] = (uint8_t)(set->distances[previous] + 1);
+        empty = previous;
+    }
+
+    set->keys[index] = key;
+    set->distances[index] = (uint8_t)distance;
+    set->size++;
+    return 0;
+}
+
+/**
+ * Move every key into a table of at least new_capacity slots. Doubles
+ * again in the unlikely case a run grows past what a distance byte holds,
+ * but gives up once the table is mostly empty.
+ */
+static int rehash(ANVIntSet* set, size_t new_capacity)
+{
+    const ANVIntSet old = *set;
+
+    for (;;)
+    {
+        if (allocate_table(set, new_capacity) != 0)
+        {
+            *set = old;
+            return -1;
+        }
+        set->size = 0;
+
+        bool placed = true;
+        for (size_t i = 0; i < old.capacity && placed; i++)
+        {
+            if (old.distances[i] == 0)
+            {
+                continue;
+            }
+
+            size_t index;
+            size_t distance;
+            locate(set, old.keys[i], &index, &distance);
+            placed = insert_at(set, old.keys[i], index, distance) == 0;
+        }
+
+        if (placed)
+        {
+            anv_alloc_deallocate(&set->alloc, old.keys);
+            return 0;
+        }
+
+        anv_alloc_deallocate(&set->alloc, set->keys);
+        if (new_capacity > SIZE_MAX / 2 || new_capacity / 8 > old.size)
+        {
+            *set = old;
+            return -1;
+        }
+        new_capacity *= 2;
+    }
+}
+
+/**
+ * Create an empty set with the allocator of 'like' and a fresh seed, so
+ * copying keys across in slot order cannot cluster.
+ */
+static ANVIntSet* create_like(const ANVIntSet* like, const size_t capacity)
+{
+    ANVAllocator alloc = like->alloc;
+    return anv_intset_create(&alloc, capacity);
+}
+
+//==============================================================================
+// Creation and destruction functions
+//==============================================================================
+
+ANV_API ANVIntSet* anv_intset_create(ANVAllocator* alloc, const size_t initial_capacity)
+{
+    if (!alloc)
+    {
+        return NULL;
+    }
+
+    ANVIntSet* set = anv_alloc_allocate(alloc, sizeof(ANVIntSet));
+    if (!set)
+    {
+        return NULL;
+    }
+
+    memset(set, 0, sizeof(ANVIntSet));
+    set->alloc = *alloc;
+    set->seed = anv_hash_random_seed().k0;
+
+    if (allocate_table(set, capacity_for(initial_capacity > 0 ? initial_capacity : DEFAULT_CAPACITY)) != 0)
+    {
+        anv_alloc_deallocate(alloc, set);
+        return NULL;
+    }
+    return set;
+}
+
+ANV_API void anv_intset_destroy(ANVIntSet* set)
+{
+    if (!set)
+    {
+        return;
+    }
+
+    anv_alloc_deallocate(&set->alloc, set->keys);
+    anv_alloc_deallocate(&set->alloc, set);
+}
+
+ANV_API void anv_intset_clear(ANVIntSet* set)
+{
+    if (!set)
+    {
+        return;
+    }
+
+    memset(set->distances, 0, set->capacity);
+    set->size = 0;
+}
+
+ANV_API int anv_intset_reserve(ANVIntSet* set, const size_t count)
+{
+    if (!set)
+    {
+        return -1;
+    }
+    if (count <= max_entries(set->capacity))
+    {
+        return 0;
+    }
+
+    const size_t capacity = capacity_for(count);
+    return capacity ? rehash(set, capacity) : -1;
+}
+
+//==============================================================================
+// Information functions
+//==============================================================================
+
+ANV_API size_t anv_intset_size(const ANVIntSet* set)
+{
+    return set ? set->size : 0;
+}
+
+ANV_API int anv_intset_is_empty(const ANVIntSet* set)
+{
+    return !set || set->size == 0;
+}
+
+ANV_API double anv_intset_load_factor(const ANVIntSet* set)
+{
+    if (!set || set->capacity == 0)
+    {
+        return 0.0;
+    }
+    return (double)set->size / (double)set->capacity;
+}
+
+//==============================================================================
+// Integer set operations
+//==============================================================================
+
+ANV_API int anv_intset_add(ANVIntSet* set, const uint64_t key)
+{
+    return anv_intset_add_check(set, key, NULL);
+}
+
+ANV_API int anv_intset_add_check(ANVIntSet* set, const uint64_t key, bool* was_added_out)
+{
+    if (was_added_out)
+    {
+        *was_added_out = false;
+    }
+    if (!set)
+    {
+        return -1;
+    }
+
+    for (;;)
+    {
+        size_t index;
+        size_t distance;
+        if (locate(set, key, &index, &distance))
+        {
+            return 0;
+        }
+
+        if (set->size < max_entries(set->capacity) && insert_at(set, key, index, distance) == 0)
+        {
+            if (was_added_out)
+            {
+                *was_added_out = true;
+            }
+            return 0;
+        }
+
+        // Full, or the run is too long to shift: grow and probe again. A
+        // sparse table whose runs still overflow will not be helped by growing
+        if (set->size < set->capacity / 8 || set->capacity > SIZE_MAX / 2 ||
+            rehash(set, set->capacity * 2) != 0)
+        {
+            return -1;
+        }
+    }
+}
+
+ANV_API int anv_intset_contains(const ANVIntSet* set, const uint64_t key)
+{
+    if (!set)
+    {
+        return 0;
+    }
+
+    size_t index;
+    size_t distance;
+    return locate(set, key, &index, &distance);
+}
+
+ANV_API int anv_intset_remove(ANVIntSet* set, const uint64_t key)
+{
+    if (!set)
+    {
+        return -1;
+    }
+
+    size_t index;
+    size_t distance;
+    if (!locate(set, key, &index, &distance))
+    {
+        return -1;
+    }
+
+    // Backward shift: pull the rest of the run one slot toward home
+    const size_t mask = set->capacity - 1;
+    size_t next = (index + 1) & mask;
+    while (set->distances[next] > 1)
+    {
+        set->keys[index] = set->keys[next];
+        set->distances[index] = (uint8_t)(set->distances[next] - 1);
+        index = next;
+        next = (next + 1) & mask;
+    }
+
+    set->distances[index] = 0;
+    set->size--;
+    return 0;
+}
+
+//==============================================================================
+// Set operations
+//==============================================================================
+
+ANV_API ANVIntSet* anv_intset_union(const ANVIntSet* set1, const ANVIntSet* set2)
+{
+    if (!set1 || !set2)
+    {
+        return NULL;
+    }
+
+    ANVIntSet* result = anv_intset_copy(set1);
+    if (!result || anv_intset_reserve(result, set1->size + set2->size) != 0)
+    {
+        anv_intset_destroy(result);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < set2->capacity; i++)
+    {
+        if (set2->distances[i] && anv_intset_add(result, set2->keys[i]) != 0)
+        {
+            anv_intset_destroy(result);
+            return NULL;
+        }
+    }
+    return result;
+}
+
+ANV_API ANVIntSet* anv_intset_intersection(const ANVIntSet* set1, const ANVIntSet* set2)
+{
+    if (!set1 || !set2)
+    {
+        return NULL;
+    }
+
+    // Walk the smaller set, probe the larger
+    const ANVIntSet* smaller = set1->size <= set2->size ? set1 : set2;
+    const ANVIntSet* larger = smaller == set1 ? set2 : set1;
+
+    ANVIntSet* result = create_like(set1, smaller->size);
+    if (!result)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < smaller->capacity; i++)
+    {
+        if (smaller->distances[i] && anv_intset_contains(larger, smaller->keys[i]) &&
+            anv_intset_add(result, smaller->keys[i]) != 0)
+        {
+            anv_intset_destroy(result);
+            return NULL;
+        }
+    }
+    return result;
+}
+
+ANV_API ANVIntSet* anv_intset_difference(const ANVIntSet* set1, const ANVIntSet* set2)
+{
+    if (!set1 || !set2)
+    {
+        return NULL;
+    }
+
+    ANVIntSet* result = create_like(set1, set1->size);
+    if (!result)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < set1->capacity; i++)
+    {
+        if (set1->distances[i] && !anv_intset_contains(set2, set1->keys[i]) &&
+            anv_intset_add(result, set1->keys[i]) != 0)
+        {
+            anv_intset_destroy(result);
+            return NULL;
+        }
+    }
+    return result;
+}
+
+ANV_API int anv_intset_is_subset(const ANVIntSet* subset, const ANVIntSet* superset)
+{
+    if (!subset || !superset)
+    {
+        return 0;
+    }
+    if (subset->size > superset->size)
+    {
+        return 0;
+    }
+
+    for (size_t i = 0; i < subset->capacity; i++)
+    {
+        if (subset->distances[i] && !anv_intset_contains(superset, subset->keys[i]))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+//==============================================================================
+// Bulk operations
+//==============================================================================
+
+ANV_API int anv_intset_get_elements(const ANVIntSet* set, uint64_t** keys_out, size_t* count_out)
+{
+    if (!set || !keys_out || !count_out)
+    {
+        return -1;
+    }
+
+    if (set->size == 0)
+    {
+        *keys_out = NULL;
+        *count_out = 0;
+        return 0;
+    }
+
+    uint64_t* keys = anv_alloc_allocate(&set->alloc, set->size * sizeof(uint64_t));
+    if (!keys)
+    {
+        return -1;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < set->capacity; i++)
+    {
+        if (set->distances[i])
+        {
+            keys[count++] = set->keys[i];
+        }
+    }
+
+    *keys_out = keys;
+    *count_out = count;
+    return 0;
+}
+
+ANV_API void anv_intset_for_each(const ANVIntSet* set, void (*action)(uint64_t key))
+{
+    if (!set || !action)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < set->capacity; i++)
+    {
+        if (set->distances[i])
+        {
+            action(set->keys[i]);
+        }
+    }
+}
+
+//==============================================================================
+// Integer set copying functions
+//==============================================================================
+
+ANV_API ANVIntSet* anv_intset_copy(const ANVIntSet* set)
+{
+    if (!set)
+    {
+        return NULL;
+    }
+
+    ANVIntSet* copy = anv_alloc_allocate(&set->alloc, sizeof(ANVIntSet));
+    if (!copy)
+    {
+        return NULL;
+    }
+
+    // Same seed and capacity, so the table can be copied byte for byte
+    *copy = *set;
+    if (allocate_table(copy, set->capacity) != 0)
+    {
+        anv_alloc_deallocate(&copy->alloc, copy);
+        return NULL;
+    }
+
+    memcpy(copy->keys, set->keys, set->capacity * (sizeof(uint64_t) + 1));
+    return copy;
+}
+
+//==============================================================================
+// Iterator implementation
+//==============================================================================
+
+typedef struct IntSetIteratorState
+{
+    const ANVIntSet* set;
+    size_t current_index; // Next full slot, or capacity at the end
+} IntSetIteratorState;
+
+static size_t next_full(const ANVIntSet* set, size_t index)
+{
+    while (index < set->capacity && set->distances[index] == 0)
+    {
+        index++;
+    }
+    return index;
+}
+
+static void* intset_iterator_get(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return NULL;
+    }
+
+    const IntSetIteratorState* state = it->data_state;
+    if (state->current_index >= state->set->capacity)
+    {
+        return NULL;
+    }
+
+    return &state->set->keys[state->current_index];
+}
+
+static int intset_iterator_has_next(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return 0;
+    }
+
+    const IntSetIteratorState* state = it->data_state;
+    return state->current_index < state->set->capacity;
+}
+
+static int intset_iterator_next(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return -1;
+    }
+
+    IntSetIteratorState* state = it->data_state;
+    if (state->current_index >= state->set->capacity)
+    {
+        return -1;
+    }
+
+    state->current_index = next_full(state->set, state->current_index + 1);
+    return 0;
+}
+
+static int intset_iterator_has_prev(const ANVIterator* it)
+{
+    (void)it;
+    return 0;
+}
+
+static int intset_iterator_prev(const ANVIterator* it)
+{
+    (void)it;
+    return -1;
+}
+
+static void intset_iterator_reset(const ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return;
+    }
+
+    IntSetIteratorState* state = it->data_state;
+    state->current_index = next_full(state->set, 0);
+}
+
+static int intset_iterator_is_valid(const ANVIterator* it)
+{
+    return it && it->data_state != NULL;
+}
+
+static void intset_iterator_destroy(ANVIterator* it)
+{
+    if (!it || !it->data_state)
+    {
+        return;
+    }
+
+    const IntSetIteratorState* state = it->data_state;
+    anv_alloc_deallocate(&state->set->alloc, it->data_state);
+    it->data_state = NULL;
+}
+
+ANV_API ANVIterator anv_intset_iterator(const ANVIntSet* set)
+{
+    ANVIterator it = {0};
+
+    it.get = intset_iterator_get;
+    it.has_next = intset_iterator_has_next;
+    it.next = intset_iterator_next;
+    it.has_prev = intset_iterator_has_prev;
+    it.prev = intset_iterator_prev;
+    it.reset = intset_iterator_reset;
+    it.is_valid = intset_iterator_is_valid;
+    it.destroy = intset_iterator_destroy;
+
+    if (!set)
+    {
+        return it;
+    }
+
+    IntSetIteratorState* state = anv_alloc_allocate(&set->alloc, sizeof(IntSetIteratorState));
+    if (!state)
+    {
+        return it;
+    }
+
+    state->set = set;
+    state->current_index = next_full(set, 0);
+
+    it.alloc = set->alloc;
+    it.data_state = state;
+    return it;
+}
+
+ANV_API ANVIntSet* anv_intset_from_iterator(ANVIterator* it, ANVAllocator* alloc)
+{
+    if (!it || !alloc)
+    {
+        return NULL;
+    }
+
+    if (!it->is_valid || !it->is_valid(it))
+    {
+        return NULL;
+    }
+
+    ANVIntSet* set = anv_intset_create(alloc, 0);
+    if (!set)
+    {
+        return NULL;
+    }
+
+    while (it->has_next(it))
+    {
+        const uint64_t* key = it->get(it);
+        if (key && anv_intset_add(set, *key) != 0)
+        {
+            anv_intset_destroy(set);
+            return NULL;
+        }
+
+        if (it->next(it) != 0)
+        {
+            break;
+        }
+    }
+
+    return set;
+}
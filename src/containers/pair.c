@@ -12,7 +12,7 @@
 
 ANV_API ANVPair* anv_pair_create(ANVAllocator* alloc, void* first, void* second)
 {
-    if (!alloc || !alloc->allocate || !alloc->deallocate)
+    if (!anv_alloc_is_valid(alloc))
     {
         return NULL;
     }
@@ -10,7 +10,7 @@
 
 static ANVQueueNode* create_node(const ANVQueue* queue, void* data)
 {
-    ANVQueueNode* node = anv_alloc_allocate(&queue->alloc, sizeof(ANVQueueNode));
+    ANVQueueNode* node = anv_slab_pool_allocate(queue->node_pool, &queue->alloc, sizeof(ANVQueueNode));
     if (!node)
     {
         return NULL;
@@ -33,7 +33,7 @@ static void free_node(const ANVQueue* queue, ANVQueueNode* node, const bool shou
         anv_alloc_data_deallocate(&queue->alloc, node->data);
     }
 
-    anv_alloc_deallocate(&queue->alloc, node);
+    anv_slab_pool_deallocate(queue->node_pool, &queue->alloc, node);
 }
 
 //==============================================================================
@@ -57,6 +57,7 @@ ANV_API ANVQueue* anv_queue_create(ANVAllocator* alloc)
     queue->back = NULL;
     queue->size = 0;
     queue->alloc = *alloc;
+    queue->node_pool = anv_slab_pool_create(alloc, sizeof(ANVQueueNode));
 
     return queue;
 }
@@ -69,6 +70,7 @@ ANV_API void anv_queue_destroy(ANVQueue* queue, const bool should_free_data)
     }
 
     anv_queue_clear(queue, should_free_data);
+    anv_slab_pool_destroy(&queue->alloc, queue->node_pool);
     anv_alloc_deallocate(&queue->alloc, queue);
 }
 
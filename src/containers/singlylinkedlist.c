@@ -35,6 +35,57 @@ static ANVSinglyLinkedNode* sll_sort_helper_merge(ANVSinglyLinkedNode* left, ANV
     return result;
 }
 
+// Each list frees nodes into its own pool, so nodes moving from src to dest
+// are reallocated by dest first when either list pools its nodes
+static int adopt_nodes(ANVSinglyLinkedList* dest, ANVSinglyLinkedList* src)
+{
+    if (!dest->node_pool && !src->node_pool)
+    {
+        return 0;
+    }
+
+    ANVSinglyLinkedNode* head = NULL;
+    ANVSinglyLinkedNode* tail = NULL;
+    for (const ANVSinglyLinkedNode* node = src->head; node; node = node->next)
+    {
+        ANVSinglyLinkedNode* copy = anv_slab_pool_allocate(dest->node_pool, &dest->alloc, sizeof(ANVSinglyLinkedNode));
+        if (!copy)
+        {
+            while (head)
+            {
+                ANVSinglyLinkedNode* next = head->next;
+                anv_slab_pool_deallocate(dest->node_pool, &dest->alloc, head);
+                head = next;
+            }
+            return -1;
+        }
+
+        copy->data = node->data;
+        copy->next = NULL;
+        if (tail)
+        {
+            tail->next = copy;
+        }
+        else
+        {
+            head = copy;
+        }
+        tail = copy;
+    }
+
+    ANVSinglyLinkedNode* node = src->head;
+    while (node)
+    {
+        ANVSinglyLinkedNode* next = node->next;
+        anv_slab_pool_deallocate(src->node_pool, &src->alloc, node);
+        node = next;
+    }
+
+    src->head = head;
+    src->tail = tail;
+    return 0;
+}
+
 //==============================================================================
 // Creation and destruction functions
 //==============================================================================
@@ -56,6 +107,7 @@ ANV_API ANVSinglyLinkedList* anv_sll_create(ANVAllocator* alloc)
     list->tail = NULL;
     list->size = 0;
     list->alloc = *alloc;
+    list->node_pool = anv_slab_pool_create(alloc, sizeof(ANVSinglyLinkedNode));
 
     return list;
 }
@@ -65,6 +117,7 @@ ANV_API void anv_sll_destroy(ANVSinglyLinkedList* list, const bool should_free_d
     if (list)
     {
         anv_sll_clear(list, should_free_data);
+        anv_slab_pool_destroy(&list->alloc, list->node_pool);
         anv_alloc_deallocate(&list->alloc, list);
     }
 }
@@ -84,7 +137,7 @@ ANV_API void anv_sll_clear(ANVSinglyLinkedList* list, const bool should_free_dat
         {
             anv_alloc_data_deallocate(&list->alloc, node->data);
         }
-        anv_alloc_deallocate(&list->alloc, node);
+        anv_slab_pool_deallocate(list->node_pool, &list->alloc, node);
         node = next;
     }
     list->head = NULL;
@@ -176,7 +229,7 @@ ANV_API int anv_sll_push_front(ANVSinglyLinkedList* list, void* data)
         return -1;
     }
 
-    ANVSinglyLinkedNode* node = anv_alloc_allocate(&list->alloc, sizeof(ANVSinglyLinkedNode));
+    ANVSinglyLinkedNode* node = anv_slab_pool_allocate(list->node_pool, &list->alloc, sizeof(ANVSinglyLinkedNode));
     if (!node)
     {
         return -1;
@@ -202,7 +255,7 @@ ANV_API int anv_sll_push_back(ANVSinglyLinkedList* list, void* data)
         return -1;
     }
 
-    ANVSinglyLinkedNode* node = anv_alloc_allocate(&list->alloc, sizeof(ANVSinglyLinkedNode));
+    ANVSinglyLinkedNode* node = anv_slab_pool_allocate(list->node_pool, &list->alloc, sizeof(ANVSinglyLinkedNode));
     if (!node)
     {
         return -1;
@@ -238,7 +291,7 @@ ANV_API int anv_sll_insert_at(ANVSinglyLinkedList* list, const size_t pos, void*
         return anv_sll_push_front(list, data);
     }
 
-    ANVSinglyLinkedNode* node = anv_alloc_allocate(&list->alloc, sizeof(ANVSinglyLinkedNode));
+    ANVSinglyLinkedNode* node = anv_slab_pool_allocate(list->node_pool, &list->alloc, sizeof(ANVSinglyLinkedNode));
     if (!node)
     {
         return -1;
@@ -252,7 +305,7 @@ ANV_API int anv_sll_insert_at(ANVSinglyLinkedList* list, const size_t pos, void*
         prev = prev->next;
         if (!prev)
         {
-            anv_alloc_deallocate(&list->alloc, node);
+            anv_slab_pool_deallocate(list->node_pool, &list->alloc, node);
             return -1;
         }
     }
@@ -299,7 +352,7 @@ ANV_API int anv_sll_remove(ANVSinglyLinkedList* list, const void* data, const an
                 anv_alloc_data_deallocate(&list->alloc, curr->data);
             }
 
-            anv_alloc_deallocate(&list->alloc, curr);
+            anv_slab_pool_deallocate(list->node_pool, &list->alloc, curr);
             list->size--;
             return 0;
         }
@@ -340,7 +393,7 @@ ANV_API int anv_sll_remove_at(ANVSinglyLinkedList* list, const size_t pos, const
         anv_alloc_data_deallocate(&list->alloc, curr->data);
     }
 
-    anv_alloc_deallocate(&list->alloc, curr);
+    anv_slab_pool_deallocate(list->node_pool, &list->alloc, curr);
     list->size--;
     return 0;
 }
@@ -360,7 +413,7 @@ ANV_API int anv_sll_pop_front(ANVSinglyLinkedList* list, const bool should_free_
         anv_alloc_data_deallocate(&list->alloc, node_to_remove->data);
     }
 
-    anv_alloc_deallocate(&list->alloc, node_to_remove);
+    anv_slab_pool_deallocate(list->node_pool, &list->alloc, node_to_remove);
     list->size--;
     return 0;
 }
@@ -395,7 +448,7 @@ ANV_API int anv_sll_pop_back(ANVSinglyLinkedList* list, const bool should_free_d
         anv_alloc_data_deallocate(&list->alloc, curr->data);
     }
 
-    anv_alloc_deallocate(&list->alloc, curr);
+    anv_slab_pool_deallocate(list->node_pool, &list->alloc, curr);
     list->size--;
     return 0;
 }
@@ -490,6 +543,11 @@ ANV_API int anv_sll_merge(ANVSinglyLinkedList* dest, ANVSinglyLinkedList* src)
         return 0;
     }
 
+    if (adopt_nodes(dest, src) != 0)
+    {
+        return -1;
+    }
+
     if (dest->size == 0)
     {
         dest->head = src->head;
@@ -529,6 +587,11 @@ ANV_API int anv_sll_splice(ANVSinglyLinkedList* dest, ANVSinglyLinkedList* src,
         return anv_sll_merge(dest, src);
     }
 
+    if (adopt_nodes(dest, src) != 0)
+    {
+        return -1;
+    }
+
     ANVSinglyLinkedNode* src_last = src->head;
     while (src_last->next)
     {
@@ -0,0 +1,463 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include <stdint.h>
+#include <string.h>
+
+#include "slotmap.h"
+
+// Default initial capacity for new slot maps
+#define DEFAULT_CAPACITY ANV_DEFAULT_CAPACITY
+// Marks the end of the free slot list
+#define NO_SLOT UINT32_MAX
+// Slot indices and dense positions must fit in 32 bits
+#define MAX_CAPACITY ((size_t)UINT32_MAX - 1)
+
+//==============================================================================
+// Private helper functions
+//==============================================================================
+
+static bool slot_is_occupied(const ANVSlot* slot)
+{
+    return (slot->generation & 1u) != 0;
+}
+
+static const ANVSlot* find_slot(const ANVSlotMap* map, const ANVSlotHandle handle)
+{
+    if (!map || handle.index >= map->slot_count)
+    {
+        return NULL;
+    }
+
+    const ANVSlot* slot = &map->slots[handle.index];
+    if (slot->generation != handle.generation || !slot_is_occupied(slot))
+    {
+        return NULL;
+    }
+    return slot;
+}
+
+static void* element_at(const ANVSlotMap* map, const size_t dense_index)
+{
+    return map->dense + dense_index * map->element_size;
+}
+
+/**
+ * Grow the dense arrays to hold at least min_capacity elements.
+ */
+static int ensure_capacity(ANVSlotMap* map, const size_t min_capacity)
+{
+    if (map->capacity >= min_capacity)
+    {
+        return 0;
+    }
+    if (min_capacity > MAX_CAPACITY)
+    {
+        return -1;
+    }
+
+    size_t new_capacity = map->capacity ? map->capacity : DEFAULT_CAPACITY;
+    while (new_capacity < min_capacity)
+    {
+        new_capacity *= 2;
+    }
+    if (new_capacity > MAX_CAPACITY)
+    {
+        new_capacity = MAX_CAPACITY;
+    }
+    if (new_capacity > SIZE_MAX / map->element_size)
+    {
+        return -1;
+    }
+
+    uint8_t* dense = anv_alloc_reallocate(&map->alloc, map->dense, map->capacity * map->element_size,
+                                          new_capacity * map->element_size);
+    if (!dense)
+    {
+        return -1;
+    }
+    map->dense = dense;
+
+    uint32_t* dense_slots = anv_alloc_reallocate(&map->alloc, map->dense_slots, map->capacity * sizeof(uint32_t),
+                                                 new_capacity * sizeof(uint32_t));
+    if (!dense_slots)
+    {
+        return -1;
+    }
+    map->dense_slots = dense_slots;
+    map->capacity = new_capacity;
+    return 0;
+}
+
+/**
+ * Take a slot from the free list, or append a new one.
+ */
+static uint32_t acquire_slot(ANVSlotMap* map)
+{
+    if (map->free_head != NO_SLOT)
+    {
+        const uint32_t index = map->free_head;
+        map->free_head = map->slots[index].dense_index;
+        return index;
+    }
+
+    if (map->slot_count == map->slot_capacity)
+    {
+        // The dense arrays were grown first, so slot_capacity <= MAX_CAPACITY here
+        const size_t new_capacity = map->slot_capacity ? map->slot_capacity * 2 : DEFAULT_CAPACITY;
+        ANVSlot* slots = anv_alloc_reallocate(&map->alloc, map->slots, map->slot_capacity * sizeof(ANVSlot),
+                                              new_capacity * sizeof(ANVSlot));
+        if (!slots)
+        {
+            return NO_SLOT;
+        }
+        map->slots = slots;
+        map->slot_capacity = new_capacity;
+    }
+
+    const uint32_t index = (uint32_t)map->slot_count++;
+    map->slots[index].generation = 0;
+    return index;
+}
+
+static void release_slot(ANVSlotMap* map, const uint32_t index)
+{
+    ANVSlot* slot = &map->slots[index];
+    slot->generation++;
+
+    // A slot whose generation wrapped is retired so old handles can never match it
+    if (slot->generation == 0)
+    {
+        return;
+    }
+    slot->dense_index = map->free_head;
+    map->free_head = index;
+}
+
+//==============================================================================
+// Creation and destruction functions
+//==============================================================================
+
+ANV_API ANVSlotMap* anv_slotmap_create(ANVAllocator* alloc, const size_t element_size, const size_t initial_capacity)
+{
+    if (!alloc || element_size == 0)
+    {
+        return NULL;
+    }
+
+    ANVSlotMap* map = anv_alloc_allocate(alloc, sizeof(ANVSlotMap));
+    if (!map)
+    {
+        return NULL;
+    }
+
+    memset(map, 0, sizeof(ANVSlotMap));
+    map->element_size = element_size;
+    map->free_head = NO_SLOT;
+    map->alloc = *alloc;
+
+    if (ensure_capacity(map, initial_capacity > 0 ? initial_capacity : DEFAULT_CAPACITY) != 0)
+    {
+        anv_slotmap_destroy(map);
+        return NULL;
+    }
+    return map;
+}
+
+ANV_API void anv_slotmap_destroy(ANVSlotMap* map)
+{
+    if (!map)
+    {
+        return;
+    }
+
+    anv_alloc_deallocate(&map->alloc, map->dense);
+    anv_alloc_deallocate(&map->alloc, map->dense_slots);
+    anv_alloc_deallocate(&map->alloc, map->slots);
+    anv_alloc_deallocate(&map->alloc, map);
+}
+
+ANV_API void anv_slotmap_clear(ANVSlotMap* map)
+{
+    if (!map)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < map->size; i++)
+    {
+        release_slot(map, map->dense_slots[i]);
+    }
+    map->size = 0;
+}
+
+ANV_API int anv_slotmap_reserve(ANVSlotMap* map, const size_t capacity)
+{
+    if (!map)
+    {
+        return -1;
+    }
+    return ensure_capacity(map, capacity);
+}
+
+//==============================================================================
+// Information functions
+//==============================================================================
+
+ANV_API size_t anv_slotmap_size(const ANVSlotMap* map)
+{
+    return map ? map->size : 0;
+}
+
+ANV_API int anv_slotmap_is_empty(const ANVSlotMap* map)
+{
+    return !map || map->size == 0;
+}
+
+ANV_API int anv_slotmap_contains(const ANVSlotMap* map, const ANVSlotHandle handle)
+{
+    return find_slot(map, handle) != NULL;
+}
+
+//==============================================================================
+// Element access functions
+//==============================================================================
+
+ANV_API void* anv_slotmap_emplace(ANVSlotMap* map, ANVSlotHandle* handle_out)
+{
+    if (!map || ensure_capacity(map, map->size + 1) != 0)
+    {
+        return NULL;
+    }
+
+    const uint32_t index = acquire_slot(map);
+    if (index == NO_SLOT)
+    {
+        return NULL;
+    }
+
+    ANVSlot* slot = &map->slots[index];
+    slot->generation++;
+    slot->dense_index = (uint32_t)map->size;
+    map->dense_slots[map->size] = index;
+
+    void* element = element_at(map, map->size);
+    memset(element, 0, map->element_size);
+    map->size++;
+
+    if (handle_out)
+    {
+        handle_out->index = index;
+        handle_out->generation = slot->generation;
+    }
+    return element;
+}
+
+ANV_API ANVSlotHandle anv_slotmap_insert(ANVSlotMap* map, const void* element)
+{
+    ANVSlotHandle handle = {0};
+    void* slot_element = anv_slotmap_emplace(map, &handle);
+    if (slot_element && element)
+    {
+        memcpy(slot_element, element, map->element_size);
+    }
+    return handle;
+}
+
+ANV_API void* anv_slotmap_get(const ANVSlotMap* map, const ANVSlotHandle handle)
+{
+    const ANVSlot* slot = find_slot(map, handle);
+    return slot ? element_at(map, slot->dense_index) : NULL;
+}
+
+ANV_API int anv_slotmap_remove(ANVSlotMap* map, const ANVSlotHandle handle, void* element_out)
+{
+    const ANVSlot* slot = find_slot(map, handle);
+    if (!slot)
+    {
+        return -1;
+    }
+
+    const uint32_t dense_index = slot->dense_index;
+    void* element = element_at(map, dense_index);
+    if (element_out)
+    {
+        memcpy(element_out, element, map->element_size);
+    }
+
+    // Fill the hole with the last element and repoint its slot
+    const size_t last = map->size - 1;
+    if (dense_index != last)
+    {
+        memcpy(element, element_at(map, last), map->element_size);
+        const uint32_t moved_slot = map->dense_slots[last];
+        map->dense_slots[dense_index] = moved_slot;
+        map->slots[moved_slot].dense_index = dense_index;
+    }
+
+    map->size--;
+    release_slot(map, handle.index);
+    return 0;
+}
+
+//==============================================================================
+// Dense iteration functions
+//==============================================================================
+
+ANV_API void* anv_slotmap_data(const ANVSlotMap* map)
+{
+    return map ? map->dense : NULL;
+}
+
+ANV_API ANVSlotHandle anv_slotmap_handle_at(const ANVSlotMap* map, const size_t dense_index)
+{
+    ANVSlotHandle handle = {0};
+    if (!map || dense_index >= map->size)
+    {
+        return handle;
+    }
+
+    handle.index = map->dense_slots[dense_index];
+    handle.generation = map->slots[handle.index].generation;
+    return handle;
+}
+
+//==============================================================================
+// Iterator implementation
+//==============================================================================
+
+typedef struct SlotMapIterState
+{
+    const ANVSlotMap* map;
+    size_t current_index;
+} SlotMapIterState;
+
+static void* slotmap_iter_get(const ANVIterator* iter)
+{
+    if (!iter || !iter->data_state)
+    {
+        return NULL;
+    }
+
+    const SlotMapIterState* state = iter->data_state;
+    if (state->current_index >= state->map->size)
+    {
+        return NULL;
+    }
+    return element_at(state->map, state->current_index);
+}
+
+static int slotmap_iter_has_next(const ANVIterator* iter)
+{
+    if (!iter || !iter->data_state)
+    {
+        return 0;
+    }
+
+    const SlotMapIterState* state = iter->data_state;
+    return state->current_index < state->map->size;
+}
+
+static int slotmap_iter_next(const ANVIterator* iter)
+{
+    if (!iter || !iter->data_state)
+    {
+        return -1;
+    }
+
+    SlotMapIterState* state = iter->data_state;
+    if (state->current_index >= state->map->size)
+    {
+        return -1;
+    }
+    state->current_index++;
+    return 0;
+}
+
+static int slotmap_iter_has_prev(const ANVIterator* iter)
+{
+    if (!iter || !iter->data_state)
+    {
+        return 0;
+    }
+
+    const SlotMapIterState* state = iter->data_state;
+    return state->current_index > 0;
+}
+
+static int slotmap_iter_prev(const ANVIterator* iter)
+{
+    if (!iter || !iter->data_state)
+    {
+        return -1;
+    }
+
+    SlotMapIterState* state = iter->data_state;
+    if (state->current_index == 0)
+    {
+        return -1;
+    }
+    state->current_index--;
+    return 0;
+}
+
+static void slotmap_iter_reset(const ANVIterator* iter)
+{
+    if (!iter || !iter->data_state)
+    {
+        return;
+    }
+
+    SlotMapIterState* state = iter->data_state;
+    state->current_index = 0;
+}
+
+static int slotmap_iter_is_valid(const ANVIterator* iter)
+{
+    return iter && iter->data_state != NULL;
+}
+
+static void slotmap_iter_destroy(ANVIterator* iter)
+{
+    if (!iter || !iter->data_state)
+    {
+        return;
+    }
+
+    const SlotMapIterState* state = iter->data_state;
+    anv_alloc_deallocate(&state->map->alloc, iter->data_state);
+    iter->data_state = NULL;
+}
+
+ANV_API ANVIterator anv_slotmap_iterator(const ANVSlotMap* map)
+{
+    ANVIterator iter = {0};
+
+    iter.get = slotmap_iter_get;
+    iter.next = slotmap_iter_next;
+    iter.has_next = slotmap_iter_has_next;
+    iter.prev = slotmap_iter_prev;
+    iter.has_prev = slotmap_iter_has_prev;
+    iter.reset = slotmap_iter_reset;
+    iter.is_valid = slotmap_iter_is_valid;
+    iter.destroy = slotmap_iter_destroy;
+
+    if (!map || !anv_alloc_is_valid(&map->alloc))
+    {
+        return iter;
+    }
+
+    SlotMapIterState* state = anv_alloc_allocate(&map->alloc, sizeof(SlotMapIterState));
+    if (!state)
+    {
+        return iter;
+    }
+
+    state->map = map;
+    state->current_index = 0;
+
+    iter.alloc = map->alloc;
+    iter.data_state = state;
+    return iter;
+}
@@ -10,7 +10,7 @@
 
 static ANVStackNode* create_node(const ANVStack* stack, void* data)
 {
-    ANVStackNode* node = anv_alloc_allocate(&stack->alloc, sizeof(ANVStackNode));
+    ANVStackNode* node = anv_slab_pool_allocate(stack->node_pool, &stack->alloc, sizeof(ANVStackNode));
     if (!node)
     {
         return NULL;
@@ -33,7 +33,7 @@ static void free_node(const ANVStack* stack, ANVStackNode* node, const bool shou
         anv_alloc_data_deallocate(&stack->alloc, node->data);
     }
 
-    anv_alloc_deallocate(&stack->alloc, node);
+    anv_slab_pool_deallocate(stack->node_pool, &stack->alloc, node);
 }
 
 //==============================================================================
@@ -56,6 +56,7 @@ ANV_API ANVStack* anv_stack_create(ANVAllocator* alloc)
     stack->top = NULL;
     stack->size = 0;
     stack->alloc = *alloc;
+    stack->node_pool = anv_slab_pool_create(alloc, sizeof(ANVStackNode));
 
     return stack;
 }
@@ -68,6 +69,7 @@ ANV_API void anv_stack_destroy(ANVStack* stack, const bool should_free_data)
     }
 
     anv_stack_clear(stack, should_free_data);
+    anv_slab_pool_destroy(&stack->alloc, stack->node_pool);
 
     anv_alloc_deallocate(&stack->alloc, stack);
 }
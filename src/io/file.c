@@ -2,8 +2,50 @@
 // Created by zack on 10/9/25.
 //
 
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE 1
+#endif
+
 #include "anvil/io/file.h"
 
+#ifdef ANV_PLATFORM_WINDOWS
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+static void release_contents(ANVFile* file)
+{
+    if (!file->contents)
+    {
+        return;
+    }
+
+    if (file->is_mapped)
+    {
+#ifdef ANV_PLATFORM_WINDOWS
+        UnmapViewOfFile(file->contents);
+#else
+        munmap(file->contents, file->size);
+#endif
+    }
+    else
+    {
+        anv_alloc_deallocate(&file->allocator, file->contents);
+    }
+
+    file->contents = NULL;
+    file->size = 0;
+    file->is_mapped = false;
+}
+
 ANV_API ANVFile* anv_file_create(ANVAllocator *alloc, const char* path)
 {
     if (!alloc || !path)
@@ -21,6 +63,7 @@ ANV_API ANVFile* anv_file_create(ANVAllocator *alloc, const char* path)
     file->handle = NULL;
     file->contents = NULL;
     file->size = 0;
+    file->is_mapped = false;
     file->path = anv_str_create_from_cstring(path);
 
     return file;
@@ -39,11 +82,7 @@ ANV_API ANVResult anv_file_destroy(ANVFile* file)
         file->handle = NULL;
     }
 
-    if (file->contents)
-    {
-        anv_alloc_deallocate(&file->allocator, file->contents);
-        file->contents = NULL;
-    }
+    release_contents(file);
 
     anv_str_destroy(&file->path);
     anv_alloc_deallocate(&file->allocator, file);
@@ -58,6 +97,8 @@ ANV_API ANVResult anv_file_read(ANVFile* file)
         return ANV_RESULT_INVALID_ARGUMENT;
     }
 
+    release_contents(file);
+
     file->handle = fopen(anv_str_data(&file->path), "rb");
     if (!file->handle)
     {
@@ -155,3 +196,85 @@ ANV_API ANVResult anv_file_write_append(ANVFile* file, const uint8_t* data, cons
 
     return ANV_RESULT_SUCCESS;
 }
+
+ANV_API ANVResult anv_file_map(ANVFile* file)
+{
+    if (!file)
+    {
+        return ANV_RESULT_INVALID_ARGUMENT;
+    }
+
+    release_contents(file);
+
+#ifdef ANV_PLATFORM_WINDOWS
+    const HANDLE handle = CreateFileA(anv_str_data(&file->path), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        return ANV_RESULT_NOT_FOUND;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(handle, &file_size) || file_size.QuadPart < 0)
+    {
+        CloseHandle(handle);
+        return ANV_RESULT_OUT_OF_BOUNDS;
+    }
+
+    if (file_size.QuadPart == 0)
+    {
+        CloseHandle(handle);
+        return ANV_RESULT_SUCCESS;
+    }
+
+    const size_t mapped_size = (size_t)file_size.QuadPart;
+
+    // The view keeps the mapping alive, so both handles can be closed now
+    const HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (mapping)
+    {
+        CloseHandle(mapping);
+    }
+    CloseHandle(handle);
+    if (!view)
+    {
+        return ANV_RESULT_OUT_OF_MEMORY;
+    }
+#else
+    const int fd = open(anv_str_data(&file->path), O_RDONLY);
+    if (fd < 0)
+    {
+        return ANV_RESULT_NOT_FOUND;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < 0)
+    {
+        close(fd);
+        return ANV_RESULT_OUT_OF_BOUNDS;
+    }
+
+    if (info.st_size == 0)
+    {
+        close(fd);
+        return ANV_RESULT_SUCCESS;
+    }
+
+    const size_t mapped_size = (size_t)info.st_size;
+
+    // The mapping holds its own reference to the file, so the descriptor can be closed now
+    void* view = mmap(NULL, mapped_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+    {
+        return ANV_RESULT_OUT_OF_MEMORY;
+    }
+#endif
+
+    file->contents = view;
+    file->size = mapped_size;
+    file->is_mapped = true;
+
+    return ANV_RESULT_SUCCESS;
+}
@@ -0,0 +1,641 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "anvil/io/image.h"
+#include "anvil/io/file.h"
+
+#ifdef ANV_PLATFORM_WINDOWS
+    #include <Windows.h>
+#endif
+
+//==============================================================================
+// Image format
+//==============================================================================
+
+#define IMAGE_MAGIC "ANVIMAGE"
+#define IMAGE_MAGIC_LENGTH 8
+
+// Written in native order; reads back differently on a machine of the other byte order
+#define IMAGE_BYTE_ORDER 0x01020304u
+
+#define IMAGE_CHECKSUM_SEED 0x414E56494D414745ull
+
+#define IMAGE_FLAG_SEEDED 1u
+
+typedef enum ImageKind
+{
+    IMAGE_KIND_HASHMAP = 1,
+    IMAGE_KIND_ARRAYLIST = 2
+} ImageKind;
+
+/**
+ * Fixed header at offset 0. Every offset is from the start of the image and
+ * a multiple of 8, so the mapped sections are naturally aligned.
+ */
+typedef struct ImageHeader
+{
+    char magic[IMAGE_MAGIC_LENGTH]; // IMAGE_MAGIC, not NUL-terminated
+    uint32_t version;               // ANV_IMAGE_VERSION
+    uint32_t kind;                  // ImageKind
+    uint32_t byte_order;            // IMAGE_BYTE_ORDER as the writer stored it
+    uint32_t flags;                 // IMAGE_FLAG_* bits
+    uint64_t size;                  // Total image size in bytes
+    uint64_t checksum;              // anv_hash_bytes of everything after the header
+    uint64_t count;                 // Number of entries or elements
+    uint64_t bucket_count;          // Hash map only: number of buckets
+    uint64_t seed[2];               // Hash map only: ANVHashSeed of a seeded map
+    uint64_t index_offset;          // Hash map: bucket table; array list: element table
+    uint64_t entries_offset;        // Hash map only: entry array
+} ImageHeader;
+
+static_assert(sizeof(ImageHeader) % 8 == 0, "image sections must stay 8-byte aligned");
+
+// Entries of bucket b are entries[buckets[b]] up to entries[buckets[b + 1]]
+typedef struct ImageMapEntry
+{
+    uint64_t hash;         // Full hash of the key
+    uint64_t key_offset;   // Offset of the key's bytes
+    uint64_t key_size;     // Size of the key's bytes
+    uint64_t value_offset; // Offset of the value's bytes, or 0 for NULL
+    uint64_t value_size;   // Size of the value's bytes
+} ImageMapEntry;
+
+typedef struct ImageListEntry
+{
+    uint64_t offset; // Offset of the element's bytes, or 0 for NULL
+    uint64_t size;   // Size of the element's bytes
+} ImageListEntry;
+
+struct ANVHashMapImage
+{
+    ANVFile* file;                     // Mapped image file
+    const uint64_t* buckets;           // Bucket table, bucket_count + 1 entry indices
+    const ImageMapEntry* entries;      // Entry array
+    size_t size;                       // Number of entries
+    size_t bucket_count;               // Number of buckets
+    anv_hash_func hash;                // Hash function for keys (NULL in seeded mode)
+    anv_seeded_hash_func seeded_hash;  // Keyed hash function (NULL unless seeded)
+    ANVHashSeed seed;                  // Seed read from the image
+    key_equals_func key_equals;        // Key equality function
+    ANVAllocator alloc;                // Custom allocator
+};
+
+struct ANVArrayListImage
+{
+    ANVFile* file;                 // Mapped image file
+    const ImageListEntry* entries; // Element table
+    size_t size;                   // Number of elements
+    ANVAllocator alloc;            // Custom allocator
+};
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+static size_t align8(const size_t size)
+{
+    return (size + 7) & ~(size_t)7;
+}
+
+static uint64_t image_checksum(const uint8_t* image, const size_t size)
+{
+    return anv_hash_bytes(image + sizeof(ImageHeader), size - sizeof(ImageHeader), IMAGE_CHECKSUM_SEED);
+}
+
+// Whether count items of item_size bytes starting at offset lie inside the image
+static bool section_fits(const uint64_t image_size, const uint64_t offset, const uint64_t count,
+                         const size_t item_size)
+{
+    return offset % 8 == 0 && offset >= sizeof(ImageHeader) && offset <= image_size &&
+           count <= (image_size - offset) / item_size;
+}
+
+// Whether size bytes of data at offset lie past the header and inside the image
+static bool data_in_image(const ANVFile* file, const uint64_t offset, const uint64_t size)
+{
+    return offset >= sizeof(ImageHeader) && offset < file->size && size <= file->size - offset;
+}
+
+/**
+ * Whether an entry's key and value bytes lie inside the image. Open only
+ * checks the tables, not every entry, so each lookup checks the entries it
+ * touches; a damaged entry reads as absent.
+ */
+static bool map_entry_in_image(const ANVFile* file, const ImageMapEntry* entry)
+{
+    return data_in_image(file, entry->key_offset, entry->key_size) &&
+           (entry->value_offset == 0 || data_in_image(file, entry->value_offset, entry->value_size));
+}
+
+static void init_header(ImageHeader* header, const ImageKind kind, const size_t size, const size_t count)
+{
+    memcpy(header->magic, IMAGE_MAGIC, IMAGE_MAGIC_LENGTH);
+    header->version = ANV_IMAGE_VERSION;
+    header->kind = kind;
+    header->byte_order = IMAGE_BYTE_ORDER;
+    header->size = size;
+    header->count = count;
+}
+
+// Replace 'to' with 'from' in one step, so 'to' is always either the old or the new file
+static bool replace_file(const char* from, const char* to)
+{
+#ifdef ANV_PLATFORM_WINDOWS
+    return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(from, to) == 0;
+#endif
+}
+
+/**
+ * Seal a filled image buffer with its checksum and write it to path. The
+ * image goes to path.tmp first and is then renamed over path. Truncating
+ * path in place would cut the pages from under any process that still has
+ * the old image mapped, which then faults on its next lookup; after a
+ * rename it keeps the old file until it closes the image.
+ */
+static ANVResult write_image(ANVAllocator* alloc, const char* path, uint8_t* image, const size_t size)
+{
+    ImageHeader* header = (ImageHeader*)image;
+    header->checksum = image_checksum(image, size);
+
+    const size_t path_length = strlen(path);
+    char* temp_path = anv_alloc_allocate(alloc, path_length + sizeof(".tmp"));
+    if (!temp_path)
+    {
+        return ANV_RESULT_OUT_OF_MEMORY;
+    }
+    memcpy(temp_path, path, path_length);
+    memcpy(temp_path + path_length, ".tmp", sizeof(".tmp"));
+
+    ANVFile* file = anv_file_create(alloc, temp_path);
+    if (!file)
+    {
+        anv_alloc_deallocate(alloc, temp_path);
+        return ANV_RESULT_OUT_OF_MEMORY;
+    }
+
+    ANVResult result = anv_file_write(file, image, size);
+    anv_file_destroy(file);
+    if (ANV_SUCCEEDED(result) && !replace_file(temp_path, path))
+    {
+        result = ANV_RESULT_NOT_FOUND;
+    }
+    if (ANV_FAILED(result))
+    {
+        remove(temp_path);
+    }
+
+    anv_alloc_deallocate(alloc, temp_path);
+    return result;
+}
+
+/**
+ * Map an image file and check everything that can be checked without
+ * touching more than the header, plus the checksum if asked.
+ */
+static ANVResult map_image(ANVAllocator* alloc, const char* path, const ImageKind kind, const bool verify_checksum,
+                           ANVFile** file_out)
+{
+    ANVFile* file = anv_file_create(alloc, path);
+    if (!file)
+    {
+        return ANV_RESULT_OUT_OF_MEMORY;
+    }
+
+    ANVResult result = anv_file_map(file);
+    if (ANV_FAILED(result))
+    {
+        anv_file_destroy(file);
+        return result;
+    }
+
+    const ImageHeader* header = (const ImageHeader*)file->contents;
+    if (file->size < sizeof(ImageHeader) ||
+        memcmp(header->magic, IMAGE_MAGIC, IMAGE_MAGIC_LENGTH) != 0 ||
+        header->version != ANV_IMAGE_VERSION ||
+        header->byte_order != IMAGE_BYTE_ORDER ||
+        header->kind != (uint32_t)kind ||
+        header->size != file->size ||
+        (verify_checksum && header->checksum != image_checksum(file->contents, file->size)))
+    {
+        anv_file_destroy(file);
+        return ANV_RESULT_INVALID_STATE;
+    }
+
+    *file_out = file;
+    return ANV_RESULT_SUCCESS;
+}
+
+//==============================================================================
+// Writing functions
+//==============================================================================
+
+ANV_API size_t anv_image_size_string(const void* data)
+{
+    return strlen(data) + 1;
+}
+
+typedef struct PendingEntry
+{
+    uint64_t hash;
+    const void* key;
+    const void* value;
+    size_t key_size;
+    size_t value_size;
+} PendingEntry;
+
+ANV_API ANVResult anv_image_write_hashmap(const ANVHashMap* map, const char* path,
+                                          const anv_image_size_func key_size, const anv_image_size_func value_size)
+{
+    if (!map || !path || !key_size || !value_size || (!map->hash && !map->seeded_hash))
+    {
+        return ANV_RESULT_INVALID_ARGUMENT;
+    }
+
+    ANVAllocator alloc = map->alloc;
+    const size_t count = map->size;
+    const size_t bucket_count = count ? count : 1;
+
+    PendingEntry* pending = anv_alloc_allocate(&alloc, (count ? count : 1) * sizeof(PendingEntry));
+    if (!pending)
+    {
+        return ANV_RESULT_OUT_OF_MEMORY;
+    }
+
+    size_t collected = 0;
+    size_t data_size = 0;
+    ANVIterator it = anv_hashmap_iterator(map);
+    while (it.has_next(&it) && collected < count)
+    {
+        const ANVPair* pair = it.get(&it);
+        if (pair)
+        {
+            PendingEntry* entry = &pending[collected++];
+            entry->hash = map->seeded_hash ? (uint64_t)map->seeded_hash(pair->first, &map->seed)
+                                           : (uint64_t)map->hash(pair->first);
+            entry->key = pair->first;
+            entry->value = pair->second;
+            entry->key_size = key_size(pair->first);
+            entry->value_size = pair->second ? value_size(pair->second) : 0;
+            data_size += align8(entry->key_size) + align8(entry->value_size);
+        }
+        it.next(&it);
+    }
+    it.destroy(&it);
+
+    const size_t index_offset = sizeof(ImageHeader);
+    const size_t entries_offset = index_offset + (bucket_count + 1) * sizeof(uint64_t);
+    const size_t data_offset = entries_offset + collected * sizeof(ImageMapEntry);
+    const size_t size = data_offset + data_size;
+
+    uint8_t* image = anv_alloc_allocate(&alloc, size);
+    if (!image)
+    {
+        anv_alloc_deallocate(&alloc, pending);
+        return ANV_RESULT_OUT_OF_MEMORY;
+    }
+
+    // Zeroed so padding bytes, and with them the checksum, are deterministic
+    memset(image, 0, size);
+
+    ImageHeader* header = (ImageHeader*)image;
+    init_header(header, IMAGE_KIND_HASHMAP, size, collected);
+    header->bucket_count = bucket_count;
+    header->index_offset = index_offset;
+    header->entries_offset = entries_offset;
+    if (map->seeded_hash)
+    {
+        header->flags |= IMAGE_FLAG_SEEDED;
+        header->seed[0] = map->seed.k0;
+        header->seed[1] = map->seed.k1;
+    }
+
+    // Counting sort by bucket: buckets[b + 1] counts, then prefix sums give starts
+    uint64_t* buckets = (uint64_t*)(image + index_offset);
+    for (size_t i = 0; i < collected; i++)
+    {
+        buckets[pending[i].hash % bucket_count + 1]++;
+    }
+    for (size_t b = 0; b < bucket_count; b++)
+    {
+        buckets[b + 1] += buckets[b];
+    }
+
+    // Placing advances each start to the next bucket's start; shift back afterwards
+    ImageMapEntry* entries = (ImageMapEntry*)(image + entries_offset);
+    size_t cursor = data_offset;
+    for (size_t i = 0; i < collected; i++)
+    {
+        const PendingEntry* source = &pending[i];
+        ImageMapEntry* entry = &entries[buckets[source->hash % bucket_count]++];
+        entry->hash = source->hash;
+
+        entry->key_offset = cursor;
+        entry->key_size = source->key_size;
+        memcpy(image + cursor, source->key, source->key_size);
+        cursor += align8(source->key_size);
+
+        if (source->value)
+        {
+            entry->value_offset = cursor;
+            entry->value_size = source->value_size;
+            memcpy(image + cursor, source->value, source->value_size);
+            cursor += align8(source->value_size);
+        }
+    }
+    memmove(buckets + 1, buckets, bucket_count * sizeof(uint64_t));
+    buckets[0] = 0;
+
+    anv_alloc_deallocate(&alloc, pending);
+    const ANVResult result = write_image(&alloc, path, image, size);
+    anv_alloc_deallocate(&alloc, image);
+    return result;
+}
+
+ANV_API ANVResult anv_image_write_arraylist(const ANVArrayList* list, const char* path,
+                                            const anv_image_size_func element_size)
+{
+    if (!list || !path || !element_size)
+    {
+        return ANV_RESULT_INVALID_ARGUMENT;
+    }
+
+    ANVAllocator alloc = list->alloc;
+    const size_t count = anv_arraylist_size(list);
+    const size_t index_offset = sizeof(ImageHeader);
+    const size_t data_offset = index_offset + count * sizeof(ImageListEntry);
+
+    size_t* sizes = anv_alloc_allocate(&alloc, (count ? count : 1) * sizeof(size_t));
+    if (!sizes)
+    {
+        return ANV_RESULT_OUT_OF_MEMORY;
+    }
+
+    size_t data_size = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        const void* element = anv_arraylist_get(list, i);
+        sizes[i] = element ? element_size(element) : 0;
+        data_size += align8(sizes[i]);
+    }
+
+    const size_t size = data_offset + data_size;
+    uint8_t* image = anv_alloc_allocate(&alloc, size);
+    if (!image)
+    {
+        anv_alloc_deallocate(&alloc, sizes);
+        return ANV_RESULT_OUT_OF_MEMORY;
+    }
+
+    memset(image, 0, size);
+
+    ImageHeader* header = (ImageHeader*)image;
+    init_header(header, IMAGE_KIND_ARRAYLIST, size, count);
+    header->index_offset = index_offset;
+
+    ImageListEntry* entries = (ImageListEntry*)(image + index_offset);
+    size_t cursor = data_offset;
+    for (size_t i = 0; i < count; i++)
+    {
+        const void* element = anv_arraylist_get(list, i);
+        if (!element)
+        {
+            continue;
+        }
+
+        entries[i].offset = cursor;
+        entries[i].size = sizes[i];
+        memcpy(image + cursor, element, sizes[i]);
+        cursor += align8(sizes[i]);
+    }
+
+    anv_alloc_deallocate(&alloc, sizes);
+    const ANVResult result = write_image(&alloc, path, image, size);
+    anv_alloc_deallocate(&alloc, image);
+    return result;
+}
+
+//==============================================================================
+// Hash map image functions
+//==============================================================================
+
+static ANVResult open_hashmap(ANVAllocator* alloc, const char* path, const anv_hash_func hash,
+                              const anv_seeded_hash_func seeded_hash, const key_equals_func key_equals,
+                              const bool verify_checksum, ANVHashMapImage** image_out)
+{
+    if (!alloc || !path || !key_equals || !image_out)
+    {
+        return ANV_RESULT_INVALID_ARGUMENT;
+    }
+
+    ANVFile* file = NULL;
+    const ANVResult result = map_image(alloc, path, IMAGE_KIND_HASHMAP, verify_checksum, &file);
+    if (ANV_FAILED(result))
+    {
+        return result;
+    }
+
+    const ImageHeader* header = (const ImageHeader*)file->contents;
+    const bool seeded = (header->flags & IMAGE_FLAG_SEEDED) != 0;
+    if (seeded != (seeded_hash != NULL) || header->bucket_count == 0 ||
+        !section_fits(header->size, header->index_offset, header->bucket_count + 1, sizeof(uint64_t)) ||
+        !section_fits(header->size, header->entries_offset, header->count, sizeof(ImageMapEntry)))
+    {
+        anv_file_destroy(file);
+        return ANV_RESULT_INVALID_STATE;
+    }
+
+    ANVHashMapImage* image = anv_alloc_allocate(alloc, sizeof(ANVHashMapImage));
+    if (!image)
+    {
+        anv_file_destroy(file);
+        return ANV_RESULT_OUT_OF_MEMORY;
+    }
+
+    image->file = file;
+    image->buckets = (const uint64_t*)(file->contents + header->index_offset);
+    image->entries = (const ImageMapEntry*)(file->contents + header->entries_offset);
+    image->size = (size_t)header->count;
+    image->bucket_count = (size_t)header->bucket_count;
+    image->hash = hash;
+    image->seeded_hash = seeded_hash;
+    image->seed.k0 = header->seed[0];
+    image->seed.k1 = header->seed[1];
+    image->key_equals = key_equals;
+    image->alloc = *alloc;
+
+    *image_out = image;
+    return ANV_RESULT_SUCCESS;
+}
+
+ANV_API ANVResult anv_image_open_hashmap(ANVAllocator* alloc, const char* path, const anv_hash_func hash,
+                                         const key_equals_func key_equals, const bool verify_checksum,
+                                         ANVHashMapImage** image_out)
+{
+    if (!hash)
+    {
+        return ANV_RESULT_INVALID_ARGUMENT;
+    }
+    return open_hashmap(alloc, path, hash, NULL, key_equals, verify_checksum, image_out);
+}
+
+ANV_API ANVResult anv_image_open_hashmap_seeded(ANVAllocator* alloc, const char* path,
+                                                const anv_seeded_hash_func hash, const key_equals_func key_equals,
+                                                const bool verify_checksum, ANVHashMapImage** image_out)
+{
+    if (!hash)
+    {
+        return ANV_RESULT_INVALID_ARGUMENT;
+    }
+    return open_hashmap(alloc, path, NULL, hash, key_equals, verify_checksum, image_out);
+}
+
+ANV_API void anv_image_hashmap_close(ANVHashMapImage* image)
+{
+    if (!image)
+    {
+        return;
+    }
+
+    anv_file_destroy(image->file);
+    anv_alloc_deallocate(&image->alloc, image);
+}
+
+ANV_API size_t anv_image_hashmap_size(const ANVHashMapImage* image)
+{
+    return image ? image->size : 0;
+}
+
+ANV_API const void* anv_image_hashmap_get(const ANVHashMapImage* image, const void* key)
+{
+    if (!image || !key)
+    {
+        return NULL;
+    }
+
+    const uint64_t hash = image->seeded_hash ? (uint64_t)image->seeded_hash(key, &image->seed)
+                                             : (uint64_t)image->hash(key);
+    const size_t bucket = (size_t)(hash % image->bucket_count);
+    const uint8_t* base = image->file->contents;
+
+    // Clamp to the entry count and check offsets so a damaged image cannot send the lookup out of bounds
+    const uint64_t end = image->buckets[bucket + 1] < image->size ? image->buckets[bucket + 1] : image->size;
+    for (uint64_t i = image->buckets[bucket]; i < end; i++)
+    {
+        const ImageMapEntry* entry = &image->entries[i];
+        if (entry->hash == hash && map_entry_in_image(image->file, entry) &&
+            image->key_equals(base + entry->key_offset, key))
+        {
+            return entry->value_offset ? base + entry->value_offset : NULL;
+        }
+    }
+    return NULL;
+}
+
+ANV_API int anv_image_hashmap_contains_key(const ANVHashMapImage* image, const void* key)
+{
+    return anv_image_hashmap_get(image, key) != NULL;
+}
+
+ANV_API void anv_image_hashmap_for_each(const ANVHashMapImage* image,
+                                        void (*action)(const void* key, const void* value))
+{
+    if (!image || !action)
+    {
+        return;
+    }
+
+    const uint8_t* base = image->file->contents;
+    for (size_t i = 0; i < image->size; i++)
+    {
+        const ImageMapEntry* entry = &image->entries[i];
+        if (map_entry_in_image(image->file, entry))
+        {
+            action(base + entry->key_offset, entry->value_offset ? base + entry->value_offset : NULL);
+        }
+    }
+}
+
+//==============================================================================
+// Array list image functions
+//==============================================================================
+
+ANV_API ANVResult anv_image_open_arraylist(ANVAllocator* alloc, const char* path, const bool verify_checksum,
+                                           ANVArrayListImage** image_out)
+{
+    if (!alloc || !path || !image_out)
+    {
+        return ANV_RESULT_INVALID_ARGUMENT;
+    }
+
+    ANVFile* file = NULL;
+    const ANVResult result = map_image(alloc, path, IMAGE_KIND_ARRAYLIST, verify_checksum, &file);
+    if (ANV_FAILED(result))
+    {
+        return result;
+    }
+
+    const ImageHeader* header = (const ImageHeader*)file->contents;
+    if (!section_fits(header->size, header->index_offset, header->count, sizeof(ImageListEntry)))
+    {
+        anv_file_destroy(file);
+        return ANV_RESULT_INVALID_STATE;
+    }
+
+    ANVArrayListImage* image = anv_alloc_allocate(alloc, sizeof(ANVArrayListImage));
+    if (!image)
+    {
+        anv_file_destroy(file);
+        return ANV_RESULT_OUT_OF_MEMORY;
+    }
+
+    image->file = file;
+    image->entries = (const ImageListEntry*)(file->contents + header->index_offset);
+    image->size = (size_t)header->count;
+    image->alloc = *alloc;
+
+    *image_out = image;
+    return ANV_RESULT_SUCCESS;
+}
+
+ANV_API void anv_image_arraylist_close(ANVArrayListImage* image)
+{
+    if (!image)
+    {
+        return;
+    }
+
+    anv_file_destroy(image->file);
+    anv_alloc_deallocate(&image->alloc, image);
+}
+
+ANV_API size_t anv_image_arraylist_size(const ANVArrayListImage* image)
+{
+    return image ? image->size : 0;
+}
+
+ANV_API const void* anv_image_arraylist_get(const ANVArrayListImage* image, const size_t index, size_t* size_out)
+{
+    if (!image || index >= image->size)
+    {
+        if (size_out)
+        {
+            *size_out = 0;
+        }
+        return NULL;
+    }
+
+    // An element out of the image's bounds reads as NULL, like a NULL element
+    const ImageListEntry* entry = &image->entries[index];
+    const bool present = entry->offset != 0 && data_in_image(image->file, entry->offset, entry->size);
+    if (size_out)
+    {
+        *size_out = present ? (size_t)entry->size : 0;
+    }
+    return present ? image->file->contents + entry->offset : NULL;
+}
@@ -3,19 +3,292 @@
 //
 
 #include "anvil/memory/arena.h"
+#include "anvil/memory/virtual_memory.h"
 
 #include <stdlib.h>
 #include <string.h>
 
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+// Keep block data 16-byte aligned regardless of the header layout
+#define BLOCK_HEADER_SIZE ((sizeof(ANVArenaBlock) + 15) & ~(size_t)15)
+#define BLOCK_DATA(block) ((uint8_t*)(block) + BLOCK_HEADER_SIZE)
+
+static size_t touched_bytes(const ANVArena *arena)
+{
+    return arena->used > arena->high_water ? arena->used : arena->high_water;
+}
+
+/**
+ * Fold the current total usage into the peak counters. Usage only grows
+ * between rewinds, so calling this before any rewind keeps the peaks exact
+ * without touching the allocation fast path.
+ */
+static void update_peaks(ANVArena *arena)
+{
+    const size_t total = arena->chain_used + arena->used;
+    if (total > arena->peak_used)
+    {
+        arena->peak_used = total;
+    }
+    if (total > arena->scope_peak)
+    {
+        arena->scope_peak = total;
+    }
+}
+
+static ANVArenaBlock* block_create(const size_t size)
+{
+    if (size > SIZE_MAX - BLOCK_HEADER_SIZE)
+    {
+        return NULL;
+    }
+
+    ANVArenaBlock* block = calloc(1, BLOCK_HEADER_SIZE + size);
+    if (!block)
+    {
+        return NULL;
+    }
+
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    block->touched = 0;
+    return block;
+}
+
+static void set_current_block(ANVArena *arena, ANVArenaBlock* block, const size_t used)
+{
+    arena->current = block;
+    arena->memory = BLOCK_DATA(block);
+    arena->size = block->size;
+    arena->committed = block->size;
+    arena->used = used;
+    arena->high_water = block->touched;
+}
+
+/**
+ * Clear the bytes the block handed out and put it on the free list, so a
+ * reused block reads as zero just like a fresh one.
+ */
+static void release_block(ANVArena *arena, ANVArenaBlock* block)
+{
+    memset(BLOCK_DATA(block), 0, block->touched);
+    block->used = 0;
+    block->touched = 0;
+    block->next = arena->free_blocks;
+    arena->free_blocks = block;
+}
+
+/**
+ * Move every block chained after 'owner' to the free list and make 'owner'
+ * the current block again.
+ */
+static void unwind_to_block(ANVArena *arena, ANVArenaBlock* owner, const size_t used)
+{
+    update_peaks(arena);
+    arena->current->touched = touched_bytes(arena);
+    while (arena->current != owner)
+    {
+        ANVArenaBlock* next = arena->current->next;
+        release_block(arena, arena->current);
+        arena->current = next;
+        arena->chain_used -= next->used;
+    }
+    set_current_block(arena, owner, used);
+}
+
+/**
+ * Check whether block is one of the blocks chained before the current one.
+ */
+static bool is_chained_block(const ANVArena *arena, const ANVArenaBlock* block)
+{
+    const ANVArenaBlock* chained = arena->current ? arena->current->next : NULL;
+    while (chained && chained != block)
+    {
+        chained = chained->next;
+    }
+    return block && chained == block;
+}
+
+/**
+ * Find the block in the current chain whose live bytes contain ptr, or NULL.
+ * Pointers into space a block had already given back are rejected.
+ */
+static ANVArenaBlock* find_chained_block(const ANVArena *arena, const uint8_t* ptr)
+{
+    ANVArenaBlock* block = arena->current ? arena->current->next : NULL;
+    while (block)
+    {
+        const uint8_t* block_start = BLOCK_DATA(block);
+        if (ptr >= block_start && ptr < block_start + block->used)
+        {
+            return block;
+        }
+        block = block->next;
+    }
+    return NULL;
+}
+
+/**
+ * Make a block with at least min_size free bytes current, reusing the
+ * first large enough block on the free list or chaining a new one.
+ */
+static bool grow_arena(ANVArena *arena, const size_t min_size)
+{
+    ANVArenaBlock* block = NULL;
+    ANVArenaBlock** link = &arena->free_blocks;
+    while (*link)
+    {
+        if ((*link)->size >= min_size)
+        {
+            block = *link;
+            *link = block->next;
+            break;
+        }
+        link = &(*link)->next;
+    }
+
+    if (!block)
+    {
+        size_t new_size = arena->size * 2;
+        if (new_size < arena->size || new_size < min_size)
+        {
+            new_size = min_size;
+        }
+
+        block = block_create(new_size);
+        if (!block)
+        {
+            return false;
+        }
+        arena->reserved += new_size;
+    }
+
+    // Keep the live size for accounting and the touched size for a later reset
+    arena->current->used = arena->used;
+    arena->current->touched = touched_bytes(arena);
+    arena->chain_used += arena->used;
+    block->next = arena->current;
+    set_current_block(arena, block, 0);
+    return true;
+}
+
+static size_t align_padding(const uint8_t *ptr, const size_t alignment)
+{
+    return (size_t)(-(uintptr_t)ptr & (uintptr_t)(alignment - 1));
+}
+
+static size_t commit_granularity(const ANVArena *arena)
+{
+    return (arena->flags & ANV_ARENA_HUGE_PAGES) ? ANV_VMEM_HUGE_PAGE_SIZE : ANV_ARENA_COMMIT_SIZE;
+}
+
+static size_t round_to_commit(const ANVArena *arena, const size_t size)
+{
+    const size_t granularity = commit_granularity(arena);
+    const size_t rounded = (size + granularity - 1) & ~(granularity - 1);
+    return rounded < size || rounded > arena->size ? arena->size : rounded;
+}
+
+/**
+ * Commit enough pages of a virtual arena to cover 'required' bytes.
+ */
+static bool commit_virtual(ANVArena *arena, const size_t required)
+{
+    if (required > arena->size)
+    {
+        return false;
+    }
+
+    const size_t new_committed = round_to_commit(arena, required);
+    if (ANV_FAILED(anv_vmem_commit(arena->memory + arena->committed, new_committed - arena->committed,
+                                   (arena->flags & ANV_ARENA_HUGE_PAGES) != 0)))
+    {
+        return false;
+    }
+
+    arena->committed = new_committed;
+    return true;
+}
+
+/**
+ * Decommit the pages of a virtual arena above 'keep' bytes.
+ */
+static void decommit_virtual(ANVArena *arena, const size_t keep)
+{
+    const size_t boundary = round_to_commit(arena, keep);
+    if (boundary < arena->committed &&
+        ANV_SUCCEEDED(anv_vmem_decommit(arena->memory + boundary, arena->committed - boundary)))
+    {
+        arena->committed = boundary;
+    }
+}
+
+static void reset_virtual(ANVArena *arena)
+{
+    update_peaks(arena);
+
+    const size_t touched = touched_bytes(arena);
+    const size_t keep = arena->retain_size > 0 ? round_to_commit(arena, arena->retain_size) : arena->committed;
+
+    // Freshly committed pages are zero, so only the retained prefix needs clearing
+    memset(arena->memory, 0, touched < keep ? touched : keep);
+    if (touched > keep)
+    {
+        decommit_virtual(arena, keep);
+    }
+
+    arena->used = 0;
+    arena->high_water = 0;
+}
+
+//==============================================================================
+// Creation and destruction functions
+//==============================================================================
+
 ANV_API ANVArena anv_arena_create(const size_t size)
 {
     ANVArena arena = {0};
-    arena.memory = malloc(size);
+    ANVArenaBlock* block = block_create(size);
+    if (block)
+    {
+        set_current_block(&arena, block, 0);
+        arena.reserved = size;
+        arena.flags = ANV_ARENA_FIXED;
+    }
+    return arena;
+}
+
+ANV_API ANVArena anv_arena_create_growable(const size_t initial_size, const size_t retain_size)
+{
+    ANVArena arena = anv_arena_create(initial_size);
     if (arena.memory)
     {
-        memset(arena.memory, 0, size);
-        arena.size = size;
-        arena.used = 0;
+        arena.retain_size = retain_size;
+        arena.flags = ANV_ARENA_GROWABLE;
+    }
+    return arena;
+}
+
+ANV_API ANVArena anv_arena_create_virtual(const size_t reserve_size, const size_t retain_size, const uint32_t flags)
+{
+    ANVArena arena = {0};
+    if (reserve_size == 0)
+    {
+        return arena;
+    }
+
+    const bool huge_pages = (flags & ANV_ARENA_HUGE_PAGES) != 0;
+    arena.memory = anv_vmem_reserve(reserve_size, huge_pages ? ANV_VMEM_HUGE_PAGE_SIZE : 0);
+    if (arena.memory)
+    {
+        arena.size = reserve_size;
+        arena.reserved = reserve_size;
+        arena.retain_size = retain_size;
+        arena.flags = ANV_ARENA_VIRTUAL | (huge_pages ? ANV_ARENA_HUGE_PAGES : 0);
     }
     return arena;
 }
@@ -27,33 +300,141 @@ ANV_API ANVResult anv_arena_destroy(ANVArena *arena)
         return ANV_RESULT_INVALID_ARGUMENT;
     }
 
-    free(arena->memory);
-    arena->memory = NULL;
-    arena->size = 0;
-    arena->used = 0;
+    if (arena->flags & ANV_ARENA_VIRTUAL)
+    {
+        anv_vmem_release(arena->memory, arena->size);
+        *arena = (ANVArena){0};
+        return ANV_RESULT_SUCCESS;
+    }
+
+    ANVArenaBlock* block = arena->current;
+    while (block)
+    {
+        ANVArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+
+    block = arena->free_blocks;
+    while (block)
+    {
+        ANVArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+
+    *arena = (ANVArena){0};
 
     return ANV_RESULT_SUCCESS;
 }
 
+//==============================================================================
+// Memory allocation operations
+//==============================================================================
+
 ANV_API void *anv_arena_allocate(ANVArena *arena, const size_t size)
 {
-    if (!arena || !arena->memory || size == 0)
+    return anv_arena_allocate_aligned(arena, size, ANV_ARENA_DEFAULT_ALIGNMENT);
+}
+
+ANV_API void *anv_arena_allocate_aligned(ANVArena *arena, const size_t size, const size_t alignment)
+{
+    if (!arena || !arena->memory || size == 0 || alignment == 0 || (alignment & (alignment - 1)) != 0)
     {
         return NULL;
     }
 
-    const size_t aligned_size = (size + 7) & ~7;
-
-    if (arena->used + aligned_size > arena->size)
+    // Sizes stay multiples of 8 so 'used' keeps the default alignment
+    const size_t aligned_size = (size + 7) & ~(size_t)7;
+    if (aligned_size < size)
     {
         return NULL;
     }
 
-    void* ptr = arena->memory + arena->used;
-    arena->used += aligned_size;
+    size_t padding = align_padding(arena->memory + arena->used, alignment);
+    if (aligned_size > arena->committed - arena->used ||
+        padding > arena->committed - arena->used - aligned_size)
+    {
+        if (arena->flags & ANV_ARENA_VIRTUAL)
+        {
+            if (aligned_size > arena->size - arena->used ||
+                padding > arena->size - arena->used - aligned_size ||
+                !commit_virtual(arena, arena->used + padding + aligned_size))
+            {
+                return NULL;
+            }
+        }
+        else
+        {
+            // A fresh block is only 16-byte aligned, so reserve room for the worst-case padding
+            if (!(arena->flags & ANV_ARENA_GROWABLE) || aligned_size > SIZE_MAX - alignment ||
+                !grow_arena(arena, aligned_size + alignment - 1))
+            {
+                return NULL;
+            }
+            padding = align_padding(arena->memory, alignment);
+        }
+    }
+
+    void* ptr = arena->memory + arena->used + padding;
+    arena->used += padding + aligned_size;
     return ptr;
 }
 
+ANV_API void *anv_arena_reallocate(ANVArena *arena, void *ptr, const size_t old_size, const size_t new_size)
+{
+    if (!ptr)
+    {
+        return anv_arena_allocate(arena, new_size);
+    }
+
+    if (!arena || !arena->memory || new_size == 0)
+    {
+        return NULL;
+    }
+
+    const size_t old_aligned = (old_size + 7) & ~(size_t)7;
+    const size_t new_aligned = (new_size + 7) & ~(size_t)7;
+    if (old_aligned < old_size || new_aligned < new_size)
+    {
+        return NULL;
+    }
+
+    // The most recent allocation in the current block can be resized in place
+    uint8_t *bytes = ptr;
+    if (bytes >= arena->memory && bytes + old_aligned == arena->memory + arena->used)
+    {
+        const size_t offset = (size_t)(bytes - arena->memory);
+        bool fits = new_aligned <= arena->committed - offset;
+        if (!fits && (arena->flags & ANV_ARENA_VIRTUAL) && new_aligned <= arena->size - offset)
+        {
+            fits = commit_virtual(arena, offset + new_aligned);
+        }
+
+        if (fits)
+        {
+            if (new_aligned < old_aligned)
+            {
+                update_peaks(arena);
+                arena->high_water = touched_bytes(arena);
+            }
+            arena->used = offset + new_aligned;
+            return ptr;
+        }
+    }
+    else if (new_aligned <= old_aligned)
+    {
+        return ptr;
+    }
+
+    void *new_ptr = anv_arena_allocate(arena, new_size);
+    if (new_ptr)
+    {
+        memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+    }
+    return new_ptr;
+}
+
 ANV_API void anv_arena_deallocate(ANVArena *arena, const void *ptr)
 {
     if (!arena || !arena->memory || !ptr)
@@ -70,8 +451,18 @@ ANV_API void anv_arena_deallocate(ANVArena *arena, const void *ptr)
         const size_t offset = alloc_ptr - arena_start;
         if (offset <= arena->used)
         {
+            update_peaks(arena);
+            arena->high_water = touched_bytes(arena);
             arena->used = offset;
         }
+        return;
+    }
+
+    // Look for the pointer in an older block, then unwind the blocks after it
+    ANVArenaBlock* owner = find_chained_block(arena, alloc_ptr);
+    if (owner)
+    {
+        unwind_to_block(arena, owner, (size_t)(alloc_ptr - BLOCK_DATA(owner)));
     }
 }
 
@@ -82,7 +473,173 @@ ANV_API ANVResult anv_arena_reset(ANVArena *arena)
         return ANV_RESULT_INVALID_ARGUMENT;
     }
 
-    memset(arena->memory, 0, arena->size);
+    if (arena->flags & ANV_ARENA_VIRTUAL)
+    {
+        reset_virtual(arena);
+        return ANV_RESULT_SUCCESS;
+    }
+
+    update_peaks(arena);
+
+    ANVArenaBlock* first = arena->current;
+    while (first->next)
+    {
+        first = first->next;
+    }
+    if (first != arena->current)
+    {
+        unwind_to_block(arena, first, 0);
+    }
+
+    memset(arena->memory, 0, touched_bytes(arena));
     arena->used = 0;
+    arena->high_water = 0;
+    arena->chain_used = 0;
+    first->used = 0;
+    first->touched = 0;
+
+    if (arena->retain_size > 0)
+    {
+        anv_arena_trim(arena, arena->retain_size);
+    }
+    return ANV_RESULT_SUCCESS;
+}
+
+ANV_API ANVResult anv_arena_trim(ANVArena *arena, const size_t retain_size)
+{
+    if (!arena || !arena->memory)
+    {
+        return ANV_RESULT_INVALID_ARGUMENT;
+    }
+
+    if (arena->flags & ANV_ARENA_VIRTUAL)
+    {
+        decommit_virtual(arena, arena->used > retain_size ? arena->used : retain_size);
+        if (arena->high_water > arena->committed)
+        {
+            arena->high_water = arena->committed;
+        }
+        return ANV_RESULT_SUCCESS;
+    }
+
+    while (arena->free_blocks && arena->reserved > retain_size)
+    {
+        ANVArenaBlock* block = arena->free_blocks;
+        arena->free_blocks = block->next;
+        arena->reserved -= block->size;
+        free(block);
+    }
     return ANV_RESULT_SUCCESS;
 }
+
+//==============================================================================
+// Markers and statistics
+//==============================================================================
+
+ANV_API ANVArenaMarker anv_arena_save(ANVArena *arena)
+{
+    ANVArenaMarker marker = {0};
+    if (!arena || !arena->memory)
+    {
+        return marker;
+    }
+
+    update_peaks(arena);
+
+    marker.block = arena->current;
+    marker.used = arena->used;
+    marker.total_used = arena->chain_used + arena->used;
+    marker.outer_scope_peak = arena->scope_peak;
+
+    arena->scope_peak = marker.total_used;
+    return marker;
+}
+
+ANV_API size_t anv_arena_restore(ANVArena *arena, const ANVArenaMarker *marker)
+{
+    const size_t peak = anv_arena_scope_peak(arena, marker);
+    if (!arena || !arena->memory || !marker)
+    {
+        return 0;
+    }
+
+    if (marker->block == arena->current)
+    {
+        if (marker->used < arena->used)
+        {
+            arena->high_water = touched_bytes(arena);
+            arena->used = marker->used;
+        }
+    }
+    else if (is_chained_block(arena, marker->block))
+    {
+        unwind_to_block(arena, marker->block, marker->used);
+    }
+
+    if (marker->outer_scope_peak > arena->scope_peak)
+    {
+        arena->scope_peak = marker->outer_scope_peak;
+    }
+    return peak;
+}
+
+ANV_API size_t anv_arena_scope_peak(ANVArena *arena, const ANVArenaMarker *marker)
+{
+    if (!arena || !arena->memory || !marker)
+    {
+        return 0;
+    }
+
+    update_peaks(arena);
+    return arena->scope_peak > marker->total_used ? arena->scope_peak - marker->total_used : 0;
+}
+
+ANV_API size_t anv_arena_total_used(const ANVArena *arena)
+{
+    return arena ? arena->chain_used + arena->used : 0;
+}
+
+ANV_API size_t anv_arena_peak_used(ANVArena *arena)
+{
+    if (!arena)
+    {
+        return 0;
+    }
+
+    update_peaks(arena);
+    return arena->peak_used;
+}
+
+//==============================================================================
+// Allocator integration
+//==============================================================================
+
+static void* arena_allocator_allocate(void* context, const size_t size)
+{
+    return anv_arena_allocate(context, size);
+}
+
+static void arena_allocator_deallocate(void* context, void* ptr)
+{
+    // Arena memory is released in bulk by reset/destroy
+    (void)context;
+    (void)ptr;
+}
+
+static void* arena_allocator_reallocate(void* context, void* ptr, const size_t old_size, const size_t new_size)
+{
+    return anv_arena_reallocate(context, ptr, old_size, new_size);
+}
+
+static void* arena_allocator_allocate_aligned(void* context, const size_t size, const size_t alignment)
+{
+    return anv_arena_allocate_aligned(context, size, alignment);
+}
+
+ANV_API ANVAllocator anv_arena_allocator(ANVArena *arena)
+{
+    ANVAllocator alloc = anv_alloc_stateful(arena, arena_allocator_allocate, arena_allocator_deallocate, NULL, NULL);
+    alloc.reallocate = arena_allocator_reallocate;
+    alloc.allocate_aligned = arena_allocator_allocate_aligned;
+    return alloc;
+}
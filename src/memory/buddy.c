@@ -0,0 +1,426 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include "anvil/memory/buddy.h"
+#include "anvil/memory/virtual_memory.h"
+
+#include <string.h>
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+// Side table entry: block order in the low bits plus state flags
+#define ORDER_MASK   0x3Fu
+#define TRIMMED_FLAG 0x40u // Free block whose pages past the header may be decommitted
+#define FREE_FLAG    0x80u
+
+static size_t block_size(const ANVBuddyAllocator* buddy, const uint32_t order)
+{
+    return buddy->min_block << order;
+}
+
+static size_t index_of(const ANVBuddyAllocator* buddy, const uint8_t* block)
+{
+    return (size_t)(block - buddy->memory) >> buddy->min_shift;
+}
+
+static uint32_t order_for(const ANVBuddyAllocator* buddy, const size_t size)
+{
+    const size_t blocks = (size + buddy->min_block - 1) >> buddy->min_shift;
+    uint32_t order = 0;
+    while (((size_t)1 << order) < blocks)
+    {
+        order++;
+    }
+    return order;
+}
+
+static void push_free(ANVBuddyAllocator* buddy, uint8_t* block, const uint32_t order, const uint8_t flags)
+{
+    ANVBuddyBlock* node = (ANVBuddyBlock*)block;
+    node->prev = NULL;
+    node->next = buddy->free_lists[order];
+    if (node->next)
+    {
+        node->next->prev = node;
+    }
+
+    buddy->free_lists[order] = node;
+    buddy->free_counts[order]++;
+    buddy->free_mask |= (uint32_t)1 << order;
+    buddy->block_orders[index_of(buddy, block)] = (uint8_t)(order | FREE_FLAG | flags);
+}
+
+static void remove_free(ANVBuddyAllocator* buddy, uint8_t* block, const uint32_t order)
+{
+    ANVBuddyBlock* node = (ANVBuddyBlock*)block;
+    if (node->prev)
+    {
+        node->prev->next = node->next;
+    }
+    else
+    {
+        buddy->free_lists[order] = node->next;
+    }
+    if (node->next)
+    {
+        node->next->prev = node->prev;
+    }
+
+    if (--buddy->free_counts[order] == 0)
+    {
+        buddy->free_mask &= ~((uint32_t)1 << order);
+    }
+}
+
+static bool is_free_block(const ANVBuddyAllocator* buddy, const uint8_t* block, const uint32_t order)
+{
+    const uint8_t entry = buddy->block_orders[index_of(buddy, block)];
+    return (entry & FREE_FLAG) && (entry & ORDER_MASK) == order;
+}
+
+// Commit the pages covering [ptr, ptr + size), which may start mid-page
+static void commit_range(uint8_t* ptr, const size_t size)
+{
+    const size_t page = anv_vmem_page_size();
+    const uintptr_t start = (uintptr_t)ptr & ~(uintptr_t)(page - 1);
+    anv_vmem_commit((void*)start, (uintptr_t)ptr + size - start, false);
+}
+
+/**
+ * Split a free block (already off its list) down to 'order', returning the
+ * upper halves to the free lists. Pages are committed before headers are
+ * written into a trimmed block.
+ */
+static void split_to(ANVBuddyAllocator* buddy, uint8_t* block, uint32_t current, const uint32_t order,
+                     const uint8_t flags)
+{
+    while (current > order)
+    {
+        current--;
+        uint8_t* upper = block + block_size(buddy, current);
+        if (flags & TRIMMED_FLAG)
+        {
+            commit_range(upper, sizeof(ANVBuddyBlock));
+        }
+        push_free(buddy, upper, current, flags);
+    }
+}
+
+static void mark_used(ANVBuddyAllocator* buddy, uint8_t* block, const uint32_t order, const size_t requested)
+{
+    const size_t index = index_of(buddy, block);
+    buddy->block_orders[index] = (uint8_t)order;
+    buddy->block_requests[index] = requested;
+    buddy->used_bytes += block_size(buddy, order);
+    buddy->requested_bytes += requested;
+    buddy->live_blocks++;
+}
+
+//==============================================================================
+// Buddy allocator functions
+//==============================================================================
+
+ANV_API ANVBuddyAllocator anv_buddy_create(const size_t size, const size_t min_block)
+{
+    ANVBuddyAllocator buddy = {0};
+    if (size == 0 || min_block < ANV_BUDDY_MIN_BLOCK_SIZE || (min_block & (min_block - 1)) != 0)
+    {
+        return buddy;
+    }
+
+    uint32_t min_shift = 0;
+    while (((size_t)1 << min_shift) < min_block)
+    {
+        min_shift++;
+    }
+
+    size_t region = min_block;
+    uint32_t order_count = 1;
+    while (region < size)
+    {
+        if (order_count == ANV_BUDDY_MAX_ORDERS || region > SIZE_MAX / 2)
+        {
+            return buddy;
+        }
+        region *= 2;
+        order_count++;
+    }
+
+    const size_t entries = region >> min_shift;
+    const size_t metadata_size = entries * (sizeof(size_t) + 1);
+    void* metadata = anv_vmem_reserve(metadata_size, 0);
+    if (!metadata)
+    {
+        return buddy;
+    }
+    if (anv_vmem_commit(metadata, metadata_size, false) != ANV_RESULT_SUCCESS)
+    {
+        anv_vmem_release(metadata, metadata_size);
+        return buddy;
+    }
+
+    // Aligning the region to its size keeps every block aligned to its own size
+    const size_t page = anv_vmem_page_size();
+    uint8_t* memory = anv_vmem_reserve(region, region > page ? region : 0);
+    if (!memory || anv_vmem_commit(memory, region, false) != ANV_RESULT_SUCCESS)
+    {
+        if (memory)
+        {
+            anv_vmem_release(memory, region);
+        }
+        anv_vmem_release(metadata, metadata_size);
+        return buddy;
+    }
+
+    buddy.memory = memory;
+    buddy.size = region;
+    buddy.min_block = min_block;
+    buddy.min_shift = min_shift;
+    buddy.order_count = order_count;
+    buddy.block_requests = metadata;
+    buddy.block_orders = (uint8_t*)metadata + entries * sizeof(size_t);
+    buddy.metadata_size = metadata_size;
+    push_free(&buddy, memory, order_count - 1, 0);
+    return buddy;
+}
+
+ANV_API void anv_buddy_destroy(ANVBuddyAllocator* buddy)
+{
+    if (!buddy || !buddy->memory)
+    {
+        return;
+    }
+
+    anv_vmem_release(buddy->memory, buddy->size);
+    anv_vmem_release(buddy->block_requests, buddy->metadata_size);
+    *buddy = (ANVBuddyAllocator){0};
+}
+
+ANV_API void* anv_buddy_allocate(ANVBuddyAllocator* buddy, const size_t size)
+{
+    if (!buddy || !buddy->memory || size == 0 || size > buddy->size)
+    {
+        return NULL;
+    }
+
+    const uint32_t order = order_for(buddy, size);
+    const uint32_t candidates = buddy->free_mask & (~(uint32_t)0 << order);
+    if (!candidates)
+    {
+        return NULL;
+    }
+
+    // Lowest non-empty order that fits
+    uint32_t current = order;
+    while (!(candidates & ((uint32_t)1 << current)))
+    {
+        current++;
+    }
+
+    uint8_t* block = (uint8_t*)buddy->free_lists[current];
+    const uint8_t flags = buddy->block_orders[index_of(buddy, block)] & TRIMMED_FLAG;
+    remove_free(buddy, block, current);
+    split_to(buddy, block, current, order, flags);
+
+    if (flags)
+    {
+        commit_range(block, block_size(buddy, order));
+    }
+    mark_used(buddy, block, order, size);
+    return block;
+}
+
+ANV_API void anv_buddy_deallocate(ANVBuddyAllocator* buddy, void* ptr)
+{
+    if (!buddy || !buddy->memory || !ptr)
+    {
+        return;
+    }
+
+    uint8_t* block = ptr;
+    const size_t index = index_of(buddy, block);
+    uint32_t order = buddy->block_orders[index] & ORDER_MASK;
+
+    buddy->used_bytes -= block_size(buddy, order);
+    buddy->requested_bytes -= buddy->block_requests[index];
+    buddy->live_blocks--;
+
+    // Merge upward while the buddy at the same order is free
+    uint8_t flags = 0;
+    while (order + 1 < buddy->order_count)
+    {
+        const size_t offset = (size_t)(block - buddy->memory);
+        uint8_t* partner = buddy->memory + (offset ^ block_size(buddy, order));
+        if (!is_free_block(buddy, partner, order))
+        {
+            break;
+        }
+
+        flags |= buddy->block_orders[index_of(buddy, partner)] & TRIMMED_FLAG;
+        remove_free(buddy, partner, order);
+        if (partner < block)
+        {
+            block = partner;
+        }
+        order++;
+    }
+
+    push_free(buddy, block, order, flags);
+}
+
+ANV_API void* anv_buddy_reallocate(ANVBuddyAllocator* buddy, void* ptr, const size_t size)
+{
+    if (!buddy || !buddy->memory)
+    {
+        return NULL;
+    }
+    if (!ptr)
+    {
+        return anv_buddy_allocate(buddy, size);
+    }
+    if (size == 0 || size > buddy->size)
+    {
+        return NULL;
+    }
+
+    uint8_t* block = ptr;
+    const size_t index = index_of(buddy, block);
+    const uint32_t order = buddy->block_orders[index] & ORDER_MASK;
+    const uint32_t target = order_for(buddy, size);
+    const size_t old_request = buddy->block_requests[index];
+
+    if (target < order)
+    {
+        // Hand back the upper halves; their buddies are this block, so none merge
+        split_to(buddy, block, order, target, 0);
+        buddy->used_bytes -= block_size(buddy, order) - block_size(buddy, target);
+    }
+    else if (target > order)
+    {
+        // Grow in place only if every buddy above the block is free
+        const size_t offset = (size_t)(block - buddy->memory);
+        bool in_place = true;
+        for (uint32_t k = order; k < target && in_place; k++)
+        {
+            in_place = !(offset & block_size(buddy, k)) && is_free_block(buddy, block + block_size(buddy, k), k);
+        }
+
+        if (!in_place)
+        {
+            void* moved = anv_buddy_allocate(buddy, size);
+            if (moved)
+            {
+                memcpy(moved, ptr, old_request < size ? old_request : size);
+                anv_buddy_deallocate(buddy, ptr);
+            }
+            return moved;
+        }
+
+        for (uint32_t k = order; k < target; k++)
+        {
+            uint8_t* partner = block + block_size(buddy, k);
+            if (buddy->block_orders[index_of(buddy, partner)] & TRIMMED_FLAG)
+            {
+                commit_range(partner, block_size(buddy, k));
+            }
+            remove_free(buddy, partner, k);
+        }
+        buddy->used_bytes += block_size(buddy, target) - block_size(buddy, order);
+    }
+
+    buddy->block_orders[index] = (uint8_t)target;
+    buddy->block_requests[index] = size;
+    buddy->requested_bytes += size - old_request;
+    return ptr;
+}
+
+ANV_API void anv_buddy_trim(ANVBuddyAllocator* buddy)
+{
+    if (!buddy || !buddy->memory)
+    {
+        return;
+    }
+
+    // Only blocks spanning more than one page have pages to give back
+    const size_t page = anv_vmem_page_size();
+    for (uint32_t order = 0; order < buddy->order_count; order++)
+    {
+        const size_t size = block_size(buddy, order);
+        if (size <= page)
+        {
+            continue;
+        }
+
+        for (ANVBuddyBlock* node = buddy->free_lists[order]; node; node = node->next)
+        {
+            uint8_t* entry = &buddy->block_orders[index_of(buddy, (uint8_t*)node)];
+            if (!(*entry & TRIMMED_FLAG))
+            {
+                anv_vmem_decommit((uint8_t*)node + page, size - page);
+                *entry |= TRIMMED_FLAG;
+            }
+        }
+    }
+}
+
+ANV_API ANVBuddyStats anv_buddy_stats(const ANVBuddyAllocator* buddy)
+{
+    ANVBuddyStats stats = {0};
+    if (!buddy || !buddy->memory)
+    {
+        return stats;
+    }
+
+    for (uint32_t order = 0; order < buddy->order_count; order++)
+    {
+        stats.free_blocks += buddy->free_counts[order];
+        stats.free_bytes += buddy->free_counts[order] * block_size(buddy, order);
+        if (buddy->free_counts[order] > 0)
+        {
+            stats.largest_free_block = block_size(buddy, order);
+        }
+    }
+
+    stats.total_bytes = buddy->size;
+    stats.used_bytes = buddy->used_bytes;
+    stats.requested_bytes = buddy->requested_bytes;
+    if (stats.used_bytes > 0)
+    {
+        stats.internal_fragmentation = 1.0 - (double)stats.requested_bytes / (double)stats.used_bytes;
+    }
+    if (stats.free_bytes > 0)
+    {
+        stats.external_fragmentation = 1.0 - (double)stats.largest_free_block / (double)stats.free_bytes;
+    }
+    return stats;
+}
+
+//==============================================================================
+// Allocator integration
+//==============================================================================
+
+static void* buddy_allocator_allocate(void* context, const size_t size)
+{
+    return anv_buddy_allocate(context, size);
+}
+
+static void buddy_allocator_deallocate(void* context, void* ptr)
+{
+    anv_buddy_deallocate(context, ptr);
+}
+
+static void* buddy_allocator_reallocate(void* context, void* ptr, const size_t old_size, const size_t new_size)
+{
+    (void)old_size;
+    return anv_buddy_reallocate(context, ptr, new_size);
+}
+
+ANV_API ANVAllocator anv_buddy_allocator(ANVBuddyAllocator* buddy)
+{
+    ANVAllocator alloc = anv_alloc_stateful(buddy, buddy_allocator_allocate, buddy_allocator_deallocate, NULL, NULL);
+    alloc.reallocate = buddy_allocator_reallocate;
+    return alloc;
+}
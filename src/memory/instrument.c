@@ -0,0 +1,284 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include "anvil/memory/instrument.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+//==============================================================================
+// Internal types
+//==============================================================================
+
+// Each block is preceded by its requested size, padded to keep 16-byte alignment
+#define BLOCK_HEADER_SIZE ((size_t)16)
+
+// Aligned to a cache line so threads on different shards never share one
+typedef struct Shard
+{
+    _Alignas(64) atomic_size_t allocations;
+    atomic_size_t deallocations;
+    atomic_size_t reallocations;
+    atomic_size_t requested_bytes;
+    atomic_llong pending; // Live-byte delta not yet folded into the instrument
+    atomic_size_t histogram[ANV_INSTRUMENT_HISTOGRAM_BUCKETS];
+} Shard;
+
+struct ANVInstrument
+{
+    ANVAllocator backing; // Allocator the blocks come from
+    const char* tag;      // Name reported in the statistics
+    _Alignas(64) atomic_llong live;
+    atomic_llong peak;
+    Shard shards[ANV_INSTRUMENT_SHARDS];
+};
+
+static atomic_uint next_thread_slot;
+static ANV_THREAD_LOCAL unsigned thread_slot; // Shard index + 1, 0 until first use
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+static Shard* shard_of(ANVInstrument* instrument)
+{
+    if (thread_slot == 0)
+    {
+        const unsigned slot = atomic_fetch_add_explicit(&next_thread_slot, 1, memory_order_relaxed);
+        thread_slot = slot % ANV_INSTRUMENT_SHARDS + 1;
+    }
+    return &instrument->shards[thread_slot - 1];
+}
+
+static size_t histogram_bucket(const size_t size)
+{
+    size_t bucket = 0;
+    size_t limit = 16;
+    while (size > limit && bucket < ANV_INSTRUMENT_HISTOGRAM_BUCKETS - 1)
+    {
+        limit <<= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static size_t block_size(const void* ptr)
+{
+    size_t size;
+    memcpy(&size, (const uint8_t*)ptr - BLOCK_HEADER_SIZE, sizeof(size));
+    return size;
+}
+
+static void* finish_block(uint8_t* raw, const size_t size)
+{
+    memcpy(raw, &size, sizeof(size));
+    return raw + BLOCK_HEADER_SIZE;
+}
+
+static void update_peak(ANVInstrument* instrument, const long long live)
+{
+    long long peak = atomic_load_explicit(&instrument->peak, memory_order_relaxed);
+    while (live > peak &&
+           !atomic_compare_exchange_weak_explicit(&instrument->peak, &peak, live, memory_order_relaxed,
+                                                  memory_order_relaxed))
+    {
+    }
+}
+
+static void record_live(ANVInstrument* instrument, Shard* shard, const long long delta)
+{
+    const long long pending = atomic_fetch_add_explicit(&shard->pending, delta, memory_order_relaxed) + delta;
+    if (pending < (long long)ANV_INSTRUMENT_FLUSH_BYTES && pending > -(long long)ANV_INSTRUMENT_FLUSH_BYTES)
+    {
+        // Growth between flushes still counts: the folded total plus this shard's delta
+        if (delta > 0)
+        {
+            update_peak(instrument, atomic_load_explicit(&instrument->live, memory_order_relaxed) + pending);
+        }
+        return;
+    }
+
+    // Fold the shard's delta into the shared total; only growth can raise the peak
+    const long long folded = atomic_exchange_explicit(&shard->pending, 0, memory_order_relaxed);
+    const long long live = atomic_fetch_add_explicit(&instrument->live, folded, memory_order_relaxed) + folded;
+    if (folded > 0)
+    {
+        update_peak(instrument, live);
+    }
+}
+
+static void record_request(Shard* shard, const size_t size)
+{
+    atomic_fetch_add_explicit(&shard->requested_bytes, size, memory_order_relaxed);
+    atomic_fetch_add_explicit(&shard->histogram[histogram_bucket(size)], 1, memory_order_relaxed);
+}
+
+//==============================================================================
+// Allocator hooks
+//==============================================================================
+
+static void* instrument_allocate(void* context, const size_t size)
+{
+    ANVInstrument* instrument = context;
+    if (size > SIZE_MAX - BLOCK_HEADER_SIZE)
+    {
+        return NULL;
+    }
+
+    uint8_t* raw = anv_alloc_allocate(&instrument->backing, size + BLOCK_HEADER_SIZE);
+    if (!raw)
+    {
+        return NULL;
+    }
+
+    Shard* shard = shard_of(instrument);
+    atomic_fetch_add_explicit(&shard->allocations, 1, memory_order_relaxed);
+    record_request(shard, size);
+    record_live(instrument, shard, (long long)size);
+    return finish_block(raw, size);
+}
+
+static void instrument_deallocate(void* context, void* ptr)
+{
+    ANVInstrument* instrument = context;
+    if (!ptr)
+    {
+        return;
+    }
+
+    const size_t size = block_size(ptr);
+    anv_alloc_deallocate(&instrument->backing, (uint8_t*)ptr - BLOCK_HEADER_SIZE);
+
+    Shard* shard = shard_of(instrument);
+    atomic_fetch_add_explicit(&shard->deallocations, 1, memory_order_relaxed);
+    record_live(instrument, shard, -(long long)size);
+}
+
+static void* instrument_reallocate(void* context, void* ptr, const size_t old_size, const size_t new_size)
+{
+    (void)old_size;
+    ANVInstrument* instrument = context;
+    if (!ptr)
+    {
+        return instrument_allocate(context, new_size);
+    }
+    if (new_size > SIZE_MAX - BLOCK_HEADER_SIZE)
+    {
+        return NULL;
+    }
+
+    // The header holds the true size, so the caller's old_size is not trusted
+    const size_t recorded = block_size(ptr);
+    uint8_t* raw = anv_alloc_reallocate(&instrument->backing, (uint8_t*)ptr - BLOCK_HEADER_SIZE,
+                                        recorded + BLOCK_HEADER_SIZE, new_size + BLOCK_HEADER_SIZE);
+    if (!raw)
+    {
+        return NULL;
+    }
+
+    Shard* shard = shard_of(instrument);
+    atomic_fetch_add_explicit(&shard->reallocations, 1, memory_order_relaxed);
+    record_request(shard, new_size);
+    record_live(instrument, shard, (long long)new_size - (long long)recorded);
+    return finish_block(raw, new_size);
+}
+
+//==============================================================================
+// Instrumented allocator functions
+//==============================================================================
+
+ANV_API ANVInstrument* anv_instrument_create(const ANVAllocator* backing, const char* tag)
+{
+    if (!anv_alloc_is_valid(backing))
+    {
+        return NULL;
+    }
+
+    ANVInstrument* instrument = anv_alloc_allocate_aligned(backing, sizeof(ANVInstrument), _Alignof(ANVInstrument));
+    if (!instrument)
+    {
+        return NULL;
+    }
+
+    memset(instrument, 0, sizeof(*instrument));
+    instrument->backing = *backing;
+    instrument->tag = tag;
+    return instrument;
+}
+
+ANV_API void anv_instrument_destroy(ANVInstrument* instrument)
+{
+    if (!instrument)
+    {
+        return;
+    }
+
+    const ANVAllocator backing = instrument->backing;
+    anv_alloc_deallocate_aligned(&backing, instrument);
+}
+
+ANV_API ANVAllocator anv_instrument_allocator(ANVInstrument* instrument)
+{
+    ANVAllocator alloc = anv_alloc_stateful(instrument, instrument_allocate, instrument_deallocate,
+                                            instrument->backing.data_free, instrument->backing.copy);
+    alloc.reallocate = instrument_reallocate;
+    alloc.flags = instrument->backing.flags;
+    return alloc;
+}
+
+ANV_API ANVAllocStats anv_instrument_stats(const ANVInstrument* instrument)
+{
+    ANVAllocStats stats = {0};
+    if (!instrument)
+    {
+        return stats;
+    }
+
+    long long live = atomic_load_explicit(&instrument->live, memory_order_relaxed);
+    for (size_t i = 0; i < ANV_INSTRUMENT_SHARDS; i++)
+    {
+        const Shard* shard = &instrument->shards[i];
+        stats.allocations += atomic_load_explicit(&shard->allocations, memory_order_relaxed);
+        stats.deallocations += atomic_load_explicit(&shard->deallocations, memory_order_relaxed);
+        stats.reallocations += atomic_load_explicit(&shard->reallocations, memory_order_relaxed);
+        stats.requested_bytes += atomic_load_explicit(&shard->requested_bytes, memory_order_relaxed);
+        live += atomic_load_explicit(&shard->pending, memory_order_relaxed);
+
+        for (size_t b = 0; b < ANV_INSTRUMENT_HISTOGRAM_BUCKETS; b++)
+        {
+            stats.histogram[b] += atomic_load_explicit(&shard->histogram[b], memory_order_relaxed);
+        }
+    }
+
+    const long long peak = atomic_load_explicit(&instrument->peak, memory_order_relaxed);
+    stats.tag = instrument->tag;
+    stats.live_bytes = live > 0 ? (size_t)live : 0;
+    stats.peak_bytes = peak > live ? (size_t)peak : stats.live_bytes;
+    return stats;
+}
+
+ANV_API void anv_instrument_reset(ANVInstrument* instrument)
+{
+    if (!instrument)
+    {
+        return;
+    }
+
+    long long live = atomic_load_explicit(&instrument->live, memory_order_relaxed);
+    for (size_t i = 0; i < ANV_INSTRUMENT_SHARDS; i++)
+    {
+        Shard* shard = &instrument->shards[i];
+        atomic_store_explicit(&shard->allocations, 0, memory_order_relaxed);
+        atomic_store_explicit(&shard->deallocations, 0, memory_order_relaxed);
+        atomic_store_explicit(&shard->reallocations, 0, memory_order_relaxed);
+        atomic_store_explicit(&shard->requested_bytes, 0, memory_order_relaxed);
+        live += atomic_load_explicit(&shard->pending, memory_order_relaxed);
+
+        for (size_t b = 0; b < ANV_INSTRUMENT_HISTOGRAM_BUCKETS; b++)
+        {
+            atomic_store_explicit(&shard->histogram[b], 0, memory_order_relaxed);
+        }
+    }
+    atomic_store_explicit(&instrument->peak, live, memory_order_relaxed);
+}
@@ -0,0 +1,192 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include "anvil/memory/scratch.h"
+
+#ifdef ANV_PLATFORM_WINDOWS
+    #include <Windows.h>
+#else
+    #include <pthread.h>
+#endif
+
+//==============================================================================
+// Internal types
+//==============================================================================
+
+typedef struct ScratchState
+{
+    ANVArena arena;  // Growable arena, memory is NULL until first use
+    size_t size;     // First block size (0 selects ANV_SCRATCH_DEFAULT_SIZE)
+    size_t depth;    // Frames currently open
+    bool registered; // Exit hook installed for this thread
+} ScratchState;
+
+static ANV_THREAD_LOCAL ScratchState scratch;
+
+//==============================================================================
+// Thread exit handling
+//==============================================================================
+
+static void release_state(ScratchState* state)
+{
+    if (state->arena.memory)
+    {
+        anv_arena_destroy(&state->arena);
+    }
+}
+
+#ifdef ANV_PLATFORM_WINDOWS
+static DWORD exit_key = FLS_OUT_OF_INDEXES;
+static INIT_ONCE exit_once = INIT_ONCE_STATIC_INIT;
+
+static void NTAPI on_thread_exit(void* value)
+{
+    if (value)
+    {
+        release_state(value);
+        ((ScratchState*)value)->registered = false;
+    }
+}
+
+static BOOL CALLBACK create_exit_key(PINIT_ONCE once, PVOID param, PVOID* context)
+{
+    (void)once;
+    (void)param;
+    (void)context;
+    exit_key = FlsAlloc(on_thread_exit);
+    return TRUE;
+}
+
+static void register_thread(ScratchState* state)
+{
+    InitOnceExecuteOnce(&exit_once, create_exit_key, NULL, NULL);
+    if (exit_key != FLS_OUT_OF_INDEXES)
+    {
+        FlsSetValue(exit_key, state);
+    }
+    state->registered = true;
+}
+#else
+static pthread_key_t exit_key;
+static pthread_once_t exit_once = PTHREAD_ONCE_INIT;
+static bool exit_key_valid = false;
+
+static void on_thread_exit(void* value)
+{
+    release_state(value);
+    ((ScratchState*)value)->registered = false;
+}
+
+static void create_exit_key(void)
+{
+    exit_key_valid = pthread_key_create(&exit_key, on_thread_exit) == 0;
+}
+
+static void register_thread(ScratchState* state)
+{
+    pthread_once(&exit_once, create_exit_key);
+    if (exit_key_valid)
+    {
+        pthread_setspecific(exit_key, state);
+    }
+    state->registered = true;
+}
+#endif
+
+static ANVArena* get_arena(void)
+{
+    ScratchState* state = &scratch;
+    if (state->arena.memory)
+    {
+        return &state->arena;
+    }
+
+    if (!state->registered)
+    {
+        register_thread(state);
+    }
+
+    // Chained blocks beyond the first are dropped when the outermost frame ends
+    const size_t size = state->size ? state->size : ANV_SCRATCH_DEFAULT_SIZE;
+    state->arena = anv_arena_create_growable(size, size);
+    return state->arena.memory ? &state->arena : NULL;
+}
+
+//==============================================================================
+// Scratch allocator functions
+//==============================================================================
+
+ANV_API ANVResult anv_scratch_configure(const size_t size)
+{
+    if (size == 0)
+    {
+        return ANV_RESULT_INVALID_ARGUMENT;
+    }
+
+    ScratchState* state = &scratch;
+    if (state->depth > 0)
+    {
+        return ANV_RESULT_INVALID_STATE;
+    }
+
+    release_state(state);
+    state->size = size;
+    return ANV_RESULT_SUCCESS;
+}
+
+ANV_API ANVScratchFrame anv_scratch_begin(void)
+{
+    ANVScratchFrame frame = {0};
+    frame.arena = get_arena();
+    if (frame.arena)
+    {
+        frame.marker = anv_arena_save(frame.arena);
+        scratch.depth++;
+    }
+    return frame;
+}
+
+ANV_API void anv_scratch_end(ANVScratchFrame* frame)
+{
+    if (!frame || !frame->arena)
+    {
+        return;
+    }
+
+    if (--scratch.depth == 0)
+    {
+        anv_arena_reset(frame->arena);
+    }
+    else
+    {
+        anv_arena_restore(frame->arena, &frame->marker);
+    }
+    frame->arena = NULL;
+}
+
+ANV_API void* anv_scratch_allocate(ANVScratchFrame* frame, const size_t size)
+{
+    if (!frame || !frame->arena)
+    {
+        return NULL;
+    }
+    return anv_arena_allocate(frame->arena, size);
+}
+
+ANV_API ANVAllocator anv_scratch_allocator(ANVScratchFrame* frame)
+{
+    return anv_arena_allocator(frame ? frame->arena : NULL);
+}
+
+ANV_API ANVResult anv_scratch_release(void)
+{
+    ScratchState* state = &scratch;
+    if (state->depth > 0)
+    {
+        return ANV_RESULT_INVALID_STATE;
+    }
+
+    release_state(state);
+    return ANV_RESULT_SUCCESS;
+}
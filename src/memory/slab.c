@@ -0,0 +1,333 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include "anvil/memory/slab.h"
+#include "anvil/memory/virtual_memory.h"
+
+#include <string.h>
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+// Keep objects 16-byte aligned regardless of the header layout
+#define SLAB_HEADER_SIZE ((sizeof(ANVSlab) + 15) & ~(size_t)15)
+#define SLAB_OBJECTS(s) ((uint8_t*)(s) + SLAB_HEADER_SIZE)
+
+static ANVSlab* slab_of(const ANVSlabAllocator* slab, const void* ptr)
+{
+    return (ANVSlab*)((uintptr_t)ptr & ~(uintptr_t)(slab->slab_size - 1));
+}
+
+static void list_push(ANVSlab** head, ANVSlab* s)
+{
+    s->prev = NULL;
+    s->next = *head;
+    if (*head)
+    {
+        (*head)->prev = s;
+    }
+    *head = s;
+}
+
+static void list_remove(ANVSlab** head, ANVSlab* s)
+{
+    if (s->prev)
+    {
+        s->prev->next = s->next;
+    }
+    else
+    {
+        *head = s->next;
+    }
+
+    if (s->next)
+    {
+        s->next->prev = s->prev;
+    }
+    s->next = NULL;
+    s->prev = NULL;
+}
+
+static void reset_slab(ANVSlab* s)
+{
+    s->free_list = NULL;
+    s->bump = SLAB_OBJECTS(s);
+    s->used = 0;
+}
+
+static ANVSlab* map_slab(const ANVSlabAllocator* slab)
+{
+    // Aligning the slab to its own size lets deallocate find it by masking
+    void* memory = anv_vmem_reserve(slab->slab_size, slab->slab_size);
+    if (!memory)
+    {
+        return NULL;
+    }
+
+    if (anv_vmem_commit(memory, slab->slab_size, false) != ANV_RESULT_SUCCESS)
+    {
+        anv_vmem_release(memory, slab->slab_size);
+        return NULL;
+    }
+
+    ANVSlab* s = memory;
+    reset_slab(s);
+    return s;
+}
+
+static void unmap_slab(ANVSlabAllocator* slab, ANVSlab* s)
+{
+    anv_vmem_release(s, slab->slab_size);
+    slab->slab_count--;
+}
+
+static void release_list(ANVSlabAllocator* slab, ANVSlab* head)
+{
+    while (head)
+    {
+        ANVSlab* next = head->next;
+        unmap_slab(slab, head);
+        head = next;
+    }
+}
+
+static ANVSlab* acquire_slab(ANVSlabAllocator* slab)
+{
+    ANVSlab* s = slab->empty;
+    if (s)
+    {
+        list_remove(&slab->empty, s);
+        slab->empty_count--;
+        return s;
+    }
+
+    s = map_slab(slab);
+    if (s)
+    {
+        slab->slab_count++;
+    }
+    return s;
+}
+
+//==============================================================================
+// Slab allocator functions
+//==============================================================================
+
+ANV_API ANVSlabAllocator anv_slab_create(const size_t object_size)
+{
+    ANVSlabAllocator slab = {0};
+    if (object_size == 0 || object_size > ANV_SLAB_MAX_OBJECT_SIZE)
+    {
+        return slab;
+    }
+
+    // Freed objects store the free list link in their first word
+    size_t size = (object_size + 7) & ~(size_t)7;
+    if (size < sizeof(void*))
+    {
+        size = sizeof(void*);
+    }
+
+    size_t slab_size = anv_vmem_page_size();
+    while ((slab_size - SLAB_HEADER_SIZE) / size < ANV_SLAB_MIN_OBJECTS)
+    {
+        slab_size *= 2;
+    }
+
+    slab.object_size = size;
+    slab.slab_size = slab_size;
+    slab.objects_per_slab = (slab_size - SLAB_HEADER_SIZE) / size;
+    slab.max_empty = ANV_SLAB_DEFAULT_MAX_EMPTY;
+    return slab;
+}
+
+ANV_API void anv_slab_destroy(ANVSlabAllocator* slab)
+{
+    if (!slab)
+    {
+        return;
+    }
+
+    release_list(slab, slab->partial);
+    release_list(slab, slab->full);
+    release_list(slab, slab->empty);
+
+    slab->partial = NULL;
+    slab->full = NULL;
+    slab->empty = NULL;
+    slab->empty_count = 0;
+    slab->live_objects = 0;
+}
+
+ANV_API void* anv_slab_allocate(ANVSlabAllocator* slab)
+{
+    if (!slab || slab->object_size == 0)
+    {
+        return NULL;
+    }
+
+    ANVSlab* s = slab->partial;
+    if (!s)
+    {
+        s = acquire_slab(slab);
+        if (!s)
+        {
+            return NULL;
+        }
+        list_push(&slab->partial, s);
+    }
+
+    void* object = s->free_list;
+    if (object)
+    {
+        memcpy(&s->free_list, object, sizeof(void*));
+    }
+    else
+    {
+        object = s->bump;
+        s->bump += slab->object_size;
+    }
+
+    s->used++;
+    slab->live_objects++;
+
+    if (s->used == slab->objects_per_slab)
+    {
+        list_remove(&slab->partial, s);
+        list_push(&slab->full, s);
+    }
+
+    return object;
+}
+
+ANV_API void anv_slab_deallocate(ANVSlabAllocator* slab, void* ptr)
+{
+    if (!slab || !ptr)
+    {
+        return;
+    }
+
+    ANVSlab* s = slab_of(slab, ptr);
+    memcpy(ptr, &s->free_list, sizeof(void*));
+    s->free_list = ptr;
+
+    if (s->used == slab->objects_per_slab)
+    {
+        list_remove(&slab->full, s);
+        list_push(&slab->partial, s);
+    }
+
+    s->used--;
+    slab->live_objects--;
+
+    if (s->used > 0)
+    {
+        return;
+    }
+
+    list_remove(&slab->partial, s);
+    if (slab->empty_count < slab->max_empty)
+    {
+        reset_slab(s);
+        list_push(&slab->empty, s);
+        slab->empty_count++;
+    }
+    else
+    {
+        unmap_slab(slab, s);
+    }
+}
+
+ANV_API void anv_slab_trim(ANVSlabAllocator* slab)
+{
+    if (!slab)
+    {
+        return;
+    }
+
+    release_list(slab, slab->empty);
+    slab->empty = NULL;
+    slab->empty_count = 0;
+}
+
+//==============================================================================
+// Allocator integration
+//==============================================================================
+
+static void* slab_allocator_allocate(void* context, const size_t size)
+{
+    ANVSlabAllocator* slab = context;
+    if (size > slab->object_size)
+    {
+        return NULL;
+    }
+    return anv_slab_allocate(slab);
+}
+
+static void slab_allocator_deallocate(void* context, void* ptr)
+{
+    anv_slab_deallocate(context, ptr);
+}
+
+ANV_API ANVAllocator anv_slab_allocator(ANVSlabAllocator* slab)
+{
+    return anv_alloc_stateful(slab, slab_allocator_allocate, slab_allocator_deallocate, NULL, NULL);
+}
+
+//==============================================================================
+// Container node pools
+//==============================================================================
+
+ANV_API ANVSlabAllocator* anv_slab_pool_create(const ANVAllocator* alloc, const size_t node_size)
+{
+    if (!alloc || !(alloc->flags & ANV_ALLOC_POOL_NODES))
+    {
+        return NULL;
+    }
+
+    ANVSlabAllocator* pool = anv_alloc_allocate(alloc, sizeof(ANVSlabAllocator));
+    if (!pool)
+    {
+        return NULL;
+    }
+
+    *pool = anv_slab_create(node_size);
+    if (pool->object_size == 0)
+    {
+        anv_alloc_deallocate(alloc, pool);
+        return NULL;
+    }
+    return pool;
+}
+
+ANV_API void anv_slab_pool_destroy(const ANVAllocator* alloc, ANVSlabAllocator* pool)
+{
+    if (!pool)
+    {
+        return;
+    }
+
+    anv_slab_destroy(pool);
+    anv_alloc_deallocate(alloc, pool);
+}
+
+ANV_API void* anv_slab_pool_allocate(ANVSlabAllocator* pool, const ANVAllocator* alloc, const size_t node_size)
+{
+    if (pool)
+    {
+        return anv_slab_allocate(pool);
+    }
+    return anv_alloc_allocate(alloc, node_size);
+}
+
+ANV_API void anv_slab_pool_deallocate(ANVSlabAllocator* pool, const ANVAllocator* alloc, void* node)
+{
+    if (pool)
+    {
+        anv_slab_deallocate(pool, node);
+        return;
+    }
+    anv_alloc_deallocate(alloc, node);
+}
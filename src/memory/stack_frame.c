@@ -8,20 +8,34 @@
 
 ANV_API void *anv_stackframe_allocate(ANVStackFrame* frame, const size_t size)
 {
-    if (!frame || size == 0)
+    return anv_stackframe_allocate_aligned(frame, size, ANV_STACK_FRAME_DEFAULT_ALIGNMENT);
+}
+
+ANV_API void *anv_stackframe_allocate_aligned(ANVStackFrame* frame, const size_t size, const size_t alignment)
+{
+    if (!frame || size == 0 || alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        return NULL;
+    }
+
+    const size_t aligned_size = (size + 7) & ~(size_t)7;
+    if (aligned_size < size)
     {
         return NULL;
     }
 
-    const size_t aligned_size = (size + 7) & ~7;
+    // Align the address rather than the offset, the buffer itself is only 8-byte aligned
+    const uintptr_t top = (uintptr_t)(frame->memory + frame->top);
+    const size_t padding = (size_t)(-top & (uintptr_t)(alignment - 1));
 
-    if (frame->top + aligned_size > ANV_STACK_FRAME_SIZE)
+    const size_t remaining = ANV_STACK_FRAME_SIZE - frame->top;
+    if (aligned_size > remaining || padding > remaining - aligned_size)
     {
         return NULL;
     }
 
-    void* ptr = frame->memory + frame->top;
-    frame->top += aligned_size;
+    void* ptr = frame->memory + frame->top + padding;
+    frame->top += padding + aligned_size;
     return ptr;
 }
 
@@ -0,0 +1,641 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include "anvil/memory/thread_cache.h"
+#include "anvil/memory/virtual_memory.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+#ifdef ANV_PLATFORM_WINDOWS
+    #include <Windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+//==============================================================================
+// Internal types
+//==============================================================================
+
+// Every span and large block starts with this header at a span-aligned address
+typedef struct SpanHeader
+{
+    struct SpanHeader* next; // Next span of the class with objects to hand out
+    struct SpanHeader* prev; // Previous span in the same list
+    void* free;              // Objects returned to this span, linked through their first word
+    uint8_t* bump;           // Next object that has never been handed out
+    uint8_t* end;            // End of the carvable region
+    size_t length;           // Mapped length of the span or large block
+    uint32_t size_class;     // Size class of the objects, or LARGE_CLASS
+    uint32_t used;           // Objects handed out to thread caches
+} SpanHeader;
+
+#define SPAN_HEADER_SIZE ((sizeof(SpanHeader) + 15) & ~(size_t)15)
+#define LARGE_CLASS UINT32_MAX
+
+// Upper bound on objects moved between a thread and the central lists at once
+#define MAX_BATCH 32
+
+// Wholly free spans each class keeps mapped before returning them to the system
+#define MAX_EMPTY_SPANS 2
+
+typedef struct CacheList
+{
+    void* head;     // Cached objects, linked through their first word
+    uint32_t count; // Number of cached objects
+} CacheList;
+
+typedef struct ThreadCache
+{
+    CacheList lists[ANV_TCACHE_CLASS_COUNT];
+    bool registered; // Exit hook installed for this thread
+} ThreadCache;
+
+/**
+ * Spans of one size class that still have objects to hand out. Partly used
+ * spans sit at the front so allocation packs them, and wholly free spans
+ * sit at the back where they are either reused or released.
+ * Aligned to a cache line so neighbouring classes do not share one.
+ */
+typedef struct CentralList
+{
+    _Alignas(64) atomic_bool lock;
+    SpanHeader* head;   // Spans with free or uncarved objects
+    SpanHeader* tail;   // Last span on the list
+    size_t count;       // Objects returned to the spans' free lists
+    size_t empty_spans; // Spans on the list with no object handed out
+} CentralList;
+
+static CentralList central[ANV_TCACHE_CLASS_COUNT];
+static atomic_size_t span_count;
+static atomic_size_t large_count;
+
+static ANV_THREAD_LOCAL ThreadCache thread_cache;
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+static void* next_of(const void* object)
+{
+    void* next;
+    memcpy(&next, object, sizeof(void*));
+    return next;
+}
+
+static void set_next(void* object, void* next)
+{
+    memcpy(object, &next, sizeof(void*));
+}
+
+static SpanHeader* span_of(const void* ptr)
+{
+    return (SpanHeader*)((uintptr_t)ptr & ~(uintptr_t)(ANV_TCACHE_SPAN_SIZE - 1));
+}
+
+static uint32_t highest_bit(size_t value)
+{
+    uint32_t bit = 0;
+    while (value >>= 1)
+    {
+        bit++;
+    }
+    return bit;
+}
+
+static uint32_t size_to_class(const size_t size)
+{
+    if (size <= 128)
+    {
+        return size == 0 ? 0 : (uint32_t)((size + 15) / 16 - 1);
+    }
+
+    // Four classes between each pair of powers of two above 128 bytes
+    const uint32_t bit = highest_bit(size - 1);
+    const size_t step_shift = bit - 2;
+    return 8 + (bit - 7) * 4 + (uint32_t)((size - 1 - ((size_t)1 << bit)) >> step_shift);
+}
+
+static size_t class_to_size(const uint32_t size_class)
+{
+    if (size_class < 8)
+    {
+        return (size_t)16 * (size_class + 1);
+    }
+
+    const uint32_t bit = 7 + (size_class - 8) / 4;
+    return ((size_t)1 << bit) + (size_t)((size_class - 8) % 4 + 1) * ((size_t)1 << (bit - 2));
+}
+
+static uint32_t batch_size(const uint32_t size_class)
+{
+    const size_t batch = 4096 / class_to_size(size_class);
+    if (batch < 2)
+    {
+        return 2;
+    }
+    return batch > MAX_BATCH ? MAX_BATCH : (uint32_t)batch;
+}
+
+/**
+ * Classes that fit at least twice share a span; larger classes get one
+ * object per span, mapped at the page-rounded size. Either way every
+ * object lies within ANV_TCACHE_SPAN_SIZE of its header, so masking finds it.
+ */
+static size_t span_length(const uint32_t size_class)
+{
+    const size_t object_size = class_to_size(size_class);
+    if ((ANV_TCACHE_SPAN_SIZE - SPAN_HEADER_SIZE) / object_size >= 2)
+    {
+        return ANV_TCACHE_SPAN_SIZE;
+    }
+
+    const size_t page = anv_vmem_page_size();
+    return (SPAN_HEADER_SIZE + object_size + page - 1) & ~(page - 1);
+}
+
+static bool span_has_objects(const SpanHeader* span)
+{
+    return span->free || span->bump != span->end;
+}
+
+static void push_span(CentralList* list, SpanHeader* span, const bool at_tail)
+{
+    if (at_tail)
+    {
+        span->next = NULL;
+        span->prev = list->tail;
+        if (list->tail)
+        {
+            list->tail->next = span;
+        }
+        else
+        {
+            list->head = span;
+        }
+        list->tail = span;
+        return;
+    }
+
+    span->prev = NULL;
+    span->next = list->head;
+    if (list->head)
+    {
+        list->head->prev = span;
+    }
+    else
+    {
+        list->tail = span;
+    }
+    list->head = span;
+}
+
+static void unlink_span(CentralList* list, SpanHeader* span)
+{
+    if (span->prev)
+    {
+        span->prev->next = span->next;
+    }
+    else
+    {
+        list->head = span->next;
+    }
+
+    if (span->next)
+    {
+        span->next->prev = span->prev;
+    }
+    else
+    {
+        list->tail = span->prev;
+    }
+    span->next = NULL;
+    span->prev = NULL;
+}
+
+static void lock_central(CentralList* list)
+{
+    uint32_t spins = 0;
+    while (atomic_exchange_explicit(&list->lock, true, memory_order_acquire))
+    {
+        while (atomic_load_explicit(&list->lock, memory_order_relaxed))
+        {
+            // Give the holder a chance to run when threads outnumber cores
+            if (++spins % 64 == 0)
+            {
+#ifdef ANV_PLATFORM_WINDOWS
+                SwitchToThread();
+#else
+                sched_yield();
+#endif
+            }
+        }
+    }
+}
+
+static void unlock_central(CentralList* list)
+{
+    atomic_store_explicit(&list->lock, false, memory_order_release);
+}
+
+static void* map_block(const size_t length, const uint32_t size_class)
+{
+    void* memory = anv_vmem_reserve(length, ANV_TCACHE_SPAN_SIZE);
+    if (!memory)
+    {
+        return NULL;
+    }
+
+    if (anv_vmem_commit(memory, length, false) != ANV_RESULT_SUCCESS)
+    {
+        anv_vmem_release(memory, length);
+        return NULL;
+    }
+
+    SpanHeader* header = memory;
+    header->size_class = size_class;
+    header->length = length;
+    return memory;
+}
+
+// Called with the central list locked; the new span joins the list as an empty span
+static bool map_span(CentralList* list, const uint32_t size_class)
+{
+    const size_t length = span_length(size_class);
+    uint8_t* memory = map_block(length, size_class);
+    if (!memory)
+    {
+        return false;
+    }
+
+    const size_t object_size = class_to_size(size_class);
+    SpanHeader* span = (SpanHeader*)memory;
+    span->free = NULL;
+    span->used = 0;
+    span->bump = memory + SPAN_HEADER_SIZE;
+    span->end = span->bump + (length - SPAN_HEADER_SIZE) / object_size * object_size;
+    push_span(list, span, false);
+    list->empty_spans++;
+    atomic_fetch_add_explicit(&span_count, 1, memory_order_relaxed);
+    return true;
+}
+
+static bool refill(CacheList* cache, const uint32_t size_class)
+{
+    CentralList* list = &central[size_class];
+    const uint32_t batch = batch_size(size_class);
+    const size_t object_size = class_to_size(size_class);
+
+    void* head = NULL;
+    uint32_t count = 0;
+
+    lock_central(list);
+    while (count < batch)
+    {
+        if (!list->head && !map_span(list, size_class))
+        {
+            break;
+        }
+
+        SpanHeader* span = list->head;
+        if (span->used == 0)
+        {
+            list->empty_spans--;
+        }
+
+        while (count < batch && span_has_objects(span))
+        {
+            void* object = span->free;
+            if (object)
+            {
+                span->free = next_of(object);
+                list->count--;
+            }
+            else
+            {
+                object = span->bump;
+                span->bump += object_size;
+            }
+
+            set_next(object, head);
+            head = object;
+            span->used++;
+            count++;
+        }
+
+        if (!span_has_objects(span))
+        {
+            unlink_span(list, span);
+        }
+    }
+    unlock_central(list);
+
+    cache->head = head;
+    cache->count = count;
+    return count > 0;
+}
+
+/**
+ * Return one object to its span. A span whose objects are all back is
+ * cleared for fresh carving and moved behind the partly used spans, or
+ * handed back through 'released' when the class already keeps enough.
+ * Called with the central list locked.
+ */
+static void return_object(CentralList* list, void* object, const size_t object_size, SpanHeader** released)
+{
+    SpanHeader* span = span_of(object);
+    if (!span_has_objects(span))
+    {
+        push_span(list, span, false);
+    }
+    set_next(object, span->free);
+    span->free = object;
+    list->count++;
+
+    if (--span->used > 0)
+    {
+        return;
+    }
+
+    uint8_t* first = (uint8_t*)span + SPAN_HEADER_SIZE;
+    list->count -= (size_t)(span->bump - first) / object_size;
+    span->free = NULL;
+    span->bump = first;
+    unlink_span(list, span);
+
+    if (list->empty_spans < MAX_EMPTY_SPANS)
+    {
+        push_span(list, span, true);
+        list->empty_spans++;
+    }
+    else
+    {
+        span->next = *released;
+        *released = span;
+    }
+}
+
+static void release_to_central(CacheList* cache, const uint32_t size_class, const uint32_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Detach the first 'count' objects as one chain and return them under the lock
+    void* head = cache->head;
+    void* tail = head;
+    for (uint32_t i = 1; i < count; i++)
+    {
+        tail = next_of(tail);
+    }
+    cache->head = next_of(tail);
+    cache->count -= count;
+    set_next(tail, NULL);
+
+    CentralList* list = &central[size_class];
+    const size_t object_size = class_to_size(size_class);
+    SpanHeader* released = NULL;
+
+    lock_central(list);
+    while (head)
+    {
+        void* object = head;
+        head = next_of(object);
+        return_object(list, object, object_size, &released);
+    }
+    unlock_central(list);
+
+    // Unmap outside the lock so other threads are not held up by the system call
+    while (released)
+    {
+        SpanHeader* next = released->next;
+        anv_vmem_release(released, released->length);
+        atomic_fetch_sub_explicit(&span_count, 1, memory_order_relaxed);
+        released = next;
+    }
+}
+
+static void flush_cache(ThreadCache* cache)
+{
+    for (uint32_t i = 0; i < ANV_TCACHE_CLASS_COUNT; i++)
+    {
+        release_to_central(&cache->lists[i], i, cache->lists[i].count);
+    }
+}
+
+//==============================================================================
+// Thread exit handling
+//==============================================================================
+
+#ifdef ANV_PLATFORM_WINDOWS
+static DWORD exit_key = FLS_OUT_OF_INDEXES;
+static INIT_ONCE exit_once = INIT_ONCE_STATIC_INIT;
+
+static void NTAPI on_thread_exit(void* value)
+{
+    if (value)
+    {
+        flush_cache(value);
+        ((ThreadCache*)value)->registered = false;
+    }
+}
+
+static BOOL CALLBACK create_exit_key(PINIT_ONCE once, PVOID param, PVOID* context)
+{
+    (void)once;
+    (void)param;
+    (void)context;
+    exit_key = FlsAlloc(on_thread_exit);
+    return TRUE;
+}
+
+static void register_thread(ThreadCache* cache)
+{
+    InitOnceExecuteOnce(&exit_once, create_exit_key, NULL, NULL);
+    if (exit_key != FLS_OUT_OF_INDEXES)
+    {
+        FlsSetValue(exit_key, cache);
+    }
+    cache->registered = true;
+}
+#else
+static pthread_key_t exit_key;
+static pthread_once_t exit_once = PTHREAD_ONCE_INIT;
+static bool exit_key_valid = false;
+
+static void on_thread_exit(void* value)
+{
+    flush_cache(value);
+    ((ThreadCache*)value)->registered = false;
+}
+
+static void create_exit_key(void)
+{
+    exit_key_valid = pthread_key_create(&exit_key, on_thread_exit) == 0;
+}
+
+static void register_thread(ThreadCache* cache)
+{
+    pthread_once(&exit_once, create_exit_key);
+    if (exit_key_valid)
+    {
+        pthread_setspecific(exit_key, cache);
+    }
+    cache->registered = true;
+}
+#endif
+
+static ThreadCache* get_cache(void)
+{
+    ThreadCache* cache = &thread_cache;
+    if (!cache->registered)
+    {
+        // Without the exit hook, objects cached by an exiting thread would be lost
+        register_thread(cache);
+    }
+    return cache;
+}
+
+//==============================================================================
+// Thread-caching allocator
+//==============================================================================
+
+ANV_API void* anv_tcache_allocate(const size_t size)
+{
+    if (size > ANV_TCACHE_MAX_CLASS_SIZE)
+    {
+        if (size > SIZE_MAX - SPAN_HEADER_SIZE)
+        {
+            return NULL;
+        }
+
+        uint8_t* block = map_block(size + SPAN_HEADER_SIZE, LARGE_CLASS);
+        if (!block)
+        {
+            return NULL;
+        }
+        atomic_fetch_add_explicit(&large_count, 1, memory_order_relaxed);
+        return block + SPAN_HEADER_SIZE;
+    }
+
+    const uint32_t size_class = size_to_class(size);
+    CacheList* cache = &get_cache()->lists[size_class];
+    if (!cache->head && !refill(cache, size_class))
+    {
+        return NULL;
+    }
+
+    void* object = cache->head;
+    cache->head = next_of(object);
+    cache->count--;
+    return object;
+}
+
+ANV_API void anv_tcache_deallocate(void* ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    SpanHeader* span = span_of(ptr);
+    if (span->size_class == LARGE_CLASS)
+    {
+        anv_vmem_release(span, span->length);
+        atomic_fetch_sub_explicit(&large_count, 1, memory_order_relaxed);
+        return;
+    }
+
+    const uint32_t size_class = span->size_class;
+    CacheList* cache = &get_cache()->lists[size_class];
+    set_next(ptr, cache->head);
+    cache->head = ptr;
+    cache->count++;
+
+    // Keep one batch cached so alternating alloc/free does not bounce
+    const uint32_t batch = batch_size(size_class);
+    if (cache->count > 2 * batch)
+    {
+        release_to_central(cache, size_class, batch);
+    }
+}
+
+ANV_API void* anv_tcache_reallocate(void* ptr, const size_t old_size, const size_t new_size)
+{
+    if (!ptr)
+    {
+        return anv_tcache_allocate(new_size);
+    }
+
+    const SpanHeader* span = span_of(ptr);
+    const size_t usable = span->size_class == LARGE_CLASS
+                              ? span->length - SPAN_HEADER_SIZE
+                              : class_to_size(span->size_class);
+    if (new_size <= usable)
+    {
+        return ptr;
+    }
+
+    void* new_ptr = anv_tcache_allocate(new_size);
+    if (!new_ptr)
+    {
+        return NULL;
+    }
+
+    memcpy(new_ptr, ptr, old_size < usable ? old_size : usable);
+    anv_tcache_deallocate(ptr);
+    return new_ptr;
+}
+
+ANV_API void anv_tcache_flush(void)
+{
+    flush_cache(&thread_cache);
+}
+
+ANV_API ANVThreadCacheStats anv_tcache_stats(void)
+{
+    ANVThreadCacheStats stats = {0};
+    stats.spans = atomic_load_explicit(&span_count, memory_order_relaxed);
+    stats.large_blocks = atomic_load_explicit(&large_count, memory_order_relaxed);
+
+    for (uint32_t i = 0; i < ANV_TCACHE_CLASS_COUNT; i++)
+    {
+        lock_central(&central[i]);
+        stats.central_objects += central[i].count;
+        unlock_central(&central[i]);
+    }
+    return stats;
+}
+
+//==============================================================================
+// Allocator integration
+//==============================================================================
+
+static void* tcache_allocator_allocate(void* context, const size_t size)
+{
+    (void)context;
+    return anv_tcache_allocate(size);
+}
+
+static void tcache_allocator_deallocate(void* context, void* ptr)
+{
+    (void)context;
+    anv_tcache_deallocate(ptr);
+}
+
+static void* tcache_allocator_reallocate(void* context, void* ptr, const size_t old_size, const size_t new_size)
+{
+    (void)context;
+    return anv_tcache_reallocate(ptr, old_size, new_size);
+}
+
+ANV_API ANVAllocator anv_tcache_allocator(void)
+{
+    ANVAllocator alloc = anv_alloc_stateful(NULL, tcache_allocator_allocate, tcache_allocator_deallocate,
+                                            anv_tcache_deallocate, NULL);
+    alloc.reallocate = tcache_allocator_reallocate;
+    return alloc;
+}
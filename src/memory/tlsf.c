@@ -0,0 +1,530 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#include "anvil/memory/tlsf.h"
+
+#include <string.h>
+
+//==============================================================================
+// Internal types
+//==============================================================================
+
+// Second level splits each power of two into 32 linear classes
+#define SL_INDEX_COUNT_LOG2 5
+#define SL_INDEX_COUNT (1 << SL_INDEX_COUNT_LOG2)
+
+// Sizes below SMALL_BLOCK_SIZE share the first first-level list
+#define FL_INDEX_MAX 38
+#define FL_INDEX_SHIFT (SL_INDEX_COUNT_LOG2 + 3)
+#define FL_INDEX_COUNT (FL_INDEX_MAX - FL_INDEX_SHIFT + 1)
+#define SMALL_BLOCK_SIZE ((size_t)1 << FL_INDEX_SHIFT)
+
+// Low bits of the size field, free since sizes are multiples of 8
+#define BLOCK_FREE_BIT ((size_t)1)
+#define BLOCK_PREV_FREE_BIT ((size_t)2)
+
+/**
+ * Block header. prev_phys is only valid while the previous block is free,
+ * and lives in the last word of that block's payload, so a used block
+ * costs one size word. The free list links overlay the payload.
+ */
+typedef struct Block
+{
+    struct Block* prev_phys; // Previous physical block (if it is free)
+    size_t size;             // Payload size plus the flag bits
+    struct Block* next_free; // Next block in the same free list
+    struct Block* prev_free; // Previous block in the same free list
+} Block;
+
+#define BLOCK_START_OFFSET (offsetof(Block, size) + sizeof(size_t))
+#define BLOCK_OVERHEAD sizeof(size_t)
+#define BLOCK_SIZE_MIN (sizeof(Block) - sizeof(Block*))
+
+struct ANVTlsf
+{
+    uint32_t fl_bitmap;                            // First-level lists that are non-empty
+    uint32_t sl_bitmap[FL_INDEX_COUNT];            // Second-level lists that are non-empty
+    Block* blocks[FL_INDEX_COUNT][SL_INDEX_COUNT]; // Free list heads
+    size_t pool_bytes;                             // Bytes handed to the initial free block
+    size_t used_bytes;                             // Payload bytes in used blocks
+    size_t used_blocks;                            // Number of used blocks
+};
+
+#define CONTROL_SIZE ((sizeof(ANVTlsf) + ANV_TLSF_ALIGNMENT - 1) & ~(ANV_TLSF_ALIGNMENT - 1))
+
+//==============================================================================
+// Bit helpers
+//==============================================================================
+
+// Index of the lowest set bit (word must be non-zero)
+static int find_first_set(const uint32_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(word);
+#else
+    int bit = 0;
+    while (!(word & ((uint32_t)1 << bit)))
+    {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// Index of the highest set bit (value must be non-zero)
+static int find_last_set(const size_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (int)(sizeof(unsigned long long) * 8 - 1) - __builtin_clzll((unsigned long long)value);
+#else
+    int bit = 0;
+    size_t v = value;
+    while (v >>= 1)
+    {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+//==============================================================================
+// Block helpers
+//==============================================================================
+
+static size_t block_size(const Block* block)
+{
+    return block->size & ~(BLOCK_FREE_BIT | BLOCK_PREV_FREE_BIT);
+}
+
+static void block_set_size(Block* block, const size_t size)
+{
+    block->size = size | (block->size & (BLOCK_FREE_BIT | BLOCK_PREV_FREE_BIT));
+}
+
+static bool block_is_free(const Block* block)
+{
+    return (block->size & BLOCK_FREE_BIT) != 0;
+}
+
+static bool block_is_prev_free(const Block* block)
+{
+    return (block->size & BLOCK_PREV_FREE_BIT) != 0;
+}
+
+static void block_set_free(Block* block, const bool free)
+{
+    block->size = free ? block->size | BLOCK_FREE_BIT : block->size & ~BLOCK_FREE_BIT;
+}
+
+static void block_set_prev_free(Block* block, const bool free)
+{
+    block->size = free ? block->size | BLOCK_PREV_FREE_BIT : block->size & ~BLOCK_PREV_FREE_BIT;
+}
+
+static Block* block_from_ptr(const void* ptr)
+{
+    return (Block*)((uint8_t*)ptr - BLOCK_START_OFFSET);
+}
+
+static void* block_to_ptr(const Block* block)
+{
+    return (uint8_t*)block + BLOCK_START_OFFSET;
+}
+
+static Block* block_next(const Block* block)
+{
+    return (Block*)((uint8_t*)block_to_ptr(block) + block_size(block) - BLOCK_OVERHEAD);
+}
+
+static Block* block_link_next(Block* block)
+{
+    Block* next = block_next(block);
+    next->prev_phys = block;
+    return next;
+}
+
+static void block_mark_free(Block* block)
+{
+    Block* next = block_link_next(block);
+    block_set_prev_free(next, true);
+    block_set_free(block, true);
+}
+
+static void block_mark_used(Block* block)
+{
+    Block* next = block_next(block);
+    block_set_prev_free(next, false);
+    block_set_free(block, false);
+}
+
+static size_t adjust_request_size(const size_t size)
+{
+    if (size == 0 || size >= ANV_TLSF_MAX_BLOCK_SIZE)
+    {
+        return 0;
+    }
+
+    const size_t aligned = (size + ANV_TLSF_ALIGNMENT - 1) & ~(ANV_TLSF_ALIGNMENT - 1);
+    return aligned < BLOCK_SIZE_MIN ? BLOCK_SIZE_MIN : aligned;
+}
+
+//==============================================================================
+// Size class mapping
+//==============================================================================
+
+static void mapping_insert(const size_t size, int* fl, int* sl)
+{
+    if (size < SMALL_BLOCK_SIZE)
+    {
+        *fl = 0;
+        *sl = (int)(size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT));
+        return;
+    }
+
+    const int bit = find_last_set(size);
+    *sl = (int)((size >> (bit - SL_INDEX_COUNT_LOG2)) ^ ((size_t)1 << SL_INDEX_COUNT_LOG2));
+    *fl = bit - (FL_INDEX_SHIFT - 1);
+}
+
+// Round up to the next class so any block in the found list is large enough
+static void mapping_search(const size_t size, int* fl, int* sl)
+{
+    size_t rounded = size;
+    if (size >= SMALL_BLOCK_SIZE)
+    {
+        rounded += ((size_t)1 << (find_last_set(size) - SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    mapping_insert(rounded, fl, sl);
+}
+
+//==============================================================================
+// Free list helpers
+//==============================================================================
+
+static Block* search_suitable_block(const ANVTlsf* tlsf, int* fl, int* sl)
+{
+    uint32_t sl_map = tlsf->sl_bitmap[*fl] & (~(uint32_t)0 << *sl);
+    if (!sl_map)
+    {
+        const uint32_t fl_map = tlsf->fl_bitmap & (~(uint32_t)0 << (*fl + 1));
+        if (!fl_map)
+        {
+            return NULL;
+        }
+
+        *fl = find_first_set(fl_map);
+        sl_map = tlsf->sl_bitmap[*fl];
+    }
+
+    *sl = find_first_set(sl_map);
+    return tlsf->blocks[*fl][*sl];
+}
+
+static void remove_free_block(ANVTlsf* tlsf, Block* block, const int fl, const int sl)
+{
+    Block* prev = block->prev_free;
+    Block* next = block->next_free;
+    if (next)
+    {
+        next->prev_free = prev;
+    }
+    if (prev)
+    {
+        prev->next_free = next;
+    }
+
+    if (tlsf->blocks[fl][sl] == block)
+    {
+        tlsf->blocks[fl][sl] = next;
+        if (!next)
+        {
+            tlsf->sl_bitmap[fl] &= ~((uint32_t)1 << sl);
+            if (!tlsf->sl_bitmap[fl])
+            {
+                tlsf->fl_bitmap &= ~((uint32_t)1 << fl);
+            }
+        }
+    }
+}
+
+static void insert_free_block(ANVTlsf* tlsf, Block* block, const int fl, const int sl)
+{
+    Block* current = tlsf->blocks[fl][sl];
+    block->next_free = current;
+    block->prev_free = NULL;
+    if (current)
+    {
+        current->prev_free = block;
+    }
+
+    tlsf->blocks[fl][sl] = block;
+    tlsf->fl_bitmap |= (uint32_t)1 << fl;
+    tlsf->sl_bitmap[fl] |= (uint32_t)1 << sl;
+}
+
+static void block_remove(ANVTlsf* tlsf, Block* block)
+{
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+    remove_free_block(tlsf, block, fl, sl);
+}
+
+static void block_insert(ANVTlsf* tlsf, Block* block)
+{
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+    insert_free_block(tlsf, block, fl, sl);
+}
+
+//==============================================================================
+// Split and merge helpers
+//==============================================================================
+
+static bool block_can_split(const Block* block, const size_t size)
+{
+    return block_size(block) >= sizeof(Block) + size;
+}
+
+static Block* block_split(Block* block, const size_t size)
+{
+    Block* remaining = (Block*)((uint8_t*)block_to_ptr(block) + size - BLOCK_OVERHEAD);
+    const size_t remaining_size = block_size(block) - (size + BLOCK_OVERHEAD);
+
+    block_set_size(remaining, remaining_size);
+    block_set_size(block, size);
+    block_mark_free(remaining);
+    return remaining;
+}
+
+static Block* block_absorb(Block* prev, const Block* block)
+{
+    prev->size += block_size(block) + BLOCK_OVERHEAD;
+    block_link_next(prev);
+    return prev;
+}
+
+static Block* block_merge_prev(ANVTlsf* tlsf, Block* block)
+{
+    if (block_is_prev_free(block))
+    {
+        Block* prev = block->prev_phys;
+        block_remove(tlsf, prev);
+        block = block_absorb(prev, block);
+    }
+    return block;
+}
+
+static Block* block_merge_next(ANVTlsf* tlsf, Block* block)
+{
+    Block* next = block_next(block);
+    if (block_is_free(next))
+    {
+        block_remove(tlsf, next);
+        block = block_absorb(block, next);
+    }
+    return block;
+}
+
+// Give back the tail of a free block that is about to be used
+static void block_trim_free(ANVTlsf* tlsf, Block* block, const size_t size)
+{
+    if (block_can_split(block, size))
+    {
+        Block* remaining = block_split(block, size);
+        block_link_next(block);
+        block_set_prev_free(remaining, true);
+        block_insert(tlsf, remaining);
+    }
+}
+
+// Give back the tail of a used block that is shrinking
+static void block_trim_used(ANVTlsf* tlsf, Block* block, const size_t size)
+{
+    if (block_can_split(block, size))
+    {
+        Block* remaining = block_split(block, size);
+        block_set_prev_free(remaining, false);
+        remaining = block_merge_next(tlsf, remaining);
+        block_insert(tlsf, remaining);
+    }
+}
+
+static void* block_prepare_used(ANVTlsf* tlsf, Block* block, const size_t size)
+{
+    block_trim_free(tlsf, block, size);
+    block_mark_used(block);
+    tlsf->used_bytes += block_size(block);
+    tlsf->used_blocks++;
+    return block_to_ptr(block);
+}
+
+//==============================================================================
+// TLSF allocator functions
+//==============================================================================
+
+ANV_API ANVTlsf* anv_tlsf_create(void* memory, const size_t size)
+{
+    if (!memory || ((uintptr_t)memory & (ANV_TLSF_ALIGNMENT - 1)))
+    {
+        return NULL;
+    }
+
+    // The pool needs room for one minimal block plus the end sentinel's header
+    const size_t pool_overhead = 2 * BLOCK_OVERHEAD;
+    if (size < CONTROL_SIZE + pool_overhead + BLOCK_SIZE_MIN)
+    {
+        return NULL;
+    }
+
+    size_t pool_bytes = (size - CONTROL_SIZE - pool_overhead) & ~(ANV_TLSF_ALIGNMENT - 1);
+    if (pool_bytes >= ANV_TLSF_MAX_BLOCK_SIZE)
+    {
+        pool_bytes = ANV_TLSF_MAX_BLOCK_SIZE - ANV_TLSF_ALIGNMENT;
+    }
+
+    ANVTlsf* tlsf = memory;
+    memset(tlsf, 0, sizeof(*tlsf));
+    tlsf->pool_bytes = pool_bytes;
+
+    // The first block's prev_phys would sit before the pool; it is never
+    // read because the block is marked as having a used predecessor
+    Block* block = (Block*)((uint8_t*)memory + CONTROL_SIZE - BLOCK_OVERHEAD);
+    block->size = pool_bytes;
+    block_set_free(block, true);
+    block_set_prev_free(block, false);
+    block_insert(tlsf, block);
+
+    // Zero-sized used sentinel stops merging at the end of the pool
+    Block* sentinel = block_link_next(block);
+    sentinel->size = 0;
+    block_set_free(sentinel, false);
+    block_set_prev_free(sentinel, true);
+    return tlsf;
+}
+
+ANV_API void* anv_tlsf_allocate(ANVTlsf* tlsf, const size_t size)
+{
+    const size_t adjusted = adjust_request_size(size);
+    if (!tlsf || adjusted == 0)
+    {
+        return NULL;
+    }
+
+    int fl, sl;
+    mapping_search(adjusted, &fl, &sl);
+    if (fl >= FL_INDEX_COUNT)
+    {
+        return NULL;
+    }
+
+    Block* block = search_suitable_block(tlsf, &fl, &sl);
+    if (!block)
+    {
+        return NULL;
+    }
+
+    remove_free_block(tlsf, block, fl, sl);
+    return block_prepare_used(tlsf, block, adjusted);
+}
+
+ANV_API void anv_tlsf_deallocate(ANVTlsf* tlsf, void* ptr)
+{
+    if (!tlsf || !ptr)
+    {
+        return;
+    }
+
+    Block* block = block_from_ptr(ptr);
+    tlsf->used_bytes -= block_size(block);
+    tlsf->used_blocks--;
+
+    block_mark_free(block);
+    block = block_merge_prev(tlsf, block);
+    block = block_merge_next(tlsf, block);
+    block_insert(tlsf, block);
+}
+
+ANV_API void* anv_tlsf_reallocate(ANVTlsf* tlsf, void* ptr, const size_t size)
+{
+    if (!tlsf)
+    {
+        return NULL;
+    }
+    if (!ptr)
+    {
+        return anv_tlsf_allocate(tlsf, size);
+    }
+
+    const size_t adjusted = adjust_request_size(size);
+    if (adjusted == 0)
+    {
+        return NULL;
+    }
+
+    Block* block = block_from_ptr(ptr);
+    const Block* next = block_next(block);
+    const size_t current = block_size(block);
+    const size_t combined = current + block_size(next) + BLOCK_OVERHEAD;
+
+    if (adjusted > current && (!block_is_free(next) || adjusted > combined))
+    {
+        void* moved = anv_tlsf_allocate(tlsf, size);
+        if (moved)
+        {
+            memcpy(moved, ptr, current < size ? current : size);
+            anv_tlsf_deallocate(tlsf, ptr);
+        }
+        return moved;
+    }
+
+    // Grow into the free neighbour if needed, then return any surplus
+    tlsf->used_bytes -= current;
+    if (adjusted > current)
+    {
+        block_merge_next(tlsf, block);
+        block_mark_used(block);
+    }
+    block_trim_used(tlsf, block, adjusted);
+    tlsf->used_bytes += block_size(block);
+    return ptr;
+}
+
+ANV_API ANVTlsfStats anv_tlsf_stats(const ANVTlsf* tlsf)
+{
+    ANVTlsfStats stats = {0};
+    if (tlsf)
+    {
+        stats.pool_bytes = tlsf->pool_bytes;
+        stats.used_bytes = tlsf->used_bytes;
+        stats.used_blocks = tlsf->used_blocks;
+    }
+    return stats;
+}
+
+//==============================================================================
+// Allocator integration
+//==============================================================================
+
+static void* tlsf_allocator_allocate(void* context, const size_t size)
+{
+    return anv_tlsf_allocate(context, size);
+}
+
+static void tlsf_allocator_deallocate(void* context, void* ptr)
+{
+    anv_tlsf_deallocate(context, ptr);
+}
+
+static void* tlsf_allocator_reallocate(void* context, void* ptr, const size_t old_size, const size_t new_size)
+{
+    (void)old_size;
+    return anv_tlsf_reallocate(context, ptr, new_size);
+}
+
+ANV_API ANVAllocator anv_tlsf_allocator(ANVTlsf* tlsf)
+{
+    ANVAllocator alloc = anv_alloc_stateful(tlsf, tlsf_allocator_allocate, tlsf_allocator_deallocate, NULL, NULL);
+    alloc.reallocate = tlsf_allocator_reallocate;
+    return alloc;
+}
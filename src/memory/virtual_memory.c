@@ -0,0 +1,209 @@
+//
+// Created by zack on 10/16/25.
+//
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE 1
+#endif
+
+#include "anvil/memory/virtual_memory.h"
+
+#ifdef ANV_PLATFORM_WINDOWS
+    #include <Windows.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+
+    #ifndef MAP_NORESERVE
+        #define MAP_NORESERVE 0
+    #endif
+#endif
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+static size_t round_to_page(const size_t size)
+{
+    const size_t page = anv_vmem_page_size();
+    return (size + page - 1) & ~(page - 1);
+}
+
+//==============================================================================
+// Virtual memory operations
+//==============================================================================
+
+ANV_API size_t anv_vmem_page_size(void)
+{
+    static size_t page_size = 0;
+    if (page_size == 0)
+    {
+#ifdef ANV_PLATFORM_WINDOWS
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        page_size = (size_t)info.dwPageSize;
+#else
+        const long result = sysconf(_SC_PAGESIZE);
+        page_size = result > 0 ? (size_t)result : 4096;
+#endif
+    }
+    return page_size;
+}
+
+ANV_API void* anv_vmem_reserve(const size_t size, size_t alignment)
+{
+    if (size == 0)
+    {
+        return NULL;
+    }
+
+    const size_t page = anv_vmem_page_size();
+    if (alignment < page)
+    {
+        alignment = page;
+    }
+    if ((alignment & (alignment - 1)) != 0)
+    {
+        return NULL;
+    }
+
+    const size_t length = round_to_page(size);
+    if (length < size || length > SIZE_MAX - alignment)
+    {
+        return NULL;
+    }
+
+#ifdef ANV_PLATFORM_WINDOWS
+    void* base = VirtualAlloc(NULL, length, MEM_RESERVE, PAGE_NOACCESS);
+    if (!base || ((uintptr_t)base & (alignment - 1)) == 0)
+    {
+        return base;
+    }
+
+    // Windows cannot release part of a reservation, so find an aligned
+    // address inside a larger range and reserve exactly that
+    VirtualFree(base, 0, MEM_RELEASE);
+    for (int attempt = 0; attempt < 8; attempt++)
+    {
+        uint8_t* probe = VirtualAlloc(NULL, length + alignment, MEM_RESERVE, PAGE_NOACCESS);
+        if (!probe)
+        {
+            return NULL;
+        }
+        VirtualFree(probe, 0, MEM_RELEASE);
+
+        void* aligned = (void*)(((uintptr_t)probe + alignment - 1) & ~(uintptr_t)(alignment - 1));
+        base = VirtualAlloc(aligned, length, MEM_RESERVE, PAGE_NOACCESS);
+        if (base)
+        {
+            return base;
+        }
+    }
+    return NULL;
+#else
+    uint8_t* raw = mmap(NULL, length + alignment - page, PROT_NONE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (raw == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    // Trim the unaligned head and the unused tail of the over-sized mapping
+    uint8_t* aligned = (uint8_t*)(((uintptr_t)raw + alignment - 1) & ~(uintptr_t)(alignment - 1));
+    const size_t head = (size_t)(aligned - raw);
+    const size_t tail = alignment - page - head;
+    if (head > 0)
+    {
+        munmap(raw, head);
+    }
+    if (tail > 0)
+    {
+        munmap(aligned + length, tail);
+    }
+    return aligned;
+#endif
+}
+
+ANV_API ANVResult anv_vmem_commit(void* ptr, const size_t size, const bool huge_pages)
+{
+    if (!ptr || size == 0)
+    {
+        return ANV_RESULT_INVALID_ARGUMENT;
+    }
+
+    const size_t length = round_to_page(size);
+
+#ifdef ANV_PLATFORM_WINDOWS
+    (void)huge_pages;
+    if (!VirtualAlloc(ptr, length, MEM_COMMIT, PAGE_READWRITE))
+    {
+        return ANV_RESULT_OUT_OF_MEMORY;
+    }
+#else
+    if (mprotect(ptr, length, PROT_READ | PROT_WRITE) != 0)
+    {
+        return ANV_RESULT_OUT_OF_MEMORY;
+    }
+
+    #ifdef MADV_HUGEPAGE
+    if (huge_pages)
+    {
+        // Advisory only, the kernel may not have THP enabled
+        madvise(ptr, length, MADV_HUGEPAGE);
+    }
+    #else
+    (void)huge_pages;
+    #endif
+#endif
+
+    return ANV_RESULT_SUCCESS;
+}
+
+ANV_API ANVResult anv_vmem_decommit(void* ptr, const size_t size)
+{
+    if (!ptr || size == 0)
+    {
+        return ANV_RESULT_INVALID_ARGUMENT;
+    }
+
+    const size_t length = round_to_page(size);
+
+#ifdef ANV_PLATFORM_WINDOWS
+    if (!VirtualFree(ptr, length, MEM_DECOMMIT))
+    {
+        return ANV_RESULT_INVALID_STATE;
+    }
+#else
+    // Mapping fresh inaccessible pages over the range drops the old pages and
+    // guarantees zero-filled memory on the next commit on every POSIX system
+    if (mmap(ptr, length, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0) == MAP_FAILED)
+    {
+        return ANV_RESULT_INVALID_STATE;
+    }
+#endif
+
+    return ANV_RESULT_SUCCESS;
+}
+
+ANV_API ANVResult anv_vmem_release(void* ptr, const size_t size)
+{
+    if (!ptr)
+    {
+        return ANV_RESULT_INVALID_ARGUMENT;
+    }
+
+#ifdef ANV_PLATFORM_WINDOWS
+    (void)size;
+    if (!VirtualFree(ptr, 0, MEM_RELEASE))
+    {
+        return ANV_RESULT_INVALID_STATE;
+    }
+#else
+    if (munmap(ptr, round_to_page(size)) != 0)
+    {
+        return ANV_RESULT_INVALID_STATE;
+    }
+#endif
+
+    return ANV_RESULT_SUCCESS;
+}
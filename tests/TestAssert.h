@@ -8,7 +8,7 @@
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
-#include "common/common.h"
+#include "anvil/common.h"
 #include "containers/dynamicstring.h"
 
 #define TEST_SUCCESS 1
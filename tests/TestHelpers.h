@@ -5,7 +5,7 @@
 #ifndef ANVIL_TESTHELPERS_H
 #define ANVIL_TESTHELPERS_H
 
-#include "common/common.h"
+#include "anvil/common.h"
 
 // --- Types ---
 typedef struct
@@ -8,7 +8,7 @@
 
 #include "TestAssert.h"
 #include "TestHelpers.h"
-#include "common/common.h"
+#include "anvil/common.h"
 #include "containers/arraylist.h"
 #include "containers/singlylinkedlist.h"
 
@@ -206,7 +206,7 @@ int test_pool_allocator_integration(void)
     // Add elements using pool allocator for the data
     for (int i = 0; i < 8; i++)
     {
-        int* value = anv_alloc_malloc(&pool_data_alloc, sizeof(int));
+        int* value = anv_alloc_allocate(&pool_data_alloc, sizeof(int));
         ASSERT(value != NULL);
         *value = i * 10;
         anv_arraylist_push_back(list, value);
@@ -227,7 +227,7 @@ int test_pool_allocator_integration(void)
 
     for (int i = 0; i < POOL_NUM_BLOCKS + 5; i++)
     {
-        void* ptr = anv_alloc_malloc(&pool_data_alloc, 32);
+        void* ptr = anv_alloc_allocate(&pool_data_alloc, 32);
         if (ptr)
         {
             ptrs[allocated++] = ptr;
@@ -241,14 +241,14 @@ int test_pool_allocator_integration(void)
     // Free allocated blocks
     for (int i = 0; i < allocated; i++)
     {
-        anv_alloc_free(&pool_data_alloc, ptrs[i]);
+        anv_alloc_deallocate(&pool_data_alloc, ptrs[i]);
     }
 
     // Clean up: manually free data with pool allocator, then destroy list
     for (size_t i = 0; i < anv_arraylist_size(list); i++)
     {
         int* value = anv_arraylist_get(list, i);
-        anv_alloc_free(&pool_data_alloc, value);
+        anv_alloc_deallocate(&pool_data_alloc, value);
     }
     anv_arraylist_destroy(list, false); // Don't auto-free data since we freed it manually
 
@@ -273,9 +273,9 @@ int test_debug_allocator_tracking(void)
     const ANVAllocator alloc = anv_alloc_custom(debug_alloc, debug_free, debug_free, debug_int_copy);
 
     // Test allocation tracking
-    void* ptr1 = anv_alloc_malloc(&alloc, 100);
-    void* ptr2 = anv_alloc_malloc(&alloc, 200);
-    void* ptr3 = anv_alloc_malloc(&alloc, 300);
+    void* ptr1 = anv_alloc_allocate(&alloc, 100);
+    void* ptr2 = anv_alloc_allocate(&alloc, 200);
+    void* ptr3 = anv_alloc_allocate(&alloc, 300);
 
     ASSERT(ptr1 != NULL);
     ASSERT(ptr2 != NULL);
@@ -285,7 +285,7 @@ int test_debug_allocator_tracking(void)
     ASSERT_EQ(peak_allocated, 600);
 
     // Free one allocation
-    anv_alloc_free(&alloc, ptr2);
+    anv_alloc_deallocate(&alloc, ptr2);
     ASSERT_EQ(allocation_count, 2);
     ASSERT_EQ(total_allocated, 400);
     ASSERT_EQ(peak_allocated, 600); // Peak should remain
@@ -298,9 +298,9 @@ int test_debug_allocator_tracking(void)
     ASSERT_EQ(allocation_count, 3); // Should increase
 
     // Clean up
-    anv_alloc_free(&alloc, ptr1);
-    anv_alloc_free(&alloc, ptr3);
-    anv_alloc_data_free(&alloc, copied);
+    anv_alloc_deallocate(&alloc, ptr1);
+    anv_alloc_deallocate(&alloc, ptr3);
+    anv_alloc_data_deallocate(&alloc, copied);
 
     ASSERT_EQ(allocation_count, 0);
     ASSERT_EQ(total_allocated, 0);
@@ -315,23 +315,23 @@ int test_failing_allocator_error_handling(void)
     const ANVAllocator alloc = anv_alloc_custom(failing_alloc, failing_free, failing_free, NULL);
 
     // First two allocations should succeed
-    void* ptr1 = anv_alloc_malloc(&alloc, 100);
-    void* ptr2 = anv_alloc_malloc(&alloc, 100);
+    void* ptr1 = anv_alloc_allocate(&alloc, 100);
+    void* ptr2 = anv_alloc_allocate(&alloc, 100);
 
     ASSERT(ptr1 != NULL);
     ASSERT(ptr2 != NULL);
 
     // Third allocation should fail
-    const void* ptr3 = anv_alloc_malloc(&alloc, 100);
+    const void* ptr3 = anv_alloc_allocate(&alloc, 100);
     ASSERT(ptr3 == NULL);
 
     // Fourth allocation should also fail
-    const void* ptr4 = anv_alloc_malloc(&alloc, 100);
+    const void* ptr4 = anv_alloc_allocate(&alloc, 100);
     ASSERT(ptr4 == NULL);
 
     // Clean up successful allocations
-    anv_alloc_free(&alloc, ptr1);
-    anv_alloc_free(&alloc, ptr2);
+    anv_alloc_deallocate(&alloc, ptr1);
+    anv_alloc_deallocate(&alloc, ptr2);
 
     return TEST_SUCCESS;
 }
@@ -351,7 +351,7 @@ int test_allocator_with_linked_list(void)
     // Add several elements using debug allocator for data
     for (int i = 0; i < 5; i++)
     {
-        int* value = anv_alloc_malloc(&data_alloc, sizeof(int));
+        int* value = anv_alloc_allocate(&data_alloc, sizeof(int));
         ASSERT(value != NULL);
         *value = i + 1;
         anv_sll_push_back(list, value);
@@ -381,7 +381,7 @@ int test_allocator_with_linked_list(void)
     while (cleanup_iter.has_next(&cleanup_iter))
     {
         int* value = cleanup_iter.get(&cleanup_iter);
-        anv_alloc_free(&data_alloc, value);
+        anv_alloc_deallocate(&data_alloc, value);
         cleanup_iter.next(&cleanup_iter);
     }
     cleanup_iter.destroy(&cleanup_iter);
@@ -413,7 +413,7 @@ int test_allocator_stress_test(void)
         {
             // Allocate
             const size_t size = 16 + (i % 64); // Variable sizes
-            ptrs[active_ptrs] = anv_alloc_malloc(&alloc, size);
+            ptrs[active_ptrs] = anv_alloc_allocate(&alloc, size);
             ASSERT(ptrs[active_ptrs] != NULL);
             active_ptrs++;
         }
@@ -421,7 +421,7 @@ int test_allocator_stress_test(void)
         {
             // Free a random pointer
             const int index = i % active_ptrs;
-            anv_alloc_free(&alloc, ptrs[index]);
+            anv_alloc_deallocate(&alloc, ptrs[index]);
 
             // Move last pointer to freed slot
             ptrs[index] = ptrs[active_ptrs - 1];
@@ -432,7 +432,7 @@ int test_allocator_stress_test(void)
     // Free remaining allocations
     for (int i = 0; i < active_ptrs; i++)
     {
-        anv_alloc_free(&alloc, ptrs[i]);
+        anv_alloc_deallocate(&alloc, ptrs[i]);
     }
 
     // Verify no memory leaks
@@ -453,12 +453,12 @@ int test_mixed_allocator_scenarios(void)
     pool_reset();
 
     // Use debug allocator for large allocations
-    void* large_ptr = anv_alloc_malloc(&debug_alloc_struct, 1024);
+    void* large_ptr = anv_alloc_allocate(&debug_alloc_struct, 1024);
     ASSERT(large_ptr != NULL);
 
     // Use pool allocator for small allocations
-    void* small_ptr1 = anv_alloc_malloc(&pool_alloc_struct, 32);
-    void* small_ptr2 = anv_alloc_malloc(&pool_alloc_struct, 16);
+    void* small_ptr1 = anv_alloc_allocate(&pool_alloc_struct, 32);
+    void* small_ptr2 = anv_alloc_allocate(&pool_alloc_struct, 16);
 
     ASSERT(small_ptr1 != NULL);
     ASSERT(small_ptr2 != NULL);
@@ -468,9 +468,9 @@ int test_mixed_allocator_scenarios(void)
     ASSERT_EQ(total_allocated, 1024);
 
     // Clean up
-    anv_alloc_free(&debug_alloc_struct, large_ptr);
-    anv_alloc_free(&pool_alloc_struct, small_ptr1);
-    anv_alloc_free(&pool_alloc_struct, small_ptr2);
+    anv_alloc_deallocate(&debug_alloc_struct, large_ptr);
+    anv_alloc_deallocate(&pool_alloc_struct, small_ptr1);
+    anv_alloc_deallocate(&pool_alloc_struct, small_ptr2);
 
     ASSERT_EQ(allocation_count, 0);
     ASSERT_EQ(total_allocated, 0);
@@ -500,7 +500,7 @@ int test_allocator_anv_copy_function_variants(void)
     original = 100;
     ASSERT_EQ(*deep_copy, 42);
 
-    anv_alloc_data_free(&deep_alloc, deep_copy);
+    anv_alloc_data_deallocate(&deep_alloc, deep_copy);
 
     return TEST_SUCCESS;
 }
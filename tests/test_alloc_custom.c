@@ -3,6 +3,7 @@
 //
 
 #include "anvil/common.h"
+#include "containers/arraylist.h"
 #include "TestAssert.h"
 #include "TestHelpers.h"
 #include <stdio.h>
@@ -157,6 +158,56 @@ static void* counting_int_copy(const void* data)
     return copy;
 }
 
+//==============================================================================
+// Tracking Allocator (stateful, for testing)
+//==============================================================================
+
+#define TRACKER_SLOTS 256
+
+// Per-allocator state reached only through the context pointer
+typedef struct
+{
+    void* live[TRACKER_SLOTS];
+    size_t live_count;
+    size_t allocations;
+    size_t foreign_frees; // Pointers freed that this tracker never handed out
+} Tracker;
+
+static void* tracker_alloc(void* context, const size_t size)
+{
+    Tracker* tracker = context;
+    if (tracker->live_count == TRACKER_SLOTS)
+    {
+        return NULL;
+    }
+    void* ptr = malloc(size);
+    if (ptr)
+    {
+        tracker->live[tracker->live_count++] = ptr;
+        tracker->allocations++;
+    }
+    return ptr;
+}
+
+static void tracker_free(void* context, void* ptr)
+{
+    Tracker* tracker = context;
+    if (!ptr)
+    {
+        return;
+    }
+    for (size_t i = 0; i < tracker->live_count; i++)
+    {
+        if (tracker->live[i] == ptr)
+        {
+            tracker->live[i] = tracker->live[--tracker->live_count];
+            free(ptr);
+            return;
+        }
+    }
+    tracker->foreign_frees++;
+}
+
 //==============================================================================
 // Test Functions
 //==============================================================================
@@ -166,7 +217,7 @@ int test_default_allocator(void)
     const ANVAllocator alloc = anv_alloc_default();
 
     // Test allocation
-    void* ptr = anv_alloc_malloc(&alloc, 100);
+    void* ptr = anv_alloc_allocate(&alloc, 100);
     ASSERT(ptr != NULL);
 
     // Test copy (should return same pointer for default)
@@ -175,7 +226,7 @@ int test_default_allocator(void)
     ASSERT(copied == &value);
 
     // Test free
-    anv_alloc_free(&alloc, ptr);
+    anv_alloc_deallocate(&alloc, ptr);
 
     return TEST_SUCCESS;
 }
@@ -188,13 +239,13 @@ int test_arena_allocator(void)
     const ANVAllocator alloc = anv_alloc_custom(arena_alloc, arena_free, NULL, NULL);
 
     // Test multiple allocations
-    const void* ptr1 = anv_alloc_malloc(&alloc, 64);
+    const void* ptr1 = anv_alloc_allocate(&alloc, 64);
     ASSERT(ptr1 != NULL);
 
-    const void* ptr2 = anv_alloc_malloc(&alloc, 128);
+    const void* ptr2 = anv_alloc_allocate(&alloc, 128);
     ASSERT(ptr2 != NULL);
 
-    const void* ptr3 = anv_alloc_malloc(&alloc, 256);
+    const void* ptr3 = anv_alloc_allocate(&alloc, 256);
     ASSERT(ptr3 != NULL);
 
     // Verify pointers are different and ordered
@@ -204,12 +255,12 @@ int test_arena_allocator(void)
     ASSERT(ptr2 < ptr3);
 
     // Test allocation failure when out of memory
-    const void* big_ptr = anv_alloc_malloc(&alloc, 1024);
+    const void* big_ptr = anv_alloc_allocate(&alloc, 1024);
     ASSERT(big_ptr == NULL);
 
     // Test reset and reuse
     arena_reset();
-    const void* ptr4 = anv_alloc_malloc(&alloc, 64);
+    const void* ptr4 = anv_alloc_allocate(&alloc, 64);
     ASSERT(ptr4 == ptr1); // Should reuse same memory
 
     arena_destroy();
@@ -223,19 +274,19 @@ int test_stack_allocator(void)
     const ANVAllocator alloc = anv_alloc_custom(stack_alloc, stack_free, NULL, NULL);
 
     // Test allocation
-    const void* ptr1 = anv_alloc_malloc(&alloc, 64);
+    const void* ptr1 = anv_alloc_allocate(&alloc, 64);
     ASSERT(ptr1 != NULL);
 
-    void* ptr2 = anv_alloc_malloc(&alloc, 128);
+    void* ptr2 = anv_alloc_allocate(&alloc, 128);
     ASSERT(ptr2 != NULL);
 
     // Test LIFO deallocation
-    anv_alloc_free(&alloc, ptr2);
-    const void* ptr3 = anv_alloc_malloc(&alloc, 100);
+    anv_alloc_deallocate(&alloc, ptr2);
+    const void* ptr3 = anv_alloc_allocate(&alloc, 100);
     ASSERT(ptr3 == ptr2); // Should reuse freed space
 
     // Test stack overflow
-    const void* big_ptr = anv_alloc_malloc(&alloc, STACK_SIZE);
+    const void* big_ptr = anv_alloc_allocate(&alloc, STACK_SIZE);
     ASSERT(big_ptr == NULL);
 
     stack_reset();
@@ -249,12 +300,12 @@ int test_counting_allocator(void)
     const ANVAllocator alloc = anv_alloc_custom(counting_alloc, counting_free, counting_free, counting_int_copy);
 
     // Test allocations are counted
-    void* ptr1 = anv_alloc_malloc(&alloc, 64);
+    void* ptr1 = anv_alloc_allocate(&alloc, 64);
     ASSERT(ptr1 != NULL);
     ASSERT_EQ(alloc_count, 1);
     ASSERT_EQ(free_count, 0);
 
-    void* ptr2 = anv_alloc_malloc(&alloc, 128);
+    void* ptr2 = anv_alloc_allocate(&alloc, 128);
     ASSERT(ptr2 != NULL);
     ASSERT_EQ(alloc_count, 2);
     ASSERT_EQ(free_count, 0);
@@ -268,13 +319,13 @@ int test_counting_allocator(void)
     ASSERT_EQ(alloc_count, 3); // Copy should trigger allocation
 
     // Test frees are counted
-    anv_alloc_free(&alloc, ptr1);
+    anv_alloc_deallocate(&alloc, ptr1);
     ASSERT_EQ(free_count, 1);
 
-    anv_alloc_free(&alloc, ptr2);
+    anv_alloc_deallocate(&alloc, ptr2);
     ASSERT_EQ(free_count, 2);
 
-    anv_alloc_data_free(&alloc, copied);
+    anv_alloc_data_deallocate(&alloc, copied);
     ASSERT_EQ(free_count, 3);
 
     return TEST_SUCCESS;
@@ -291,7 +342,7 @@ int test_custom_anv_copy_functions(void)
     ASSERT(copied_int != NULL);
     ASSERT(copied_int != &original_int);
     ASSERT_EQ(*copied_int, 123);
-    anv_alloc_data_free(&int_alloc, copied_int);
+    anv_alloc_data_deallocate(&int_alloc, copied_int);
 
     // Test string deep copy
     const char* original_str = "Hello, World!";
@@ -299,7 +350,7 @@ int test_custom_anv_copy_functions(void)
     ASSERT(copied_str != NULL);
     ASSERT(copied_str != original_str);
     ASSERT_EQ_STR(copied_str, "Hello, World!");
-    anv_alloc_data_free(&str_alloc, copied_str);
+    anv_alloc_data_deallocate(&str_alloc, copied_str);
 
     return TEST_SUCCESS;
 }
@@ -309,18 +360,18 @@ int test_allocator_edge_cases(void)
     const ANVAllocator alloc = anv_alloc_default();
 
     // Test NULL pointer handling
-    anv_alloc_free(&alloc, NULL); // Should not crash
+    anv_alloc_deallocate(&alloc, NULL); // Should not crash
 
     const void* null_copy = anv_alloc_copy(&alloc, NULL);
     ASSERT(null_copy == NULL);
 
     // Test zero-size allocation
-    void* zero_ptr = anv_alloc_malloc(&alloc, 0);
+    void* zero_ptr = anv_alloc_allocate(&alloc, 0);
     // Behavior is implementation-defined, but shouldn't crash
-    anv_alloc_free(&alloc, zero_ptr);
+    anv_alloc_deallocate(&alloc, zero_ptr);
 
     // Test NULL allocator
-    const void* null_alloc_ptr = anv_alloc_malloc(NULL, 100);
+    const void* null_alloc_ptr = anv_alloc_allocate(NULL, 100);
     ASSERT(null_alloc_ptr == NULL);
 
     return TEST_SUCCESS;
@@ -331,18 +382,18 @@ int test_allocator_with_null_functions(void)
     // Test allocator with NULL copy and data_free functions
     const ANVAllocator alloc = anv_alloc_custom(malloc, free, NULL, NULL);
 
-    void* ptr = anv_alloc_malloc(&alloc, 64);
+    void* ptr = anv_alloc_allocate(&alloc, 64);
     ASSERT(ptr != NULL);
 
     // data_free with NULL function should not crash
-    anv_alloc_data_free(&alloc, ptr);
+    anv_alloc_data_deallocate(&alloc, ptr);
 
     // copy with NULL function should use default copy (return same pointer)
     const int value = 42;
     const void* copied = anv_alloc_copy(&alloc, &value);
     ASSERT(copied == &value); // Default copy returns original pointer
 
-    anv_alloc_free(&alloc, ptr);
+    anv_alloc_deallocate(&alloc, ptr);
 
     return TEST_SUCCESS;
 }
@@ -354,8 +405,8 @@ int test_arena_memory_alignment(void)
     const ANVAllocator alloc = anv_alloc_custom(arena_alloc, arena_free, NULL, NULL);
 
     // Test that allocations are properly aligned
-    void* ptr1 = anv_alloc_malloc(&alloc, 1);
-    void* ptr2 = anv_alloc_malloc(&alloc, 1);
+    void* ptr1 = anv_alloc_allocate(&alloc, 1);
+    void* ptr2 = anv_alloc_allocate(&alloc, 1);
 
     ASSERT(ptr1 != NULL);
     ASSERT(ptr2 != NULL);
@@ -379,33 +430,144 @@ int test_stack_allocator_lifo_behavior(void)
     const ANVAllocator alloc = anv_alloc_custom(stack_alloc, stack_free, NULL, NULL);
 
     // Allocate in order
-    const void* ptr1 = anv_alloc_malloc(&alloc, 64);
-    void* ptr2 = anv_alloc_malloc(&alloc, 64);
-    void* ptr3 = anv_alloc_malloc(&alloc, 64);
+    const void* ptr1 = anv_alloc_allocate(&alloc, 64);
+    void* ptr2 = anv_alloc_allocate(&alloc, 64);
+    void* ptr3 = anv_alloc_allocate(&alloc, 64);
 
     ASSERT(ptr1 != NULL);
     ASSERT(ptr2 != NULL);
     ASSERT(ptr3 != NULL);
 
     // Free in LIFO order (last allocated first)
-    anv_alloc_free(&alloc, ptr3);
+    anv_alloc_deallocate(&alloc, ptr3);
 
     // Next allocation should reuse ptr3's space
-    void* ptr4 = anv_alloc_malloc(&alloc, 64);
+    void* ptr4 = anv_alloc_allocate(&alloc, 64);
     ASSERT(ptr4 == ptr3);
 
     // Free ptr4 and ptr2 (not in LIFO order for ptr2)
-    anv_alloc_free(&alloc, ptr4);
-    anv_alloc_free(&alloc, ptr2);
+    anv_alloc_deallocate(&alloc, ptr4);
+    anv_alloc_deallocate(&alloc, ptr2);
 
     // New allocation should still work
-    const void* ptr5 = anv_alloc_malloc(&alloc, 64);
+    const void* ptr5 = anv_alloc_allocate(&alloc, 64);
     ASSERT(ptr5 == ptr2);
 
     stack_reset();
     return TEST_SUCCESS;
 }
 
+// Two stateful allocators back two lists at once without sharing any state
+int test_stateful_allocator_container(void)
+{
+    Tracker first = {0};
+    Tracker second = {0};
+    ANVAllocator first_alloc = anv_alloc_stateful(&first, tracker_alloc, tracker_free, NULL, NULL);
+    ANVAllocator second_alloc = anv_alloc_stateful(&second, tracker_alloc, tracker_free, NULL, NULL);
+    ASSERT(anv_alloc_is_valid(&first_alloc));
+
+    ANVArrayList* list = anv_arraylist_create(&first_alloc, 2);
+    ANVArrayList* other = anv_arraylist_create(&second_alloc, 2);
+    ASSERT_NOT_NULL(list);
+    ASSERT_NOT_NULL(other);
+
+    // Growth goes through the allocate + copy + deallocate fallback, all on the owning context
+    static int values[100];
+    for (int i = 0; i < 100; i++)
+    {
+        values[i] = i;
+        ASSERT_EQ(anv_arraylist_push_back(list, &values[i]), 0);
+    }
+    ASSERT_EQ(anv_arraylist_push_back(other, &values[0]), 0);
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(*(int*)anv_arraylist_get(list, i), i);
+    }
+    ASSERT(first.allocations > second.allocations);
+    ASSERT_EQ(first.live_count, 2); // The list and its current data block
+
+    anv_arraylist_destroy(list, false);
+    anv_arraylist_destroy(other, false);
+    ASSERT_EQ(first.live_count, 0);
+    ASSERT_EQ(second.live_count, 0);
+    ASSERT_EQ(first.foreign_frees, 0);
+    ASSERT_EQ(second.foreign_frees, 0);
+
+    return TEST_SUCCESS;
+}
+
+// Without an allocate_aligned hook the raw block is stashed in front of the aligned pointer
+int test_aligned_allocation_fallback(void)
+{
+    Tracker tracker = {0};
+    ANVAllocator alloc = anv_alloc_stateful(&tracker, tracker_alloc, tracker_free, NULL, NULL);
+    ASSERT_NULL(alloc.allocate_aligned);
+
+    const size_t alignments[] = {1, 8, 16, 64, 256, 4096};
+    for (size_t i = 0; i < sizeof(alignments) / sizeof(alignments[0]); i++)
+    {
+        uint8_t* ptr = anv_alloc_allocate_aligned(&alloc, 100, alignments[i]);
+        ASSERT_NOT_NULL(ptr);
+        ASSERT_EQ((uintptr_t)ptr % alignments[i], 0);
+        ASSERT_EQ(tracker.live_count, 1);
+
+        // The stashed raw pointer is the block the tracker handed out
+        ASSERT(ptr != (uint8_t*)tracker.live[0]);
+        void* raw;
+        memcpy(&raw, ptr - sizeof(void*), sizeof(void*));
+        ASSERT_EQ_PTR(raw, tracker.live[0]);
+        memset(ptr, 0xAB, 100);
+
+        anv_alloc_deallocate_aligned(&alloc, ptr);
+        ASSERT_EQ(tracker.live_count, 0);
+    }
+    ASSERT_EQ(tracker.foreign_frees, 0);
+
+    // Alignments that are not a power of two, and zero sizes, are rejected
+    ASSERT_NULL(anv_alloc_allocate_aligned(&alloc, 100, 0));
+    ASSERT_NULL(anv_alloc_allocate_aligned(&alloc, 100, 24));
+    ASSERT_NULL(anv_alloc_allocate_aligned(&alloc, 0, 16));
+    ASSERT_NULL(anv_alloc_allocate_aligned(&alloc, SIZE_MAX, 16));
+    ASSERT_EQ(tracker.allocations, 6);
+
+    // An aligned list uses the same path for its data block
+    ANVArrayList* list = anv_arraylist_create_aligned(&alloc, 4, 64);
+    ASSERT_NOT_NULL(list);
+    static int values[40];
+    for (int i = 0; i < 40; i++)
+    {
+        ASSERT_EQ(anv_arraylist_push_back(list, &values[i]), 0);
+    }
+    ASSERT_EQ((uintptr_t)list->data % 64, 0);
+    anv_arraylist_destroy(list, false);
+    ASSERT_EQ(tracker.live_count, 0);
+    ASSERT_EQ(tracker.foreign_frees, 0);
+
+    return TEST_SUCCESS;
+}
+
+// With the hook installed, the default allocator aligns directly and frees with the same call
+int test_aligned_allocation_hook(void)
+{
+    const ANVAllocator alloc = anv_alloc_default();
+    ASSERT_NOT_NULL(alloc.allocate_aligned);
+
+    const size_t alignments[] = {8, 32, 128, 4096};
+    for (size_t i = 0; i < sizeof(alignments) / sizeof(alignments[0]); i++)
+    {
+        // An odd size exercises the round-up aligned_alloc needs
+        void* ptr = anv_alloc_allocate_aligned(&alloc, 33, alignments[i]);
+        ASSERT_NOT_NULL(ptr);
+        ASSERT_EQ((uintptr_t)ptr % alignments[i], 0);
+        memset(ptr, 0, 33);
+        anv_alloc_deallocate_aligned(&alloc, ptr);
+    }
+    anv_alloc_deallocate_aligned(&alloc, NULL);
+    ASSERT_NULL(anv_alloc_allocate_aligned(NULL, 16, 16));
+
+    return TEST_SUCCESS;
+}
+
 //==============================================================================
 // Main test runner
 //==============================================================================
@@ -431,7 +593,10 @@ int main(void)
             {"Allocator Edge Cases", test_allocator_edge_cases},
             {"Allocator with NULL Functions", test_allocator_with_null_functions},
             {"Arena Memory Alignment", test_arena_memory_alignment},
-            {"Stack LIFO Behavior", test_stack_allocator_lifo_behavior}
+            {"Stack LIFO Behavior", test_stack_allocator_lifo_behavior},
+            {"Stateful Allocator Container", test_stateful_allocator_container},
+            {"Aligned Allocation Fallback", test_aligned_allocation_fallback},
+            {"Aligned Allocation Hook", test_aligned_allocation_hook}
         };
 
     const int num_tests = sizeof(tests) / sizeof(tests[0]);
@@ -0,0 +1,492 @@
+//
+// Arena tests - usage accounting and deallocation across chained blocks,
+// growth, block reuse and zeroing across resets, trimming, and decommit in
+// virtual arenas, markers with their scope peaks, aligned allocation, and
+// resizing in place versus copying
+//
+
+#include <stdio.h>
+#include <string.h>
+#include "containers/arraylist.h"
+#include "memory/arena.h"
+#include "TestAssert.h"
+
+// A block retired after a deallocation counts only its live bytes
+int test_arena_chain_counts_live_bytes(void)
+{
+    ANVArena arena = anv_arena_create_growable(256, 0);
+    ASSERT_NOT_NULL(arena.memory);
+
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 64));
+    char* dropped = anv_arena_allocate(&arena, 128);
+    ASSERT_NOT_NULL(dropped);
+    anv_arena_deallocate(&arena, dropped);
+    ASSERT_EQ(anv_arena_total_used(&arena), 64);
+
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 304)); // Does not fit, so a new block is chained
+    ASSERT_EQ(anv_arena_total_used(&arena), 64 + 304);
+
+    anv_arena_destroy(&arena);
+    return TEST_SUCCESS;
+}
+
+// Pointers into space an older block already gave back are ignored
+int test_arena_deallocate_freed_chained_space(void)
+{
+    ANVArena arena = anv_arena_create_growable(256, 0);
+    ASSERT_NOT_NULL(arena.memory);
+
+    char* first = anv_arena_allocate(&arena, 64);
+    char* dropped = anv_arena_allocate(&arena, 128);
+    anv_arena_deallocate(&arena, dropped);
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 304));
+
+    anv_arena_deallocate(&arena, dropped);
+    ASSERT_EQ(anv_arena_total_used(&arena), 64 + 304);
+
+    // A live pointer in the older block still unwinds to it
+    anv_arena_deallocate(&arena, first);
+    ASSERT_EQ(anv_arena_total_used(&arena), 0);
+
+    ASSERT_EQ(anv_arena_reset(&arena), ANV_RESULT_SUCCESS);
+    ASSERT_EQ(anv_arena_total_used(&arena), 0);
+    anv_arena_destroy(&arena);
+    return TEST_SUCCESS;
+}
+
+static bool all_zero(const uint8_t* bytes, const size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        if (bytes[i] != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A full block chains a new one at least twice its size, or large enough for the request
+int test_arena_growth(void)
+{
+    ANVArena arena = anv_arena_create_growable(256, 0);
+    ASSERT_NOT_NULL(arena.memory);
+    ASSERT_EQ(arena.reserved, 256);
+
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 200));
+    ANVArenaBlock* first = arena.current;
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 100));
+    ASSERT(arena.current != first);
+    ASSERT_EQ(arena.current->next, first);
+    ASSERT_EQ(arena.size, 512);
+    ASSERT_EQ(arena.reserved, 256 + 512);
+
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 5000));
+    ASSERT(arena.size >= 5000);
+    ASSERT_EQ(arena.reserved, 256 + 512 + arena.size);
+    ASSERT_EQ(anv_arena_total_used(&arena), 200 + 104 + 5000);
+
+    // A fixed arena fails instead
+    ANVArena fixed = anv_arena_create(256);
+    ASSERT_NOT_NULL(anv_arena_allocate(&fixed, 200));
+    ASSERT_NULL(anv_arena_allocate(&fixed, 100));
+    ASSERT_EQ(fixed.used, 200);
+
+    anv_arena_destroy(&fixed);
+    anv_arena_destroy(&arena);
+    return TEST_SUCCESS;
+}
+
+// Chained blocks are reused after a reset and read as zero, like the first block
+int test_arena_reuse_across_reset(void)
+{
+    ANVArena arena = anv_arena_create_growable(256, 0);
+    ASSERT_NOT_NULL(arena.memory);
+
+    uint8_t* first = anv_arena_allocate(&arena, 256);
+    uint8_t* second = anv_arena_allocate(&arena, 400);
+    ANVArenaBlock* chained = arena.current;
+    memset(first, 0xAA, 256);
+    memset(second, 0xBB, 400);
+    const size_t reserved = arena.reserved;
+
+    ASSERT_EQ(anv_arena_reset(&arena), ANV_RESULT_SUCCESS);
+    ASSERT_EQ(arena.free_blocks, chained);
+    ASSERT_EQ(anv_arena_total_used(&arena), 0);
+
+    ASSERT_EQ(anv_arena_allocate(&arena, 256), first);
+    ASSERT(all_zero(first, 256));
+    ASSERT_EQ(anv_arena_allocate(&arena, 400), second);
+    ASSERT(all_zero(second, 400));
+    ASSERT_EQ(arena.reserved, reserved);
+    ASSERT_NULL(arena.free_blocks);
+
+    // A block released by unwinding past it is cleared as well
+    memset(second, 0xCC, 400);
+    anv_arena_deallocate(&arena, first);
+    ASSERT_EQ(anv_arena_allocate(&arena, 256), first);
+    ASSERT_EQ(anv_arena_allocate(&arena, 400), second);
+    ASSERT(all_zero(second, 400));
+
+    anv_arena_destroy(&arena);
+    return TEST_SUCCESS;
+}
+
+// Free blocks are released until at most retain_size bytes stay reserved
+int test_arena_trim_retain_size(void)
+{
+    ANVArena arena = anv_arena_create_growable(256, 0);
+    ASSERT_NOT_NULL(arena.memory);
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 256));
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 500)); // 512-byte block
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 1000)); // 1024-byte block
+    ASSERT_EQ(arena.reserved, 256 + 512 + 1024);
+
+    // retain_size 0 keeps every block across the reset
+    ASSERT_EQ(anv_arena_reset(&arena), ANV_RESULT_SUCCESS);
+    ASSERT_EQ(arena.reserved, 256 + 512 + 1024);
+
+    // The free list holds the 512 block first, then the 1024 block
+    ASSERT_EQ(anv_arena_trim(&arena, 1300), ANV_RESULT_SUCCESS);
+    ASSERT_EQ(arena.reserved, 256 + 1024);
+    ASSERT_EQ(anv_arena_trim(&arena, 1024), ANV_RESULT_SUCCESS);
+    ASSERT_EQ(arena.reserved, 256);
+    ASSERT_NULL(arena.free_blocks);
+
+    // Blocks in use are never released, whatever retain_size asks for
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 256));
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 256));
+    ASSERT_EQ(anv_arena_trim(&arena, 0), ANV_RESULT_SUCCESS);
+    ASSERT_EQ(arena.reserved, 256 + 512);
+    ASSERT_EQ(anv_arena_total_used(&arena), 512);
+    anv_arena_destroy(&arena);
+
+    // A retain_size set at creation trims on every reset
+    arena = anv_arena_create_growable(256, 1300);
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 256));
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 500));
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 1000));
+    ASSERT_EQ(anv_arena_reset(&arena), ANV_RESULT_SUCCESS);
+    ASSERT_EQ(arena.reserved, 256 + 1024);
+    ASSERT_EQ(anv_arena_trim(NULL, 0), ANV_RESULT_INVALID_ARGUMENT);
+
+    anv_arena_destroy(&arena);
+    return TEST_SUCCESS;
+}
+
+// Reset keeps retain_size committed and decommits the touched pages above it
+int test_arena_virtual_reset_decommits(void)
+{
+    const size_t retain = 2 * ANV_ARENA_COMMIT_SIZE;
+    ANVArena arena = anv_arena_create_virtual((size_t)16 << 20, retain, 0);
+    ASSERT_NOT_NULL(arena.memory);
+    ASSERT_EQ(arena.committed, 0);
+
+    uint8_t* block = anv_arena_allocate(&arena, (size_t)1 << 20);
+    ASSERT_NOT_NULL(block);
+    ASSERT_EQ(arena.committed, (size_t)1 << 20);
+    memset(block, 0xAA, (size_t)1 << 20);
+
+    ASSERT_EQ(anv_arena_reset(&arena), ANV_RESULT_SUCCESS);
+    ASSERT_EQ(arena.committed, retain);
+    ASSERT_EQ(arena.used, 0);
+    ASSERT(all_zero(arena.memory, retain));
+
+    // Recommitted pages come back zeroed too
+    ASSERT_EQ(anv_arena_allocate(&arena, (size_t)1 << 20), block);
+    ASSERT(all_zero(block, (size_t)1 << 20));
+
+    // Trim decommits above whichever is larger of retain_size and the bytes in use
+    anv_arena_deallocate(&arena, block);
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 3 * ANV_ARENA_COMMIT_SIZE + 1));
+    ASSERT_EQ(anv_arena_trim(&arena, 0), ANV_RESULT_SUCCESS);
+    ASSERT_EQ(arena.committed, 4 * ANV_ARENA_COMMIT_SIZE);
+    anv_arena_deallocate(&arena, block);
+    ASSERT_EQ(anv_arena_trim(&arena, ANV_ARENA_COMMIT_SIZE), ANV_RESULT_SUCCESS);
+    ASSERT_EQ(arena.committed, ANV_ARENA_COMMIT_SIZE);
+    ASSERT(arena.high_water <= arena.committed);
+
+    anv_arena_destroy(&arena);
+    return TEST_SUCCESS;
+}
+
+// With retain_size 0 everything stays committed, and the reservation is a hard limit
+int test_arena_virtual_keep_and_limit(void)
+{
+    const size_t reserve = 4 * ANV_ARENA_COMMIT_SIZE;
+    ANVArena arena = anv_arena_create_virtual(reserve, 0, 0);
+    ASSERT_NOT_NULL(arena.memory);
+
+    uint8_t* block = anv_arena_allocate(&arena, reserve);
+    ASSERT_NOT_NULL(block);
+    memset(block, 0x55, reserve);
+    ASSERT_NULL(anv_arena_allocate(&arena, 8));
+
+    ASSERT_EQ(anv_arena_reset(&arena), ANV_RESULT_SUCCESS);
+    ASSERT_EQ(arena.committed, reserve);
+    ASSERT(all_zero(arena.memory, reserve));
+    ASSERT_NULL(anv_arena_allocate(&arena, reserve + 8));
+
+    anv_arena_destroy(&arena);
+    ASSERT_NULL(anv_arena_create_virtual(0, 0, 0).memory);
+    return TEST_SUCCESS;
+}
+
+// Restoring a marker saved in an older block unwinds the blocks chained after it
+int test_arena_marker_across_blocks(void)
+{
+    ANVArena arena = anv_arena_create_growable(256, 0);
+    ASSERT_NOT_NULL(arena.memory);
+
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 64));
+    ANVArenaBlock* first = arena.current;
+    const ANVArenaMarker marker = anv_arena_save(&arena);
+
+    uint8_t* inside = anv_arena_allocate(&arena, 128);
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 1000));
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 3000));
+    ASSERT_EQ(arena.current->next->next, first);
+    ASSERT_EQ(anv_arena_total_used(&arena), 64 + 128 + 1000 + 3000);
+
+    ASSERT_EQ(anv_arena_restore(&arena, &marker), 128 + 1000 + 3000);
+    ASSERT_EQ(arena.current, first);
+    ASSERT_EQ(anv_arena_total_used(&arena), 64);
+    ASSERT_NOT_NULL(arena.free_blocks);
+    ASSERT_EQ(anv_arena_allocate(&arena, 128), inside);
+
+    // A marker the arena was rewound past does nothing
+    const ANVArenaMarker stale = anv_arena_save(&arena);
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 1000));
+    ASSERT_EQ(anv_arena_reset(&arena), ANV_RESULT_SUCCESS);
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 8));
+    anv_arena_restore(&arena, &stale);
+    ASSERT_EQ(anv_arena_total_used(&arena), 8);
+
+    anv_arena_destroy(&arena);
+    return TEST_SUCCESS;
+}
+
+// Each scope reports its own peak, and an inner peak counts toward the outer scope
+int test_arena_nested_scope_peaks(void)
+{
+    ANVArena arena = anv_arena_create_growable(1024, 0);
+    ASSERT_NOT_NULL(arena.memory);
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 100)); // 104 bytes before any scope
+
+    const ANVArenaMarker outer = anv_arena_save(&arena);
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 200));
+
+    const ANVArenaMarker inner = anv_arena_save(&arena);
+    uint8_t* temp = anv_arena_allocate(&arena, 500);
+    ASSERT_NOT_NULL(temp);
+    anv_arena_deallocate(&arena, temp);
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 100));
+    ASSERT_EQ(anv_arena_scope_peak(&arena, &inner), 504);
+    ASSERT_EQ(anv_arena_restore(&arena, &inner), 504);
+
+    // The outer scope saw 200 of its own plus the inner peak, not what is live now
+    ASSERT_EQ(anv_arena_total_used(&arena), 104 + 200);
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 40));
+    ASSERT_EQ(anv_arena_scope_peak(&arena, &outer), 200 + 504);
+
+    // A second, smaller inner scope does not lower the outer peak
+    const ANVArenaMarker second = anv_arena_save(&arena);
+    ASSERT_NOT_NULL(anv_arena_allocate(&arena, 16));
+    ASSERT_EQ(anv_arena_restore(&arena, &second), 16);
+    ASSERT_EQ(anv_arena_restore(&arena, &outer), 200 + 504);
+
+    ASSERT_EQ(anv_arena_total_used(&arena), 104);
+    ASSERT_EQ(anv_arena_peak_used(&arena), 104 + 200 + 504);
+
+    ANV_ARENA_SCOPE(&arena)
+    {
+        ASSERT_NOT_NULL(anv_arena_allocate(&arena, 64));
+        ASSERT_EQ(anv_arena_total_used(&arena), 104 + 64);
+    }
+    ASSERT_EQ(anv_arena_total_used(&arena), 104);
+
+    anv_arena_destroy(&arena);
+    return TEST_SUCCESS;
+}
+
+// Returned pointers honour the alignment asked for, including at the start of a new block
+int test_arena_aligned_allocation(void)
+{
+    ANVArena arena = anv_arena_create_growable(256, 0);
+    ASSERT_NOT_NULL(arena.memory);
+
+    // Default allocations are 8-byte aligned whatever size came before
+    for (size_t size = 1; size <= 20; size++)
+    {
+        ASSERT_EQ((uintptr_t)anv_arena_allocate(&arena, size) % ANV_ARENA_DEFAULT_ALIGNMENT, 0);
+    }
+
+    const size_t alignments[] = {16, 32, 64, 128, 4096};
+    for (size_t i = 0; i < sizeof(alignments) / sizeof(alignments[0]); i++)
+    {
+        ASSERT_NOT_NULL(anv_arena_allocate(&arena, 1)); // Leave the top misaligned
+        uint8_t* ptr = anv_arena_allocate_aligned(&arena, 40, alignments[i]);
+        ASSERT_NOT_NULL(ptr);
+        ASSERT_EQ((uintptr_t)ptr % alignments[i], 0);
+        ASSERT(ptr >= arena.memory && ptr + 40 <= arena.memory + arena.used);
+    }
+
+    // A request that only fits a new block still lands on the boundary
+    const size_t large_size = arena.size;
+    uint8_t* large = anv_arena_allocate_aligned(&arena, large_size, 256);
+    ASSERT_NOT_NULL(large);
+    ASSERT_EQ((uintptr_t)large % 256, 0);
+    ASSERT(large >= arena.memory && large + large_size <= arena.memory + arena.size);
+
+    ASSERT_NULL(anv_arena_allocate_aligned(&arena, 8, 0));
+    ASSERT_NULL(anv_arena_allocate_aligned(&arena, 8, 48));
+
+    // The arena allocator aligns through its hook, with no over-allocation
+    ANVAllocator alloc = anv_arena_allocator(&arena);
+    const size_t before = anv_arena_total_used(&arena);
+    void* hooked = anv_alloc_allocate_aligned(&alloc, 64, 64);
+    ASSERT_EQ((uintptr_t)hooked % 64, 0);
+    ASSERT(anv_arena_total_used(&arena) - before < 64 + 64);
+    anv_arena_destroy(&arena);
+
+    // A fixed arena fails rather than overrunning when the padding does not fit
+    ANVArena fixed = anv_arena_create(128);
+    ASSERT_NOT_NULL(anv_arena_allocate(&fixed, 8));
+    ASSERT_NULL(anv_arena_allocate_aligned(&fixed, 120, 64));
+    ASSERT_EQ(fixed.used, 8);
+    anv_arena_destroy(&fixed);
+
+    // A virtual arena commits the padding along with the request
+    ANVArena virtual_arena = anv_arena_create_virtual((size_t)1 << 20, 0, 0);
+    ASSERT_NOT_NULL(anv_arena_allocate(&virtual_arena, 8));
+    uint8_t* page = anv_arena_allocate_aligned(&virtual_arena, ANV_ARENA_COMMIT_SIZE, 4096);
+    ASSERT_EQ((uintptr_t)page % 4096, 0);
+    ASSERT(virtual_arena.committed >= (size_t)(page - virtual_arena.memory) + ANV_ARENA_COMMIT_SIZE);
+    memset(page, 1, ANV_ARENA_COMMIT_SIZE);
+    anv_arena_destroy(&virtual_arena);
+
+    return TEST_SUCCESS;
+}
+
+// Only the last allocation in the current block resizes in place; others are copied
+int test_arena_reallocate_in_place(void)
+{
+    ANVArena arena = anv_arena_create_growable(1024, 0);
+    ASSERT_NOT_NULL(arena.memory);
+
+    char* first = anv_arena_allocate(&arena, 16);
+    char* last = anv_arena_allocate(&arena, 16);
+    memcpy(first, "first", 6);
+    memcpy(last, "last", 5);
+
+    ASSERT_EQ(anv_arena_reallocate(&arena, last, 16, 200), last);
+    ASSERT_EQ(arena.used, 16 + 200);
+    ASSERT_EQ(anv_arena_reallocate(&arena, last, 200, 8), last);
+    ASSERT_EQ(arena.used, 16 + 8);
+    ASSERT_EQ_STR(last, "last");
+
+    // Growing an earlier allocation copies it to the top, shrinking leaves it alone
+    char* moved = anv_arena_reallocate(&arena, first, 16, 64);
+    ASSERT(moved != first);
+    ASSERT_EQ((uint8_t*)moved, arena.memory + 16 + 8);
+    ASSERT_EQ_STR(moved, "first");
+    ASSERT_EQ(anv_arena_reallocate(&arena, last, 8, 4), last);
+    ASSERT_EQ(arena.used, 16 + 8 + 64);
+
+    // The top allocation copies to a new block once its own block is full
+    char* top = anv_arena_reallocate(&arena, moved, 64, 2000);
+    ASSERT(top != moved);
+    ASSERT(arena.current->next != NULL);
+    ASSERT_EQ_STR(top, "first");
+    ASSERT_EQ(anv_arena_reallocate(&arena, top, 2000, 2040), top);
+
+    // NULL behaves like allocate, and a failed resize leaves the block valid
+    ASSERT_NOT_NULL(anv_arena_reallocate(&arena, NULL, 0, 8));
+    ASSERT_NULL(anv_arena_reallocate(&arena, top, 2040, 0));
+    anv_arena_destroy(&arena);
+
+    ANVArena fixed = anv_arena_create(64);
+    char* only = anv_arena_allocate(&fixed, 16);
+    memcpy(only, "only", 5);
+    ASSERT_NULL(anv_arena_reallocate(&fixed, only, 16, 128));
+    ASSERT_EQ(fixed.used, 16);
+    ASSERT_EQ_STR(only, "only");
+    anv_arena_destroy(&fixed);
+    return TEST_SUCCESS;
+}
+
+// A list growing at the top of an arena keeps extending the same buffer
+int test_arena_list_grows_in_place(void)
+{
+    ANVArena arena = anv_arena_create(64 * 1024);
+    ASSERT_NOT_NULL(arena.memory);
+    ANVAllocator alloc = anv_arena_allocator(&arena);
+
+    ANVArrayList* list = anv_arraylist_create(&alloc, 4);
+    ASSERT_NOT_NULL(list);
+    void** data = list->data;
+    static int values[1000];
+    for (int i = 0; i < 1000; i++)
+    {
+        ASSERT_EQ(anv_arraylist_push_back(list, &values[i]), 0);
+        ASSERT_EQ(list->data, data);
+    }
+
+    // No copies left behind: only the list header and the live buffer are in use
+    ASSERT_EQ(arena.used, (size_t)((uint8_t*)data - arena.memory) + list->capacity * sizeof(void*));
+    ASSERT_EQ(anv_arraylist_get(list, 999), &values[999]);
+
+    anv_arena_destroy(&arena);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_arena_chain_counts_live_bytes, "test_arena_chain_counts_live_bytes"},
+        {test_arena_deallocate_freed_chained_space, "test_arena_deallocate_freed_chained_space"},
+        {test_arena_growth, "test_arena_growth"},
+        {test_arena_reuse_across_reset, "test_arena_reuse_across_reset"},
+        {test_arena_trim_retain_size, "test_arena_trim_retain_size"},
+        {test_arena_virtual_reset_decommits, "test_arena_virtual_reset_decommits"},
+        {test_arena_virtual_keep_and_limit, "test_arena_virtual_keep_and_limit"},
+        {test_arena_marker_across_blocks, "test_arena_marker_across_blocks"},
+        {test_arena_nested_scope_peaks, "test_arena_nested_scope_peaks"},
+        {test_arena_aligned_allocation, "test_arena_aligned_allocation"},
+        {test_arena_reallocate_in_place, "test_arena_reallocate_in_place"},
+        {test_arena_list_grows_in_place, "test_arena_list_grows_in_place"},
+    };
+
+    printf("Running Arena tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll Arena tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d Arena tests failed.\n", failed);
+    return 1;
+}
@@ -237,6 +237,46 @@ int test_capacity_consistency(void)
     return TEST_SUCCESS;
 }
 
+// The backing array stays on its boundary through growth, shrinking, copies and filters
+int test_aligned_storage(void)
+{
+    ANVAllocator alloc = create_int_allocator();
+    ANVArrayList* list = anv_arraylist_create_aligned(&alloc, 3, 64);
+    ASSERT_NOT_NULL(list);
+    ASSERT_EQ((uintptr_t)list->data % 64, 0);
+
+    for (int i = 0; i < 100; i++)
+    {
+        int* val = malloc(sizeof(int));
+        *val = i;
+        ASSERT_EQ(anv_arraylist_push_back(list, val), 0);
+        ASSERT_EQ((uintptr_t)list->data % 64, 0);
+    }
+
+    ASSERT_EQ(anv_arraylist_shrink_to_fit(list), 0);
+    ASSERT_EQ((uintptr_t)list->data % 64, 0);
+    ASSERT_EQ(*(int*)anv_arraylist_get(list, 99), 99);
+
+    ANVArrayList* copy = anv_arraylist_copy(list);
+    ASSERT_NOT_NULL(copy);
+    ASSERT_EQ(copy->alignment, 64);
+    ASSERT_EQ((uintptr_t)copy->data % 64, 0);
+
+    ANVArrayList* evens = anv_arraylist_filter(list, is_even);
+    ASSERT_NOT_NULL(evens);
+    ASSERT_EQ(anv_arraylist_size(evens), 50);
+    ASSERT_EQ((uintptr_t)evens->data % 64, 0);
+
+    // Alignments below pointer size or not a power of two are rejected
+    ASSERT_NULL(anv_arraylist_create_aligned(&alloc, 4, 4));
+    ASSERT_NULL(anv_arraylist_create_aligned(&alloc, 4, 96));
+
+    anv_arraylist_destroy(evens, false);
+    anv_arraylist_destroy(copy, false);
+    anv_arraylist_destroy(list, true);
+    return TEST_SUCCESS;
+}
+
 typedef struct
 {
     int (*func)(void);
@@ -255,6 +295,7 @@ int main(void)
         {test_memory_cleanup_on_destroy, "test_memory_cleanup_on_destroy"},
         {test_memory_cleanup_on_clear, "test_memory_cleanup_on_clear"},
         {test_capacity_consistency, "test_capacity_consistency"},
+        {test_aligned_storage, "test_aligned_storage"},
     };
 
     int failed = 0;
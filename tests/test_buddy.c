@@ -0,0 +1,315 @@
+//
+// Buddy allocator tests - splitting and merging, merges with trimmed buddies,
+// in-place reallocation, statistics and invalid arguments
+//
+
+#include <stdio.h>
+#include <string.h>
+#include "memory/buddy.h"
+#include "memory/virtual_memory.h"
+#include "TestAssert.h"
+
+#define REGION_SIZE ((size_t)1 << 20)
+#define MIN_BLOCK ((size_t)32)
+#define TOP_ORDER 15u // log2(REGION_SIZE / MIN_BLOCK)
+
+// Side table flags, mirroring buddy.c
+#define FREE_FLAG 0x80u
+#define TRIMMED_FLAG 0x40u
+
+static uint8_t side_entry(const ANVBuddyAllocator* buddy, const void* block)
+{
+    return buddy->block_orders[(size_t)((const uint8_t*)block - buddy->memory) / MIN_BLOCK];
+}
+
+// Each free list must be doubly linked, match its count and its bit in free_mask
+static int check_free_lists(const ANVBuddyAllocator* buddy)
+{
+    for (uint32_t order = 0; order < buddy->order_count; order++)
+    {
+        size_t length = 0;
+        const ANVBuddyBlock* prev = NULL;
+        for (const ANVBuddyBlock* node = buddy->free_lists[order]; node; node = node->next)
+        {
+            ASSERT_EQ_PTR(node->prev, prev);
+            ASSERT_EQ(side_entry(buddy, node) & ~TRIMMED_FLAG, order | FREE_FLAG);
+            length++;
+            prev = node;
+        }
+        ASSERT_EQ(length, buddy->free_counts[order]);
+        ASSERT_EQ((buddy->free_mask >> order) & 1u, length > 0 ? 1u : 0u);
+    }
+    return TEST_SUCCESS;
+}
+
+static int check_filled(const uint8_t* block, const size_t size, const uint8_t fill)
+{
+    for (size_t b = 0; b < size; b++)
+    {
+        ASSERT_EQ(block[b], fill);
+    }
+    return TEST_SUCCESS;
+}
+
+// One minimum block splits every order once, and freeing it merges the region back together
+int test_buddy_split_and_merge(void)
+{
+    ANVBuddyAllocator buddy = anv_buddy_create(REGION_SIZE, MIN_BLOCK);
+    ASSERT_NOT_NULL(buddy.memory);
+    ASSERT_EQ(buddy.order_count, TOP_ORDER + 1);
+    ASSERT_EQ(side_entry(&buddy, buddy.memory), TOP_ORDER | FREE_FLAG);
+
+    uint8_t* block = anv_buddy_allocate(&buddy, 1);
+    ASSERT_EQ_PTR(block, buddy.memory);
+    ASSERT_EQ(side_entry(&buddy, block), 0);
+    for (uint32_t order = 0; order < TOP_ORDER; order++)
+    {
+        ASSERT_EQ(buddy.free_counts[order], 1);
+        ASSERT_EQ_PTR((uint8_t*)buddy.free_lists[order], buddy.memory + (MIN_BLOCK << order));
+    }
+    ASSERT_EQ(buddy.free_counts[TOP_ORDER], 0);
+    ASSERT_EQ(check_free_lists(&buddy), TEST_SUCCESS);
+
+    // The two lowest blocks are buddies; freeing only one of them does not merge
+    uint8_t* second = anv_buddy_allocate(&buddy, MIN_BLOCK);
+    ASSERT_EQ_PTR(second, buddy.memory + MIN_BLOCK);
+    anv_buddy_deallocate(&buddy, block);
+    ASSERT_EQ(buddy.free_counts[0], 1);
+    ASSERT_EQ(side_entry(&buddy, block), FREE_FLAG);
+
+    anv_buddy_deallocate(&buddy, second);
+    ASSERT_EQ(buddy.free_mask, 1u << TOP_ORDER);
+    ASSERT_EQ(side_entry(&buddy, buddy.memory), TOP_ORDER | FREE_FLAG);
+    ASSERT_EQ(buddy.live_blocks, 0);
+    ASSERT_EQ(check_free_lists(&buddy), TEST_SUCCESS);
+
+    anv_buddy_destroy(&buddy);
+    return TEST_SUCCESS;
+}
+
+// A block merging with a trimmed buddy carries the flag, and its pages are recommitted on reuse
+int test_buddy_merge_with_trimmed_buddy(void)
+{
+    ANVBuddyAllocator buddy = anv_buddy_create(REGION_SIZE, MIN_BLOCK);
+    ASSERT_NOT_NULL(buddy.memory);
+    const size_t half = REGION_SIZE / 2;
+    const size_t quarter = REGION_SIZE / 4;
+    ASSERT(quarter > anv_vmem_page_size());
+
+    uint8_t* low = anv_buddy_allocate(&buddy, quarter);
+    uint8_t* high = anv_buddy_allocate(&buddy, quarter);
+    uint8_t* upper_half = anv_buddy_allocate(&buddy, half);
+    ASSERT_EQ_PTR(high, low + quarter);
+    ASSERT_EQ_PTR(upper_half, low + half);
+    memset(high, 0xCC, quarter);
+
+    // Trimming only touches free blocks spanning more than a page
+    anv_buddy_deallocate(&buddy, high);
+    anv_buddy_trim(&buddy);
+    const uint32_t quarter_order = TOP_ORDER - 2;
+    ASSERT_EQ(side_entry(&buddy, high), quarter_order | FREE_FLAG | TRIMMED_FLAG);
+    ASSERT_EQ(side_entry(&buddy, low), quarter_order);
+
+    // Freeing the untrimmed buddy merges into a trimmed half
+    memset(low, 0xAA, quarter);
+    anv_buddy_deallocate(&buddy, low);
+    ASSERT_EQ(side_entry(&buddy, low), (quarter_order + 1) | FREE_FLAG | TRIMMED_FLAG);
+    ASSERT_EQ(buddy.free_counts[quarter_order], 0);
+    ASSERT_EQ(check_free_lists(&buddy), TEST_SUCCESS);
+
+    // Allocating it commits every page again; decommitted ones come back zeroed
+    uint8_t* merged = anv_buddy_allocate(&buddy, half);
+    ASSERT_EQ_PTR(merged, low);
+    ASSERT_EQ(merged[quarter + anv_vmem_page_size()], 0);
+    memset(merged, 0x11, half);
+    ASSERT_EQ(check_filled(merged, half, 0x11), TEST_SUCCESS);
+
+    // Splitting a trimmed block commits the header of each upper half it frees
+    anv_buddy_deallocate(&buddy, merged);
+    anv_buddy_deallocate(&buddy, upper_half);
+    anv_buddy_trim(&buddy);
+    ASSERT_EQ(side_entry(&buddy, buddy.memory), TOP_ORDER | FREE_FLAG | TRIMMED_FLAG);
+    uint8_t* small = anv_buddy_allocate(&buddy, 100);
+    ASSERT_EQ_PTR(small, buddy.memory);
+    ASSERT_EQ(side_entry(&buddy, buddy.memory + half), (TOP_ORDER - 1) | FREE_FLAG | TRIMMED_FLAG);
+    ASSERT_EQ(check_free_lists(&buddy), TEST_SUCCESS);
+    uint8_t* large = anv_buddy_allocate(&buddy, half);
+    ASSERT_EQ_PTR(large, buddy.memory + half);
+    memset(large, 0x22, half);
+    ASSERT_EQ(check_filled(large, half, 0x22), TEST_SUCCESS);
+
+    anv_buddy_deallocate(&buddy, small);
+    anv_buddy_deallocate(&buddy, large);
+    ASSERT_EQ(anv_buddy_stats(&buddy).largest_free_block, REGION_SIZE);
+    anv_buddy_destroy(&buddy);
+    return TEST_SUCCESS;
+}
+
+// Shrinking splits in place, and growing absorbs free buddies above the block
+int test_buddy_reallocate_in_place(void)
+{
+    ANVBuddyAllocator buddy = anv_buddy_create(REGION_SIZE, MIN_BLOCK);
+    ASSERT_NOT_NULL(buddy.memory);
+
+    char* block = anv_buddy_allocate(&buddy, 1000);
+    ASSERT_EQ((uint8_t*)block, buddy.memory);
+    memcpy(block, "anvil", 6);
+    ASSERT_EQ(buddy.used_bytes, 1024);
+    ASSERT_EQ(buddy.requested_bytes, 1000);
+
+    // Shrinking 1024 -> 128 frees the 128, 256 and 512 byte upper halves
+    const size_t free_before[3] = {buddy.free_counts[2], buddy.free_counts[3], buddy.free_counts[4]};
+    ASSERT_EQ(anv_buddy_reallocate(&buddy, block, 100), block);
+    ASSERT_EQ(buddy.used_bytes, 128);
+    ASSERT_EQ(buddy.requested_bytes, 100);
+    ASSERT_EQ(side_entry(&buddy, block), 2);
+    for (uint32_t order = 2; order < 5; order++)
+    {
+        ASSERT_EQ(buddy.free_counts[order], free_before[order - 2] + 1);
+        ASSERT_EQ(side_entry(&buddy, buddy.memory + (MIN_BLOCK << order)), order | FREE_FLAG);
+    }
+    ASSERT_EQ(check_free_lists(&buddy), TEST_SUCCESS);
+
+    // Growing back absorbs exactly those halves
+    ASSERT_EQ(anv_buddy_reallocate(&buddy, block, 4000), block);
+    ASSERT_EQ(buddy.used_bytes, 4096);
+    ASSERT_EQ(side_entry(&buddy, block), 7);
+    ASSERT_EQ(buddy.free_counts[2], 0);
+    ASSERT_EQ_STR(block, "anvil");
+    ASSERT_EQ(check_free_lists(&buddy), TEST_SUCCESS);
+
+    // Staying within the same order only updates the request
+    ASSERT_EQ(anv_buddy_reallocate(&buddy, block, 4096), block);
+    ASSERT_EQ(buddy.used_bytes, 4096);
+    ASSERT_EQ(buddy.requested_bytes, 4096);
+
+    // Growing over trimmed buddies commits their pages
+    anv_buddy_trim(&buddy);
+    const size_t grown = REGION_SIZE / 4;
+    ASSERT_EQ(anv_buddy_reallocate(&buddy, block, grown), block);
+    memset(block + 6, 0x33, grown - 6);
+    ASSERT_EQ_STR(block, "anvil");
+    ASSERT_EQ(check_filled((uint8_t*)block + 6, grown - 6, 0x33), TEST_SUCCESS);
+    ASSERT_EQ(check_free_lists(&buddy), TEST_SUCCESS);
+
+    // A block in the upper half of its parent cannot grow in place
+    ASSERT_EQ(anv_buddy_reallocate(&buddy, block, 4096), block);
+    void* neighbour = anv_buddy_allocate(&buddy, 4096);
+    ASSERT_EQ((uint8_t*)neighbour, buddy.memory + 4096);
+    char* upper = anv_buddy_reallocate(&buddy, neighbour, 8192);
+    ASSERT_NOT_NULL(upper);
+    ASSERT(upper != (char*)neighbour);
+    ASSERT_EQ((size_t)((uint8_t*)upper - buddy.memory) % 8192, 0);
+
+    // With the upper buddy taken, growing has to move and copy
+    neighbour = anv_buddy_allocate(&buddy, 4096);
+    ASSERT_EQ((uint8_t*)neighbour, buddy.memory + 4096);
+    char* moved = anv_buddy_reallocate(&buddy, block, 8192);
+    ASSERT_NOT_NULL(moved);
+    ASSERT(moved != block);
+    ASSERT_EQ_STR(moved, "anvil");
+    ASSERT_EQ(buddy.live_blocks, 3);
+
+    ASSERT_NULL(anv_buddy_reallocate(&buddy, moved, REGION_SIZE + 1));
+    ASSERT_NULL(anv_buddy_allocate(&buddy, 0));
+
+    anv_buddy_deallocate(&buddy, moved);
+    anv_buddy_deallocate(&buddy, neighbour);
+    anv_buddy_deallocate(&buddy, upper);
+    ASSERT_EQ(anv_buddy_stats(&buddy).largest_free_block, REGION_SIZE);
+
+    anv_buddy_destroy(&buddy);
+    return TEST_SUCCESS;
+}
+
+// Internal fragmentation comes from rounding, external from free space split across blocks
+int test_buddy_stats(void)
+{
+    ANVBuddyAllocator buddy = anv_buddy_create(REGION_SIZE, MIN_BLOCK);
+    ASSERT_NOT_NULL(buddy.memory);
+
+    void* a = anv_buddy_allocate(&buddy, 96);
+    ANVBuddyStats stats = anv_buddy_stats(&buddy);
+    ASSERT_EQ(stats.total_bytes, REGION_SIZE);
+    ASSERT_EQ(stats.used_bytes, 128);
+    ASSERT_EQ(stats.requested_bytes, 96);
+    ASSERT(stats.internal_fragmentation == 0.25);
+    ASSERT_EQ(stats.free_bytes, REGION_SIZE - 128);
+    ASSERT_EQ(stats.free_blocks, TOP_ORDER - 2);
+    ASSERT_EQ(stats.largest_free_block, REGION_SIZE / 2);
+    ASSERT(stats.external_fragmentation == 1.0 - (double)(REGION_SIZE / 2) / (double)(REGION_SIZE - 128));
+
+    anv_buddy_deallocate(&buddy, a);
+    stats = anv_buddy_stats(&buddy);
+    ASSERT_EQ(stats.used_bytes, 0);
+    ASSERT_EQ(stats.free_blocks, 1);
+    ASSERT(stats.internal_fragmentation == 0.0);
+    ASSERT(stats.external_fragmentation == 0.0);
+
+    anv_buddy_destroy(&buddy);
+    stats = anv_buddy_stats(&buddy);
+    ASSERT_EQ(stats.total_bytes, 0);
+    return TEST_SUCCESS;
+}
+
+int test_buddy_invalid_arguments(void)
+{
+    ANVBuddyAllocator buddy = anv_buddy_create(REGION_SIZE, ANV_BUDDY_MIN_BLOCK_SIZE / 2);
+    ASSERT_NULL(buddy.memory);
+    buddy = anv_buddy_create(REGION_SIZE, 48);
+    ASSERT_NULL(buddy.memory);
+    buddy = anv_buddy_create(0, MIN_BLOCK);
+    ASSERT_NULL(buddy.memory);
+    ASSERT_NULL(anv_buddy_allocate(&buddy, 16));
+
+    // Sizes are rounded up to a power of two
+    buddy = anv_buddy_create(REGION_SIZE - 1000, MIN_BLOCK);
+    ASSERT_NOT_NULL(buddy.memory);
+    ASSERT_EQ(buddy.size, REGION_SIZE);
+    anv_buddy_destroy(&buddy);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_buddy_split_and_merge, "test_buddy_split_and_merge"},
+        {test_buddy_merge_with_trimmed_buddy, "test_buddy_merge_with_trimmed_buddy"},
+        {test_buddy_reallocate_in_place, "test_buddy_reallocate_in_place"},
+        {test_buddy_stats, "test_buddy_stats"},
+        {test_buddy_invalid_arguments, "test_buddy_invalid_arguments"},
+    };
+
+    printf("Running Buddy tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll Buddy tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d Buddy tests failed.\n", failed);
+    return 1;
+}
@@ -0,0 +1,386 @@
+//
+// Concurrent hash map stress tests - writers, readers and iterators racing
+// through segment growth and deferred reclamation
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include "containers/concurrenthashmap.h"
+#include "system/thread.h"
+#include "TestAssert.h"
+
+#define WRITERS 4
+#define READERS 4
+#define STABLE_KEYS 2048
+#define CHURN_KEYS_PER_WRITER 2048
+#define ROUNDS 6
+#define READER_PASSES 200
+
+// Values carry their key so a reader can tell a stale or recycled value apart
+typedef struct StressValue
+{
+    uint64_t key;
+    uint64_t version;
+} StressValue;
+
+typedef struct StressShared
+{
+    ANVConcurrentHashMap* map;
+    uint64_t stable_keys[STABLE_KEYS];
+    StressValue stable_values[STABLE_KEYS][ROUNDS + 1]; // Never freed, so readers may keep them
+    _Atomic int writers_done;
+    _Atomic int failures;
+} StressShared;
+
+typedef struct WriterArg
+{
+    StressShared* shared;
+    int id;
+    bool present[CHURN_KEYS_PER_WRITER]; // Expected state of each owned key once the writer is done
+    uint64_t versions[CHURN_KEYS_PER_WRITER];
+} WriterArg;
+
+static size_t hash_u64(const void* key)
+{
+    return (size_t)anv_hash_mix64(*(const uint64_t*)key);
+}
+
+static int equals_u64(const void* a, const void* b)
+{
+    return *(const uint64_t*)a == *(const uint64_t*)b;
+}
+
+static uint64_t churn_key(const int writer, const size_t index)
+{
+    return (uint64_t)(writer + 1) << 32 | index;
+}
+
+static uint64_t* heap_key(const uint64_t key)
+{
+    uint64_t* copy = malloc(sizeof(uint64_t));
+    *copy = key;
+    return copy;
+}
+
+static StressValue* heap_value(const uint64_t key, const uint64_t version)
+{
+    StressValue* value = malloc(sizeof(StressValue));
+    value->key = key;
+    value->version = version;
+    return value;
+}
+
+static void record_failure(StressShared* shared, const char* what)
+{
+    if (atomic_fetch_add(&shared->failures, 1) == 0)
+    {
+        fprintf(stderr, "Stress failure: %s\n", what);
+    }
+}
+
+/**
+ * Each writer owns a range of churn keys: it inserts them, replaces their
+ * values and removes them again, always letting the map free what it drops.
+ * Every round also replaces the value of a slice of the shared stable keys.
+ */
+static void* writer_thread(void* arg)
+{
+    WriterArg* writer = arg;
+    StressShared* shared = writer->shared;
+
+    for (uint64_t round = 1; round <= ROUNDS; round++)
+    {
+        for (size_t i = 0; i < CHURN_KEYS_PER_WRITER; i++)
+        {
+            const uint64_t key = churn_key(writer->id, i);
+            const uint64_t step = (i + round) % 3;
+
+            if (step == 0 && writer->present[i])
+            {
+                if (anv_chm_remove(shared->map, &key, true, true) != 0)
+                {
+                    record_failure(shared, "remove of a present key failed");
+                }
+                writer->present[i] = false;
+            }
+            else if (writer->present[i])
+            {
+                // The key is already stored, so the map will not keep this one
+                uint64_t probe = key;
+                if (anv_chm_put_with_free(shared->map, &probe, heap_value(key, round), true) != 0)
+                {
+                    record_failure(shared, "replace failed");
+                }
+                writer->versions[i] = round;
+            }
+            else
+            {
+                if (anv_chm_put(shared->map, heap_key(key), heap_value(key, round)) != 0)
+                {
+                    record_failure(shared, "insert failed");
+                }
+                writer->present[i] = true;
+                writer->versions[i] = round;
+            }
+        }
+
+        for (size_t i = (size_t)writer->id; i < STABLE_KEYS; i += WRITERS)
+        {
+            if (anv_chm_put(shared->map, &shared->stable_keys[i], &shared->stable_values[i][round]) != 0)
+            {
+                record_failure(shared, "stable replace failed");
+            }
+        }
+    }
+
+    atomic_fetch_add(&shared->writers_done, 1);
+    return NULL;
+}
+
+/**
+ * Readers check that stable keys never disappear while segments grow, and
+ * walk the map with iterators, dereferencing every key and value while the
+ * iterator's read guard keeps them alive.
+ */
+static void* reader_thread(void* arg)
+{
+    StressShared* shared = arg;
+    uint64_t seed = (uint64_t)(uintptr_t)&seed;
+
+    for (int pass = 0; pass < READER_PASSES || atomic_load(&shared->writers_done) < WRITERS; pass++)
+    {
+        for (size_t i = 0; i < STABLE_KEYS; i += 7)
+        {
+            const StressValue* value = anv_chm_get(shared->map, &shared->stable_keys[i]);
+            if (!value || value->key != shared->stable_keys[i])
+            {
+                record_failure(shared, "stable key lost or holds a foreign value");
+            }
+        }
+
+        // Churn values may be freed as soon as get returns, so only the pointer is checked
+        seed = anv_hash_mix64(seed);
+        const uint64_t churn = churn_key((int)(seed % WRITERS), (size_t)(seed >> 32) % CHURN_KEYS_PER_WRITER);
+        (void)anv_chm_contains_key(shared->map, &churn);
+
+        if (pass % 16 == 0)
+        {
+            ANVIterator it = anv_chm_iterator(shared->map);
+            size_t stable_seen = 0;
+            while (it.has_next(&it))
+            {
+                const ANVPair* pair = it.get(&it);
+                const uint64_t key = *(const uint64_t*)pair->first;
+                const StressValue* value = pair->second;
+                if (value->key != key)
+                {
+                    record_failure(shared, "iterator yielded a value for another key");
+                }
+                stable_seen += key < STABLE_KEYS;
+                it.next(&it);
+            }
+            it.destroy(&it);
+
+            if (stable_seen != STABLE_KEYS)
+            {
+                record_failure(shared, "iterator missed or repeated a stable key");
+            }
+        }
+    }
+    return NULL;
+}
+
+// Start near empty so every segment grows while the threads run
+int test_chm_concurrent_churn(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    StressShared* shared = calloc(1, sizeof(StressShared));
+    ASSERT_NOT_NULL(shared);
+    shared->map = anv_chm_create(&alloc, hash_u64, equals_u64, 0);
+    ASSERT_NOT_NULL(shared->map);
+
+    for (size_t i = 0; i < STABLE_KEYS; i++)
+    {
+        shared->stable_keys[i] = i;
+        for (size_t r = 0; r <= ROUNDS; r++)
+        {
+            shared->stable_values[i][r].key = i;
+            shared->stable_values[i][r].version = r;
+        }
+        ASSERT_EQ(anv_chm_put(shared->map, &shared->stable_keys[i], &shared->stable_values[i][0]), 0);
+    }
+
+    WriterArg* writers = calloc(WRITERS, sizeof(WriterArg));
+    ASSERT_NOT_NULL(writers);
+    ANVThread writer_threads[WRITERS];
+    ANVThread reader_threads[READERS];
+
+    for (int r = 0; r < READERS; r++)
+    {
+        ASSERT_EQ(anv_thread_create(&reader_threads[r], reader_thread, shared), 0);
+    }
+    for (int w = 0; w < WRITERS; w++)
+    {
+        writers[w].shared = shared;
+        writers[w].id = w;
+        ASSERT_EQ(anv_thread_create(&writer_threads[w], writer_thread, &writers[w]), 0);
+    }
+    for (int w = 0; w < WRITERS; w++)
+    {
+        anv_thread_join(writer_threads[w], NULL);
+    }
+    for (int r = 0; r < READERS; r++)
+    {
+        anv_thread_join(reader_threads[r], NULL);
+    }
+
+    ASSERT_EQ(atomic_load(&shared->failures), 0);
+
+    // Every writer's final view of its own keys must match the map exactly
+    size_t expected_size = STABLE_KEYS;
+    for (int w = 0; w < WRITERS; w++)
+    {
+        for (size_t i = 0; i < CHURN_KEYS_PER_WRITER; i++)
+        {
+            const uint64_t key = churn_key(w, i);
+            const StressValue* value = anv_chm_get(shared->map, &key);
+            if (writers[w].present[i])
+            {
+                ASSERT_NOT_NULL(value);
+                ASSERT_EQ(value->key, key);
+                ASSERT_EQ(value->version, writers[w].versions[i]);
+                expected_size++;
+            }
+            else
+            {
+                ASSERT_NULL(value);
+            }
+        }
+    }
+    for (size_t i = 0; i < STABLE_KEYS; i++)
+    {
+        const StressValue* value = anv_chm_get(shared->map, &shared->stable_keys[i]);
+        ASSERT_NOT_NULL(value);
+        ASSERT_EQ(value->version, ROUNDS);
+    }
+    ASSERT_EQ(anv_chm_size(shared->map), expected_size);
+
+    // Stable keys and values live in shared, so only churn entries may be freed
+    for (size_t i = 0; i < STABLE_KEYS; i++)
+    {
+        ASSERT_EQ(anv_chm_remove(shared->map, &shared->stable_keys[i], false, false), 0);
+    }
+    anv_chm_destroy(shared->map, true, true);
+    free(writers);
+    free(shared);
+    return TEST_SUCCESS;
+}
+
+typedef struct ComputeShared
+{
+    ANVConcurrentHashMap* map;
+    uint64_t keys[STABLE_KEYS];
+    _Atomic int computed[STABLE_KEYS];
+    _Atomic int inserted;
+} ComputeShared;
+
+static void* compute_value(const void* key, void* context)
+{
+    ComputeShared* shared = context;
+    const uint64_t index = *(const uint64_t*)key;
+    atomic_fetch_add(&shared->computed[index], 1);
+    return heap_value(index, 0);
+}
+
+static void* compute_thread(void* arg)
+{
+    ComputeShared* shared = arg;
+    for (size_t i = 0; i < STABLE_KEYS; i++)
+    {
+        bool inserted = false;
+        if (anv_chm_compute_if_absent(shared->map, &shared->keys[i], compute_value, shared, &inserted) && inserted)
+        {
+            atomic_fetch_add(&shared->inserted, 1);
+        }
+    }
+    return NULL;
+}
+
+// Racing compute_if_absent calls must compute and insert each key exactly once
+int test_chm_concurrent_compute_if_absent(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ComputeShared* shared = calloc(1, sizeof(ComputeShared));
+    ASSERT_NOT_NULL(shared);
+    shared->map = anv_chm_create(&alloc, hash_u64, equals_u64, 0);
+    ASSERT_NOT_NULL(shared->map);
+    for (size_t i = 0; i < STABLE_KEYS; i++)
+    {
+        shared->keys[i] = i;
+    }
+
+    ANVThread threads[WRITERS + READERS];
+    for (int t = 0; t < WRITERS + READERS; t++)
+    {
+        ASSERT_EQ(anv_thread_create(&threads[t], compute_thread, shared), 0);
+    }
+    for (int t = 0; t < WRITERS + READERS; t++)
+    {
+        anv_thread_join(threads[t], NULL);
+    }
+
+    ASSERT_EQ(atomic_load(&shared->inserted), STABLE_KEYS);
+    ASSERT_EQ(anv_chm_size(shared->map), STABLE_KEYS);
+    for (size_t i = 0; i < STABLE_KEYS; i++)
+    {
+        ASSERT_EQ(atomic_load(&shared->computed[i]), 1);
+    }
+
+    // Keys live in shared; only the computed values belong to the map
+    anv_chm_destroy(shared->map, false, true);
+    free(shared);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_chm_concurrent_churn, "test_chm_concurrent_churn"},
+        {test_chm_concurrent_compute_if_absent, "test_chm_concurrent_compute_if_absent"},
+    };
+
+    printf("Running ConcurrentHashMap stress tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll ConcurrentHashMap stress tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d ConcurrentHashMap stress tests failed.\n", failed);
+    return 1;
+}
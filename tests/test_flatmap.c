@@ -0,0 +1,426 @@
+//
+// Flat map tests - control bytes and tags, growth, colliding keys, copies,
+// erase and same-size rehash behavior, and iteration. Also built as
+// test_flatmap_portable with ANV_FLATMAP_NO_SSE2 to cover the 8-byte groups.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "containers/flatmap.h"
+#include "TestAssert.h"
+
+#define KEY_COUNT 4096
+
+// Group width flatmap.c selects for this build
+#if !defined(ANV_FLATMAP_NO_SSE2) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define GROUP_WIDTH 16
+#else
+    #define GROUP_WIDTH 8
+#endif
+
+// Control byte of an erased slot, mirroring flatmap.c
+#define CTRL_DELETED ((int8_t)-2)
+
+static int keys[KEY_COUNT];
+static int values[KEY_COUNT][2];
+
+static size_t hash_int(const void* key)
+{
+    return (size_t)*(const int*)key;
+}
+
+// One hash value: every key shares a tag and a probe start
+static size_t hash_constant(const void* key)
+{
+    (void)key;
+    return 42;
+}
+
+static int equals_int(const void* a, const void* b)
+{
+    return *(const int*)a == *(const int*)b;
+}
+
+static void fill_keys(void)
+{
+    for (int i = 0; i < KEY_COUNT; i++)
+    {
+        keys[i] = i;
+        values[i][0] = i;
+        values[i][1] = -i;
+    }
+}
+
+static size_t count_tombstones(const ANVFlatMap* map)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < map->capacity; i++)
+    {
+        count += map->ctrl[i] == CTRL_DELETED;
+    }
+    return count;
+}
+
+// The first group of control bytes is mirrored past the end of the table
+static int check_mirror(const ANVFlatMap* map)
+{
+    for (size_t i = 0; i < GROUP_WIDTH; i++)
+    {
+        ASSERT_EQ(map->ctrl[map->capacity + i], map->ctrl[i]);
+    }
+    return TEST_SUCCESS;
+}
+
+// Insert, replace, look up and remove, with each full slot tagged by the low 7 bits of the remixed hash
+int test_flatmap_put_get_remove(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVFlatMap* map = anv_flatmap_create(&alloc, hash_int, equals_int, 0);
+    ASSERT_NOT_NULL(map);
+    ASSERT(anv_flatmap_is_empty(map));
+
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(anv_flatmap_put(map, &keys[i], &values[i][0]), 0);
+    }
+    ASSERT_EQ(anv_flatmap_size(map), 10);
+    for (size_t i = 0; i < map->capacity; i++)
+    {
+        if (map->ctrl[i] >= 0)
+        {
+            const int key = *(const int*)map->slots[i].key;
+            ASSERT_EQ(map->ctrl[i], (int8_t)(anv_hash_mix64((uint64_t)key) & 0x7F));
+        }
+    }
+    ASSERT_EQ(check_mirror(map), TEST_SUCCESS);
+
+    // Putting an existing key replaces the value without adding an entry
+    ASSERT_EQ(anv_flatmap_put(map, &keys[3], &values[3][1]), 0);
+    ASSERT_EQ(anv_flatmap_size(map), 10);
+    ASSERT_EQ(anv_flatmap_get(map, &keys[3]), &values[3][1]);
+    void* old = NULL;
+    ASSERT_EQ(anv_flatmap_put_replace(map, &keys[3], &values[3][0], &old), 0);
+    ASSERT_EQ(old, &values[3][1]);
+    ASSERT_EQ(anv_flatmap_put_replace(map, &keys[20], &values[20][0], &old), 0);
+    ASSERT_NULL(old);
+
+    ASSERT_EQ(anv_flatmap_contains_key(map, &keys[20]), 1);
+    ASSERT_EQ(anv_flatmap_contains_key(map, &keys[21]), 0);
+    ASSERT_NULL(anv_flatmap_get(map, &keys[21]));
+
+    ASSERT_EQ(anv_flatmap_remove_get(map, &keys[20], false), &values[20][0]);
+    ASSERT_NULL(anv_flatmap_remove_get(map, &keys[20], false));
+    ASSERT_EQ(anv_flatmap_remove(map, &keys[0], false, false), 0);
+    ASSERT_EQ(anv_flatmap_remove(map, &keys[0], false, false), -1);
+    ASSERT_EQ(anv_flatmap_size(map), 9);
+    for (int i = 1; i < 10; i++)
+    {
+        ASSERT_EQ(anv_flatmap_get(map, &keys[i]), &values[i][0]);
+    }
+    ASSERT_EQ(check_mirror(map), TEST_SUCCESS);
+
+    anv_flatmap_destroy(map, false, false);
+    return TEST_SUCCESS;
+}
+
+// The smallest table is one group, and the table doubles once it passes 7/8 load
+int test_flatmap_capacity_and_growth(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVFlatMap* map = anv_flatmap_create(&alloc, hash_int, equals_int, 1);
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(map->capacity, GROUP_WIDTH);
+    const size_t limit = GROUP_WIDTH - GROUP_WIDTH / 8;
+    ASSERT_EQ(map->growth_left, limit);
+
+    for (size_t i = 0; i < limit; i++)
+    {
+        ASSERT_EQ(anv_flatmap_put(map, &keys[i], &values[i][0]), 0);
+    }
+    ASSERT_EQ(map->capacity, GROUP_WIDTH);
+    ASSERT_EQ(map->growth_left, 0);
+
+    ASSERT_EQ(anv_flatmap_put(map, &keys[limit], &values[limit][0]), 0);
+    ASSERT_EQ(map->capacity, GROUP_WIDTH * 2);
+    for (size_t i = 0; i <= limit; i++)
+    {
+        ASSERT_EQ(anv_flatmap_get(map, &keys[i]), &values[i][0]);
+    }
+    ASSERT_EQ(check_mirror(map), TEST_SUCCESS);
+
+    // Reserving up front means the inserts never rehash
+    ASSERT_EQ(anv_flatmap_reserve(map, 1000), 0);
+    const size_t capacity = map->capacity;
+    const int8_t* ctrl = map->ctrl;
+    for (int i = 0; i < 1000; i++)
+    {
+        ASSERT_EQ(anv_flatmap_put(map, &keys[i], &values[i][0]), 0);
+    }
+    ASSERT_EQ(map->capacity, capacity);
+    ASSERT_EQ_PTR(map->ctrl, ctrl);
+    ASSERT(anv_flatmap_load_factor(map) <= 7.0 / 8.0);
+
+    anv_flatmap_destroy(map, false, false);
+    return TEST_SUCCESS;
+}
+
+// Keys sharing one hash fill several groups, and every one stays reachable
+int test_flatmap_colliding_keys(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVFlatMap* map = anv_flatmap_create(&alloc, hash_constant, equals_int, 64);
+    ASSERT_NOT_NULL(map);
+
+    const int count = GROUP_WIDTH * 3 + 1;
+    for (int i = 0; i < count; i++)
+    {
+        ASSERT_EQ(anv_flatmap_put(map, &keys[i], &values[i][0]), 0);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        ASSERT_EQ(anv_flatmap_get(map, &keys[i]), &values[i][0]);
+    }
+    ASSERT_NULL(anv_flatmap_get(map, &keys[count]));
+    ASSERT_EQ(check_mirror(map), TEST_SUCCESS);
+
+    // Removing the first group's keys keeps the later ones reachable
+    for (int i = 0; i < GROUP_WIDTH; i++)
+    {
+        ASSERT_EQ(anv_flatmap_remove(map, &keys[i], false, false), 0);
+    }
+    for (int i = GROUP_WIDTH; i < count; i++)
+    {
+        ASSERT_EQ(anv_flatmap_get(map, &keys[i]), &values[i][0]);
+    }
+    ASSERT_EQ(check_mirror(map), TEST_SUCCESS);
+
+    anv_flatmap_destroy(map, false, false);
+    return TEST_SUCCESS;
+}
+
+// Copies and clear keep the table shape and contents consistent
+int test_flatmap_copy_and_clear(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVFlatMap* map = anv_flatmap_create(&alloc, hash_int, equals_int, 0);
+    ASSERT_NOT_NULL(map);
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(anv_flatmap_put(map, &keys[i], &values[i][0]), 0);
+    }
+    for (int i = 0; i < 100; i += 2)
+    {
+        ASSERT_EQ(anv_flatmap_remove(map, &keys[i], false, false), 0);
+    }
+
+    ANVFlatMap* copy = anv_flatmap_copy(map);
+    ASSERT_NOT_NULL(copy);
+    ASSERT_EQ(anv_flatmap_size(copy), 50);
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(anv_flatmap_get(copy, &keys[i]), i % 2 ? &values[i][0] : NULL);
+    }
+
+    anv_flatmap_clear(map, false, false);
+    ASSERT_EQ(anv_flatmap_size(map), 0);
+    ASSERT_EQ(count_tombstones(map), 0);
+    ASSERT_EQ(map->growth_left, map->capacity - map->capacity / 8);
+    ASSERT_NULL(anv_flatmap_get(map, &keys[1]));
+    ASSERT_EQ(anv_flatmap_get(copy, &keys[1]), &values[1][0]);
+
+    anv_flatmap_destroy(copy, false, false);
+    anv_flatmap_destroy(map, false, false);
+    return TEST_SUCCESS;
+}
+
+// A slot with no full group around it goes back to empty and returns its growth
+int test_flatmap_erase_isolated_slot_is_empty(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVFlatMap* map = anv_flatmap_create(&alloc, hash_int, equals_int, 64);
+    ASSERT_NOT_NULL(map);
+
+    const size_t growth = map->growth_left;
+    ASSERT_EQ(anv_flatmap_put(map, &keys[1], &values[1][0]), 0);
+    ASSERT_EQ(map->growth_left, growth - 1);
+    ASSERT_EQ(anv_flatmap_remove(map, &keys[1], false, false), 0);
+    ASSERT_EQ(map->growth_left, growth);
+
+    anv_flatmap_destroy(map, false, false);
+    return TEST_SUCCESS;
+}
+
+// Erasing inside a full run leaves a tombstone, so keys probed past it stay reachable
+int test_flatmap_erase_in_full_run_is_tombstone(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVFlatMap* map = anv_flatmap_create(&alloc, hash_constant, equals_int, 64);
+    ASSERT_NOT_NULL(map);
+
+    for (int i = 0; i < 40; i++)
+    {
+        ASSERT_EQ(anv_flatmap_put(map, &keys[i], &values[i][0]), 0);
+    }
+
+    const size_t growth = map->growth_left;
+    ASSERT_EQ(anv_flatmap_remove(map, &keys[0], false, false), 0);
+    ASSERT_EQ(map->growth_left, growth);
+    for (int i = 1; i < 40; i++)
+    {
+        ASSERT_EQ(anv_flatmap_get(map, &keys[i]), &values[i][0]);
+    }
+
+    // The next insert on the same probe sequence reuses the tombstone
+    ASSERT_EQ(anv_flatmap_put(map, &keys[40], &values[40][0]), 0);
+    ASSERT_EQ(map->growth_left, growth);
+
+    anv_flatmap_destroy(map, false, false);
+    return TEST_SUCCESS;
+}
+
+// Churn at a small size in a table clogged with tombstones must rebuild it without growing
+int test_flatmap_same_size_rehash(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVFlatMap* map = anv_flatmap_create(&alloc, hash_int, equals_int, 200);
+    ASSERT_NOT_NULL(map);
+    const size_t capacity = map->capacity;
+
+    // Fill to the load limit, then remove all but the newest entries; at that load most removals leave tombstones
+    int next = 0;
+    while (map->growth_left > 0)
+    {
+        ASSERT_EQ(anv_flatmap_put(map, &keys[next], &values[next][0]), 0);
+        next++;
+    }
+    const int live = 24;
+    for (int i = 0; i < next - live; i++)
+    {
+        ASSERT_EQ(anv_flatmap_remove(map, &keys[i], false, false), 0);
+    }
+
+    ASSERT(count_tombstones(map) > 0);
+
+    // FIFO churn keeps the size fixed; growth_left only rises again through a rebuild
+    bool rebuilt = false;
+    for (; next < KEY_COUNT && !rebuilt; next++)
+    {
+        const size_t growth = map->growth_left;
+        ASSERT_EQ(anv_flatmap_put(map, &keys[next], &values[next][0]), 0);
+        rebuilt = map->growth_left > growth;
+        if (rebuilt)
+        {
+            ASSERT_EQ(count_tombstones(map), 0); // The rebuild drops every tombstone
+        }
+        ASSERT_EQ(anv_flatmap_remove(map, &keys[next - live], false, false), 0);
+        ASSERT_EQ(map->capacity, capacity);
+    }
+
+    ASSERT(rebuilt);
+    ASSERT_EQ(check_mirror(map), TEST_SUCCESS);
+    ASSERT_EQ(anv_flatmap_size(map), (size_t)live);
+    for (int i = 0; i < next; i++)
+    {
+        ASSERT_EQ(anv_flatmap_get(map, &keys[i]), i >= next - live ? &values[i][0] : NULL);
+    }
+
+    anv_flatmap_destroy(map, false, false);
+    return TEST_SUCCESS;
+}
+
+// The iterator yields every entry once, and again after a reset
+int test_flatmap_iterator(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVFlatMap* map = anv_flatmap_create(&alloc, hash_int, equals_int, 0);
+    ASSERT_NOT_NULL(map);
+    for (int i = 0; i < 1000; i++)
+    {
+        ASSERT_EQ(anv_flatmap_put(map, &keys[i], &values[i][0]), 0);
+    }
+    for (int i = 0; i < 1000; i += 3)
+    {
+        ASSERT_EQ(anv_flatmap_remove(map, &keys[i], false, false), 0);
+    }
+
+    int* seen = calloc(1000, sizeof(int));
+    ASSERT_NOT_NULL(seen);
+    ANVIterator it = anv_flatmap_iterator(map);
+    for (int pass = 0; pass < 2; pass++)
+    {
+        size_t count = 0;
+        while (it.has_next(&it))
+        {
+            const ANVPair* pair = it.get(&it);
+            const int key = *(const int*)pair->first;
+            ASSERT_EQ(pair->second, &values[key][0]);
+            seen[key]++;
+            count++;
+            it.next(&it);
+        }
+        ASSERT_EQ(count, anv_flatmap_size(map));
+        ASSERT_NULL(it.get(&it));
+        ASSERT_EQ(it.next(&it), -1);
+        ASSERT(!it.has_prev(&it)); // Forward only
+        it.reset(&it);
+    }
+    it.destroy(&it);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        ASSERT_EQ(seen[i], i % 3 == 0 ? 0 : 2);
+    }
+
+    free(seen);
+    anv_flatmap_destroy(map, false, false);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_flatmap_put_get_remove, "test_flatmap_put_get_remove"},
+        {test_flatmap_capacity_and_growth, "test_flatmap_capacity_and_growth"},
+        {test_flatmap_colliding_keys, "test_flatmap_colliding_keys"},
+        {test_flatmap_copy_and_clear, "test_flatmap_copy_and_clear"},
+        {test_flatmap_erase_isolated_slot_is_empty, "test_flatmap_erase_isolated_slot_is_empty"},
+        {test_flatmap_erase_in_full_run_is_tombstone, "test_flatmap_erase_in_full_run_is_tombstone"},
+        {test_flatmap_same_size_rehash, "test_flatmap_same_size_rehash"},
+        {test_flatmap_iterator, "test_flatmap_iterator"},
+    };
+
+    fill_keys();
+    printf("Running FlatMap tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll FlatMap tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d FlatMap tests failed.\n", failed);
+    return 1;
+}
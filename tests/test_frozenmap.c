@@ -0,0 +1,168 @@
+//
+// Frozen map tests - lookups against the source map, including keys whose
+// full hashes collide
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "containers/frozenmap.h"
+#include "TestAssert.h"
+
+#define KEY_COUNT 5000
+
+static int keys[KEY_COUNT];
+static int values[KEY_COUNT];
+
+// Only 64 distinct hash values, so most keys share their full hash with others
+static size_t colliding_hash(const void* key)
+{
+    return (size_t)(*(const int*)key & 63);
+}
+
+static void fill_keys(void)
+{
+    unsigned int rng = 2463534242u;
+    for (int i = 0; i < KEY_COUNT; i++)
+    {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        keys[i] = i * 2; // Even keys are present, odd keys are probed as misses
+        values[i] = (int)(rng & 0xFFFF);
+    }
+}
+
+// Every key of the source map must be found with its value, and misses must miss
+static int check_against_source(const ANVFrozenMap* frozen, const ANVHashMap* source)
+{
+    ASSERT_EQ(anv_frozenmap_size(frozen), anv_hashmap_size(source));
+    for (int i = 0; i < KEY_COUNT; i++)
+    {
+        ASSERT_EQ(anv_frozenmap_get(frozen, &keys[i]), anv_hashmap_get(source, &keys[i]));
+        const int missing = keys[i] + 1;
+        ASSERT_NULL(anv_frozenmap_get(frozen, &missing));
+    }
+
+    size_t seen = 0;
+    ANVIterator it = anv_frozenmap_iterator(frozen);
+    while (it.has_next(&it))
+    {
+        const ANVPair* pair = it.get(&it);
+        ASSERT_EQ(anv_hashmap_get(source, pair->first), pair->second);
+        seen++;
+        it.next(&it);
+    }
+    it.destroy(&it);
+    ASSERT_EQ(seen, anv_hashmap_size(source));
+    return TEST_SUCCESS;
+}
+
+int test_frozenmap_distinct_hashes(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVHashMap* source = anv_hashmap_create(&alloc, anv_hash_int, anv_key_equals_int, 0);
+    ASSERT_NOT_NULL(source);
+    for (int i = 0; i < KEY_COUNT; i++)
+    {
+        ASSERT_EQ(anv_hashmap_put(source, &keys[i], &values[i]), 0);
+    }
+
+    ANVFrozenMap* frozen = anv_frozenmap_from_hashmap(source);
+    ASSERT_NOT_NULL(frozen);
+    ASSERT_EQ(check_against_source(frozen, source), TEST_SUCCESS);
+
+    anv_frozenmap_destroy(frozen, false, false);
+    anv_hashmap_destroy(source, false, false);
+    return TEST_SUCCESS;
+}
+
+int test_frozenmap_equal_full_hashes(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVHashMap* source = anv_hashmap_create(&alloc, colliding_hash, anv_key_equals_int, 0);
+    ASSERT_NOT_NULL(source);
+    for (int i = 0; i < KEY_COUNT; i++)
+    {
+        ASSERT_EQ(anv_hashmap_put(source, &keys[i], &values[i]), 0);
+    }
+
+    ANVFrozenMap* frozen = anv_frozenmap_from_hashmap(source);
+    ASSERT_NOT_NULL(frozen);
+    ASSERT_EQ(check_against_source(frozen, source), TEST_SUCCESS);
+
+    anv_frozenmap_destroy(frozen, false, false);
+    anv_hashmap_destroy(source, false, false);
+    return TEST_SUCCESS;
+}
+
+int test_frozenmap_single_hash(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVHashMap* source = anv_hashmap_create(&alloc, colliding_hash, anv_key_equals_int, 0);
+    ASSERT_NOT_NULL(source);
+
+    // Multiples of 64 all hash to 0
+    int same[32];
+    for (int i = 0; i < 32; i++)
+    {
+        same[i] = i * 64;
+        ASSERT_EQ(anv_hashmap_put(source, &same[i], &values[i]), 0);
+    }
+
+    ANVFrozenMap* frozen = anv_frozenmap_from_hashmap(source);
+    ASSERT_NOT_NULL(frozen);
+    ASSERT_EQ(anv_frozenmap_size(frozen), 32);
+    for (int i = 0; i < 32; i++)
+    {
+        ASSERT_EQ(anv_frozenmap_get(frozen, &same[i]), &values[i]);
+    }
+    const int missing = 32 * 64;
+    ASSERT_NULL(anv_frozenmap_get(frozen, &missing));
+
+    anv_frozenmap_destroy(frozen, false, false);
+    anv_hashmap_destroy(source, false, false);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_frozenmap_distinct_hashes, "test_frozenmap_distinct_hashes"},
+        {test_frozenmap_equal_full_hashes, "test_frozenmap_equal_full_hashes"},
+        {test_frozenmap_single_hash, "test_frozenmap_single_hash"},
+    };
+
+    fill_keys();
+    printf("Running FrozenMap tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll FrozenMap tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d FrozenMap tests failed.\n", failed);
+    return 1;
+}
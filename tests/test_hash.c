@@ -0,0 +1,340 @@
+//
+// Hash tests - every length tier of anv_hash_bytes, unaligned input, seed
+// sensitivity, the string, integer and pointer hash functions, SipHash
+// reference vectors and per-map seeds
+//
+
+#include <stdio.h>
+#include <string.h>
+#include "algorithms/hash.h"
+#include "containers/hashmap.h"
+#include "TestAssert.h"
+
+#define MAX_INPUT 256
+
+// Lengths on both sides of each tier: empty, 1-3, 4-16, 17-47 and 48 or more
+static const size_t TIER_LENGTHS[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 47, 48, 49, 95, 96, 97, 200};
+#define TIER_COUNT (sizeof(TIER_LENGTHS) / sizeof(TIER_LENGTHS[0]))
+
+static void fill_input(uint8_t* buffer, const size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        buffer[i] = (uint8_t)(i * 37 + 11);
+    }
+}
+
+// Every byte of the input must reach the hash, including those only covered by overlapping reads
+int test_hash_bytes_length_tiers(void)
+{
+    uint8_t buffer[MAX_INPUT];
+    for (size_t t = 0; t < TIER_COUNT; t++)
+    {
+        const size_t len = TIER_LENGTHS[t];
+        fill_input(buffer, len);
+        const uint64_t hash = anv_hash_bytes(buffer, len, 0);
+        ASSERT_EQ(anv_hash_bytes(buffer, len, 0), hash);
+
+        for (size_t i = 0; i < len; i++)
+        {
+            for (int bit = 0; bit < 8; bit++)
+            {
+                buffer[i] ^= (uint8_t)(1u << bit);
+                ASSERT(anv_hash_bytes(buffer, len, 0) != hash);
+                buffer[i] ^= (uint8_t)(1u << bit);
+            }
+        }
+
+        // Bytes past the length are never read
+        buffer[len] = 0xFF;
+        ASSERT_EQ(anv_hash_bytes(buffer, len, 0), hash);
+        buffer[len] = 0x00;
+        ASSERT_EQ(anv_hash_bytes(buffer, len, 0), hash);
+    }
+
+    // The empty input may be NULL
+    ASSERT_EQ(anv_hash_bytes(NULL, 0, 0), anv_hash_bytes(buffer, 0, 0));
+    return TEST_SUCCESS;
+}
+
+// Inputs that differ only in length, such as runs of zero bytes, hash differently
+int test_hash_bytes_length_is_mixed(void)
+{
+    uint8_t zeros[MAX_INPUT] = {0};
+    uint64_t hashes[MAX_INPUT];
+    for (size_t len = 0; len < MAX_INPUT; len++)
+    {
+        hashes[len] = anv_hash_bytes(zeros, len, 0);
+        for (size_t other = 0; other < len; other++)
+        {
+            ASSERT(hashes[other] != hashes[len]);
+        }
+    }
+    return TEST_SUCCESS;
+}
+
+// The hash depends only on the bytes, not on where they sit in memory
+int test_hash_bytes_unaligned(void)
+{
+    uint64_t storage[(MAX_INPUT + 16) / sizeof(uint64_t)];
+    uint8_t* base = (uint8_t*)storage;
+    uint8_t reference[MAX_INPUT];
+
+    for (size_t t = 0; t < TIER_COUNT; t++)
+    {
+        const size_t len = TIER_LENGTHS[t];
+        fill_input(reference, len);
+        const uint64_t expected = anv_hash_bytes(reference, len, 7);
+        for (size_t offset = 1; offset < 8; offset++)
+        {
+            memset(base, 0xEE, sizeof(storage));
+            memcpy(base + offset, reference, len);
+            ASSERT_EQ(anv_hash_bytes(base + offset, len, 7), expected);
+        }
+    }
+    return TEST_SUCCESS;
+}
+
+// Changing any single bit of the seed changes the hash in every tier
+int test_hash_bytes_seed_sensitivity(void)
+{
+    uint8_t buffer[MAX_INPUT];
+    for (size_t t = 0; t < TIER_COUNT; t++)
+    {
+        const size_t len = TIER_LENGTHS[t];
+        fill_input(buffer, len);
+        const uint64_t hash = anv_hash_bytes(buffer, len, 0x0123456789abcdefull);
+        for (int bit = 0; bit < 64; bit++)
+        {
+            const uint64_t seed = 0x0123456789abcdefull ^ ((uint64_t)1 << bit);
+            ASSERT(anv_hash_bytes(buffer, len, seed) != hash);
+        }
+    }
+    return TEST_SUCCESS;
+}
+
+// anv_hash_string hashes the string's bytes without the terminator, with seed 0
+int test_hash_string(void)
+{
+    const char* strings[] = {"", "a", "ab", "abc", "anvil", "sixteen bytes!!!", "seventeen bytes!!",
+                             "a string long enough to go through the forty-eight byte lanes at least once"};
+    for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); i++)
+    {
+        ASSERT_EQ(anv_hash_string(strings[i]), (size_t)anv_hash_bytes(strings[i], strlen(strings[i]), 0));
+    }
+    ASSERT(anv_hash_string("anvil") != anv_hash_string("anvim"));
+    ASSERT_EQ(anv_hash_string(NULL), 0);
+    return TEST_SUCCESS;
+}
+
+static int popcount64(uint64_t value)
+{
+    int count = 0;
+    for (; value; value &= value - 1)
+    {
+        count++;
+    }
+    return count;
+}
+
+// mix64 is the SplitMix64 finalizer; the integer and pointer hashes are built on it
+int test_hash_mix64_and_scalars(void)
+{
+    // Reference outputs of the SplitMix64 finalizer
+    ASSERT_EQ(anv_hash_mix64(0), 0);
+    ASSERT_EQ(anv_hash_mix64(1), 0x5692161d100b05e5ull);
+    ASSERT_EQ(anv_hash_mix64(0x9e3779b97f4a7c15ull), 0xe220a8397b1dcdafull);
+
+    // Flipping one input bit flips about half the output bits
+    int total = 0;
+    for (uint64_t value = 1; value <= 256; value++)
+    {
+        const uint64_t base = anv_hash_mix64(value * 0x9e3779b97f4a7c15ull);
+        for (int bit = 0; bit < 64; bit++)
+        {
+            total += popcount64(base ^ anv_hash_mix64((value * 0x9e3779b97f4a7c15ull) ^ ((uint64_t)1 << bit)));
+        }
+    }
+    const double average = (double)total / (256.0 * 64.0);
+    ASSERT(average > 30.0 && average < 34.0);
+
+    const int ints[] = {0, 1, -1, 42, INT32_MIN, INT32_MAX};
+    for (size_t i = 0; i < sizeof(ints) / sizeof(ints[0]); i++)
+    {
+        ASSERT_EQ(anv_hash_int(&ints[i]), (size_t)anv_hash_mix64((uint32_t)ints[i]));
+    }
+    ASSERT(anv_hash_int(&ints[1]) != anv_hash_int(&ints[2]));
+
+    const int64_t wide[] = {0, -1, INT64_MAX, (int64_t)1 << 40};
+    for (size_t i = 0; i < sizeof(wide) / sizeof(wide[0]); i++)
+    {
+        ASSERT_EQ(anv_hash_int64(&wide[i]), (size_t)anv_hash_mix64((uint64_t)wide[i]));
+    }
+
+    // Pointer keys hash the address itself, not what it points to
+    ASSERT_EQ(anv_hash_pointer(&wide[0]), (size_t)anv_hash_mix64((uintptr_t)&wide[0]));
+    ASSERT(anv_hash_pointer(&wide[0]) != anv_hash_pointer(&wide[1]));
+    ASSERT_EQ(anv_hash_pointer(NULL), 0);
+
+    ASSERT_EQ(anv_hash_int(NULL), 0);
+    ASSERT_EQ(anv_hash_int64(NULL), 0);
+    return TEST_SUCCESS;
+}
+
+// Reference key 00 01 .. 0f; HalfSipHash uses the first eight bytes
+static const ANVHashSeed REFERENCE_KEY = {0x0706050403020100ull, 0x0f0e0d0c0b0a0908ull};
+static const ANVHashSeed REFERENCE_HALF_KEY = {0x03020100ull, 0x07060504ull};
+
+// Outputs of the reference SipHash-1-3 and HalfSipHash-1-3 for messages 00 01 .. len-1
+static const size_t VECTOR_LENGTHS[] = {0, 1, 7, 8, 9, 15, 16, 63};
+static const uint64_t SIPHASH13_VECTORS[] = {
+    0xabac0158050fc4dcull, 0xc9f49bf37d57ca93ull, 0xd3927d989bb11140ull, 0x369095118d299a8eull,
+    0x25a48eb36c063de4ull, 0xd320d86d2a519956ull, 0xcc4fdd1a7d908b66ull, 0x9d199062b7bbb3a8ull,
+};
+static const uint32_t HALFSIPHASH13_VECTORS[] = {
+    0x5814c896u, 0xe7e864cau, 0x9d38d9d6u, 0x577999b1u, 0xc839caedu, 0xd0257b04u, 0x8b31d501u, 0x87178304u,
+};
+
+int test_siphash_reference_vectors(void)
+{
+    uint8_t message[64];
+    for (size_t i = 0; i < sizeof(message); i++)
+    {
+        message[i] = (uint8_t)i;
+    }
+
+    for (size_t v = 0; v < sizeof(VECTOR_LENGTHS) / sizeof(VECTOR_LENGTHS[0]); v++)
+    {
+        const size_t len = VECTOR_LENGTHS[v];
+        ASSERT_EQ(anv_siphash13(message, len, &REFERENCE_KEY), SIPHASH13_VECTORS[v]);
+        ASSERT_EQ(anv_halfsiphash13(message, len, &REFERENCE_HALF_KEY), HALFSIPHASH13_VECTORS[v]);
+    }
+
+    // HalfSipHash only uses the low halves of the seed words
+    const ANVHashSeed widened = {REFERENCE_HALF_KEY.k0 | 0xffffffff00000000ull, REFERENCE_HALF_KEY.k1};
+    ASSERT_EQ(anv_halfsiphash13(message, 9, &widened), HALFSIPHASH13_VECTORS[4]);
+
+    // The string variants hash strlen bytes
+    const char* text = "anvil";
+    ASSERT_EQ(anv_hash_string_siphash(text, &REFERENCE_KEY), (size_t)anv_siphash13(text, 5, &REFERENCE_KEY));
+    ASSERT_EQ(anv_hash_string_halfsiphash(text, &REFERENCE_KEY), anv_halfsiphash13(text, 5, &REFERENCE_KEY));
+    ASSERT_EQ(anv_hash_string_siphash(NULL, &REFERENCE_KEY), 0);
+    ASSERT_EQ(anv_hash_string_siphash(text, NULL), 0);
+    return TEST_SUCCESS;
+}
+
+// The node holding key, found by walking the buckets
+static const ANVHashMapNode* find_node(const ANVHashMap* map, const char* key)
+{
+    for (size_t i = 0; i < map->bucket_count; i++)
+    {
+        for (const ANVHashMapNode* node = map->buckets[i]; node; node = node->next)
+        {
+            if (strcmp(node->key, key) == 0)
+            {
+                return node;
+            }
+        }
+    }
+    return NULL;
+}
+
+// Maps created with different seeds hash the same key differently
+int test_hashmap_seeds_differ(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    const ANVHashSeed seed_a = {1, 2};
+    const ANVHashSeed seed_b = {3, 4};
+    ANVHashMap* map_a = anv_hashmap_create_seeded(&alloc, anv_hash_string_siphash, anv_key_equals_string, 64, &seed_a);
+    ANVHashMap* map_b = anv_hashmap_create_seeded(&alloc, anv_hash_string_siphash, anv_key_equals_string, 64, &seed_b);
+    ASSERT_NOT_NULL(map_a);
+    ASSERT_NOT_NULL(map_b);
+
+    static char keys[32][8];
+    static int value = 1;
+    size_t same_bucket = 0;
+    for (int i = 0; i < 32; i++)
+    {
+        snprintf(keys[i], sizeof(keys[i]), "key%d", i);
+        ASSERT_EQ(anv_hashmap_put(map_a, keys[i], &value), 0);
+        ASSERT_EQ(anv_hashmap_put(map_b, keys[i], &value), 0);
+
+        const ANVHashMapNode* node_a = find_node(map_a, keys[i]);
+        const ANVHashMapNode* node_b = find_node(map_b, keys[i]);
+        ASSERT_NOT_NULL(node_a);
+        ASSERT_NOT_NULL(node_b);
+        ASSERT_EQ(node_a->hash, anv_hash_string_siphash(keys[i], &seed_a));
+        ASSERT_EQ(node_b->hash, anv_hash_string_siphash(keys[i], &seed_b));
+        ASSERT(node_a->hash != node_b->hash);
+        same_bucket += node_a->hash % map_a->bucket_count == node_b->hash % map_b->bucket_count;
+    }
+    ASSERT(same_bucket < 16); // The layouts are unrelated
+
+    // Copies keep the seed
+    ANVHashMap* copy = anv_hashmap_copy(map_a);
+    ASSERT_NOT_NULL(copy);
+    ASSERT_EQ(copy->seed.k0, seed_a.k0);
+    ASSERT_EQ(copy->seed.k1, seed_a.k1);
+    ASSERT_EQ(find_node(copy, "key7")->hash, find_node(map_a, "key7")->hash);
+    anv_hashmap_destroy(copy, false, false);
+
+    // Without a seed, each map draws its own
+    ANVHashMap* random_a = anv_hashmap_create_seeded(&alloc, anv_hash_string_siphash, anv_key_equals_string, 0, NULL);
+    ANVHashMap* random_b = anv_hashmap_create_seeded(&alloc, anv_hash_string_siphash, anv_key_equals_string, 0, NULL);
+    ASSERT_NOT_NULL(random_a);
+    ASSERT_NOT_NULL(random_b);
+    ASSERT(random_a->seed.k0 != random_b->seed.k0 || random_a->seed.k1 != random_b->seed.k1);
+
+    anv_hashmap_destroy(random_a, false, false);
+    anv_hashmap_destroy(random_b, false, false);
+    anv_hashmap_destroy(map_a, false, false);
+    anv_hashmap_destroy(map_b, false, false);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_hash_bytes_length_tiers, "test_hash_bytes_length_tiers"},
+        {test_hash_bytes_length_is_mixed, "test_hash_bytes_length_is_mixed"},
+        {test_hash_bytes_unaligned, "test_hash_bytes_unaligned"},
+        {test_hash_bytes_seed_sensitivity, "test_hash_bytes_seed_sensitivity"},
+        {test_hash_string, "test_hash_string"},
+        {test_hash_mix64_and_scalars, "test_hash_mix64_and_scalars"},
+        {test_siphash_reference_vectors, "test_siphash_reference_vectors"},
+        {test_hashmap_seeds_differ, "test_hashmap_seeds_differ"},
+    };
+
+    printf("Running Hash tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll Hash tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d Hash tests failed.\n", failed);
+    return 1;
+}
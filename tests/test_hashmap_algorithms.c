@@ -246,6 +246,86 @@ int test_hashmap_from_iterator(void)
     return TEST_SUCCESS;
 }
 
+// Batched lookups must agree with anv_hashmap_get key by key
+static int check_batch(const ANVHashMap* map, const void* const* keys, const size_t count)
+{
+    void* values[200];
+    size_t expected = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = (void*)&values; // Overwritten for every key, found or not
+    }
+
+    const size_t found = anv_hashmap_get_batch(map, keys, count, values);
+    for (size_t i = 0; i < count; i++)
+    {
+        ASSERT_EQ_PTR(values[i], anv_hashmap_get(map, keys[i]));
+        expected += values[i] != NULL;
+    }
+    ASSERT_EQ(found, expected);
+    return TEST_SUCCESS;
+}
+
+// Batches of any length, with NULL and missing keys, before, during and after an incremental resize
+int test_hashmap_get_batch(void)
+{
+    ANVAllocator alloc = create_int_allocator();
+    ANVHashMap* map = anv_hashmap_create(&alloc, anv_hash_int, anv_key_equals_int, 8);
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(anv_hashmap_set_incremental_resize(map, true), 0);
+
+    static int keys[400];
+    const void* queries[200];
+    for (int i = 0; i < 400; i++)
+    {
+        keys[i] = i;
+    }
+
+    // Even keys are stored; odd ones are misses and every seventh query is NULL
+    int added = 0;
+    while (added < 200 || !map->old_buckets)
+    {
+        ASSERT(added < 400);
+        ASSERT_EQ(anv_hashmap_put(map, &keys[added], &keys[added]), 0);
+        added += 2;
+    }
+    ASSERT_NOT_NULL(map->old_buckets);
+    ASSERT(map->migrate_index < map->old_bucket_count);
+
+    const size_t counts[] = {1, ANV_HASHMAP_BATCH_WINDOW - 1, ANV_HASHMAP_BATCH_WINDOW, ANV_HASHMAP_BATCH_WINDOW + 1,
+                             3 * ANV_HASHMAP_BATCH_WINDOW + 5, 200};
+    for (int round = 0; round < 2; round++)
+    {
+        for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+        {
+            for (size_t i = 0; i < counts[c]; i++)
+            {
+                queries[i] = i % 7 == 3 ? NULL : &keys[(i * 2 + c) % 400];
+            }
+            ASSERT_EQ(check_batch(map, queries, counts[c]), TEST_SUCCESS);
+        }
+
+        // Finish the migration and check again against the single table
+        while (map->old_buckets)
+        {
+            ASSERT_EQ(anv_hashmap_put(map, &keys[0], &keys[0]), 0);
+        }
+    }
+
+    // An all-NULL batch finds nothing, and bad arguments return 0
+    void* values[3];
+    const void* nulls[3] = {NULL, NULL, NULL};
+    ASSERT_EQ(anv_hashmap_get_batch(map, nulls, 3, values), 0);
+    ASSERT_NULL(values[0]);
+    ASSERT_EQ(anv_hashmap_get_batch(map, queries, 0, values), 0);
+    ASSERT_EQ(anv_hashmap_get_batch(NULL, queries, 3, values), 0);
+    ASSERT_EQ(anv_hashmap_get_batch(map, NULL, 3, values), 0);
+    ASSERT_EQ(anv_hashmap_get_batch(map, queries, 3, NULL), 0);
+
+    anv_hashmap_destroy(map, false, false);
+    return TEST_SUCCESS;
+}
+
 typedef struct
 {
     int (*func)(void);
@@ -261,6 +341,7 @@ int main(void)
         {test_hashmap_get_keys, "test_hashmap_get_keys"},
         {test_hashmap_get_values, "test_hashmap_get_values"},
         {test_hashmap_from_iterator, "test_hashmap_from_iterator"},
+        {test_hashmap_get_batch, "test_hashmap_get_batch"},
     };
 
     printf("Running HashMap algorithms tests...\n");
@@ -218,6 +218,341 @@ int test_hashmap_resize(void)
     return TEST_SUCCESS;
 }
 
+// Random puts and removes against a presence model while tables are half migrated
+#define INCREMENTAL_KEYS 200000
+
+int test_hashmap_incremental_resize(void)
+{
+    ANVAllocator alloc = create_int_allocator();
+    ANVHashMap* map = anv_hashmap_create(&alloc, anv_hash_int, anv_key_equals_int, 4);
+    ASSERT_EQ(anv_hashmap_set_incremental_resize(map, true), 0);
+
+    int* keys = malloc(INCREMENTAL_KEYS * sizeof(int));
+    bool* present = calloc(INCREMENTAL_KEYS, sizeof(bool));
+    ASSERT_NOT_NULL(keys);
+    ASSERT_NOT_NULL(present);
+    for (int i = 0; i < INCREMENTAL_KEYS; i++)
+    {
+        keys[i] = i;
+    }
+
+    size_t expected = 0;
+    unsigned int rng = 12345;
+    for (int op = 0; op < 3 * INCREMENTAL_KEYS; op++)
+    {
+        rng = rng * 1103515245u + 12345u;
+        // Early keys are hit often, so removes and re-inserts land mid-migration
+        const int i = (int)((rng >> 8) % (unsigned int)(op / 2 + 1)) % INCREMENTAL_KEYS;
+        if (present[i] && (rng & 3) == 0)
+        {
+            ASSERT_EQ(anv_hashmap_remove(map, &keys[i], false, false), 0);
+            present[i] = false;
+            expected--;
+        }
+        else if (!present[i])
+        {
+            ASSERT_EQ(anv_hashmap_put(map, &keys[i], &keys[i]), 0);
+            present[i] = true;
+            expected++;
+        }
+        ASSERT_EQ(anv_hashmap_get(map, &keys[i]) != NULL, present[i]);
+    }
+    ASSERT_EQ(anv_hashmap_size(map), expected);
+
+    size_t seen = 0;
+    ANVIterator it = anv_hashmap_iterator(map);
+    while (it.has_next(&it))
+    {
+        const ANVPair* pair = it.get(&it);
+        ASSERT(present[*(const int*)pair->first]);
+        seen++;
+        it.next(&it);
+    }
+    it.destroy(&it);
+    ASSERT_EQ(seen, expected);
+
+    for (int i = 0; i < INCREMENTAL_KEYS; i++)
+    {
+        ASSERT_EQ(anv_hashmap_contains_key(map, &keys[i]), present[i]);
+    }
+
+    anv_hashmap_destroy(map, false, false);
+    free(present);
+    free(keys);
+    return TEST_SUCCESS;
+}
+
+static size_t hash_calls;
+
+static size_t counting_hash(const void* key)
+{
+    hash_calls++;
+    return anv_hash_int(key);
+}
+
+// Every key lands in one chain, so removals unlink from its middle
+static size_t colliding_hash(const void* key)
+{
+    (void)key;
+    hash_calls++;
+    return 7;
+}
+
+#define COUNT(n) ((void*)(uintptr_t)(n))
+
+// Each call hashes once, and the returned slot is the stored value
+int test_hashmap_entry(void)
+{
+    ANVAllocator alloc = create_int_allocator();
+    ANVHashMap* map = anv_hashmap_create(&alloc, counting_hash, anv_key_equals_int, 0);
+    ASSERT_NOT_NULL(map);
+    static int keys[] = {1, 2, 1, 3, 1, 2};
+
+    hash_calls = 0;
+    bool inserted = false;
+    void** slot = anv_hashmap_entry(map, &keys[0], &inserted);
+    ASSERT_EQ(hash_calls, 1);
+    ASSERT_NOT_NULL(slot);
+    ASSERT(inserted);
+    ASSERT_NULL(*slot);
+    ASSERT_EQ(anv_hashmap_size(map), 1);
+
+    // The key counts toward the size but reads as absent until a value is written
+    ASSERT(!anv_hashmap_contains_key(map, &keys[0]));
+    *slot = COUNT(1);
+    ASSERT(anv_hashmap_contains_key(map, &keys[0]));
+
+    // The same key gives back the same slot without inserting
+    hash_calls = 0;
+    void** again = anv_hashmap_entry(map, &keys[2], &inserted);
+    ASSERT_EQ(hash_calls, 1);
+    ASSERT(!inserted);
+    ASSERT_EQ_PTR(again, slot);
+
+    // Counting occurrences costs one hash per key
+    anv_hashmap_clear(map, false, false);
+    hash_calls = 0;
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+    {
+        void** count = anv_hashmap_entry(map, &keys[i], NULL);
+        ASSERT_NOT_NULL(count);
+        *count = COUNT((uintptr_t)*count + 1);
+    }
+    ASSERT_EQ(hash_calls, sizeof(keys) / sizeof(keys[0]));
+    ASSERT_EQ(anv_hashmap_size(map), 3);
+    ASSERT_EQ_PTR(anv_hashmap_get(map, &keys[0]), COUNT(3));
+    ASSERT_EQ_PTR(anv_hashmap_get(map, &keys[1]), COUNT(2));
+    ASSERT_EQ_PTR(anv_hashmap_get(map, &keys[3]), COUNT(1));
+
+    inserted = true;
+    ASSERT_NULL(anv_hashmap_entry(map, NULL, &inserted));
+    ASSERT(!inserted);
+    ASSERT_NULL(anv_hashmap_entry(NULL, &keys[0], NULL));
+
+    anv_hashmap_destroy(map, false, false);
+    return TEST_SUCCESS;
+}
+
+// Slots taken before and during a migration stay valid and reach the same node after it
+int test_hashmap_entry_mid_resize(void)
+{
+    ANVAllocator alloc = create_int_allocator();
+    ANVHashMap* map = anv_hashmap_create(&alloc, anv_hash_int, anv_key_equals_int, 4);
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(anv_hashmap_set_incremental_resize(map, true), 0);
+
+    static int keys[400];
+    void** slots[400];
+    int count = 0;
+    while (!map->old_buckets)
+    {
+        keys[count] = count;
+        bool inserted = false;
+        slots[count] = anv_hashmap_entry(map, &keys[count], &inserted);
+        ASSERT_NOT_NULL(slots[count]);
+        ASSERT(inserted);
+        *slots[count] = COUNT(count + 1);
+        count++;
+    }
+
+    // Existing keys are found whether their chain has migrated or not
+    const size_t migrated = map->migrate_index;
+    for (int i = 0; i < count; i++)
+    {
+        bool inserted = true;
+        ASSERT_EQ_PTR(anv_hashmap_entry(map, &keys[i], &inserted), slots[i]);
+        ASSERT(!inserted);
+    }
+    ASSERT(!map->old_buckets || map->migrate_index > migrated);
+
+    // New keys go in mid-migration and the migration runs to completion
+    while (map->old_buckets)
+    {
+        ASSERT(count < 400);
+        keys[count] = count;
+        slots[count] = anv_hashmap_entry(map, &keys[count], NULL);
+        ASSERT_NOT_NULL(slots[count]);
+        *slots[count] = COUNT(count + 1);
+        count++;
+    }
+
+    ASSERT_EQ(anv_hashmap_size(map), (size_t)count);
+    for (int i = 0; i < count; i++)
+    {
+        ASSERT_EQ_PTR(anv_hashmap_get(map, &keys[i]), COUNT(i + 1));
+        *slots[i] = COUNT(i + 2);
+        ASSERT_EQ_PTR(anv_hashmap_get(map, &keys[i]), COUNT(i + 2));
+    }
+
+    anv_hashmap_destroy(map, false, false);
+    return TEST_SUCCESS;
+}
+
+static int compute_calls;
+
+static void* compute_value(const void* key, void* context)
+{
+    (void)key;
+    compute_calls++;
+    return context;
+}
+
+// The produced value is released if the node cannot be allocated
+static void* compute_heap_value(const void* key, void* context)
+{
+    (void)context;
+    compute_calls++;
+    int* value = malloc(sizeof(int));
+    if (value)
+    {
+        *value = *(const int*)key;
+    }
+    return value;
+}
+
+int test_hashmap_compute_if_absent(void)
+{
+    ANVAllocator alloc = create_int_allocator();
+    ANVHashMap* map = anv_hashmap_create(&alloc, counting_hash, anv_key_equals_int, 0);
+    ASSERT_NOT_NULL(map);
+    static int keys[] = {10, 20, 30};
+    static char first[] = "first";
+    static char second[] = "second";
+
+    hash_calls = 0;
+    compute_calls = 0;
+    bool inserted = false;
+    ASSERT_EQ_PTR(anv_hashmap_compute_if_absent(map, &keys[0], compute_value, first, &inserted), first);
+    ASSERT(inserted);
+    ASSERT_EQ(hash_calls, 1);
+    ASSERT_EQ(compute_calls, 1);
+
+    // A present key returns its value without calling compute
+    hash_calls = 0;
+    ASSERT_EQ_PTR(anv_hashmap_compute_if_absent(map, &keys[0], compute_value, second, &inserted), first);
+    ASSERT(!inserted);
+    ASSERT_EQ(hash_calls, 1);
+    ASSERT_EQ(compute_calls, 1);
+
+    // compute returning NULL inserts nothing
+    inserted = true;
+    ASSERT_NULL(anv_hashmap_compute_if_absent(map, &keys[1], compute_value, NULL, &inserted));
+    ASSERT(!inserted);
+    ASSERT_EQ(compute_calls, 2);
+    ASSERT_EQ(anv_hashmap_size(map), 1);
+    ASSERT_NULL(anv_hashmap_get(map, &keys[1]));
+
+    ASSERT_NULL(anv_hashmap_compute_if_absent(map, &keys[1], NULL, first, NULL));
+    ASSERT_NULL(anv_hashmap_compute_if_absent(NULL, &keys[1], compute_value, first, NULL));
+    anv_hashmap_destroy(map, false, false);
+
+    // When the node allocation fails, the computed value is freed and nothing is inserted
+    ANVAllocator failing = create_failing_int_allocator();
+    map = anv_hashmap_create(&failing, anv_hash_int, anv_key_equals_int, 0);
+    ASSERT_NOT_NULL(map);
+    ASSERT_NOT_NULL(anv_hashmap_compute_if_absent(map, &keys[0], compute_heap_value, NULL, NULL));
+
+    compute_calls = 0;
+    set_alloc_fail_countdown(0);
+    inserted = true;
+    ASSERT_NULL(anv_hashmap_compute_if_absent(map, &keys[2], compute_heap_value, NULL, &inserted));
+    ASSERT(!inserted);
+    ASSERT_EQ(compute_calls, 1);
+    ASSERT_EQ(anv_hashmap_size(map), 1);
+    ASSERT_NULL(anv_hashmap_get(map, &keys[2]));
+
+    // A present key needs no allocation
+    const int* existing = anv_hashmap_compute_if_absent(map, &keys[0], compute_heap_value, NULL, &inserted);
+    set_alloc_fail_countdown(-1);
+    ASSERT_NOT_NULL(existing);
+    ASSERT_EQ(*existing, 10);
+    ASSERT(!inserted);
+    ASSERT_EQ(compute_calls, 1);
+
+    anv_hashmap_destroy(map, false, true);
+    return TEST_SUCCESS;
+}
+
+// Adds the counts, and drops the key once its count reaches zero
+static void* add_counts(void* old_value, void* value, void* context)
+{
+    (void)context;
+    return COUNT((uintptr_t)old_value + (uintptr_t)value);
+}
+
+int test_hashmap_merge(void)
+{
+    ANVAllocator alloc = create_int_allocator();
+    ANVHashMap* map = anv_hashmap_create(&alloc, colliding_hash, anv_key_equals_int, 0);
+    ASSERT_NOT_NULL(map);
+    static int keys[] = {0, 1, 2, 3, 4};
+
+    hash_calls = 0;
+    for (int i = 0; i < 5; i++)
+    {
+        ASSERT_EQ(anv_hashmap_merge(map, &keys[i], COUNT(i + 1), add_counts, NULL), 0);
+    }
+    ASSERT_EQ(hash_calls, 5);
+    ASSERT_EQ(anv_hashmap_size(map), 5);
+
+    hash_calls = 0;
+    ASSERT_EQ(anv_hashmap_merge(map, &keys[2], COUNT(10), add_counts, NULL), 0);
+    ASSERT_EQ(hash_calls, 1);
+    ASSERT_EQ_PTR(anv_hashmap_get(map, &keys[2]), COUNT(13));
+    ASSERT_EQ(anv_hashmap_size(map), 5);
+
+    // Merging down to NULL removes the key from the middle of the chain
+    ASSERT_EQ(anv_hashmap_merge(map, &keys[2], COUNT(-13), add_counts, NULL), 0);
+    ASSERT_EQ(anv_hashmap_size(map), 4);
+    ASSERT_NULL(anv_hashmap_get(map, &keys[2]));
+    for (int i = 0; i < 5; i++)
+    {
+        if (i != 2)
+        {
+            ASSERT_EQ_PTR(anv_hashmap_get(map, &keys[i]), COUNT(i + 1));
+        }
+    }
+
+    // Both ends of the chain too
+    ASSERT_EQ(anv_hashmap_merge(map, &keys[0], COUNT(-1), add_counts, NULL), 0);
+    ASSERT_EQ(anv_hashmap_merge(map, &keys[4], COUNT(-5), add_counts, NULL), 0);
+    ASSERT_EQ(anv_hashmap_size(map), 2);
+    ASSERT_EQ_PTR(anv_hashmap_get(map, &keys[1]), COUNT(2));
+    ASSERT_EQ_PTR(anv_hashmap_get(map, &keys[3]), COUNT(4));
+
+    // A removed key merges back in as a fresh insert
+    ASSERT_EQ(anv_hashmap_merge(map, &keys[2], COUNT(7), add_counts, NULL), 0);
+    ASSERT_EQ_PTR(anv_hashmap_get(map, &keys[2]), COUNT(7));
+    ASSERT_EQ(anv_hashmap_size(map), 3);
+
+    ASSERT_EQ(anv_hashmap_merge(map, &keys[2], COUNT(1), NULL, NULL), -1);
+    ASSERT_EQ(anv_hashmap_merge(map, NULL, COUNT(1), add_counts, NULL), -1);
+    ASSERT_EQ(anv_hashmap_merge(NULL, &keys[2], COUNT(1), add_counts, NULL), -1);
+
+    anv_hashmap_destroy(map, false, false);
+    return TEST_SUCCESS;
+}
+
 typedef struct
 {
     int (*func)(void);
@@ -235,6 +570,11 @@ int main(void)
         {test_hashmap_contains, "test_hashmap_contains"},
         {test_hashmap_int_keys, "test_hashmap_int_keys"},
         {test_hashmap_resize, "test_hashmap_resize"},
+        {test_hashmap_incremental_resize, "test_hashmap_incremental_resize"},
+        {test_hashmap_entry, "test_hashmap_entry"},
+        {test_hashmap_entry_mid_resize, "test_hashmap_entry_mid_resize"},
+        {test_hashmap_compute_if_absent, "test_hashmap_compute_if_absent"},
+        {test_hashmap_merge, "test_hashmap_merge"},
     };
 
     printf("Running HashMap CRUD tests...\n");
@@ -120,8 +120,8 @@ int test_hashmap_copy_failure(void)
     set_alloc_fail_countdown(1);
 
     // Temporarily replace allocator for copy test
-    ANVAllocator* orig_alloc = original->alloc;
-    original->alloc = &failing_alloc;
+    ANVAllocator orig_alloc = original->alloc;
+    original->alloc = failing_alloc;
 
     ANVHashMap* copy = anv_hashmap_copy(original);
     ASSERT_NULL(copy); // Should fail
@@ -95,7 +95,7 @@ int test_hashmap_uniqueness_property(void)
     ASSERT_EQ_STR((char*)anv_hashmap_get(map, key), "heap_second");
 
     // Clean up the old value (no memory leak!)
-    anv_alloc_free(&alloc, old_value);
+    anv_alloc_deallocate(&alloc, old_value);
 
     // Clean up remaining value
     char* final_value = (char*)anv_hashmap_get(map, key);
@@ -371,6 +371,60 @@ int test_hashmap_anv_hash_function_property(void)
     return TEST_SUCCESS;
 }
 
+static size_t hash_calls = 0;
+
+static size_t counting_hash(const void* key)
+{
+    hash_calls++;
+    return anv_hash_int(key);
+}
+
+// Each key is hashed once on insert; resizes and copies reuse the stored hash
+int test_hashmap_stored_hash_reuse(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    static int keys[500];
+    for (int i = 0; i < 500; i++)
+    {
+        keys[i] = i * 7919;
+    }
+
+    for (int incremental = 0; incremental < 2; incremental++)
+    {
+        ANVHashMap* map = anv_hashmap_create(&alloc, counting_hash, anv_key_equals_int, 4);
+        ASSERT_NOT_NULL(map);
+        ASSERT_EQ(anv_hashmap_set_incremental_resize(map, incremental != 0), 0);
+        hash_calls = 0;
+
+        const size_t initial_buckets = map->bucket_count;
+        for (int i = 0; i < 500; i++)
+        {
+            ASSERT_EQ(anv_hashmap_put(map, &keys[i], &keys[i]), 0);
+        }
+        ASSERT(map->bucket_count > initial_buckets * 16);
+        ASSERT_EQ(hash_calls, 500);
+
+        ANVHashMap* copy = anv_hashmap_copy(map);
+        ANVHashMap* deep = anv_hashmap_copy_deep(map, int_copy, NULL);
+        ASSERT_NOT_NULL(copy);
+        ASSERT_NOT_NULL(deep);
+        ASSERT_EQ(hash_calls, 500);
+
+        // Lookups in the copies hash the probe key once each and find every key
+        for (int i = 0; i < 500; i++)
+        {
+            ASSERT_EQ_PTR(anv_hashmap_get(copy, &keys[i]), &keys[i]);
+            ASSERT_EQ_PTR(anv_hashmap_get(deep, &keys[i]), &keys[i]);
+        }
+        ASSERT_EQ(hash_calls, 1500);
+
+        anv_hashmap_destroy(copy, false, false);
+        anv_hashmap_destroy(deep, true, false);
+        anv_hashmap_destroy(map, false, false);
+    }
+    return TEST_SUCCESS;
+}
+
 typedef struct
 {
     int (*func)(void);
@@ -388,6 +442,7 @@ int main(void)
         {test_hashmap_contains_property, "test_hashmap_contains_property"},
         {test_hashmap_iterator_completeness, "test_hashmap_iterator_completeness"},
         {test_hashmap_anv_hash_function_property, "test_hashmap_anv_hash_function_property"},
+        {test_hashmap_stored_hash_reuse, "test_hashmap_stored_hash_reuse"},
     };
 
     printf("Running HashMap properties tests...\n");
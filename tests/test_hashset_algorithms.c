@@ -252,6 +252,68 @@ int test_hashset_identical_operations(void)
     return TEST_SUCCESS;
 }
 
+// Set operations see every key while an incremental resize is only partly done
+int test_hashset_operations_mid_resize(void)
+{
+    ANVAllocator alloc = create_int_allocator();
+    static int values[400];
+    for (int i = 0; i < 400; i++)
+    {
+        values[i] = i;
+    }
+
+    // set1 holds 0..299 and is caught mid-migration; set2 holds the multiples of 3
+    ANVHashSet* set1 = anv_hashset_create(&alloc, anv_hash_int, anv_key_equals_int, 16);
+    ANVHashSet* set2 = anv_hashset_create(&alloc, anv_hash_int, anv_key_equals_int, 0);
+    ASSERT_NOT_NULL(set1);
+    ASSERT_NOT_NULL(set2);
+    ASSERT_EQ(anv_hashmap_set_incremental_resize(set1->map, true), 0);
+
+    int added = 0;
+    while (added < 300 || !set1->map->old_buckets)
+    {
+        ASSERT(added < 400);
+        ASSERT_EQ(anv_hashset_add(set1, &values[added++]), 0);
+    }
+    for (int i = 0; i < 400; i += 3)
+    {
+        ASSERT_EQ(anv_hashset_add(set2, &values[i]), 0);
+    }
+    ASSERT_NOT_NULL(set1->map->old_buckets);
+
+    int in_both = 0;
+    for (int i = 0; i < added; i += 3)
+    {
+        in_both++;
+    }
+
+    ANVHashSet* union_set = anv_hashset_union(set1, set2);
+    ANVHashSet* intersection = anv_hashset_intersection(set1, set2);
+    ANVHashSet* difference = anv_hashset_difference(set1, set2);
+    ASSERT_NOT_NULL(union_set);
+    ASSERT_NOT_NULL(intersection);
+    ASSERT_NOT_NULL(difference);
+
+    ASSERT_EQ(anv_hashset_size(union_set), anv_hashset_size(set1) + anv_hashset_size(set2) - (size_t)in_both);
+    ASSERT_EQ(anv_hashset_size(intersection), (size_t)in_both);
+    ASSERT_EQ(anv_hashset_size(difference), (size_t)(added - in_both));
+    for (int i = 0; i < 400; i++)
+    {
+        const bool in1 = i < added;
+        const bool in2 = i % 3 == 0;
+        ASSERT_EQ(anv_hashset_contains(union_set, &values[i]) != 0, in1 || in2);
+        ASSERT_EQ(anv_hashset_contains(intersection, &values[i]) != 0, in1 && in2);
+        ASSERT_EQ(anv_hashset_contains(difference, &values[i]) != 0, in1 && !in2);
+    }
+
+    anv_hashset_destroy(set1, false);
+    anv_hashset_destroy(set2, false);
+    anv_hashset_destroy(union_set, false);
+    anv_hashset_destroy(intersection, false);
+    anv_hashset_destroy(difference, false);
+    return TEST_SUCCESS;
+}
+
 // Main test runner
 typedef struct
 {
@@ -269,6 +331,7 @@ int main(void)
         {test_hashset_empty_operations, "test_hashset_empty_operations"},
         {test_hashset_operations_null_params, "test_hashset_operations_null_params"},
         {test_hashset_identical_operations, "test_hashset_identical_operations"},
+        {test_hashset_operations_mid_resize, "test_hashset_operations_mid_resize"},
     };
 
     printf("Running HashSet Algorithms tests...\n");
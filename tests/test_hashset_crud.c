@@ -236,6 +236,60 @@ typedef struct
     const char* name;
 } TestCase;
 
+// Batched membership checks agree with anv_hashset_contains, including during an incremental resize
+int test_hashset_contains_batch(void)
+{
+    ANVAllocator alloc = create_int_allocator();
+    ANVHashSet* set = anv_hashset_create(&alloc, anv_hash_int, anv_key_equals_int, 8);
+    ASSERT_NOT_NULL(set);
+    ASSERT_EQ(anv_hashmap_set_incremental_resize(set->map, true), 0);
+
+    static int keys[300];
+    for (int i = 0; i < 300; i++)
+    {
+        keys[i] = i;
+    }
+
+    // Multiples of three are members; the set is caught mid-migration
+    int added = 0;
+    while (added < 150 || !set->map->old_buckets)
+    {
+        ASSERT(added < 300);
+        ASSERT_EQ(anv_hashset_add(set, &keys[added]), 0);
+        added += 3;
+    }
+
+    const void* queries[ANV_HASHMAP_BATCH_WINDOW * 2 + 3];
+    bool results[ANV_HASHMAP_BATCH_WINDOW * 2 + 3];
+    const size_t count = sizeof(queries) / sizeof(queries[0]);
+    for (size_t start = 0; start < 300; start += count)
+    {
+        size_t expected = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            queries[i] = i == ANV_HASHMAP_BATCH_WINDOW ? NULL : &keys[(start + i) % 300];
+            results[i] = true;
+        }
+        ASSERT_NOT_NULL(set->map->old_buckets);
+
+        const size_t found = anv_hashset_contains_batch(set, queries, count, results);
+        for (size_t i = 0; i < count; i++)
+        {
+            const bool present = queries[i] && anv_hashset_contains(set, queries[i]);
+            ASSERT_EQ(results[i], present);
+            expected += present;
+        }
+        ASSERT_EQ(found, expected);
+        ASSERT(!results[ANV_HASHMAP_BATCH_WINDOW]);
+    }
+
+    ASSERT_EQ(anv_hashset_contains_batch(NULL, queries, count, results), 0);
+    ASSERT_EQ(anv_hashset_contains_batch(set, queries, 0, results), 0);
+
+    anv_hashset_destroy(set, false);
+    return TEST_SUCCESS;
+}
+
 int main(void)
 {
     const TestCase tests[] = {
@@ -248,6 +302,7 @@ int main(void)
         {test_hashset_clear, "test_hashset_clear"},
         {test_hashset_null_params, "test_hashset_null_params"},
         {test_hashset_invalid_creation, "test_hashset_invalid_creation"},
+        {test_hashset_contains_batch, "test_hashset_contains_batch"},
     };
 
     printf("Running HashSet CRUD tests...\n");
@@ -0,0 +1,219 @@
+//
+// Image tests - round trips of maps and lists, rewriting an image that is
+// still open, and damaged offsets and sizes in images opened without
+// checksum verification
+//
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "io/image.h"
+#include "TestAssert.h"
+
+#define MAP_PATH "anv_test_image_map.bin"
+#define LIST_PATH "anv_test_image_list.bin"
+
+// Header field offsets of format version 2, used to find the tables to damage
+#define HEADER_INDEX_OFFSET 72
+#define HEADER_ENTRIES_OFFSET 80
+
+// Field offsets within a hash map entry
+#define ENTRY_KEY_OFFSET 8
+#define ENTRY_KEY_SIZE 16
+#define ENTRY_VALUE_SIZE 32
+
+static uint64_t read_u64(FILE* file, const long offset)
+{
+    uint64_t value = 0;
+    fseek(file, offset, SEEK_SET);
+    if (fread(&value, sizeof(value), 1, file) != 1)
+    {
+        return 0;
+    }
+    return value;
+}
+
+static void write_u64(FILE* file, const long offset, const uint64_t value)
+{
+    fseek(file, offset, SEEK_SET);
+    fwrite(&value, sizeof(value), 1, file);
+}
+
+int test_image_hashmap_round_trip(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVHashMap* map = anv_hashmap_create(&alloc, anv_hash_string, anv_key_equals_string, 0);
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(anv_hashmap_put(map, "alpha", "one"), 0);
+    ASSERT_EQ(anv_hashmap_put(map, "beta", "two"), 0);
+    ASSERT(ANV_SUCCEEDED(anv_image_write_hashmap(map, MAP_PATH, anv_image_size_string, anv_image_size_string)));
+
+    ANVHashMapImage* image = NULL;
+    ASSERT(ANV_SUCCEEDED(anv_image_open_hashmap(&alloc, MAP_PATH, anv_hash_string, anv_key_equals_string,
+                                                true, &image)));
+    ASSERT_EQ(anv_image_hashmap_size(image), 2);
+    ASSERT_EQ_STR((const char*)anv_image_hashmap_get(image, "alpha"), "one");
+    ASSERT_EQ_STR((const char*)anv_image_hashmap_get(image, "beta"), "two");
+    ASSERT_NULL(anv_image_hashmap_get(image, "gamma"));
+
+    anv_image_hashmap_close(image);
+    anv_hashmap_destroy(map, false, false);
+    remove(MAP_PATH);
+    return TEST_SUCCESS;
+}
+
+// Rewriting the file leaves an image opened on the old one readable
+int test_image_rewrite_while_open(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVHashMap* map = anv_hashmap_create(&alloc, anv_hash_string, anv_key_equals_string, 0);
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(anv_hashmap_put(map, "alpha", "one"), 0);
+    ASSERT_EQ(anv_hashmap_put(map, "beta", "two"), 0);
+    ASSERT(ANV_SUCCEEDED(anv_image_write_hashmap(map, MAP_PATH, anv_image_size_string, anv_image_size_string)));
+
+    ANVHashMapImage* old_image = NULL;
+    ASSERT(ANV_SUCCEEDED(anv_image_open_hashmap(&alloc, MAP_PATH, anv_hash_string, anv_key_equals_string,
+                                                true, &old_image)));
+
+    // The new image is smaller, so writing it in place would cut the old mapping short
+    ASSERT_EQ(anv_hashmap_remove(map, "beta", false, false), 0);
+    ASSERT_EQ(anv_hashmap_put(map, "alpha", "1"), 0);
+    ASSERT(ANV_SUCCEEDED(anv_image_write_hashmap(map, MAP_PATH, anv_image_size_string, anv_image_size_string)));
+    ASSERT_EQ_STR((const char*)anv_image_hashmap_get(old_image, "alpha"), "one");
+    ASSERT_EQ_STR((const char*)anv_image_hashmap_get(old_image, "beta"), "two");
+
+    ANVHashMapImage* new_image = NULL;
+    ASSERT(ANV_SUCCEEDED(anv_image_open_hashmap(&alloc, MAP_PATH, anv_hash_string, anv_key_equals_string,
+                                                true, &new_image)));
+    ASSERT_EQ_STR((const char*)anv_image_hashmap_get(new_image, "alpha"), "1");
+    ASSERT_NULL(anv_image_hashmap_get(new_image, "beta"));
+
+    // The temporary file is gone once it is renamed into place
+    FILE* temp = fopen(MAP_PATH ".tmp", "rb");
+    ASSERT_NULL(temp);
+
+    anv_image_hashmap_close(new_image);
+    anv_image_hashmap_close(old_image);
+    anv_hashmap_destroy(map, false, false);
+    remove(MAP_PATH);
+    return TEST_SUCCESS;
+}
+
+// Write a one-entry map image, then overwrite one field of its entry
+static int write_damaged_map(const long field, const uint64_t value)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVHashMap* map = anv_hashmap_create(&alloc, anv_hash_string, anv_key_equals_string, 0);
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(anv_hashmap_put(map, "alpha", "one"), 0);
+    ASSERT(ANV_SUCCEEDED(anv_image_write_hashmap(map, MAP_PATH, anv_image_size_string, anv_image_size_string)));
+    anv_hashmap_destroy(map, false, false);
+
+    FILE* file = fopen(MAP_PATH, "r+b");
+    ASSERT_NOT_NULL(file);
+    const uint64_t entries = read_u64(file, HEADER_ENTRIES_OFFSET);
+    ASSERT(entries > 0);
+    write_u64(file, (long)entries + field, value);
+    fclose(file);
+    return TEST_SUCCESS;
+}
+
+// Offsets and sizes past the end of the file must not be followed when the checksum is skipped
+int test_image_hashmap_damaged_offsets(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    const long fields[] = {ENTRY_KEY_OFFSET, ENTRY_KEY_SIZE, ENTRY_VALUE_SIZE};
+    const uint64_t values[] = {UINT64_MAX / 2, 4096, UINT64_MAX};
+
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++)
+    {
+        ASSERT_EQ(write_damaged_map(fields[i], values[i]), TEST_SUCCESS);
+
+        ANVHashMapImage* image = NULL;
+        ASSERT_EQ(anv_image_open_hashmap(&alloc, MAP_PATH, anv_hash_string, anv_key_equals_string, true, &image),
+                  ANV_RESULT_INVALID_STATE);
+        ASSERT(ANV_SUCCEEDED(anv_image_open_hashmap(&alloc, MAP_PATH, anv_hash_string, anv_key_equals_string,
+                                                    false, &image)));
+        ASSERT_NULL(anv_image_hashmap_get(image, "alpha"));
+        anv_image_hashmap_close(image);
+    }
+
+    remove(MAP_PATH);
+    return TEST_SUCCESS;
+}
+
+int test_image_arraylist_damaged_offsets(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVArrayList* list = anv_arraylist_create(&alloc, 4);
+    ASSERT_NOT_NULL(list);
+    ASSERT_EQ(anv_arraylist_push_back(list, "first"), 0);
+    ASSERT_EQ(anv_arraylist_push_back(list, "second"), 0);
+    ASSERT(ANV_SUCCEEDED(anv_image_write_arraylist(list, LIST_PATH, anv_image_size_string)));
+
+    FILE* file = fopen(LIST_PATH, "r+b");
+    ASSERT_NOT_NULL(file);
+    const uint64_t table = read_u64(file, HEADER_INDEX_OFFSET);
+    ASSERT(table > 0);
+    write_u64(file, (long)table + 16 + 8, UINT64_MAX); // Second element's size runs off the end
+    fclose(file);
+
+    ANVArrayListImage* image = NULL;
+    ASSERT(ANV_SUCCEEDED(anv_image_open_arraylist(&alloc, LIST_PATH, false, &image)));
+    ASSERT_EQ(anv_image_arraylist_size(image), 2);
+
+    size_t size = 0;
+    ASSERT_EQ_STR((const char*)anv_image_arraylist_get(image, 0, &size), "first");
+    ASSERT_EQ(size, 6);
+    ASSERT_NULL(anv_image_arraylist_get(image, 1, &size));
+    ASSERT_EQ(size, 0);
+
+    anv_image_arraylist_close(image);
+    anv_arraylist_destroy(list, false);
+    remove(LIST_PATH);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_image_hashmap_round_trip, "test_image_hashmap_round_trip"},
+        {test_image_rewrite_while_open, "test_image_rewrite_while_open"},
+        {test_image_hashmap_damaged_offsets, "test_image_hashmap_damaged_offsets"},
+        {test_image_arraylist_damaged_offsets, "test_image_arraylist_damaged_offsets"},
+    };
+
+    printf("Running Image tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll Image tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d Image tests failed.\n", failed);
+    return 1;
+}
@@ -0,0 +1,255 @@
+//
+// Instrument tests - call counters, live and peak bytes, the size histogram,
+// reset, nesting and counting from several threads
+//
+
+#include <stdio.h>
+#include <string.h>
+#include "containers/arraylist.h"
+#include "memory/instrument.h"
+#include "system/thread.h"
+#include "TestAssert.h"
+
+#define COUNTER_THREADS 4
+#define COUNTER_ALLOCATIONS 5000
+
+int test_instrument_counters(void)
+{
+    const ANVAllocator backing = anv_alloc_default();
+    ANVInstrument* instrument = anv_instrument_create(&backing, "counters");
+    ASSERT_NOT_NULL(instrument);
+    ANVAllocator alloc = anv_instrument_allocator(instrument);
+
+    char* a = anv_alloc_allocate(&alloc, 100);
+    char* b = anv_alloc_allocate(&alloc, 200);
+    ASSERT_NOT_NULL(a);
+    ASSERT_NOT_NULL(b);
+    ASSERT_EQ((uintptr_t)a % 16, 0);
+    memcpy(a, "anvil", 6);
+
+    a = anv_alloc_reallocate(&alloc, a, 100, 300);
+    ASSERT_NOT_NULL(a);
+    ASSERT_EQ_STR(a, "anvil");
+    anv_alloc_deallocate(&alloc, b);
+    anv_alloc_deallocate(&alloc, NULL);
+
+    const ANVAllocStats stats = anv_instrument_stats(instrument);
+    ASSERT_EQ_STR(stats.tag, "counters");
+    ASSERT_EQ(stats.allocations, 2);
+    ASSERT_EQ(stats.reallocations, 1);
+    ASSERT_EQ(stats.deallocations, 1);
+    ASSERT_EQ(stats.requested_bytes, 100 + 200 + 300);
+    ASSERT_EQ(stats.live_bytes, 300);
+
+    anv_alloc_deallocate(&alloc, a);
+    ASSERT_EQ(anv_instrument_stats(instrument).live_bytes, 0);
+
+    anv_instrument_destroy(instrument);
+    return TEST_SUCCESS;
+}
+
+// The peak follows live bytes exactly, even while the shard has not flushed
+int test_instrument_peak_between_flushes(void)
+{
+    const ANVAllocator backing = anv_alloc_default();
+    ANVInstrument* instrument = anv_instrument_create(&backing, NULL);
+    ASSERT_NOT_NULL(instrument);
+    ANVAllocator alloc = anv_instrument_allocator(instrument);
+
+    void* a = anv_alloc_allocate(&alloc, 1000);
+    void* b = anv_alloc_allocate(&alloc, 3000);
+    ASSERT_EQ(anv_instrument_stats(instrument).peak_bytes, 4000);
+    anv_alloc_deallocate(&alloc, b);
+    void* c = anv_alloc_allocate(&alloc, 500);
+
+    ANVAllocStats stats = anv_instrument_stats(instrument);
+    ASSERT_EQ(stats.live_bytes, 1500);
+    ASSERT_EQ(stats.peak_bytes, 4000);
+
+    // A flush in the middle neither loses nor double-counts the peak
+    void* big = anv_alloc_allocate(&alloc, ANV_INSTRUMENT_FLUSH_BYTES * 2);
+    ASSERT_EQ(anv_instrument_stats(instrument).peak_bytes, 1500 + ANV_INSTRUMENT_FLUSH_BYTES * 2);
+    anv_alloc_deallocate(&alloc, big);
+    void* d = anv_alloc_allocate(&alloc, 100);
+    stats = anv_instrument_stats(instrument);
+    ASSERT_EQ(stats.live_bytes, 1600);
+    ASSERT_EQ(stats.peak_bytes, 1500 + ANV_INSTRUMENT_FLUSH_BYTES * 2);
+
+    // Reset restarts the peak from what is live now
+    anv_instrument_reset(instrument);
+    stats = anv_instrument_stats(instrument);
+    ASSERT_EQ(stats.allocations, 0);
+    ASSERT_EQ(stats.requested_bytes, 0);
+    ASSERT_EQ(stats.live_bytes, 1600);
+    ASSERT_EQ(stats.peak_bytes, 1600);
+    void* e = anv_alloc_allocate(&alloc, 400);
+    ASSERT_EQ(anv_instrument_stats(instrument).peak_bytes, 2000);
+
+    anv_alloc_deallocate(&alloc, a);
+    anv_alloc_deallocate(&alloc, c);
+    anv_alloc_deallocate(&alloc, d);
+    anv_alloc_deallocate(&alloc, e);
+    anv_instrument_destroy(instrument);
+    return TEST_SUCCESS;
+}
+
+// Bucket 0 holds up to 16 bytes, bucket i holds (8 << i, 16 << i], the last takes the rest
+int test_instrument_histogram(void)
+{
+    const ANVAllocator backing = anv_alloc_default();
+    ANVInstrument* instrument = anv_instrument_create(&backing, NULL);
+    ASSERT_NOT_NULL(instrument);
+    ANVAllocator alloc = anv_instrument_allocator(instrument);
+
+    const size_t last = ANV_INSTRUMENT_HISTOGRAM_BUCKETS - 1;
+    const size_t sizes[] = {1, 16, 17, 32, 33, 4096, (size_t)16 << last, ((size_t)16 << last) + 1};
+    const size_t buckets[] = {0, 0, 1, 1, 2, 8, last, last};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        anv_alloc_deallocate(&alloc, anv_alloc_allocate(&alloc, sizes[i]));
+    }
+
+    // Reallocation counts the new size
+    void* block = anv_alloc_allocate(&alloc, 8);
+    block = anv_alloc_reallocate(&alloc, block, 8, 100);
+    anv_alloc_deallocate(&alloc, block);
+
+    size_t expected[ANV_INSTRUMENT_HISTOGRAM_BUCKETS] = {0};
+    for (size_t i = 0; i < sizeof(buckets) / sizeof(buckets[0]); i++)
+    {
+        expected[buckets[i]]++;
+    }
+    expected[0]++; // 8
+    expected[3]++; // 100
+
+    const ANVAllocStats stats = anv_instrument_stats(instrument);
+    for (size_t b = 0; b < ANV_INSTRUMENT_HISTOGRAM_BUCKETS; b++)
+    {
+        ASSERT_EQ(stats.histogram[b], expected[b]);
+    }
+
+    anv_instrument_destroy(instrument);
+    return TEST_SUCCESS;
+}
+
+// An instrument wrapping another counts its own traffic while the outer one sees the total
+int test_instrument_nested_container(void)
+{
+    const ANVAllocator backing = anv_alloc_default();
+    ANVInstrument* outer = anv_instrument_create(&backing, "total");
+    ASSERT_NOT_NULL(outer);
+    const ANVAllocator outer_alloc = anv_instrument_allocator(outer);
+    ANVInstrument* inner = anv_instrument_create(&outer_alloc, "list");
+    ASSERT_NOT_NULL(inner);
+    ANVAllocator inner_alloc = anv_instrument_allocator(inner);
+
+    ANVArrayList* list = anv_arraylist_create(&inner_alloc, 4);
+    ASSERT_NOT_NULL(list);
+    static int values[100];
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(anv_arraylist_push_back(list, &values[i]), 0);
+    }
+
+    const ANVAllocStats list_stats = anv_instrument_stats(inner);
+    const ANVAllocStats total_stats = anv_instrument_stats(outer);
+    ASSERT(list_stats.reallocations > 0);
+    ASSERT(list_stats.live_bytes >= 100 * sizeof(void*));
+    ASSERT(total_stats.live_bytes > list_stats.live_bytes); // Includes the inner instrument itself
+
+    anv_arraylist_destroy(list, false);
+    ASSERT_EQ(anv_instrument_stats(inner).live_bytes, 0);
+    anv_instrument_destroy(inner);
+    ASSERT_EQ(anv_instrument_stats(outer).live_bytes, 0);
+    anv_instrument_destroy(outer);
+
+    ASSERT_NULL(anv_instrument_create(NULL, NULL));
+    ASSERT_NULL(anv_instrument_stats(NULL).tag);
+    anv_instrument_reset(NULL);
+    anv_instrument_destroy(NULL);
+    return TEST_SUCCESS;
+}
+
+static void* count_thread(void* arg)
+{
+    const ANVAllocator* alloc = arg;
+    for (int i = 0; i < COUNTER_ALLOCATIONS; i++)
+    {
+        anv_alloc_deallocate(alloc, anv_alloc_allocate(alloc, 64));
+    }
+    return NULL;
+}
+
+// Counters sharded across threads add up, and the live total settles back to zero
+int test_instrument_threads(void)
+{
+    const ANVAllocator backing = anv_alloc_default();
+    ANVInstrument* instrument = anv_instrument_create(&backing, NULL);
+    ASSERT_NOT_NULL(instrument);
+    ANVAllocator alloc = anv_instrument_allocator(instrument);
+
+    ANVThread threads[COUNTER_THREADS];
+    for (int t = 0; t < COUNTER_THREADS; t++)
+    {
+        ASSERT_EQ(anv_thread_create(&threads[t], count_thread, &alloc), 0);
+    }
+    for (int t = 0; t < COUNTER_THREADS; t++)
+    {
+        anv_thread_join(threads[t], NULL);
+    }
+
+    const ANVAllocStats stats = anv_instrument_stats(instrument);
+    ASSERT_EQ(stats.allocations, COUNTER_THREADS * COUNTER_ALLOCATIONS);
+    ASSERT_EQ(stats.deallocations, COUNTER_THREADS * COUNTER_ALLOCATIONS);
+    ASSERT_EQ(stats.requested_bytes, (size_t)COUNTER_THREADS * COUNTER_ALLOCATIONS * 64);
+    ASSERT_EQ(stats.live_bytes, 0);
+    ASSERT(stats.peak_bytes >= 64);
+    ASSERT(stats.peak_bytes <= COUNTER_THREADS * 64);
+
+    anv_instrument_destroy(instrument);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_instrument_counters, "test_instrument_counters"},
+        {test_instrument_peak_between_flushes, "test_instrument_peak_between_flushes"},
+        {test_instrument_histogram, "test_instrument_histogram"},
+        {test_instrument_nested_container, "test_instrument_nested_container"},
+        {test_instrument_threads, "test_instrument_threads"},
+    };
+
+    printf("Running Instrument tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll Instrument tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d Instrument tests failed.\n", failed);
+    return 1;
+}
@@ -0,0 +1,449 @@
+//
+// Int set tests - Robin Hood placement and backward-shift removal on keys
+// chosen for their home slots, wraparound, growth at the load limit and set
+// algebra on small explicit sets
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "algorithms/hash.h"
+#include "containers/intset.h"
+#include "TestAssert.h"
+
+static size_t home_of(const ANVIntSet* set, const uint64_t key)
+{
+    return (size_t)anv_hash_mix64(key ^ set->seed) & (set->capacity - 1);
+}
+
+// The first key at or after *next whose home slot in 'set' is 'home'
+static uint64_t key_with_home(const ANVIntSet* set, const size_t home, uint64_t* next)
+{
+    while (home_of(set, *next) != home)
+    {
+        (*next)++;
+    }
+    return (*next)++;
+}
+
+/**
+ * Every key must sit at its recorded distance from its home slot, and
+ * backward-shift deletion must leave no key displaced past an empty slot.
+ */
+static int check_layout(const ANVIntSet* set)
+{
+    const size_t mask = set->capacity - 1;
+    size_t count = 0;
+    for (size_t i = 0; i < set->capacity; i++)
+    {
+        const uint8_t distance = set->distances[i];
+        const uint8_t next = set->distances[(i + 1) & mask];
+        if (distance == 0)
+        {
+            ASSERT(next <= 1);
+            continue;
+        }
+
+        ASSERT_EQ((i - home_of(set, set->keys[i])) & mask, (size_t)distance - 1);
+        ASSERT(next <= distance + 1);
+        count++;
+    }
+    ASSERT_EQ(count, set->size);
+    return TEST_SUCCESS;
+}
+
+static int check_slot(const ANVIntSet* set, const size_t slot, const uint64_t key, const uint8_t distance)
+{
+    ASSERT_EQ(set->distances[slot], distance);
+    ASSERT_EQ(set->keys[slot], key);
+    return TEST_SUCCESS;
+}
+
+// Holds exactly the listed keys
+static int check_contents(const ANVIntSet* set, const uint64_t* keys, const size_t count)
+{
+    ASSERT_EQ(anv_intset_size(set), count);
+    for (size_t i = 0; i < count; i++)
+    {
+        ASSERT(anv_intset_contains(set, keys[i]));
+    }
+    return check_layout(set);
+}
+
+int test_intset_add_contains_remove(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVIntSet* set = anv_intset_create(&alloc, 0);
+    ASSERT_NOT_NULL(set);
+    ASSERT(anv_intset_is_empty(set));
+
+    const uint64_t keys[] = {0, 1, 42, UINT64_MAX};
+    for (size_t i = 0; i < 4; i++)
+    {
+        bool added = false;
+        ASSERT_EQ(anv_intset_add_check(set, keys[i], &added), 0);
+        ASSERT(added);
+    }
+
+    // Adding a key already present changes nothing
+    bool added = true;
+    ASSERT_EQ(anv_intset_add_check(set, 42, &added), 0);
+    ASSERT(!added);
+    ASSERT_EQ(anv_intset_add(set, 0), 0);
+    ASSERT_EQ(check_contents(set, keys, 4), TEST_SUCCESS);
+    ASSERT(!anv_intset_contains(set, 2));
+    ASSERT(!anv_intset_contains(set, UINT64_MAX - 1));
+
+    ASSERT_EQ(anv_intset_remove(set, 42), 0);
+    ASSERT_EQ(anv_intset_remove(set, 42), -1);
+    ASSERT_EQ(anv_intset_remove(set, 7), -1);
+    ASSERT(!anv_intset_contains(set, 42));
+    ASSERT_EQ(anv_intset_remove(set, UINT64_MAX), 0);
+    ASSERT_EQ(anv_intset_remove(set, 0), 0);
+    ASSERT_EQ(anv_intset_size(set), 1);
+    ASSERT(anv_intset_contains(set, 1));
+
+    anv_intset_clear(set);
+    ASSERT(anv_intset_is_empty(set));
+    ASSERT(!anv_intset_contains(set, 1));
+    ASSERT_EQ(anv_intset_add(set, 1), 0);
+    ASSERT(anv_intset_contains(set, 1));
+
+    ASSERT_EQ(anv_intset_add(NULL, 1), -1);
+    ASSERT_EQ(anv_intset_remove(NULL, 1), -1);
+    ASSERT(!anv_intset_contains(NULL, 1));
+    ASSERT_NULL(anv_intset_create(NULL, 0));
+
+    anv_intset_destroy(set);
+    return TEST_SUCCESS;
+}
+
+// A key takes the slot of any key closer to home, pushing the rest of the run along
+int test_intset_robin_hood_insert(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVIntSet* set = anv_intset_create(&alloc, 1);
+    ASSERT_NOT_NULL(set);
+    ASSERT_EQ(set->capacity, 8);
+
+    uint64_t next = 0;
+    const uint64_t a = key_with_home(set, 2, &next);
+    const uint64_t b = key_with_home(set, 2, &next);
+    const uint64_t c = key_with_home(set, 3, &next);
+    const uint64_t d = key_with_home(set, 4, &next);
+
+    ASSERT_EQ(anv_intset_add(set, a), 0);
+    ASSERT_EQ(anv_intset_add(set, c), 0);
+    ASSERT_EQ(check_slot(set, 2, a, 1), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(set, 3, c, 1), TEST_SUCCESS);
+
+    // b ties with a at slot 2, then displaces c, which sits at its home
+    ASSERT_EQ(anv_intset_add(set, b), 0);
+    ASSERT_EQ(check_slot(set, 2, a, 1), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(set, 3, b, 2), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(set, 4, c, 2), TEST_SUCCESS);
+
+    // d's home is taken by c, which is further from home, so d goes past it
+    ASSERT_EQ(anv_intset_add(set, d), 0);
+    ASSERT_EQ(check_slot(set, 4, c, 2), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(set, 5, d, 2), TEST_SUCCESS);
+    ASSERT_EQ(set->distances[6], 0);
+
+    // A lookup for an absent key from the same home stops at the end of the run
+    const uint64_t missing = key_with_home(set, 2, &next);
+    ASSERT(!anv_intset_contains(set, missing));
+
+    const uint64_t keys[] = {a, b, c, d};
+    ASSERT_EQ(check_contents(set, keys, 4), TEST_SUCCESS);
+
+    anv_intset_destroy(set);
+    return TEST_SUCCESS;
+}
+
+// Removal pulls the rest of the run back until a key at home or an empty slot
+int test_intset_backward_shift(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVIntSet* set = anv_intset_create(&alloc, 1);
+    ASSERT_NOT_NULL(set);
+
+    uint64_t next = 0;
+    const uint64_t a = key_with_home(set, 2, &next);
+    const uint64_t b = key_with_home(set, 2, &next);
+    const uint64_t c = key_with_home(set, 3, &next);
+    const uint64_t d = key_with_home(set, 4, &next);
+    const uint64_t e = key_with_home(set, 6, &next);
+    const uint64_t keys[] = {a, b, c, d, e};
+    for (size_t i = 0; i < 5; i++)
+    {
+        ASSERT_EQ(anv_intset_add(set, keys[i]), 0);
+    }
+    // Slots 2..6 hold a b c d e, with e at home right after the run
+    ASSERT_EQ(check_slot(set, 5, d, 2), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(set, 6, e, 1), TEST_SUCCESS);
+
+    // Removing a key that is absent moves nothing
+    ASSERT_EQ(anv_intset_remove(set, key_with_home(set, 3, &next)), -1);
+    ASSERT_EQ(check_slot(set, 3, b, 2), TEST_SUCCESS);
+
+    // Every displaced key moves one slot back, and e stays at home
+    ASSERT_EQ(anv_intset_remove(set, a), 0);
+    ASSERT_EQ(check_slot(set, 2, b, 1), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(set, 3, c, 1), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(set, 4, d, 1), TEST_SUCCESS);
+    ASSERT_EQ(set->distances[5], 0);
+    ASSERT_EQ(check_slot(set, 6, e, 1), TEST_SUCCESS);
+    ASSERT_EQ(check_contents(set, keys + 1, 4), TEST_SUCCESS);
+
+    // A key followed by one at home leaves a hole and shifts nothing
+    ASSERT_EQ(anv_intset_remove(set, c), 0);
+    ASSERT_EQ(set->distances[3], 0);
+    ASSERT_EQ(check_slot(set, 2, b, 1), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(set, 4, d, 1), TEST_SUCCESS);
+    ASSERT_EQ(anv_intset_size(set), 3);
+    ASSERT(!anv_intset_contains(set, a));
+    ASSERT(!anv_intset_contains(set, c));
+    ASSERT_EQ(check_layout(set), TEST_SUCCESS);
+
+    anv_intset_destroy(set);
+    return TEST_SUCCESS;
+}
+
+// Runs continue from the last slot to the first, for both inserts and removals
+int test_intset_wraparound(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVIntSet* set = anv_intset_create(&alloc, 1);
+    ASSERT_NOT_NULL(set);
+    const size_t last = set->capacity - 1;
+
+    uint64_t next = 0;
+    const uint64_t a = key_with_home(set, last, &next);
+    const uint64_t b = key_with_home(set, last, &next);
+    const uint64_t c = key_with_home(set, 0, &next);
+    ASSERT_EQ(anv_intset_add(set, a), 0);
+    ASSERT_EQ(anv_intset_add(set, c), 0);
+    ASSERT_EQ(anv_intset_add(set, b), 0);
+    ASSERT_EQ(check_slot(set, last, a, 1), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(set, 0, b, 2), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(set, 1, c, 2), TEST_SUCCESS);
+    const uint64_t keys[] = {a, b, c};
+    ASSERT_EQ(check_contents(set, keys, 3), TEST_SUCCESS);
+
+    ASSERT_EQ(anv_intset_remove(set, a), 0);
+    ASSERT_EQ(check_slot(set, last, b, 1), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(set, 0, c, 1), TEST_SUCCESS);
+    ASSERT_EQ(set->distances[1], 0);
+    ASSERT_EQ(check_contents(set, keys + 1, 2), TEST_SUCCESS);
+
+    anv_intset_destroy(set);
+    return TEST_SUCCESS;
+}
+
+// The table doubles when an add would pass 7/8 load, and reserve sizes it up front
+int test_intset_growth_and_reserve(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVIntSet* set = anv_intset_create(&alloc, 0);
+    ASSERT_NOT_NULL(set);
+    const size_t capacity = set->capacity;
+    const size_t limit = capacity - capacity / 8;
+
+    for (uint64_t key = 0; key < limit; key++)
+    {
+        ASSERT_EQ(anv_intset_add(set, key * 1000003), 0);
+    }
+    ASSERT_EQ(set->capacity, capacity);
+    ASSERT(anv_intset_load_factor(set) == (double)limit / (double)capacity);
+
+    // Adding a duplicate at the limit does not grow the table
+    ASSERT_EQ(anv_intset_add(set, 0), 0);
+    ASSERT_EQ(set->capacity, capacity);
+
+    ASSERT_EQ(anv_intset_add(set, limit * 1000003), 0);
+    ASSERT_EQ(set->capacity, capacity * 2);
+    ASSERT_EQ(anv_intset_size(set), limit + 1);
+    for (uint64_t key = 0; key <= limit; key++)
+    {
+        ASSERT(anv_intset_contains(set, key * 1000003));
+    }
+    ASSERT_EQ(check_layout(set), TEST_SUCCESS);
+
+    // 1000 keys do not fit in 1024 slots at 7/8 load, so reserve takes 2048
+    ASSERT_EQ(anv_intset_reserve(set, 1000), 0);
+    ASSERT_EQ(set->capacity, 2048);
+    ASSERT_EQ(anv_intset_size(set), limit + 1);
+    ASSERT_EQ(check_layout(set), TEST_SUCCESS);
+    for (uint64_t key = 0; key < 1000; key++)
+    {
+        ASSERT_EQ(anv_intset_add(set, key * 1000003), 0);
+    }
+    ASSERT_EQ(set->capacity, 2048);
+
+    // Reserving less than the table holds is a no-op
+    ASSERT_EQ(anv_intset_reserve(set, 10), 0);
+    ASSERT_EQ(set->capacity, 2048);
+    ASSERT_EQ(anv_intset_reserve(NULL, 10), -1);
+
+    anv_intset_destroy(set);
+    return TEST_SUCCESS;
+}
+
+// Fill a table to its load limit, then empty it in an order unrelated to insertion
+int test_intset_drain_full_table(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVIntSet* set = anv_intset_create(&alloc, 1000);
+    ASSERT_NOT_NULL(set);
+    const size_t capacity = set->capacity;
+    const size_t count = capacity - capacity / 8;
+
+    for (uint64_t key = 0; key < count; key++)
+    {
+        ASSERT_EQ(anv_intset_add(set, key), 0);
+    }
+    ASSERT_EQ(set->capacity, capacity);
+    ASSERT_EQ(check_layout(set), TEST_SUCCESS);
+
+    // 5 is coprime with count (1792), so the stride visits every key once
+    ASSERT(count % 5 != 0);
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint64_t key = (uint64_t)(i * 5 % count);
+        ASSERT_EQ(anv_intset_remove(set, key), 0);
+        ASSERT(!anv_intset_contains(set, key));
+        ASSERT_EQ(check_layout(set), TEST_SUCCESS);
+        if (i + 1 < count)
+        {
+            ASSERT(anv_intset_contains(set, (uint64_t)((i + 1) * 5 % count)));
+        }
+    }
+    ASSERT(anv_intset_is_empty(set));
+
+    anv_intset_destroy(set);
+    return TEST_SUCCESS;
+}
+
+static ANVIntSet* set_of(ANVAllocator* alloc, const uint64_t* keys, const size_t count)
+{
+    ANVIntSet* set = anv_intset_create(alloc, 0);
+    for (size_t i = 0; set && i < count; i++)
+    {
+        if (anv_intset_add(set, keys[i]) != 0)
+        {
+            anv_intset_destroy(set);
+            return NULL;
+        }
+    }
+    return set;
+}
+
+int test_intset_set_algebra(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    const uint64_t a_keys[] = {1, 2, 3, 4, UINT64_MAX};
+    const uint64_t b_keys[] = {3, 4, 5, UINT64_MAX};
+    ANVIntSet* a = set_of(&alloc, a_keys, 5);
+    ANVIntSet* b = set_of(&alloc, b_keys, 4);
+    ANVIntSet* empty = anv_intset_create(&alloc, 0);
+    ASSERT_NOT_NULL(a);
+    ASSERT_NOT_NULL(b);
+    ASSERT_NOT_NULL(empty);
+
+    ANVIntSet* both = anv_intset_union(a, b);
+    ANVIntSet* common = anv_intset_intersection(a, b);
+    ANVIntSet* only_a = anv_intset_difference(a, b);
+    ANVIntSet* only_b = anv_intset_difference(b, a);
+    ASSERT_NOT_NULL(both);
+    ASSERT_NOT_NULL(common);
+    ASSERT_NOT_NULL(only_a);
+    ASSERT_NOT_NULL(only_b);
+
+    const uint64_t both_keys[] = {1, 2, 3, 4, 5, UINT64_MAX};
+    const uint64_t common_keys[] = {3, 4, UINT64_MAX};
+    const uint64_t only_a_keys[] = {1, 2};
+    const uint64_t only_b_keys[] = {5};
+    ASSERT_EQ(check_contents(both, both_keys, 6), TEST_SUCCESS);
+    ASSERT_EQ(check_contents(common, common_keys, 3), TEST_SUCCESS);
+    ASSERT_EQ(check_contents(only_a, only_a_keys, 2), TEST_SUCCESS);
+    ASSERT_EQ(check_contents(only_b, only_b_keys, 1), TEST_SUCCESS);
+
+    ASSERT_EQ(anv_intset_is_subset(a, b), 0);
+    ASSERT_EQ(anv_intset_is_subset(common, a), 1);
+    ASSERT_EQ(anv_intset_is_subset(common, b), 1);
+    ASSERT_EQ(anv_intset_is_subset(a, both), 1);
+    ASSERT_EQ(anv_intset_is_subset(a, a), 1);
+
+    // The empty set is a subset of everything and the identity for union
+    ASSERT_EQ(anv_intset_is_subset(empty, a), 1);
+    ASSERT_EQ(anv_intset_is_subset(a, empty), 0);
+    ANVIntSet* same = anv_intset_union(a, empty);
+    ANVIntSet* none = anv_intset_intersection(a, empty);
+    ANVIntSet* all = anv_intset_difference(a, empty);
+    ASSERT_NOT_NULL(same);
+    ASSERT_NOT_NULL(none);
+    ASSERT_NOT_NULL(all);
+    ASSERT_EQ(check_contents(same, a_keys, 5), TEST_SUCCESS);
+    ASSERT(anv_intset_is_empty(none));
+    ASSERT_EQ(check_contents(all, a_keys, 5), TEST_SUCCESS);
+
+    ASSERT_NULL(anv_intset_union(a, NULL));
+    ASSERT_NULL(anv_intset_intersection(NULL, b));
+
+    anv_intset_destroy(all);
+    anv_intset_destroy(none);
+    anv_intset_destroy(same);
+    anv_intset_destroy(only_b);
+    anv_intset_destroy(only_a);
+    anv_intset_destroy(common);
+    anv_intset_destroy(both);
+    anv_intset_destroy(empty);
+    anv_intset_destroy(b);
+    anv_intset_destroy(a);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_intset_add_contains_remove, "test_intset_add_contains_remove"},
+        {test_intset_robin_hood_insert, "test_intset_robin_hood_insert"},
+        {test_intset_backward_shift, "test_intset_backward_shift"},
+        {test_intset_wraparound, "test_intset_wraparound"},
+        {test_intset_growth_and_reserve, "test_intset_growth_and_reserve"},
+        {test_intset_drain_full_table, "test_intset_drain_full_table"},
+        {test_intset_set_algebra, "test_intset_set_algebra"},
+    };
+
+    printf("Running IntSet tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll IntSet tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d IntSet tests failed.\n", failed);
+    return 1;
+}
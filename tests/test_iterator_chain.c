@@ -61,8 +61,8 @@ static int test_chain_basic_functionality(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create two range iterators to chain
-    const ANVIterator range1 = anv_iterator_range(1, 4, 1, &alloc);   // [1,2,3]
-    const ANVIterator range2 = anv_iterator_range(10, 13, 1, &alloc); // [10,11,12]
+    const ANVIterator range1 = anv_iterator_range(&alloc, 1, 4, 1);   // [1,2,3]
+    const ANVIterator range2 = anv_iterator_range(&alloc, 10, 13, 1); // [10,11,12]
 
     // Create array of iterators to chain
     ANVIterator iterators[] = {range1, range2};
@@ -87,7 +87,7 @@ static int test_chain_single_iterator(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Chain a single iterator
-    const ANVIterator range1 = anv_iterator_range(5, 8, 1, &alloc); // [5,6,7]
+    const ANVIterator range1 = anv_iterator_range(&alloc, 5, 8, 1); // [5,6,7]
 
     ANVIterator iterators[] = {range1};
     ANVIterator chain_it = anv_iterator_chain(iterators, 1, &alloc);
@@ -110,8 +110,8 @@ static int test_chain_empty_iterators(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create empty range iterators (start == end)
-    const ANVIterator range1 = anv_iterator_range(5, 5, 1, &alloc); // empty
-    const ANVIterator range2 = anv_iterator_range(10, 10, 1, &alloc); // empty
+    const ANVIterator range1 = anv_iterator_range(&alloc, 5, 5, 1); // empty
+    const ANVIterator range2 = anv_iterator_range(&alloc, 10, 10, 1); // empty
 
     ANVIterator iterators[] = {range1, range2};
     ANVIterator chain_it = anv_iterator_chain(iterators, 2, &alloc);
@@ -129,10 +129,10 @@ static int test_chain_mixed_empty_and_non_empty(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Mix empty and non-empty iterators
-    const ANVIterator range1 = anv_iterator_range(1, 1, 1, &alloc);   // empty
-    const ANVIterator range2 = anv_iterator_range(5, 7, 1, &alloc);   // [5,6]
-    const ANVIterator range3 = anv_iterator_range(10, 10, 1, &alloc); // empty
-    const ANVIterator range4 = anv_iterator_range(20, 22, 1, &alloc); // [20,21]
+    const ANVIterator range1 = anv_iterator_range(&alloc, 1, 1, 1);   // empty
+    const ANVIterator range2 = anv_iterator_range(&alloc, 5, 7, 1);   // [5,6]
+    const ANVIterator range3 = anv_iterator_range(&alloc, 10, 10, 1); // empty
+    const ANVIterator range4 = anv_iterator_range(&alloc, 20, 22, 1); // [20,21]
 
     ANVIterator iterators[] = {range1, range2, range3, range4};
     ANVIterator chain_it = anv_iterator_chain(iterators, 4, &alloc);
@@ -155,10 +155,10 @@ static int test_chain_multiple_iterators(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Chain multiple range iterators
-    const ANVIterator range1 = anv_iterator_range(1, 3, 1, &alloc);   // [1,2]
-    const ANVIterator range2 = anv_iterator_range(10, 12, 1, &alloc); // [10,11]
-    const ANVIterator range3 = anv_iterator_range(20, 22, 1, &alloc); // [20,21]
-    const ANVIterator range4 = anv_iterator_range(30, 32, 1, &alloc); // [30,31]
+    const ANVIterator range1 = anv_iterator_range(&alloc, 1, 3, 1);   // [1,2]
+    const ANVIterator range2 = anv_iterator_range(&alloc, 10, 12, 1); // [10,11]
+    const ANVIterator range3 = anv_iterator_range(&alloc, 20, 22, 1); // [20,21]
+    const ANVIterator range4 = anv_iterator_range(&alloc, 30, 32, 1); // [30,31]
 
     ANVIterator iterators[] = {range1, range2, range3, range4};
     ANVIterator chain_it = anv_iterator_chain(iterators, 4, &alloc);
@@ -212,8 +212,8 @@ static int test_chain_with_take_skip_iterators(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create base range and apply take/skip to different copies
-    ANVIterator range1 = anv_iterator_range(1, 10, 1, &alloc); // [1,2,3,4,5,6,7,8,9]
-    ANVIterator range2 = anv_iterator_range(1, 10, 1, &alloc); // [1,2,3,4,5,6,7,8,9]
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 10, 1); // [1,2,3,4,5,6,7,8,9]
+    ANVIterator range2 = anv_iterator_range(&alloc, 1, 10, 1); // [1,2,3,4,5,6,7,8,9]
 
     const ANVIterator take_it = anv_iterator_take(&range1, &alloc, 3);    // [1,2,3]
     const ANVIterator skip_it = anv_iterator_skip(&range2, &alloc, 6);    // [7,8,9]
@@ -247,7 +247,7 @@ static int test_chain_invalid_parameters(void)
     ASSERT_FALSE(chain_it1.is_valid(&chain_it1));
 
     // Test with zero count
-    ANVIterator range = anv_iterator_range(1, 3, 1, &alloc);
+    ANVIterator range = anv_iterator_range(&alloc, 1, 3, 1);
     ANVIterator iterators[] = {range};
     const ANVIterator chain_it2 = anv_iterator_chain(iterators, 0, &alloc);
     ASSERT_FALSE(chain_it2.is_valid(&chain_it2));
@@ -266,8 +266,8 @@ static int test_chain_iterator_operations(void)
 {
     const ANVAllocator alloc = create_int_allocator();
 
-    const ANVIterator range1 = anv_iterator_range(1, 3, 1, &alloc); // [1,2]
-    const ANVIterator range2 = anv_iterator_range(10, 12, 1, &alloc); // [10,11]
+    const ANVIterator range1 = anv_iterator_range(&alloc, 1, 3, 1); // [1,2]
+    const ANVIterator range2 = anv_iterator_range(&alloc, 10, 12, 1); // [10,11]
 
     ANVIterator iterators[] = {range1, range2};
     ANVIterator chain_it = anv_iterator_chain(iterators, 2, &alloc);
@@ -321,14 +321,14 @@ static int test_chain_with_nested_chains(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create first chain: [1,2] + [10,11]
-    const ANVIterator range1 = anv_iterator_range(1, 3, 1, &alloc);
-    const ANVIterator range2 = anv_iterator_range(10, 12, 1, &alloc);
+    const ANVIterator range1 = anv_iterator_range(&alloc, 1, 3, 1);
+    const ANVIterator range2 = anv_iterator_range(&alloc, 10, 12, 1);
     ANVIterator iterators1[] = {range1, range2};
     const ANVIterator chain1 = anv_iterator_chain(iterators1, 2, &alloc);
 
     // Create second chain: [20,21] + [30,31]
-    const ANVIterator range3 = anv_iterator_range(20, 22, 1, &alloc);
-    const ANVIterator range4 = anv_iterator_range(30, 32, 1, &alloc);
+    const ANVIterator range3 = anv_iterator_range(&alloc, 20, 22, 1);
+    const ANVIterator range4 = anv_iterator_range(&alloc, 30, 32, 1);
     ANVIterator iterators2[] = {range3, range4};
     const ANVIterator chain2 = anv_iterator_chain(iterators2, 2, &alloc);
 
@@ -606,7 +606,7 @@ static int test_chain_with_zip_and_data_structures(void)
     const ANVIterator zipped = anv_iterator_zip(&filtered_arraylist, &taken_sll, &alloc); // [(1,10),(3,20)]
 
     // Create a simple range for chaining
-    const ANVIterator range_it = anv_iterator_range(100, 103, 1, &alloc); // [100,101,102]
+    const ANVIterator range_it = anv_iterator_range(&alloc, 100, 103, 1); // [100,101,102]
 
     // Chain zip result with range
     ANVIterator iterators[] = {zipped, range_it};
@@ -669,7 +669,7 @@ static int test_chain_data_structure_round_trip(void)
     }
 
     // Create range iterator
-    const ANVIterator range_it = anv_iterator_range(100, 103, 1, &alloc); // [100, 101, 102]
+    const ANVIterator range_it = anv_iterator_range(&alloc, 100, 103, 1); // [100, 101, 102]
 
     // Get iterator from ArrayList and apply transformation
     ANVIterator list_it = anv_arraylist_iterator(original_list);
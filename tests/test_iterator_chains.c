@@ -88,7 +88,7 @@ static int test_range_filter_even(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range [1, 2, 3, 4, 5, 6, 7, 8, 9, 10]
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
     ASSERT_TRUE(range_it.is_valid(&range_it));
 
     // Chain with even filter
@@ -115,7 +115,7 @@ static int test_range_step_filter_div3(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range [2, 5, 8, 11, 14, 17, 20]
-    ANVIterator range_it = anv_iterator_range(2, 21, 3, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 2, 21, 3);
     ASSERT_TRUE(range_it.is_valid(&range_it));
 
     // Chain with divisible by 3 filter
@@ -138,7 +138,7 @@ static int test_range_filter_greater_than_5(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range [1, 2, 3, 4, 5, 6, 7, 8]
-    ANVIterator range_it = anv_iterator_range(1, 9, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 9, 1);
 
     // Chain with greater than 5 filter
     ANVIterator filter_it = anv_iterator_filter(&range_it, &alloc, is_greater_than_five);
@@ -167,7 +167,7 @@ static int test_range_transform_double(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range [1, 2, 3, 4, 5]
-    ANVIterator range_it = anv_iterator_range(1, 6, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 6, 1);
 
     // Chain with double transform
     ANVIterator transform_it = anv_iterator_transform(&range_it, &alloc, double_value, true);
@@ -192,7 +192,7 @@ static int test_range_transform_square(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range [2, 4, 6]
-    ANVIterator range_it = anv_iterator_range(2, 7, 2, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 2, 7, 2);
 
     // Chain with square transform
     ANVIterator transform_it = anv_iterator_transform(&range_it, &alloc, square_func, true);
@@ -217,7 +217,7 @@ static int test_range_transform_add_ten(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range [1, 2, 3, 4]
-    ANVIterator range_it = anv_iterator_range(1, 5, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 5, 1);
 
     // Chain with add_ten transform
     ANVIterator transform_it = anv_iterator_transform(&range_it, &alloc, add_ten_func, true);
@@ -427,7 +427,7 @@ static int test_range_filter_transform_chain(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range [1, 2, 3, 4, 5, 6, 7, 8, 9, 10]
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     // Chain: range → filter even → transform square
     ANVIterator filter_it = anv_iterator_filter(&range_it, &alloc, is_even);
@@ -453,7 +453,7 @@ static int test_range_transform_filter_chain(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range [1, 2, 3, 4, 5, 6, 7, 8]
-    ANVIterator range_it = anv_iterator_range(1, 9, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 9, 1);
 
     // Chain: range → transform add_ten → filter divisible by 3
     ANVIterator transform_it = anv_iterator_transform(&range_it, &alloc, add_ten_func, true);
@@ -479,7 +479,7 @@ static int test_range_filter_transform_filter_chain(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range [1, 2, 3, 4, 5, 6, 7, 8, 9, 10]
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     // Chain: range → filter odd → transform square → filter > 20
     ANVIterator filter_odd = anv_iterator_filter(&range_it, &alloc, is_odd);
@@ -506,7 +506,7 @@ static int test_range_transform_transform_filter_chain(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range [1, 2, 3, 4]
-    ANVIterator range_it = anv_iterator_range(1, 5, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 5, 1);
 
     // Chain: range → transform double → transform add_five → filter > 10
     ANVIterator transform_double = anv_iterator_transform(&range_it, &alloc, double_value, true);
@@ -533,7 +533,7 @@ static int test_deep_nested_chain(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range [1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12]
-    ANVIterator range_it = anv_iterator_range(1, 13, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 13, 1);
 
     // Chain: range → filter even → transform add_one → filter divisible by 3 → transform square
     ANVIterator filter_even = anv_iterator_filter(&range_it, &alloc, is_even);
@@ -565,7 +565,7 @@ static int test_empty_chain_propagation(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range with only odd numbers, then filter for even
-    ANVIterator range_it = anv_iterator_range(1, 10, 2, &alloc); // [1,3,5,7,9]
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 10, 2); // [1,3,5,7,9]
 
     // Chain: range (odd) → filter even → transform double
     ANVIterator filter_it = anv_iterator_filter(&range_it, &alloc, is_even);
@@ -588,7 +588,7 @@ static int test_single_element_chain(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range with single element
-    ANVIterator range_it = anv_iterator_range(4, 5, 1, &alloc); // [4]
+    ANVIterator range_it = anv_iterator_range(&alloc, 4, 5, 1); // [4]
 
     // Chain: range → filter even → transform square
     ANVIterator filter_it = anv_iterator_filter(&range_it, &alloc, is_even);
@@ -616,7 +616,7 @@ static int test_chain_invalid_intermediate(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range [100, 200, 300]
-    ANVIterator range_it = anv_iterator_range(100, 301, 100, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 100, 301, 100);
 
     // Chain: range → filter (impossible condition) → transform
     ANVIterator filter_it = anv_iterator_filter(&range_it, &alloc, is_odd); // None match (all are even)
@@ -771,7 +771,7 @@ static int test_chain_ownership_cleanup(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create a chain of iterators
-    ANVIterator range_it = anv_iterator_range(1, 5, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 5, 1);
     ANVIterator filter_it = anv_iterator_filter(&range_it, &alloc, is_even);
     ANVIterator transform_it = anv_iterator_transform(&filter_it, &alloc, double_value, true);
 
@@ -796,7 +796,7 @@ static int test_chain_performance(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create a moderately large range
-    ANVIterator range_it = anv_iterator_range(1, 1001, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 1001, 1);
 
     // Create a complex chain that actually filters significantly
     ANVIterator filter_even = anv_iterator_filter(&range_it, &alloc, is_even);
@@ -878,7 +878,7 @@ static int test_chain_helper_validation(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create a simple chain
-    ANVIterator range_it = anv_iterator_range(1, 7, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 7, 1);
     ANVIterator filter_it = anv_iterator_filter(&range_it, &alloc, is_even);
 
     int values[3];
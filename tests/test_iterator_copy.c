@@ -508,7 +508,7 @@ static int test_copy_with_range_iterator(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator: [1, 2, 3, 4, 5]
-    ANVIterator range_it = anv_iterator_range(1, 6, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 6, 1);
     ASSERT_TRUE(range_it.is_valid(&range_it));
 
     // Apply copy
@@ -537,7 +537,7 @@ static int test_range_copy_chain(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator: [2, 4, 6, 8, 10]
-    ANVIterator range_it = anv_iterator_range(2, 11, 2, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 2, 11, 2);
 
     // Chain: range → copy
     ANVIterator copy_it = anv_iterator_copy(&range_it, &alloc, int_copy);
@@ -758,7 +758,7 @@ static int test_complex_chain_with_copy(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range [1,2,3,4,5,6,7,8,9,10]
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     // Chain: range → filter even → transform square → copy
     ANVIterator filter_it = anv_iterator_filter(&range_it, &alloc, is_even);
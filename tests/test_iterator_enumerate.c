@@ -69,7 +69,7 @@ int test_enumerate_basic_functionality(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator [10, 11, 12, 13, 14]
-    ANVIterator range_it = anv_iterator_range(10, 15, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 10, 15, 1);
 
     // Enumerate starting from index 0
     ANVIterator enum_it = anv_iterator_enumerate(&range_it, &alloc, 0);
@@ -94,7 +94,7 @@ int test_enumerate_custom_start_index(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator [1, 2, 3]
-    ANVIterator range_it = anv_iterator_range(1, 4, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 4, 1);
 
     // Enumerate starting from index 100
     ANVIterator enum_it = anv_iterator_enumerate(&range_it, &alloc, 100);
@@ -119,7 +119,7 @@ int test_enumerate_single_element(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator with single element [42]
-    ANVIterator range_it = anv_iterator_range(42, 43, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 42, 43, 1);
 
     // Enumerate starting from index 5
     ANVIterator enum_it = anv_iterator_enumerate(&range_it, &alloc, 5);
@@ -145,7 +145,7 @@ int test_enumerate_large_start_index(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator [1, 2]
-    ANVIterator range_it = anv_iterator_range(1, 3, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 3, 1);
 
     // Enumerate starting from SIZE_MAX - 1
     ANVIterator enum_it = anv_iterator_enumerate(&range_it, &alloc, SIZE_MAX - 1);
@@ -174,7 +174,7 @@ int test_enumerate_empty_source(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create empty range iterator
-    ANVIterator range_it = anv_iterator_range(1, 1, 1, &alloc); // Empty
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 1, 1); // Empty
 
     // Enumerate empty iterator
     ANVIterator enum_it = anv_iterator_enumerate(&range_it, &alloc, 0);
@@ -197,7 +197,7 @@ int test_enumerate_invalid_parameters(void)
     ASSERT_FALSE(enum_it1.is_valid(&enum_it1));
 
     // Test with NULL allocator
-    ANVIterator range_it = anv_iterator_range(1, 4, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 4, 1);
     const ANVIterator enum_it2 = anv_iterator_enumerate(&range_it, NULL, 0);
     ASSERT_FALSE(enum_it2.is_valid(&enum_it2));
     range_it.destroy(&range_it); // Clean up since enumerate failed
@@ -214,7 +214,7 @@ int test_enumerate_with_filter(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range 1-10, filter evens, then enumerate
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);   // [1,2,3,4,5,6,7,8,9,10]
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);   // [1,2,3,4,5,6,7,8,9,10]
     ANVIterator filter_it = anv_iterator_filter(&range_it, &alloc, is_even); // [2,4,6,8,10]
     ANVIterator enum_it = anv_iterator_enumerate(&filter_it, &alloc, 0);
 
@@ -239,7 +239,7 @@ int test_enumerate_with_take(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range 1-10, take first 3, then enumerate starting from 10
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);   // [1,2,3,4,5,6,7,8,9,10]
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);   // [1,2,3,4,5,6,7,8,9,10]
     ANVIterator take_it = anv_iterator_take(&range_it, &alloc, 3); // [1,2,3]
     ANVIterator enum_it = anv_iterator_enumerate(&take_it, &alloc, 10);
 
@@ -264,7 +264,7 @@ int test_enumerate_with_skip(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range 1-7, skip first 2, then enumerate starting from 0
-    ANVIterator range_it = anv_iterator_range(1, 8, 1, &alloc);   // [1,2,3,4,5,6,7]
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 8, 1);   // [1,2,3,4,5,6,7]
     ANVIterator skip_it = anv_iterator_skip(&range_it, &alloc, 2); // [3,4,5,6,7]
     ANVIterator enum_it = anv_iterator_enumerate(&skip_it, &alloc, 0);
 
@@ -289,7 +289,7 @@ int test_enumerate_chained(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range 1-10, filter odds, enumerate, then take first 2
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);   // [1,2,3,4,5,6,7,8,9,10]
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);   // [1,2,3,4,5,6,7,8,9,10]
     ANVIterator filter_it = anv_iterator_filter(&range_it, &alloc, is_odd); // [1,3,5,7,9]
     ANVIterator enum_it = anv_iterator_enumerate(&filter_it, &alloc, 50); // [(50,1),(51,3),(52,5),(53,7),(54,9)]
     ANVIterator take_it = anv_iterator_take(&enum_it, &alloc, 2); // [(50,1),(51,3)]
@@ -442,7 +442,7 @@ int test_enumerate_complex_composition(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Complex pipeline: Range -> Filter -> Take -> Enumerate
-    ANVIterator range_it = anv_iterator_range(1, 20, 1, &alloc); // [1..19]
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 20, 1); // [1..19]
     ANVIterator filter_it = anv_iterator_filter(&range_it, &alloc, is_divisible_by_3); // [3,6,9,12,15,18]
     ANVIterator take_it = anv_iterator_take(&filter_it, &alloc, 4); // [3,6,9,12]
     ANVIterator enum_it = anv_iterator_enumerate(&take_it, &alloc, 100); // [(100,3),(101,6),(102,9),(103,12)]
@@ -472,7 +472,7 @@ int test_enumerate_iteration_state(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create enumerate iterator and test step-by-step iteration
-    ANVIterator range_it = anv_iterator_range(50, 53, 1, &alloc); // [50,51,52]
+    ANVIterator range_it = anv_iterator_range(&alloc, 50, 53, 1); // [50,51,52]
     ANVIterator enum_it = anv_iterator_enumerate(&range_it, &alloc, 20);
 
     // Test step-by-step iteration
@@ -512,7 +512,7 @@ int test_enumerate_unsupported_operations(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create enumerate iterator
-    ANVIterator range_it = anv_iterator_range(1, 4, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 4, 1);
     ANVIterator enum_it = anv_iterator_enumerate(&range_it, &alloc, 0);
 
     // Test unsupported operations
@@ -531,7 +531,7 @@ int test_enumerate_element_consistency(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Test that the same ANVIndexedElement pointer is returned for multiple get() calls
-    ANVIterator range_it = anv_iterator_range(1, 3, 1, &alloc); // [1,2]
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 3, 1); // [1,2]
     ANVIterator enum_it = anv_iterator_enumerate(&range_it, &alloc, 0);
 
     ASSERT_TRUE(enum_it.has_next(&enum_it));
@@ -559,7 +559,7 @@ int test_enumerate_index_overflow_behavior(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Test behavior near SIZE_MAX (this tests the edge case of index overflow)
-    ANVIterator range_it = anv_iterator_range(1, 3, 1, &alloc); // [1,2]
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 3, 1); // [1,2]
     ANVIterator enum_it = anv_iterator_enumerate(&range_it, &alloc, SIZE_MAX);
 
     ASSERT_TRUE(enum_it.is_valid(&enum_it));
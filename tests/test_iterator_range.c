@@ -63,7 +63,7 @@ static int verify_values(const int* actual, const int* expected, const int count
 static int test_range_positive_step(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(0, 5, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 0, 5, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -88,7 +88,7 @@ static int test_range_positive_step(void)
 static int test_range_negative_step(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(10, 5, -1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 10, 5, -1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -113,7 +113,7 @@ static int test_range_negative_step(void)
 static int test_range_larger_step(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(2, 15, 3, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 2, 15, 3);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -134,7 +134,7 @@ static int test_range_larger_step(void)
 static int test_range_negative_step_size(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(20, 5, -4, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 20, 5, -4);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -159,7 +159,7 @@ static int test_range_negative_step_size(void)
 static int test_range_empty(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(5, 5, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 5, 5, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
     ASSERT_FALSE(it.has_next(&it));
@@ -175,7 +175,7 @@ static int test_range_empty(void)
 static int test_single_element_range(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(7, 8, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 7, 8, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
     ASSERT_TRUE(it.has_next(&it));
@@ -200,7 +200,7 @@ static int test_range_extreme_values(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Test near INT_MAX
-    ANVIterator it1 = anv_iterator_range(INT_MAX - 3, INT_MAX, 1, &alloc);
+    ANVIterator it1 = anv_iterator_range(&alloc, INT_MAX - 3, INT_MAX, 1);
     ASSERT_TRUE(it1.is_valid(&it1));
 
     const int expected_max[] = {INT_MAX - 3, INT_MAX - 2, INT_MAX - 1};
@@ -212,7 +212,7 @@ static int test_range_extreme_values(void)
     it1.destroy(&it1);
 
     // Test near INT_MIN
-    ANVIterator it2 = anv_iterator_range(INT_MIN + 3, INT_MIN, -1, &alloc);
+    ANVIterator it2 = anv_iterator_range(&alloc, INT_MIN + 3, INT_MIN, -1);
     ASSERT_TRUE(it2.is_valid(&it2));
 
     const int expected_min[] = {INT_MIN + 3, INT_MIN + 2, INT_MIN + 1};
@@ -238,21 +238,21 @@ static int test_range_invalid_step(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Test zero step
-    ANVIterator it1 = anv_iterator_range(0, 5, 0, &alloc);
+    ANVIterator it1 = anv_iterator_range(&alloc, 0, 5, 0);
     ASSERT_FALSE(it1.is_valid(&it1));
     ASSERT_FALSE(it1.has_next(&it1));
     ASSERT_NULL(it1.get(&it1));
     it1.destroy(&it1);
 
     // Test conflicting direction: start < end with negative step
-    ANVIterator it2 = anv_iterator_range(0, 10, -1, &alloc);
+    ANVIterator it2 = anv_iterator_range(&alloc, 0, 10, -1);
     ASSERT_FALSE(it2.is_valid(&it2));
     ASSERT_FALSE(it2.has_next(&it2));
     ASSERT_NULL(it2.get(&it2));
     it2.destroy(&it2);
 
     // Test conflicting direction: start > end with positive step
-    ANVIterator it3 = anv_iterator_range(10, 0, 1, &alloc);
+    ANVIterator it3 = anv_iterator_range(&alloc, 10, 0, 1);
     ASSERT_FALSE(it3.is_valid(&it3));
     ASSERT_FALSE(it3.has_next(&it3));
     ASSERT_NULL(it3.get(&it3));
@@ -266,7 +266,7 @@ static int test_range_invalid_step(void)
  */
 static int test_invalid_allocator(void)
 {
-    ANVIterator it = anv_iterator_range(0, 5, 1, NULL);
+    ANVIterator it = anv_iterator_range(NULL, 0, 5, 1);
     ASSERT_FALSE(it.is_valid(&it));
     ASSERT_FALSE(it.has_next(&it));
     ASSERT_NULL(it.get(&it));
@@ -287,7 +287,7 @@ static int test_range_stress(void)
     const ANVAllocator alloc = create_int_allocator();
     const int SIZE = 10000;
 
-    ANVIterator it = anv_iterator_range(0, SIZE, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 0, SIZE, 1);
     ASSERT_TRUE(it.is_valid(&it));
 
     int count = 0;
@@ -321,7 +321,7 @@ static int test_range_stress(void)
 static int test_range_reset(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(0, 10, 2, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 0, 10, 2);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -358,7 +358,7 @@ static int test_range_reset(void)
 static int test_reset_after_bidirectional(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(10, 20, 3, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 10, 20, 3);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -392,7 +392,7 @@ static int test_reset_after_bidirectional(void)
 static int test_zigzag_compensation(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(0, 10, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 0, 10, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -434,7 +434,7 @@ static int test_zigzag_compensation(void)
 static int test_bidirectional_boundaries(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(0, 5, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 0, 5, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -469,7 +469,7 @@ static int test_bidirectional_boundaries(void)
 static int test_direction_change_compensation(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(10, 20, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 10, 20, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -505,7 +505,7 @@ static int test_direction_change_compensation(void)
 static int test_start_boundary_behavior(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(0, 5, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 0, 5, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -537,7 +537,7 @@ static int test_start_boundary_behavior(void)
 static int test_get_next_separation(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(5, 10, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 5, 10, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -566,7 +566,7 @@ static int test_get_next_separation(void)
 static int test_next_return_codes(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(0, 2, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 0, 2, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -585,7 +585,7 @@ static int test_next_return_codes(void)
 static int test_prev_return_codes(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(0, 3, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 0, 3, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -610,7 +610,7 @@ static int test_prev_return_codes(void)
 static int test_memory_consistency(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(100, 105, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 100, 105, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -650,7 +650,7 @@ static int test_memory_consistency(void)
 static int test_has_prev_at_start(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(10, 15, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 10, 15, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -679,7 +679,7 @@ static int test_has_prev_at_start(void)
 static int test_has_next_at_end(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(0, 3, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 0, 3, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -707,7 +707,7 @@ static int test_has_next_at_end(void)
 static int test_bidirectional_with_large_steps(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(0, 20, 5, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 0, 20, 5);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -746,7 +746,7 @@ static int test_bidirectional_with_large_steps(void)
 static int test_negative_step_boundaries(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(10, 0, -2, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 10, 0, -2);
 
     ASSERT_TRUE(it.is_valid(&it));
     // Expected range: 10, 8, 6, 4, 2
@@ -788,7 +788,7 @@ static int test_negative_step_boundaries(void)
 static int test_operations_on_invalid_iterator(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(0, 5, 0, &alloc); // Invalid: zero step
+    ANVIterator it = anv_iterator_range(&alloc, 0, 5, 0); // Invalid: zero step
 
     ASSERT_FALSE(it.is_valid(&it));
 
@@ -813,7 +813,7 @@ static int test_operations_on_invalid_iterator(void)
 static int test_reset_after_boundary_errors(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(0, 3, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 0, 3, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -850,7 +850,7 @@ static int test_reset_after_boundary_errors(void)
 static int test_concurrent_get_calls_during_movement(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(100, 104, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 100, 104, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -887,7 +887,7 @@ static int test_concurrent_get_calls_during_movement(void)
 static int test_single_step_boundaries(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(5, 8, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 5, 8, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
     // Range: 5, 6, 7
@@ -951,7 +951,7 @@ static int collect_values_with_validation(const ANVIterator* it, int* values, in
 static int test_helper_function_validation(void)
 {
     const ANVAllocator alloc = create_int_allocator();
-    ANVIterator it = anv_iterator_range(0, 5, 1, &alloc);
+    ANVIterator it = anv_iterator_range(&alloc, 0, 5, 1);
 
     ASSERT_TRUE(it.is_valid(&it));
 
@@ -588,7 +588,7 @@ int test_repeat_with_range(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Zip range with repeat iterator
-    ANVIterator range_it = anv_iterator_range(1, 6, 1, &alloc); // [1,2,3,4,5]
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 6, 1); // [1,2,3,4,5]
 
     const int repeat_value = -1;
     ANVIterator repeat_it = anv_iterator_repeat(&repeat_value, &alloc, 5);
@@ -61,7 +61,7 @@ int test_skip_basic_functionality(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-10
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     // Skip first 3 elements (should yield 4, 5, 6, 7, 8, 9, 10)
     ANVIterator skip_it = anv_iterator_skip(&range_it, &alloc, 3);
@@ -84,7 +84,7 @@ int test_skip_zero_count(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-5
-    ANVIterator range_it = anv_iterator_range(1, 6, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 6, 1);
 
     // Skip 0 elements (should yield all elements)
     ANVIterator skip_it = anv_iterator_skip(&range_it, &alloc, 0);
@@ -107,7 +107,7 @@ int test_skip_more_than_available(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator with only 3 elements
-    ANVIterator range_it = anv_iterator_range(1, 4, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 4, 1);
 
     // Try to skip 10 elements (more than available)
     ANVIterator skip_it = anv_iterator_skip(&range_it, &alloc, 10);
@@ -126,7 +126,7 @@ int test_skip_all_elements(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-5
-    ANVIterator range_it = anv_iterator_range(1, 6, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 6, 1);
 
     // Skip exactly all elements
     ANVIterator skip_it = anv_iterator_skip(&range_it, &alloc, 5);
@@ -145,7 +145,7 @@ int test_skip_single_element(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-5
-    ANVIterator range_it = anv_iterator_range(1, 6, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 6, 1);
 
     // Skip only 1 element
     ANVIterator skip_it = anv_iterator_skip(&range_it, &alloc, 1);
@@ -172,7 +172,7 @@ int test_skip_empty_source(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create empty range iterator
-    ANVIterator range_it = anv_iterator_range(1, 1, 1, &alloc);  // Empty range
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 1, 1);  // Empty range
 
     // Try to skip 5 elements from empty iterator
     ANVIterator skip_it = anv_iterator_skip(&range_it, &alloc, 5);
@@ -195,7 +195,7 @@ int test_skip_invalid_parameters(void)
     ASSERT_FALSE(skip_it1.is_valid(&skip_it1));
 
     // Test with NULL allocator
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     const ANVIterator skip_it2 = anv_iterator_skip(&range_it, NULL, 5);
     ASSERT_FALSE(skip_it2.is_valid(&skip_it2));
@@ -211,7 +211,7 @@ int test_skip_large_count(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-5
-    ANVIterator range_it = anv_iterator_range(1, 6, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 6, 1);
 
     // Skip very large number of elements
     ANVIterator skip_it = anv_iterator_skip(&range_it, &alloc, SIZE_MAX);
@@ -234,7 +234,7 @@ int test_skip_with_filter(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range 1-10, filter evens, then skip 1 (should skip first even: 2)
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     ANVIterator filter_it = anv_iterator_filter(&range_it, &alloc, is_even);
 
@@ -258,7 +258,7 @@ int test_skip_chained(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range 1-20, skip 5, then skip 2 more from that
-    ANVIterator range_it = anv_iterator_range(1, 21, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 21, 1);
 
     ANVIterator skip_it1 = anv_iterator_skip(&range_it, &alloc, 5);
 
@@ -282,7 +282,7 @@ int test_skip_with_take(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range 1-20, skip 3, then take 5
-    ANVIterator range_it = anv_iterator_range(1, 21, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 21, 1);
 
     ANVIterator skip_it = anv_iterator_skip(&range_it, &alloc, 3);
 
@@ -310,7 +310,7 @@ int test_skip_iteration_state(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-10
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     // Skip first 2 elements
     ANVIterator skip_it = anv_iterator_skip(&range_it, &alloc, 2);
@@ -344,7 +344,7 @@ int test_skip_lazy_evaluation(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-10
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     // Skip first 3 elements - should not perform skip until first access
     ANVIterator skip_it = anv_iterator_skip(&range_it, &alloc, 3);
@@ -366,7 +366,7 @@ int test_skip_unsupported_operations(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-10
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     // Skip first 5 elements
     ANVIterator skip_it = anv_iterator_skip(&range_it, &alloc, 5);
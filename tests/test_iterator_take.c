@@ -61,7 +61,7 @@ int test_take_basic_functionality(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-10
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     // Take first 5 elements
     ANVIterator take_it = anv_iterator_take(&range_it, &alloc, 5);
@@ -84,7 +84,7 @@ int test_take_zero_count(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-10
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     // Take 0 elements
     ANVIterator take_it = anv_iterator_take(&range_it, &alloc, 0);
@@ -103,7 +103,7 @@ int test_take_more_than_available(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator with only 3 elements
-    ANVIterator range_it = anv_iterator_range(1, 4, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 4, 1);
 
     // Try to take 10 elements (more than available)
     ANVIterator take_it = anv_iterator_take(&range_it, &alloc, 10);
@@ -126,7 +126,7 @@ int test_take_single_element(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-10
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     // Take only 1 element
     ANVIterator take_it = anv_iterator_take(&range_it, &alloc, 1);
@@ -156,7 +156,7 @@ int test_take_empty_source(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create empty range iterator
-    ANVIterator range_it = anv_iterator_range(1, 1, 1, &alloc);  // Empty range
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 1, 1);  // Empty range
 
     // Try to take 5 elements from empty iterator
     ANVIterator take_it = anv_iterator_take(&range_it, &alloc, 5);
@@ -179,7 +179,7 @@ int test_take_invalid_parameters(void)
     ASSERT_FALSE(take_it1.is_valid(&take_it1));
 
     // Test with NULL allocator
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     const ANVIterator take_it2 = anv_iterator_take(&range_it, NULL, 5);
     ASSERT_FALSE(take_it2.is_valid(&take_it2));
@@ -195,7 +195,7 @@ int test_take_large_count(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-5
-    ANVIterator range_it = anv_iterator_range(1, 6, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 6, 1);
 
     // Take very large number of elements
     ANVIterator take_it = anv_iterator_take(&range_it, &alloc, SIZE_MAX);
@@ -222,7 +222,7 @@ int test_take_with_filter(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range 1-10, filter evens, then take 2
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     ANVIterator filter_it = anv_iterator_filter(&range_it, &alloc, is_even);
 
@@ -246,7 +246,7 @@ int test_take_chained(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range 1-20, take 10, then take 3 from that
-    ANVIterator range_it = anv_iterator_range(1, 21, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 21, 1);
 
     ANVIterator take_it1 = anv_iterator_take(&range_it, &alloc, 10);
 
@@ -274,7 +274,7 @@ int test_take_iteration_state(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-10
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     // Take first 3 elements
     ANVIterator take_it = anv_iterator_take(&range_it, &alloc, 3);
@@ -315,7 +315,7 @@ int test_take_unsupported_operations(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator 1-10
-    ANVIterator range_it = anv_iterator_range(1, 11, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 11, 1);
 
     // Take first 5 elements
     ANVIterator take_it = anv_iterator_take(&range_it, &alloc, 5);
@@ -494,7 +494,7 @@ static int test_transform_with_range_iterator(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator: [2, 4, 6, 8]
-    ANVIterator range_it = anv_iterator_range(2, 10, 2, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 2, 10, 2);
     ASSERT_TRUE(range_it.is_valid(&range_it));
 
     // Apply square transform
@@ -521,7 +521,7 @@ static int test_range_transform_chain(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator: [1, 2, 3]
-    ANVIterator range_it = anv_iterator_range(1, 4, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 1, 4, 1);
 
     // Chain: range -> double -> add_five
     ANVIterator double_it = anv_iterator_transform(&range_it, &alloc, double_value, true);
@@ -71,8 +71,8 @@ int test_zip_basic_functionality(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create two range iterators
-    ANVIterator range1 = anv_iterator_range(1, 4, 1, &alloc);   // [1,2,3]
-    ANVIterator range2 = anv_iterator_range(10, 13, 1, &alloc); // [10,11,12]
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 4, 1);   // [1,2,3]
+    ANVIterator range2 = anv_iterator_range(&alloc, 10, 13, 1); // [10,11,12]
 
     // Zip them together
     ANVIterator zip_it = anv_iterator_zip(&range1, &range2, &alloc);
@@ -96,8 +96,8 @@ int test_zip_different_lengths_first_shorter(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // First iterator shorter: [1,2] vs [10,11,12,13]
-    ANVIterator range1 = anv_iterator_range(1, 3, 1, &alloc);   // [1,2]
-    ANVIterator range2 = anv_iterator_range(10, 14, 1, &alloc); // [10,11,12,13]
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 3, 1);   // [1,2]
+    ANVIterator range2 = anv_iterator_range(&alloc, 10, 14, 1); // [10,11,12,13]
 
     ANVIterator zip_it = anv_iterator_zip(&range1, &range2, &alloc);
     ASSERT_TRUE(zip_it.is_valid(&zip_it));
@@ -120,8 +120,8 @@ int test_zip_different_lengths_second_shorter(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Second iterator shorter: [1,2,3,4] vs [10,11]
-    ANVIterator range1 = anv_iterator_range(1, 5, 1, &alloc);   // [1,2,3,4]
-    ANVIterator range2 = anv_iterator_range(10, 12, 1, &alloc); // [10,11]
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 5, 1);   // [1,2,3,4]
+    ANVIterator range2 = anv_iterator_range(&alloc, 10, 12, 1); // [10,11]
 
     ANVIterator zip_it = anv_iterator_zip(&range1, &range2, &alloc);
     ASSERT_TRUE(zip_it.is_valid(&zip_it));
@@ -144,8 +144,8 @@ int test_zip_equal_length_single_elements(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Both iterators have single element
-    ANVIterator range1 = anv_iterator_range(42, 43, 1, &alloc); // [42]
-    ANVIterator range2 = anv_iterator_range(99, 100, 1, &alloc); // [99]
+    ANVIterator range1 = anv_iterator_range(&alloc, 42, 43, 1); // [42]
+    ANVIterator range2 = anv_iterator_range(&alloc, 99, 100, 1); // [99]
 
     ANVIterator zip_it = anv_iterator_zip(&range1, &range2, &alloc);
     ASSERT_TRUE(zip_it.is_valid(&zip_it));
@@ -175,8 +175,8 @@ int test_zip_both_empty(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Both iterators empty
-    ANVIterator range1 = anv_iterator_range(1, 1, 1, &alloc); // Empty
-    ANVIterator range2 = anv_iterator_range(1, 1, 1, &alloc); // Empty
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 1, 1); // Empty
+    ANVIterator range2 = anv_iterator_range(&alloc, 1, 1, 1); // Empty
 
     ANVIterator zip_it = anv_iterator_zip(&range1, &range2, &alloc);
     ASSERT_TRUE(zip_it.is_valid(&zip_it));
@@ -194,8 +194,8 @@ int test_zip_one_empty_first(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // First iterator empty, second has elements
-    ANVIterator range1 = anv_iterator_range(1, 1, 1, &alloc);   // Empty
-    ANVIterator range2 = anv_iterator_range(10, 13, 1, &alloc); // [10,11,12]
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 1, 1);   // Empty
+    ANVIterator range2 = anv_iterator_range(&alloc, 10, 13, 1); // [10,11,12]
 
     ANVIterator zip_it = anv_iterator_zip(&range1, &range2, &alloc);
     ASSERT_TRUE(zip_it.is_valid(&zip_it));
@@ -213,8 +213,8 @@ int test_zip_one_empty_second(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // First iterator has elements, second empty
-    ANVIterator range1 = anv_iterator_range(1, 4, 1, &alloc);   // [1,2,3]
-    ANVIterator range2 = anv_iterator_range(1, 1, 1, &alloc);   // Empty
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 4, 1);   // [1,2,3]
+    ANVIterator range2 = anv_iterator_range(&alloc, 1, 1, 1);   // Empty
 
     ANVIterator zip_it = anv_iterator_zip(&range1, &range2, &alloc);
     ASSERT_TRUE(zip_it.is_valid(&zip_it));
@@ -232,20 +232,20 @@ int test_zip_invalid_parameters(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Test with NULL first iterator
-    ANVIterator range2 = anv_iterator_range(1, 4, 1, &alloc);
+    ANVIterator range2 = anv_iterator_range(&alloc, 1, 4, 1);
     const ANVIterator zip_it1 = anv_iterator_zip(NULL, &range2, &alloc);
     ASSERT_FALSE(zip_it1.is_valid(&zip_it1));
     range2.destroy(&range2); // Clean up since zip failed
 
     // Test with NULL second iterator
-    ANVIterator range1 = anv_iterator_range(1, 4, 1, &alloc);
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 4, 1);
     const ANVIterator zip_it2 = anv_iterator_zip(&range1, NULL, &alloc);
     ASSERT_FALSE(zip_it2.is_valid(&zip_it2));
     range1.destroy(&range1); // Clean up since zip failed
 
     // Test with NULL allocator
-    ANVIterator range3 = anv_iterator_range(1, 4, 1, &alloc);
-    ANVIterator range4 = anv_iterator_range(1, 4, 1, &alloc);
+    ANVIterator range3 = anv_iterator_range(&alloc, 1, 4, 1);
+    ANVIterator range4 = anv_iterator_range(&alloc, 1, 4, 1);
     const ANVIterator zip_it3 = anv_iterator_zip(&range3, &range4, NULL);
     ASSERT_FALSE(zip_it3.is_valid(&zip_it3));
     range3.destroy(&range3); // Clean up since zip failed
@@ -263,9 +263,9 @@ int test_zip_with_filter(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create range 1-6, filter evens from first, zip with 10-15
-    ANVIterator range1 = anv_iterator_range(1, 7, 1, &alloc);   // [1,2,3,4,5,6]
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 7, 1);   // [1,2,3,4,5,6]
     ANVIterator filter_it = anv_iterator_filter(&range1, &alloc, is_even); // [2,4,6]
-    ANVIterator range2 = anv_iterator_range(10, 16, 1, &alloc); // [10,11,12,13,14,15]
+    ANVIterator range2 = anv_iterator_range(&alloc, 10, 16, 1); // [10,11,12,13,14,15]
 
     ANVIterator zip_it = anv_iterator_zip(&filter_it, &range2, &alloc);
     ASSERT_TRUE(zip_it.is_valid(&zip_it));
@@ -288,10 +288,10 @@ int test_zip_with_take(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create ranges, take first 2 from each, then zip
-    ANVIterator range1 = anv_iterator_range(1, 10, 1, &alloc);  // [1,2,3,4,5,6,7,8,9]
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 10, 1);  // [1,2,3,4,5,6,7,8,9]
     ANVIterator take_it1 = anv_iterator_take(&range1, &alloc, 2); // [1,2]
 
-    ANVIterator range2 = anv_iterator_range(20, 30, 1, &alloc); // [20,21,22,23,24,25,26,27,28,29]
+    ANVIterator range2 = anv_iterator_range(&alloc, 20, 30, 1); // [20,21,22,23,24,25,26,27,28,29]
     ANVIterator take_it2 = anv_iterator_take(&range2, &alloc, 2); // [20,21]
 
     ANVIterator zip_it = anv_iterator_zip(&take_it1, &take_it2, &alloc);
@@ -315,10 +315,10 @@ int test_zip_with_skip(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create ranges, skip first 2 from each, then zip
-    ANVIterator range1 = anv_iterator_range(1, 6, 1, &alloc);   // [1,2,3,4,5]
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 6, 1);   // [1,2,3,4,5]
     ANVIterator skip_it1 = anv_iterator_skip(&range1, &alloc, 2); // [3,4,5]
 
-    ANVIterator range2 = anv_iterator_range(10, 15, 1, &alloc); // [10,11,12,13,14]
+    ANVIterator range2 = anv_iterator_range(&alloc, 10, 15, 1); // [10,11,12,13,14]
     ANVIterator skip_it2 = anv_iterator_skip(&range2, &alloc, 2); // [12,13,14]
 
     ANVIterator zip_it = anv_iterator_zip(&skip_it1, &skip_it2, &alloc);
@@ -342,11 +342,11 @@ int test_zip_nested(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create nested zip: zip(1-3, 10-12) then zip that with 100-102
-    ANVIterator range1 = anv_iterator_range(1, 4, 1, &alloc);     // [1,2,3]
-    ANVIterator range2 = anv_iterator_range(10, 13, 1, &alloc);   // [10,11,12]
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 4, 1);     // [1,2,3]
+    ANVIterator range2 = anv_iterator_range(&alloc, 10, 13, 1);   // [10,11,12]
     ANVIterator zip_it1 = anv_iterator_zip(&range1, &range2, &alloc); // [(1,10),(2,11),(3,12)]
 
-    ANVIterator range3 = anv_iterator_range(100, 103, 1, &alloc); // [100,101,102]
+    ANVIterator range3 = anv_iterator_range(&alloc, 100, 103, 1); // [100,101,102]
     ANVIterator zip_it2 = anv_iterator_zip(&zip_it1, &range3, &alloc);
 
     ASSERT_TRUE(zip_it2.is_valid(&zip_it2));
@@ -395,8 +395,8 @@ int test_zip_iteration_state(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create zip iterator and test step-by-step iteration
-    ANVIterator range1 = anv_iterator_range(100, 103, 1, &alloc); // [100,101,102]
-    ANVIterator range2 = anv_iterator_range(200, 203, 1, &alloc); // [200,201,202]
+    ANVIterator range1 = anv_iterator_range(&alloc, 100, 103, 1); // [100,101,102]
+    ANVIterator range2 = anv_iterator_range(&alloc, 200, 203, 1); // [200,201,202]
 
     ANVIterator zip_it = anv_iterator_zip(&range1, &range2, &alloc);
 
@@ -437,8 +437,8 @@ int test_zip_unsupported_operations(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Create zip iterator
-    ANVIterator range1 = anv_iterator_range(1, 4, 1, &alloc);
-    ANVIterator range2 = anv_iterator_range(10, 13, 1, &alloc);
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 4, 1);
+    ANVIterator range2 = anv_iterator_range(&alloc, 10, 13, 1);
     ANVIterator zip_it = anv_iterator_zip(&range1, &range2, &alloc);
 
     // Test unsupported operations
@@ -457,8 +457,8 @@ int test_zip_pair_consistency(void)
     const ANVAllocator alloc = create_int_allocator();
 
     // Test that the same pair pointer is returned for multiple get() calls
-    ANVIterator range1 = anv_iterator_range(1, 3, 1, &alloc); // [1,2]
-    ANVIterator range2 = anv_iterator_range(10, 12, 1, &alloc); // [10,11]
+    ANVIterator range1 = anv_iterator_range(&alloc, 1, 3, 1); // [1,2]
+    ANVIterator range2 = anv_iterator_range(&alloc, 10, 12, 1); // [10,11]
 
     ANVIterator zip_it = anv_iterator_zip(&range1, &range2, &alloc);
 
@@ -680,7 +680,7 @@ int test_zip_range_with_arraylist(void)
     ANVAllocator alloc = create_int_allocator();
 
     // Create range iterator and ArrayList
-    ANVIterator range_iter = anv_iterator_range(100, 105, 1, &alloc); // [100, 101, 102, 103, 104]
+    ANVIterator range_iter = anv_iterator_range(&alloc, 100, 105, 1); // [100, 101, 102, 103, 104]
 
     ANVArrayList* list = anv_arraylist_create(&alloc, 0);
     // Populate with characters as integers: 'a', 'b', 'c'
@@ -764,7 +764,7 @@ int test_zip_complex_composition(void)
     ANVAllocator alloc = create_int_allocator();
 
     // Create a complex composition: Range -> Skip -> Take vs ArrayList -> Filter
-    ANVIterator range_iter = anv_iterator_range(1, 20, 1, &alloc); // [1..19]
+    ANVIterator range_iter = anv_iterator_range(&alloc, 1, 20, 1); // [1..19]
     ANVIterator skip_iter = anv_iterator_skip(&range_iter, &alloc, 5); // [6..19]
     ANVIterator take_iter = anv_iterator_take(&skip_iter, &alloc, 3); // [6, 7, 8]
 
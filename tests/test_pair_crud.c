@@ -49,10 +49,10 @@ int test_pair_anv_copy_functions(void)
     ASSERT_NOT_EQ_PTR(shallow, original);
     ASSERT_EQ_PTR(shallow->first, original->first);   // Same pointers
     ASSERT_EQ_PTR(shallow->second, original->second); // Same pointers
-    ASSERT_EQ_PTR(shallow->alloc, original->alloc);
+    ASSERT(shallow->alloc.allocate == original->alloc.allocate);
 
     // Test deep copy with both copy functions
-    ANVPair* deep = anv_pair_copy_deep(original, true, int_anv_copy_func, int_anv_copy_func);
+    ANVPair* deep = anv_pair_copy_deep(original, int_anv_copy_func, int_anv_copy_func, true);
     ASSERT_NOT_NULL(deep);
     ASSERT_NOT_EQ_PTR(deep, original);
     ASSERT_NOT_EQ_PTR(deep->first, original->first);         // Different pointers
@@ -61,7 +61,7 @@ int test_pair_anv_copy_functions(void)
     ASSERT_EQ(*(int*)deep->second, *(int*)original->second); // Same values
 
     // Test deep copy with only first copy function
-    ANVPair* partial = anv_pair_copy_deep(original, true, int_anv_copy_func, NULL);
+    ANVPair* partial = anv_pair_copy_deep(original, int_anv_copy_func, NULL, true);
     ASSERT_NOT_NULL(partial);
     ASSERT_NOT_EQ_PTR(partial->first, original->first); // Copied
     ASSERT_EQ_PTR(partial->second, original->second);   // Referenced
@@ -69,7 +69,7 @@ int test_pair_anv_copy_functions(void)
 
     // Test copy with NULL
     ASSERT_NULL(anv_pair_copy(NULL));
-    ASSERT_NULL(anv_pair_copy_deep(NULL, true, int_anv_copy_func, int_anv_copy_func));
+    ASSERT_NULL(anv_pair_copy_deep(NULL, int_anv_copy_func, int_anv_copy_func, true));
 
     anv_pair_destroy(original, true, true);
     anv_pair_destroy(shallow, false, false); // Don't free data (shared with original)
@@ -90,7 +90,7 @@ int test_pair_mixed_type_copy(void)
     ANVPair* original = anv_pair_create(&alloc, first, second);
 
     // Test deep copy with different copy functions for each element
-    ANVPair* mixed_copy = anv_pair_copy_deep(original, true, int_anv_copy_func, string_anv_copy_func);
+    ANVPair* mixed_copy = anv_pair_copy_deep(original, int_anv_copy_func, string_anv_copy_func, true);
     ASSERT_NOT_NULL(mixed_copy);
     ASSERT_NOT_EQ_PTR(mixed_copy->first, original->first);
     ASSERT_NOT_EQ_PTR(mixed_copy->second, original->second);
@@ -115,7 +115,7 @@ int test_pair_create_destroy(void)
     ASSERT_NOT_NULL(pair);
     ASSERT_EQ_PTR(pair->first, first);
     ASSERT_EQ_PTR(pair->second, second);
-    ASSERT_EQ_PTR(pair->alloc, &alloc);
+    ASSERT(pair->alloc.allocate == alloc.allocate);
 
     anv_pair_destroy(pair, true, true);
     return TEST_SUCCESS;
@@ -54,7 +54,6 @@ int test_pair_memory_allocation_failure(void)
 int test_pair_copy_deep_allocation_failure(void)
 {
     ANVAllocator normal_alloc = create_int_allocator();
-    const ANVAllocator failing_alloc = create_failing_int_allocator();
 
     int* first = malloc(sizeof(int));
     int* second = malloc(sizeof(int));
@@ -65,12 +64,12 @@ int test_pair_copy_deep_allocation_failure(void)
 
     // Test failure during first element copy by using a failing copy function
     set_alloc_fail_countdown(1); // Allocate the Pair structure then fail on the first copy
-    ANVPair* copy1 = anv_pair_copy_deep(original, true, failing_anv_copy_func, normal_alloc.copy);
+    ANVPair* copy1 = anv_pair_copy_deep(original, failing_anv_copy_func, normal_alloc.copy, true);
     ASSERT_NULL(copy1);
 
     // Test failure during second element copy by using a failing copy function
     set_alloc_fail_countdown(1); // Allocate the Pair structure then fail on the second copy
-    ANVPair* copy2 = anv_pair_copy_deep(original, true, normal_alloc.copy, failing_anv_copy_func);
+    ANVPair* copy2 = anv_pair_copy_deep(original, normal_alloc.copy, failing_anv_copy_func, true);
     ASSERT_NULL(copy2);
 
     anv_pair_destroy(original, true, true);
@@ -145,7 +144,7 @@ int test_pair_copy_deep_with_different_anv_copy_functions(void)
     ANVPair* original = anv_pair_create(&alloc, first, second);
 
     // Test deep copy with different copy functions for each element
-    ANVPair* deep_copy = anv_pair_copy_deep(original, true, int_anv_copy_func, string_anv_copy_func);
+    ANVPair* deep_copy = anv_pair_copy_deep(original, int_anv_copy_func, string_anv_copy_func, true);
     ASSERT_NOT_NULL(deep_copy);
     ASSERT_NOT_EQ_PTR(deep_copy->first, original->first);
     ASSERT_NOT_EQ_PTR(deep_copy->second, original->second);
@@ -183,7 +182,7 @@ int test_pair_large_data_handling(void)
     ASSERT_EQ(strncmp((char*)pair->second, large_str2, 100), 0); // Check first 100 chars
 
     // Test deep copy
-    ANVPair* deep_copy = anv_pair_copy_deep(pair, true, alloc.copy, alloc.copy);
+    ANVPair* deep_copy = anv_pair_copy_deep(pair, alloc.copy, alloc.copy, true);
     ASSERT_NOT_NULL(deep_copy);
     ASSERT_EQ(strncmp((char*)deep_copy->first, large_str1, 100), 0);  // Check first 100 chars
     ASSERT_EQ(strncmp((char*)deep_copy->second, large_str2, 100), 0); // Check first 100 chars
@@ -224,7 +223,7 @@ int test_pair_multiple_operations_memory_safety(void)
     ANVPair* copies[10];
     for (int i = 0; i < 10; i++)
     {
-        copies[i] = anv_pair_copy_deep(pairs[i], true, alloc.copy, alloc.copy);
+        copies[i] = anv_pair_copy_deep(pairs[i], alloc.copy, alloc.copy, true);
         ASSERT_NOT_NULL(copies[i]);
     }
 
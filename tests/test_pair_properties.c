@@ -140,7 +140,7 @@ int test_pair_copy_independence(void)
     *second = 84;
 
     ANVPair* original = anv_pair_create(&alloc, first, second);
-    ANVPair* copy = anv_pair_copy_deep(original, true, int_anv_copy_func, int_anv_copy_func);
+    ANVPair* copy = anv_pair_copy_deep(original, int_anv_copy_func, int_anv_copy_func, true);
 
     // Modify original
     int* new_value = malloc(sizeof(int));
@@ -65,7 +65,7 @@ int test_queue_from_iterator(void)
     ANVAllocator alloc = create_int_allocator();
 
     // Create a range iterator (0, 1, 2, 3, 4)
-    ANVIterator range_it = anv_iterator_range(0, 5, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 0, 5, 1);
 
     // Create queue from iterator
     ANVQueue* queue = anv_queue_from_iterator(&range_it, &alloc, true);
@@ -213,7 +213,7 @@ int test_queue_anv_copy_function_required(void)
     ANVAllocator alloc = anv_alloc_default();
     alloc.copy = NULL;
 
-    ANVIterator range_it = anv_iterator_range(0, 3, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 0, 3, 1);
     ASSERT(range_it.is_valid(&range_it));
 
     // Should return NULL because should_copy=true but no copy function available
@@ -230,7 +230,7 @@ int test_queue_from_iterator_no_copy(void)
     ANVAllocator alloc = create_int_allocator();
 
     // Create a range iterator and then a copy iterator to get actual owned data
-    ANVIterator range_it = anv_iterator_range(0, 3, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 0, 3, 1);
     ASSERT(range_it.is_valid(&range_it));
 
     // Use copy iterator to create actual data elements that we own
@@ -269,7 +269,7 @@ int test_queue_from_iterator_no_copy(void)
 int test_iterator_exhaustion_after_queue_creation(void)
 {
     ANVAllocator alloc = create_int_allocator();
-    ANVIterator range_it = anv_iterator_range(0, 5, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 0, 5, 1);
     ASSERT(range_it.is_valid(&range_it));
 
     // Verify iterator starts with elements
@@ -0,0 +1,219 @@
+//
+// Scratch allocator tests - nested frames, growth past the first block,
+// configuration rules and per-thread regions
+//
+
+#include <stdio.h>
+#include <string.h>
+#include "containers/arraylist.h"
+#include "memory/scratch.h"
+#include "system/thread.h"
+#include "TestAssert.h"
+
+// Ending an inner frame releases only what it allocated, in LIFO order
+int test_scratch_frame_nesting(void)
+{
+    ANVScratchFrame outer = anv_scratch_begin();
+    ASSERT_NOT_NULL(outer.arena);
+    char* kept = anv_scratch_allocate(&outer, 64);
+    ASSERT_NOT_NULL(kept);
+    memcpy(kept, "outer", 6);
+    const size_t outer_used = anv_arena_total_used(outer.arena);
+
+    ANVScratchFrame inner = anv_scratch_begin();
+    ASSERT_EQ_PTR(inner.arena, outer.arena);
+    char* temp = anv_scratch_allocate(&inner, 128);
+    ASSERT_NOT_NULL(temp);
+    ASSERT((uintptr_t)temp % 8 == 0);
+    ASSERT(temp >= kept + 64);
+
+    // A frame begun inside the inner one is released along with it
+    ANVScratchFrame innermost = anv_scratch_begin();
+    ASSERT_NOT_NULL(anv_scratch_allocate(&innermost, 256));
+    anv_scratch_end(&innermost);
+    ASSERT_NULL(innermost.arena);
+    ASSERT_EQ(anv_arena_total_used(outer.arena), outer_used + 128);
+
+    anv_scratch_end(&inner);
+    ASSERT_EQ(anv_arena_total_used(outer.arena), outer_used);
+    ASSERT_EQ_STR(kept, "outer");
+
+    // The released space is handed out again
+    ANVScratchFrame again = anv_scratch_begin();
+    ASSERT_EQ_PTR(anv_scratch_allocate(&again, 128), temp);
+    anv_scratch_end(&again);
+
+    ANVArena* arena = outer.arena;
+    anv_scratch_end(&outer);
+    ASSERT_EQ(anv_arena_total_used(arena), 0);
+
+    // Ending a frame twice or a NULL frame does nothing
+    anv_scratch_end(&outer);
+    anv_scratch_end(NULL);
+    ASSERT_NULL(anv_scratch_allocate(&outer, 16));
+    ASSERT_NULL(anv_scratch_allocate(NULL, 16));
+    return TEST_SUCCESS;
+}
+
+// A frame that outgrows the first block chains more, and they go when the outermost frame ends
+int test_scratch_fallback_growth(void)
+{
+    ASSERT_EQ(anv_scratch_configure(1024), ANV_RESULT_SUCCESS);
+
+    ANVScratchFrame outer = anv_scratch_begin();
+    ASSERT_NOT_NULL(outer.arena);
+    ANVArena* arena = outer.arena;
+    uint8_t* first = anv_scratch_allocate(&outer, 256);
+    ASSERT_NOT_NULL(first);
+    const size_t base_reserved = arena->reserved;
+    ASSERT(base_reserved < 4096);
+
+    ANVScratchFrame inner = anv_scratch_begin();
+    uint8_t* large = anv_scratch_allocate(&inner, 8192);
+    ASSERT_NOT_NULL(large);
+    memset(large, 0x5A, 8192);
+    ASSERT(arena->reserved > base_reserved);
+
+    // Restoring the inner frame keeps the chained block for reuse while the outer frame is open
+    anv_scratch_end(&inner);
+    ASSERT_EQ(anv_arena_total_used(arena), 256);
+    const size_t grown_reserved = arena->reserved;
+    ASSERT(grown_reserved > base_reserved);
+
+    anv_scratch_end(&outer);
+    ASSERT_EQ(arena->reserved, base_reserved);
+
+    // The first block is still there
+    ANVScratchFrame next = anv_scratch_begin();
+    ASSERT_EQ_PTR(next.arena, arena);
+    ASSERT_EQ_PTR(anv_scratch_allocate(&next, 256), first);
+    anv_scratch_end(&next);
+
+    ASSERT_EQ(anv_scratch_configure(ANV_SCRATCH_DEFAULT_SIZE), ANV_RESULT_SUCCESS);
+    return TEST_SUCCESS;
+}
+
+// Size changes and releases are refused while a frame is open
+int test_scratch_configure_and_release(void)
+{
+    ASSERT_EQ(anv_scratch_configure(0), ANV_RESULT_INVALID_ARGUMENT);
+
+    ANVScratchFrame frame = anv_scratch_begin();
+    ASSERT_NOT_NULL(frame.arena);
+    ASSERT_EQ(anv_scratch_configure(4096), ANV_RESULT_INVALID_STATE);
+    ASSERT_EQ(anv_scratch_release(), ANV_RESULT_INVALID_STATE);
+    anv_scratch_end(&frame);
+
+    ASSERT_EQ(anv_scratch_configure(4096), ANV_RESULT_SUCCESS);
+    frame = anv_scratch_begin();
+    ASSERT_NOT_NULL(frame.arena);
+    ASSERT_EQ(frame.arena->size, 4096);
+    anv_scratch_end(&frame);
+
+    ASSERT_EQ(anv_scratch_release(), ANV_RESULT_SUCCESS);
+    ASSERT_EQ(anv_scratch_configure(ANV_SCRATCH_DEFAULT_SIZE), ANV_RESULT_SUCCESS);
+
+    // The region is recreated on the next frame
+    frame = anv_scratch_begin();
+    ASSERT_NOT_NULL(frame.arena);
+    ASSERT_NOT_NULL(anv_scratch_allocate(&frame, 32));
+    anv_scratch_end(&frame);
+    return TEST_SUCCESS;
+}
+
+// A container backed by a frame lives until the frame ends
+int test_scratch_allocator(void)
+{
+    ANVScratchFrame frame = anv_scratch_begin();
+    ANVAllocator alloc = anv_scratch_allocator(&frame);
+    ANVArrayList* list = anv_arraylist_create(&alloc, 2);
+    ASSERT_NOT_NULL(list);
+
+    static int values[200];
+    for (int i = 0; i < 200; i++)
+    {
+        values[i] = i;
+        ASSERT_EQ(anv_arraylist_push_back(list, &values[i]), 0);
+    }
+    ASSERT_EQ(anv_arraylist_size(list), 200);
+    ASSERT_EQ(*(int*)anv_arraylist_get(list, 199), 199);
+    ASSERT(anv_arena_total_used(frame.arena) > 200 * sizeof(void*));
+
+    anv_scratch_end(&frame);
+    return TEST_SUCCESS;
+}
+
+static void* region_thread(void* arg)
+{
+    ANVArena** region = arg;
+    ANVScratchFrame frame = anv_scratch_begin();
+    *region = frame.arena;
+    if (!anv_scratch_allocate(&frame, 1024))
+    {
+        *region = NULL;
+    }
+    anv_scratch_end(&frame);
+    return NULL;
+}
+
+// Every thread gets a region of its own
+int test_scratch_per_thread(void)
+{
+    ANVScratchFrame frame = anv_scratch_begin();
+    ASSERT_NOT_NULL(anv_scratch_allocate(&frame, 64));
+
+    ANVArena* other = NULL;
+    ANVThread thread;
+    ASSERT_EQ(anv_thread_create(&thread, region_thread, &other), 0);
+    anv_thread_join(thread, NULL);
+    ASSERT_NOT_NULL(other);
+    ASSERT(other != frame.arena);
+    ASSERT_EQ(anv_arena_total_used(frame.arena), 64);
+
+    anv_scratch_end(&frame);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_scratch_frame_nesting, "test_scratch_frame_nesting"},
+        {test_scratch_fallback_growth, "test_scratch_fallback_growth"},
+        {test_scratch_configure_and_release, "test_scratch_configure_and_release"},
+        {test_scratch_allocator, "test_scratch_allocator"},
+        {test_scratch_per_thread, "test_scratch_per_thread"},
+    };
+
+    printf("Running Scratch tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll Scratch tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d Scratch tests failed.\n", failed);
+    return 1;
+}
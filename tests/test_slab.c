@@ -0,0 +1,237 @@
+//
+// Slab allocator tests - size classes, partial/full/empty list transitions,
+// free list reuse and the empty slab cache
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "memory/slab.h"
+#include "TestAssert.h"
+
+// Every object must lie inside the slab its address masks to, past the header
+static int check_in_slab(const ANVSlabAllocator* slab, const void* object)
+{
+    const uintptr_t base = (uintptr_t)object & ~(uintptr_t)(slab->slab_size - 1);
+    ASSERT((uintptr_t)object >= base + sizeof(ANVSlab));
+    ASSERT((uintptr_t)object + slab->object_size <= base + slab->slab_size);
+    ASSERT_EQ((uintptr_t)object % 8, 0);
+    return TEST_SUCCESS;
+}
+
+// Sizes round up to 8 bytes, and slabs double until they hold the minimum object count
+int test_slab_size_classes(void)
+{
+    const size_t requests[] = {1, 8, 24, 100, 3000, ANV_SLAB_MAX_OBJECT_SIZE};
+    const size_t rounded[] = {8, 8, 24, 104, 3000, ANV_SLAB_MAX_OBJECT_SIZE};
+    for (size_t i = 0; i < sizeof(requests) / sizeof(requests[0]); i++)
+    {
+        ANVSlabAllocator slab = anv_slab_create(requests[i]);
+        ASSERT_EQ(slab.object_size, rounded[i]);
+        ASSERT_EQ(slab.slab_size & (slab.slab_size - 1), 0);
+        ASSERT(slab.objects_per_slab >= ANV_SLAB_MIN_OBJECTS);
+        ASSERT(slab.objects_per_slab * slab.object_size < slab.slab_size);
+        ASSERT_EQ(slab.slab_count, 0); // Nothing is mapped until the first allocation
+
+        // Fresh objects are carved back to back from the bump pointer
+        uint8_t* first = anv_slab_allocate(&slab);
+        uint8_t* second = anv_slab_allocate(&slab);
+        ASSERT_EQ(check_in_slab(&slab, first), TEST_SUCCESS);
+        ASSERT_EQ(check_in_slab(&slab, second), TEST_SUCCESS);
+        ASSERT_EQ(second, first + slab.object_size);
+        memset(first, 0xAA, slab.object_size);
+        memset(second, 0xBB, slab.object_size);
+        ASSERT_EQ(first[slab.object_size - 1], 0xAA);
+
+        anv_slab_destroy(&slab);
+    }
+    return TEST_SUCCESS;
+}
+
+// A slab moves partial -> full when its last object is taken and back when one is freed
+int test_slab_list_transitions(void)
+{
+    ANVSlabAllocator slab = anv_slab_create(100);
+    const size_t per_slab = slab.objects_per_slab;
+    uint8_t** objects = malloc((per_slab + 1) * sizeof(uint8_t*));
+    ASSERT_NOT_NULL(objects);
+
+    for (size_t i = 0; i < per_slab; i++)
+    {
+        objects[i] = anv_slab_allocate(&slab);
+        ASSERT_NOT_NULL(objects[i]);
+        ASSERT_EQ(check_in_slab(&slab, objects[i]), TEST_SUCCESS);
+        memset(objects[i], (int)i, slab.object_size);
+    }
+    ASSERT_NULL(slab.partial);
+    ASSERT_NOT_NULL(slab.full);
+    ASSERT_NULL(slab.full->next);
+    ASSERT_EQ(slab.full->used, per_slab);
+    ASSERT_EQ(slab.slab_count, 1);
+
+    // The next object needs a second slab
+    objects[per_slab] = anv_slab_allocate(&slab);
+    ASSERT_EQ(slab.slab_count, 2);
+    ASSERT_NOT_NULL(slab.partial);
+    ASSERT_EQ(slab.partial->used, 1);
+
+    // Freeing from the full slab puts it back on the partial list, where it is used first
+    ANVSlab* first_slab = slab.full;
+    anv_slab_deallocate(&slab, objects[7]);
+    ASSERT_NULL(slab.full);
+    ASSERT_EQ(slab.partial, first_slab);
+    ASSERT_EQ(first_slab->used, per_slab - 1);
+    ASSERT_EQ(anv_slab_allocate(&slab), objects[7]);
+    ASSERT_EQ(slab.full, first_slab);
+
+    // The free list link written into a freed object leaves its neighbours alone
+    for (size_t i = 0; i < per_slab; i++)
+    {
+        if (i != 7)
+        {
+            ASSERT_EQ(objects[i][0], (uint8_t)i);
+            ASSERT_EQ(objects[i][slab.object_size - 1], (uint8_t)i);
+        }
+    }
+    ASSERT_EQ(slab.live_objects, per_slab + 1);
+
+    for (size_t i = 0; i <= per_slab; i++)
+    {
+        anv_slab_deallocate(&slab, objects[i]);
+    }
+    ASSERT_EQ(slab.live_objects, 0);
+    ASSERT_NULL(slab.partial);
+    ASSERT_NULL(slab.full);
+
+    free(objects);
+    anv_slab_destroy(&slab);
+    return TEST_SUCCESS;
+}
+
+// Freed objects are handed out again most recently freed first
+int test_slab_free_list_order(void)
+{
+    ANVSlabAllocator slab = anv_slab_create(32);
+    void* a = anv_slab_allocate(&slab);
+    void* b = anv_slab_allocate(&slab);
+    void* c = anv_slab_allocate(&slab);
+    ASSERT_EQ((uint8_t*)b, (uint8_t*)a + slab.object_size);
+
+    anv_slab_deallocate(&slab, a);
+    anv_slab_deallocate(&slab, c);
+    ASSERT_EQ(anv_slab_allocate(&slab), c);
+    ASSERT_EQ(anv_slab_allocate(&slab), a);
+
+    // With the free list empty, the bump pointer continues after c
+    ASSERT_EQ((uint8_t*)anv_slab_allocate(&slab), (uint8_t*)c + slab.object_size);
+    ASSERT_EQ(slab.live_objects, 4);
+
+    anv_slab_destroy(&slab);
+    ASSERT_EQ(slab.slab_count, 0);
+    return TEST_SUCCESS;
+}
+
+// Only max_empty drained slabs stay mapped, and trim releases those too
+int test_slab_empty_cache(void)
+{
+    ANVSlabAllocator slab = anv_slab_create(64);
+    const size_t count = slab.objects_per_slab * 3;
+    void** objects = malloc(count * sizeof(void*));
+    ASSERT_NOT_NULL(objects);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        objects[i] = anv_slab_allocate(&slab);
+        ASSERT_NOT_NULL(objects[i]);
+    }
+    ASSERT_EQ(slab.slab_count, 3);
+    ASSERT_NULL(slab.partial);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        anv_slab_deallocate(&slab, objects[i]);
+    }
+    ASSERT_EQ(slab.live_objects, 0);
+    ASSERT_EQ(slab.empty_count, ANV_SLAB_DEFAULT_MAX_EMPTY);
+    ASSERT_EQ(slab.slab_count, ANV_SLAB_DEFAULT_MAX_EMPTY);
+
+    // The cached slab is reused before a new one is mapped
+    void* object = anv_slab_allocate(&slab);
+    ASSERT_NOT_NULL(object);
+    ASSERT_EQ(slab.slab_count, 1);
+    ASSERT_EQ(slab.empty_count, 0);
+    anv_slab_deallocate(&slab, object);
+
+    anv_slab_trim(&slab);
+    ASSERT_EQ(slab.slab_count, 0);
+    ASSERT_NULL(slab.empty);
+
+    free(objects);
+    anv_slab_destroy(&slab);
+    return TEST_SUCCESS;
+}
+
+int test_slab_invalid_sizes_and_allocator(void)
+{
+    ANVSlabAllocator invalid = anv_slab_create(0);
+    ASSERT_EQ(invalid.object_size, 0);
+    ASSERT_NULL(anv_slab_allocate(&invalid));
+    invalid = anv_slab_create(ANV_SLAB_MAX_OBJECT_SIZE + 1);
+    ASSERT_EQ(invalid.object_size, 0);
+
+    ANVSlabAllocator slab = anv_slab_create(32);
+    ANVAllocator alloc = anv_slab_allocator(&slab);
+    ASSERT_NULL(anv_alloc_allocate(&alloc, 33));
+    void* object = anv_alloc_allocate(&alloc, 32);
+    ASSERT_NOT_NULL(object);
+    ASSERT_EQ(slab.live_objects, 1);
+    anv_alloc_deallocate(&alloc, object);
+    ASSERT_EQ(slab.live_objects, 0);
+
+    anv_slab_destroy(&slab);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_slab_size_classes, "test_slab_size_classes"},
+        {test_slab_list_transitions, "test_slab_list_transitions"},
+        {test_slab_free_list_order, "test_slab_free_list_order"},
+        {test_slab_empty_cache, "test_slab_empty_cache"},
+        {test_slab_invalid_sizes_and_allocator, "test_slab_invalid_sizes_and_allocator"},
+    };
+
+    printf("Running Slab tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll Slab tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d Slab tests failed.\n", failed);
+    return 1;
+}
@@ -0,0 +1,326 @@
+//
+// Slot map tests - handle issue and lookup, stale handles, free slot
+// reuse, growth, clear, swap-remove of the dense array and generation wrap
+//
+
+#include <stdio.h>
+#include "containers/slotmap.h"
+#include "TestAssert.h"
+
+// The dense array must be packed, and every dense position must map back to itself
+static int check_dense(const ANVSlotMap* map)
+{
+    const uint64_t* data = anv_slotmap_data(map);
+    for (size_t i = 0; i < anv_slotmap_size(map); i++)
+    {
+        const ANVSlotHandle handle = anv_slotmap_handle_at(map, i);
+        ASSERT(anv_slotmap_contains(map, handle));
+        ASSERT_EQ(anv_slotmap_get(map, handle), &data[i]);
+    }
+    const ANVSlotHandle past_end = anv_slotmap_handle_at(map, anv_slotmap_size(map));
+    ASSERT_EQ(past_end.index, 0);
+    ASSERT_EQ(past_end.generation, 0);
+    return TEST_SUCCESS;
+}
+
+// Handles are issued in slot order with odd generations, and emplace hands out a zeroed element
+int test_slotmap_insert_get(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVSlotMap* map = anv_slotmap_create(&alloc, sizeof(uint64_t), 0);
+    ASSERT_NOT_NULL(map);
+    ASSERT(anv_slotmap_is_empty(map));
+
+    ANVSlotHandle handles[3];
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        const uint64_t value = 100 + i;
+        handles[i] = anv_slotmap_insert(map, &value);
+        ASSERT_EQ(handles[i].index, i);
+        ASSERT_EQ(handles[i].generation, 1);
+    }
+
+    ANVSlotHandle emplaced;
+    uint64_t* element = anv_slotmap_emplace(map, &emplaced);
+    ASSERT_NOT_NULL(element);
+    ASSERT_EQ(*element, 0);
+    *element = 42;
+    ASSERT_EQ(emplaced.index, 3);
+
+    // NULL inserts a zeroed element
+    const ANVSlotHandle zeroed = anv_slotmap_insert(map, NULL);
+    ASSERT_EQ(*(uint64_t*)anv_slotmap_get(map, zeroed), 0);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(*(uint64_t*)anv_slotmap_get(map, handles[i]), 100 + i);
+    }
+    ASSERT_EQ(*(uint64_t*)anv_slotmap_get(map, emplaced), 42);
+    ASSERT_EQ(anv_slotmap_size(map), 5);
+    ASSERT_EQ(check_dense(map), TEST_SUCCESS);
+
+    anv_slotmap_destroy(map);
+    return TEST_SUCCESS;
+}
+
+// A removed element's handle, a forged generation and an unissued index never match
+int test_slotmap_stale_handles(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVSlotMap* map = anv_slotmap_create(&alloc, sizeof(uint64_t), 0);
+    ASSERT_NOT_NULL(map);
+
+    const uint64_t value = 5;
+    const ANVSlotHandle handle = anv_slotmap_insert(map, &value);
+    const ANVSlotHandle other = anv_slotmap_insert(map, &value);
+
+    uint64_t removed = 0;
+    ASSERT_EQ(anv_slotmap_remove(map, handle, &removed), 0);
+    ASSERT_EQ(removed, 5);
+    ASSERT_EQ(map->slots[handle.index].generation, handle.generation + 1);
+    ASSERT_NULL(anv_slotmap_get(map, handle));
+    ASSERT(!anv_slotmap_contains(map, handle));
+    ASSERT_EQ(anv_slotmap_remove(map, handle, NULL), -1);
+
+    // The free slot's current generation is even, so it does not match either
+    const ANVSlotHandle forged = {handle.index, handle.generation + 1};
+    ASSERT_NULL(anv_slotmap_get(map, forged));
+    const ANVSlotHandle unissued = {2, 1};
+    ASSERT_NULL(anv_slotmap_get(map, unissued));
+    ASSERT_EQ(anv_slotmap_remove(map, unissued, NULL), -1);
+
+    // The other element is untouched
+    ASSERT_EQ(*(uint64_t*)anv_slotmap_get(map, other), 5);
+    ASSERT_EQ(anv_slotmap_size(map), 1);
+
+    anv_slotmap_destroy(map);
+    ASSERT_NULL(anv_slotmap_get(NULL, other));
+    return TEST_SUCCESS;
+}
+
+// Freed slots are reused most recently freed first, each with a newer generation
+int test_slotmap_free_list_reuse(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVSlotMap* map = anv_slotmap_create(&alloc, sizeof(uint64_t), 0);
+    ASSERT_NOT_NULL(map);
+
+    ANVSlotHandle handles[4];
+    for (uint64_t i = 0; i < 4; i++)
+    {
+        handles[i] = anv_slotmap_insert(map, &i);
+    }
+    ASSERT_EQ(anv_slotmap_remove(map, handles[1], NULL), 0);
+    ASSERT_EQ(anv_slotmap_remove(map, handles[2], NULL), 0);
+    ASSERT_EQ(map->free_head, handles[2].index);
+
+    const uint64_t value = 9;
+    const ANVSlotHandle first = anv_slotmap_insert(map, &value);
+    const ANVSlotHandle second = anv_slotmap_insert(map, &value);
+    const ANVSlotHandle fresh = anv_slotmap_insert(map, &value);
+    ASSERT_EQ(first.index, handles[2].index);
+    ASSERT_EQ(first.generation, 3);
+    ASSERT_EQ(second.index, handles[1].index);
+    ASSERT_EQ(fresh.index, 4);
+    ASSERT_EQ(map->slot_count, 5);
+
+    ASSERT_NULL(anv_slotmap_get(map, handles[1]));
+    ASSERT_NULL(anv_slotmap_get(map, handles[2]));
+    ASSERT_EQ(check_dense(map), TEST_SUCCESS);
+
+    anv_slotmap_destroy(map);
+    return TEST_SUCCESS;
+}
+
+// Growing the dense and sparse arrays keeps every handle and value
+int test_slotmap_growth(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVSlotMap* map = anv_slotmap_create(&alloc, sizeof(uint64_t), 4);
+    ASSERT_NOT_NULL(map);
+    ASSERT(map->capacity < 100);
+
+    ANVSlotHandle handles[100];
+    for (uint64_t i = 0; i < 100; i++)
+    {
+        const uint64_t value = i * i;
+        handles[i] = anv_slotmap_insert(map, &value);
+        ASSERT_EQ(handles[i].index, (uint32_t)i);
+    }
+    ASSERT(map->capacity >= 100);
+    ASSERT(map->slot_capacity >= 100);
+    for (uint64_t i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(*(uint64_t*)anv_slotmap_get(map, handles[i]), i * i);
+    }
+    ASSERT_EQ(check_dense(map), TEST_SUCCESS);
+
+    // Reserving less than the capacity changes nothing
+    const size_t capacity = map->capacity;
+    ASSERT_EQ(anv_slotmap_reserve(map, 10), 0);
+    ASSERT_EQ(map->capacity, capacity);
+    ASSERT_EQ(anv_slotmap_reserve(map, capacity + 1), 0);
+    ASSERT(map->capacity > capacity);
+
+    anv_slotmap_destroy(map);
+    return TEST_SUCCESS;
+}
+
+// Clearing makes every handle stale and recycles all slots
+int test_slotmap_clear(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVSlotMap* map = anv_slotmap_create(&alloc, sizeof(uint64_t), 0);
+    ASSERT_NOT_NULL(map);
+
+    ANVSlotHandle handles[8];
+    for (uint64_t i = 0; i < 8; i++)
+    {
+        handles[i] = anv_slotmap_insert(map, &i);
+    }
+    anv_slotmap_clear(map);
+    ASSERT(anv_slotmap_is_empty(map));
+    for (int i = 0; i < 8; i++)
+    {
+        ASSERT_NULL(anv_slotmap_get(map, handles[i]));
+    }
+
+    const uint64_t value = 1;
+    for (int i = 0; i < 8; i++)
+    {
+        const ANVSlotHandle handle = anv_slotmap_insert(map, &value);
+        ASSERT(handle.index < 8);
+        ASSERT_EQ(handle.generation, 3);
+    }
+    ASSERT_EQ(map->slot_count, 8);
+    ASSERT_EQ(check_dense(map), TEST_SUCCESS);
+
+    anv_slotmap_destroy(map);
+    return TEST_SUCCESS;
+}
+
+// Removing from the middle moves the last element into the hole without disturbing its handle
+int test_slotmap_swap_remove(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVSlotMap* map = anv_slotmap_create(&alloc, sizeof(uint64_t), 4);
+    ASSERT_NOT_NULL(map);
+
+    ANVSlotHandle handles[5];
+    for (uint64_t i = 0; i < 5; i++)
+    {
+        const uint64_t value = i * 10;
+        handles[i] = anv_slotmap_insert(map, &value);
+    }
+
+    ASSERT_EQ(anv_slotmap_remove(map, handles[1], NULL), 0);
+    const uint64_t* data = anv_slotmap_data(map);
+    ASSERT_EQ(anv_slotmap_size(map), 4);
+    ASSERT_EQ(data[0], 0);
+    ASSERT_EQ(data[1], 40);
+    ASSERT_EQ(data[2], 20);
+    ASSERT_EQ(data[3], 30);
+    ASSERT_EQ(anv_slotmap_get(map, handles[4]), &data[1]);
+    ASSERT_EQ(anv_slotmap_handle_at(map, 1).index, handles[4].index);
+
+    // Removing the last element moves nothing
+    ASSERT_EQ(anv_slotmap_remove(map, handles[3], NULL), 0);
+    ASSERT_EQ(data[0], 0);
+    ASSERT_EQ(data[1], 40);
+    ASSERT_EQ(data[2], 20);
+    ASSERT_EQ(anv_slotmap_size(map), 3);
+
+    // The freed slot is reused with a new generation, so the old handle stays stale
+    const uint64_t value = 99;
+    const ANVSlotHandle reused = anv_slotmap_insert(map, &value);
+    ASSERT_EQ(reused.index, handles[3].index);
+    ASSERT(reused.generation != handles[3].generation);
+    ASSERT_NULL(anv_slotmap_get(map, handles[3]));
+    ASSERT_EQ(*(uint64_t*)anv_slotmap_get(map, reused), 99);
+    ASSERT_EQ(check_dense(map), TEST_SUCCESS);
+
+    anv_slotmap_destroy(map);
+    return TEST_SUCCESS;
+}
+
+// A slot whose generation wraps is retired instead of going back on the free list
+int test_slotmap_generation_wrap(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    ANVSlotMap* map = anv_slotmap_create(&alloc, sizeof(uint64_t), 0);
+    ASSERT_NOT_NULL(map);
+
+    const uint64_t value = 7;
+    ANVSlotHandle handle = anv_slotmap_insert(map, &value);
+    ASSERT_EQ(handle.index, 0);
+
+    // Fast-forward the slot to the last occupied generation
+    map->slots[handle.index].generation = UINT32_MAX;
+    handle.generation = UINT32_MAX;
+    ASSERT(anv_slotmap_contains(map, handle));
+    ASSERT_EQ(anv_slotmap_remove(map, handle, NULL), 0);
+    ASSERT_EQ(map->slots[handle.index].generation, 0);
+    ASSERT_EQ(map->free_head, UINT32_MAX);
+
+    // A new element gets a fresh slot, and neither the old handle nor a zero handle match
+    const ANVSlotHandle next = anv_slotmap_insert(map, &value);
+    ASSERT_EQ(next.index, 1);
+    ASSERT(!anv_slotmap_contains(map, handle));
+    const ANVSlotHandle zero = {0};
+    ASSERT(!anv_slotmap_contains(map, zero));
+    ASSERT_EQ(anv_slotmap_remove(map, zero, NULL), -1);
+    ASSERT_EQ(anv_slotmap_size(map), 1);
+
+    // Ordinary removal still recycles the slot
+    ASSERT_EQ(anv_slotmap_remove(map, next, NULL), 0);
+    ASSERT_EQ(anv_slotmap_insert(map, &value).index, 1);
+
+    anv_slotmap_destroy(map);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_slotmap_insert_get, "test_slotmap_insert_get"},
+        {test_slotmap_stale_handles, "test_slotmap_stale_handles"},
+        {test_slotmap_free_list_reuse, "test_slotmap_free_list_reuse"},
+        {test_slotmap_growth, "test_slotmap_growth"},
+        {test_slotmap_clear, "test_slotmap_clear"},
+        {test_slotmap_swap_remove, "test_slotmap_swap_remove"},
+        {test_slotmap_generation_wrap, "test_slotmap_generation_wrap"},
+    };
+
+    printf("Running SlotMap tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll SlotMap tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d SlotMap tests failed.\n", failed);
+    return 1;
+}
@@ -65,7 +65,7 @@ int test_stack_from_iterator(void)
     ANVAllocator alloc = create_int_allocator();
 
     // Create a range iterator (0, 1, 2, 3, 4)
-    ANVIterator range_it = anv_iterator_range(0, 5, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 0, 5, 1);
 
     // Create stack from iterator
     ANVStack* stack = anv_stack_from_iterator(&range_it, &alloc, true);
@@ -212,7 +212,7 @@ int test_stack_anv_copy_function_required(void)
     ANVAllocator alloc = anv_alloc_default();
     alloc.copy = NULL;
 
-    ANVIterator range_it = anv_iterator_range(0, 3, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 0, 3, 1);
     ASSERT(range_it.is_valid(&range_it));
 
     // Should return NULL because should_copy=true but no copy function available
@@ -229,7 +229,7 @@ int test_stack_from_iterator_no_copy(void)
     ANVAllocator alloc = create_int_allocator();
 
     // Create a range iterator and then a copy iterator to get actual owned data
-    ANVIterator range_it = anv_iterator_range(0, 3, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 0, 3, 1);
     ASSERT(range_it.is_valid(&range_it));
 
     // Use copy iterator to create actual data elements that we own
@@ -268,7 +268,7 @@ int test_stack_from_iterator_no_copy(void)
 int test_iterator_exhaustion_after_stack_creation(void)
 {
     ANVAllocator alloc = create_int_allocator();
-    ANVIterator range_it = anv_iterator_range(0, 5, 1, &alloc);
+    ANVIterator range_it = anv_iterator_range(&alloc, 0, 5, 1);
     ASSERT(range_it.is_valid(&range_it));
 
     // Verify iterator starts with elements
@@ -62,7 +62,7 @@ int test_stack_copy_memory_failure(void)
 
     // Replace allocator with failing one
     ANVAllocator failing_alloc = create_failing_int_allocator();
-    original->alloc = &failing_alloc;
+    original->alloc = failing_alloc;
 
     // Set to fail on copy creation
     set_alloc_fail_countdown(0);
@@ -71,7 +71,7 @@ int test_stack_copy_memory_failure(void)
     ASSERT_NULL(copy);
 
     // Restore original allocator for cleanup
-    original->alloc = &std_alloc;
+    original->alloc = std_alloc;
     anv_stack_destroy(original, true);
     return TEST_SUCCESS;
 }
@@ -655,6 +655,22 @@ int test_str_split_nullptr(void)
     return TEST_SUCCESS;
 }
 
+int test_str_split_only_delims_clears_out(void)
+{
+    ANVString str = anv_str_create_from_cstring(",,,");
+    ANVString stale;
+    ANVString* out = &stale; // Must not survive a split that finds no tokens
+    const size_t count = anv_str_split(&str, ",", &out);
+    ASSERT_EQ(count, 0);
+    ASSERT_NULL(out);
+
+    out = &stale;
+    ASSERT_EQ(anv_str_split(nullptr, ",", &out), 0);
+    ASSERT_NULL(out);
+    anv_str_destroy(&str);
+    return TEST_SUCCESS;
+}
+
 int test_str_split_and_free_split(void)
 {
     ANVString str = anv_str_create_from_cstring("alpha,beta,gamma,delta");
@@ -737,6 +753,7 @@ TestCase tests[] = {
     {test_str_split_no_delim, "test_str_split_no_delim"},
     {test_str_split_empty_string, "test_str_split_empty_string"},
     {test_str_split_nullptr, "test_str_split_nullptr"},
+    {test_str_split_only_delims_clears_out, "test_str_split_only_delims_clears_out"},
     {test_str_split_and_free_split, "test_str_split_and_free_split"},
 };
 
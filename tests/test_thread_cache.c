@@ -0,0 +1,302 @@
+//
+// Thread cache tests - size class boundaries, mid-size reuse, release of
+// drained spans, and blocks freed by a thread other than the one that
+// allocated them
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "memory/thread_cache.h"
+#include "system/thread.h"
+#include "TestAssert.h"
+
+#define HANDOFF_THREADS 4
+#define HANDOFF_BLOCKS 3000
+#define HANDOFF_ROUNDS 40
+#define MID_BLOCKS 20
+
+static void fill_block(uint8_t* block, const size_t size, const uint8_t fill)
+{
+    memset(block, fill, size);
+}
+
+static int check_block(const uint8_t* block, const size_t size, const uint8_t fill)
+{
+    for (size_t b = 0; b < size; b++)
+    {
+        ASSERT_EQ(block[b], fill);
+    }
+    return TEST_SUCCESS;
+}
+
+// Growing up to a class's size stays in place, and one byte more moves to the next class
+int test_tcache_class_boundaries(void)
+{
+    const size_t bounds[] = {16, 128, 160, 1024, 8192, 10240, 65536, ANV_TCACHE_MAX_CLASS_SIZE};
+    for (size_t i = 0; i < sizeof(bounds) / sizeof(bounds[0]); i++)
+    {
+        uint8_t* block = anv_tcache_allocate(bounds[i] - 1);
+        ASSERT_NOT_NULL(block);
+        ASSERT_EQ((uintptr_t)block % 16, 0);
+        fill_block(block, bounds[i] - 1, (uint8_t)i);
+
+        ASSERT_EQ(anv_tcache_reallocate(block, bounds[i] - 1, bounds[i]), block);
+        uint8_t* moved = anv_tcache_reallocate(block, bounds[i], bounds[i] + 1);
+        ASSERT_NOT_NULL(moved);
+        ASSERT(moved != block);
+        ASSERT_EQ(check_block(moved, bounds[i] - 1, (uint8_t)i), TEST_SUCCESS);
+        fill_block(moved, bounds[i] + 1, (uint8_t)i);
+
+        // Shrinking never moves the block
+        ASSERT_EQ(anv_tcache_reallocate(moved, bounds[i] + 1, 1), moved);
+        anv_tcache_deallocate(moved);
+    }
+    return TEST_SUCCESS;
+}
+
+// Requests up to ANV_TCACHE_MAX_CLASS_SIZE are cached rather than mapped per call
+int test_tcache_mid_size_reuse(void)
+{
+    const size_t sizes[] = {ANV_TCACHE_SPAN_SIZE / 8 + 1, 24 * 1024, 100 * 1024, ANV_TCACHE_MAX_CLASS_SIZE};
+    const size_t large_before = anv_tcache_stats().large_blocks;
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        // A freed block comes straight back from the thread cache
+        uint8_t* block = anv_tcache_allocate(sizes[i]);
+        ASSERT_NOT_NULL(block);
+        fill_block(block, sizes[i], 0x5A);
+        const size_t spans = anv_tcache_stats().spans;
+        anv_tcache_deallocate(block);
+        for (int round = 0; round < 100; round++)
+        {
+            uint8_t* again = anv_tcache_allocate(sizes[i]);
+            ASSERT_EQ(again, block);
+            anv_tcache_deallocate(again);
+        }
+        ASSERT_EQ(anv_tcache_stats().spans, spans);
+
+        // Blocks of the same class never overlap
+        uint8_t* blocks[MID_BLOCKS];
+        for (int b = 0; b < MID_BLOCKS; b++)
+        {
+            blocks[b] = anv_tcache_allocate(sizes[i]);
+            ASSERT_NOT_NULL(blocks[b]);
+            fill_block(blocks[b], sizes[i], (uint8_t)b);
+        }
+        for (int b = 0; b < MID_BLOCKS; b++)
+        {
+            ASSERT_EQ(check_block(blocks[b], sizes[i], (uint8_t)b), TEST_SUCCESS);
+            anv_tcache_deallocate(blocks[b]);
+        }
+    }
+    ASSERT_EQ(anv_tcache_stats().large_blocks, large_before);
+
+    // Only requests past the largest class are mapped on their own
+    uint8_t* large = anv_tcache_allocate(ANV_TCACHE_MAX_CLASS_SIZE + 1);
+    ASSERT_NOT_NULL(large);
+    ASSERT_EQ(anv_tcache_stats().large_blocks, large_before + 1);
+    fill_block(large, ANV_TCACHE_MAX_CLASS_SIZE + 1, 0x77);
+    ASSERT_EQ(anv_tcache_reallocate(large, ANV_TCACHE_MAX_CLASS_SIZE + 1, 100), large);
+    anv_tcache_deallocate(large);
+    ASSERT_EQ(anv_tcache_stats().large_blocks, large_before);
+
+    anv_tcache_flush();
+    return TEST_SUCCESS;
+}
+
+// Spans whose objects have all come back are unmapped beyond a couple kept per class
+int test_tcache_empty_spans_released(void)
+{
+    const size_t size = 48;
+    const size_t count = 6 * (ANV_TCACHE_SPAN_SIZE / size);
+    void** blocks = malloc(count * sizeof(void*));
+    ASSERT_NOT_NULL(blocks);
+
+    anv_tcache_flush();
+    const size_t before = anv_tcache_stats().spans;
+    for (size_t i = 0; i < count; i++)
+    {
+        blocks[i] = anv_tcache_allocate(size);
+        ASSERT_NOT_NULL(blocks[i]);
+    }
+    const size_t grown = anv_tcache_stats().spans;
+    ASSERT(grown >= before + 6);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        anv_tcache_deallocate(blocks[i]);
+    }
+    anv_tcache_flush();
+    const ANVThreadCacheStats drained = anv_tcache_stats();
+    ASSERT(drained.spans <= before + 2);
+
+    // The kept spans are carved again before anything new is mapped
+    for (size_t i = 0; i < 100; i++)
+    {
+        blocks[i] = anv_tcache_allocate(size);
+    }
+    ASSERT_EQ(anv_tcache_stats().spans, drained.spans);
+    for (size_t i = 0; i < 100; i++)
+    {
+        anv_tcache_deallocate(blocks[i]);
+    }
+    anv_tcache_flush();
+
+    free(blocks);
+    return TEST_SUCCESS;
+}
+
+typedef struct HandoffArg
+{
+    uint8_t* blocks[HANDOFF_BLOCKS];
+    uint8_t fill;
+    bool ok;
+} HandoffArg;
+
+static void* allocate_thread(void* arg)
+{
+    HandoffArg* handoff = arg;
+    handoff->ok = true;
+    for (size_t i = 0; i < HANDOFF_BLOCKS; i++)
+    {
+        const size_t size = 16 + i % 8 * 16;
+        handoff->blocks[i] = anv_tcache_allocate(size);
+        if (!handoff->blocks[i])
+        {
+            handoff->ok = false;
+            break;
+        }
+        memset(handoff->blocks[i], handoff->fill, size);
+    }
+    return NULL;
+}
+
+// Frees blocks another thread allocated; what it caches must reach the central lists on exit
+static void* free_thread(void* arg)
+{
+    HandoffArg* handoff = arg;
+    for (size_t i = 0; i < HANDOFF_BLOCKS && handoff->blocks[i]; i++)
+    {
+        const size_t size = 16 + i % 8 * 16;
+        for (size_t b = 0; b < size; b++)
+        {
+            handoff->ok = handoff->ok && handoff->blocks[i][b] == handoff->fill;
+        }
+        anv_tcache_deallocate(handoff->blocks[i]);
+    }
+    return NULL;
+}
+
+int test_tcache_cross_thread_free(void)
+{
+    HandoffArg* handoffs = calloc(HANDOFF_THREADS, sizeof(HandoffArg));
+    ASSERT_NOT_NULL(handoffs);
+    ANVThread threads[HANDOFF_THREADS];
+    size_t spans_after_first = 0;
+
+    for (int round = 0; round < HANDOFF_ROUNDS; round++)
+    {
+        for (int t = 0; t < HANDOFF_THREADS; t++)
+        {
+            memset(handoffs[t].blocks, 0, sizeof(handoffs[t].blocks));
+            handoffs[t].fill = (uint8_t)(round * HANDOFF_THREADS + t + 1);
+            ASSERT_EQ(anv_thread_create(&threads[t], allocate_thread, &handoffs[t]), 0);
+        }
+        for (int t = 0; t < HANDOFF_THREADS; t++)
+        {
+            anv_thread_join(threads[t], NULL);
+            ASSERT(handoffs[t].ok);
+        }
+
+        // Each thread frees a list allocated by a different thread
+        for (int t = 0; t < HANDOFF_THREADS; t++)
+        {
+            HandoffArg* other = &handoffs[(t + 1) % HANDOFF_THREADS];
+            ASSERT_EQ(anv_thread_create(&threads[t], free_thread, other), 0);
+        }
+        for (int t = 0; t < HANDOFF_THREADS; t++)
+        {
+            anv_thread_join(threads[t], NULL);
+        }
+        for (int t = 0; t < HANDOFF_THREADS; t++)
+        {
+            ASSERT(handoffs[t].ok);
+        }
+
+        // Objects left in exited threads' caches are reused, so the span count settles after one round
+        const size_t spans = anv_tcache_stats().spans;
+        if (round == 0)
+        {
+            spans_after_first = spans;
+        }
+        ASSERT(spans <= spans_after_first + 1);
+    }
+
+    free(handoffs);
+    return TEST_SUCCESS;
+}
+
+int test_tcache_allocator_adapter(void)
+{
+    ANVAllocator alloc = anv_tcache_allocator();
+    char* text = anv_alloc_allocate(&alloc, 6);
+    ASSERT_NOT_NULL(text);
+    memcpy(text, "anvil", 6);
+
+    // Growing within the 16-byte class keeps the block in place
+    ASSERT_EQ(anv_alloc_reallocate(&alloc, text, 6, 16), text);
+    char* moved = anv_alloc_reallocate(&alloc, text, 16, 4096);
+    ASSERT_NOT_NULL(moved);
+    ASSERT_EQ_STR(moved, "anvil");
+    anv_alloc_data_deallocate(&alloc, moved);
+
+    ASSERT_NULL(anv_tcache_reallocate(NULL, 0, SIZE_MAX));
+    anv_tcache_deallocate(NULL);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_tcache_class_boundaries, "test_tcache_class_boundaries"},
+        {test_tcache_mid_size_reuse, "test_tcache_mid_size_reuse"},
+        {test_tcache_empty_spans_released, "test_tcache_empty_spans_released"},
+        {test_tcache_cross_thread_free, "test_tcache_cross_thread_free"},
+        {test_tcache_allocator_adapter, "test_tcache_allocator_adapter"},
+    };
+
+    printf("Running ThreadCache tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll ThreadCache tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d ThreadCache tests failed.\n", failed);
+    return 1;
+}
@@ -0,0 +1,245 @@
+//
+// TLSF tests - first/second-level class boundaries, request rounding,
+// coalescing back to a single free block, and in-place resizing
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "memory/tlsf.h"
+#include "TestAssert.h"
+
+#define REGION_SIZE ((size_t)1 << 20)
+/**
+ * With nothing allocated, every free block must have merged back into one.
+ * Requests are rounded up to the next of 32 classes per power of two, so the
+ * largest request one pool-sized block is sure to serve is the start of its
+ * own class.
+ */
+static int check_fully_coalesced(ANVTlsf* tlsf)
+{
+    const ANVTlsfStats stats = anv_tlsf_stats(tlsf);
+    ASSERT_EQ(stats.used_blocks, 0);
+    ASSERT_EQ(stats.used_bytes, 0);
+
+    size_t top_bit = 0;
+    while ((stats.pool_bytes >> (top_bit + 1)) != 0)
+    {
+        top_bit++;
+    }
+    const size_t class_start = stats.pool_bytes & ~(((size_t)1 << (top_bit - 5)) - 1);
+
+    void* whole = anv_tlsf_allocate(tlsf, class_start);
+    ASSERT_NOT_NULL(whole);
+    anv_tlsf_deallocate(tlsf, whole);
+    return TEST_SUCCESS;
+}
+
+// Step between second-level classes for a size: 8 bytes below 256, else 1/32 of the power of two
+static size_t class_step(const size_t size)
+{
+    if (size < 256)
+    {
+        return 8;
+    }
+    size_t top = 256;
+    while (top * 2 <= size)
+    {
+        top *= 2;
+    }
+    return top >> 5;
+}
+
+/**
+ * A hole at the top of its class only serves requests for the class start:
+ * anything larger is rounded up to the next class and never searched for in
+ * the hole's list, even though it would fit.
+ */
+int test_tlsf_class_boundaries(void)
+{
+    uint8_t* region = malloc(REGION_SIZE);
+    ASSERT_NOT_NULL(region);
+    ANVTlsf* tlsf = anv_tlsf_create(region, REGION_SIZE);
+    ASSERT_NOT_NULL(tlsf);
+
+    // Class starts on both sides of the small/first-level split and in later first-level lists
+    const size_t starts[] = {24, 248, 256, 512, 1024 + 3 * 32, 4096, 8192 + 31 * 256, 65536};
+    for (size_t i = 0; i < sizeof(starts) / sizeof(starts[0]); i++)
+    {
+        const size_t step = class_step(starts[i]);
+        const size_t hole_size = starts[i] + step - 8;
+
+        void* before = anv_tlsf_allocate(tlsf, 16);
+        void* hole = anv_tlsf_allocate(tlsf, hole_size);
+        void* after = anv_tlsf_allocate(tlsf, 16);
+        ASSERT_NOT_NULL(hole);
+        ASSERT_NOT_NULL(after);
+        anv_tlsf_deallocate(tlsf, hole);
+
+        if (step > 8)
+        {
+            void* rounded = anv_tlsf_allocate(tlsf, starts[i] + 8);
+            ASSERT_NOT_NULL(rounded);
+            ASSERT(rounded != hole);
+            anv_tlsf_deallocate(tlsf, rounded);
+        }
+
+        void* exact = anv_tlsf_allocate(tlsf, starts[i]);
+        ASSERT_EQ(exact, hole);
+        ASSERT_EQ(anv_tlsf_stats(tlsf).used_blocks, 3);
+
+        anv_tlsf_deallocate(tlsf, exact);
+        anv_tlsf_deallocate(tlsf, before);
+        anv_tlsf_deallocate(tlsf, after);
+        ASSERT_EQ(check_fully_coalesced(tlsf), TEST_SUCCESS);
+    }
+
+    free(region);
+    return TEST_SUCCESS;
+}
+
+// Requests are rounded to 8 bytes with a minimum block, and oversized requests fail cleanly
+int test_tlsf_request_sizes(void)
+{
+    uint8_t* region = malloc(REGION_SIZE);
+    ASSERT_NOT_NULL(region);
+    ANVTlsf* tlsf = anv_tlsf_create(region, REGION_SIZE);
+    ASSERT_NOT_NULL(tlsf);
+
+    void* tiny = anv_tlsf_allocate(tlsf, 1);
+    ASSERT_NOT_NULL(tiny);
+    ASSERT_EQ((uintptr_t)tiny % ANV_TLSF_ALIGNMENT, 0);
+    const size_t minimum = anv_tlsf_stats(tlsf).used_bytes;
+    ASSERT(minimum >= 8 && minimum % 8 == 0);
+
+    void* odd = anv_tlsf_allocate(tlsf, 257);
+    ASSERT_EQ(anv_tlsf_stats(tlsf).used_bytes, minimum + 264);
+
+    ASSERT_NULL(anv_tlsf_allocate(tlsf, 0));
+    ASSERT_NULL(anv_tlsf_allocate(tlsf, ANV_TLSF_MAX_BLOCK_SIZE));
+    ASSERT_NULL(anv_tlsf_allocate(tlsf, REGION_SIZE));
+    ASSERT_EQ(anv_tlsf_stats(tlsf).used_blocks, 2);
+
+    anv_tlsf_deallocate(tlsf, odd);
+    anv_tlsf_deallocate(tlsf, tiny);
+    anv_tlsf_deallocate(tlsf, NULL);
+    ASSERT_EQ(check_fully_coalesced(tlsf), TEST_SUCCESS);
+
+    free(region);
+    return TEST_SUCCESS;
+}
+
+// Freeing alternate blocks and then the rest merges with both neighbours
+int test_tlsf_coalesce_both_sides(void)
+{
+    uint8_t* region = malloc(REGION_SIZE);
+    ASSERT_NOT_NULL(region);
+    ANVTlsf* tlsf = anv_tlsf_create(region, REGION_SIZE);
+    ASSERT_NOT_NULL(tlsf);
+
+    void* blocks[256];
+    for (int i = 0; i < 256; i++)
+    {
+        blocks[i] = anv_tlsf_allocate(tlsf, 200);
+        ASSERT_NOT_NULL(blocks[i]);
+    }
+    for (int i = 0; i < 256; i += 2)
+    {
+        anv_tlsf_deallocate(tlsf, blocks[i]);
+    }
+
+    // Every freed block is boxed in by used neighbours, so nothing merged yet
+    ASSERT_EQ(anv_tlsf_stats(tlsf).used_blocks, 128);
+    for (int i = 1; i < 256; i += 2)
+    {
+        anv_tlsf_deallocate(tlsf, blocks[i]);
+    }
+    ASSERT_EQ(check_fully_coalesced(tlsf), TEST_SUCCESS);
+
+    free(region);
+    return TEST_SUCCESS;
+}
+
+int test_tlsf_reallocate_in_place(void)
+{
+    uint8_t* region = malloc(REGION_SIZE);
+    ASSERT_NOT_NULL(region);
+    ANVTlsf* tlsf = anv_tlsf_create(region, REGION_SIZE);
+    ASSERT_NOT_NULL(tlsf);
+
+    char* first = anv_tlsf_allocate(tlsf, 64);
+    void* second = anv_tlsf_allocate(tlsf, 512);
+    void* guard = anv_tlsf_allocate(tlsf, 64);
+    ASSERT_NOT_NULL(first);
+    ASSERT_NOT_NULL(second);
+    ASSERT_NOT_NULL(guard);
+    memcpy(first, "anvil", 6);
+
+    // Growing into the freed neighbour keeps the address
+    anv_tlsf_deallocate(tlsf, second);
+    ASSERT_EQ(anv_tlsf_reallocate(tlsf, first, 400), first);
+    ASSERT_EQ_STR(first, "anvil");
+
+    // Growing past the guard block has to move
+    char* moved = anv_tlsf_reallocate(tlsf, first, 4096);
+    ASSERT_NOT_NULL(moved);
+    ASSERT(moved != first);
+    ASSERT_EQ_STR(moved, "anvil");
+    ASSERT_EQ(anv_tlsf_stats(tlsf).used_blocks, 2);
+
+    // A failed resize leaves the block alone
+    ASSERT_NULL(anv_tlsf_reallocate(tlsf, moved, REGION_SIZE));
+    ASSERT_EQ_STR(moved, "anvil");
+
+    anv_tlsf_deallocate(tlsf, moved);
+    anv_tlsf_deallocate(tlsf, guard);
+    ASSERT_EQ(check_fully_coalesced(tlsf), TEST_SUCCESS);
+
+    ASSERT_NULL(anv_tlsf_create(region + 1, REGION_SIZE - 1));
+    ASSERT_NULL(anv_tlsf_create(region, 16));
+    free(region);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_tlsf_class_boundaries, "test_tlsf_class_boundaries"},
+        {test_tlsf_request_sizes, "test_tlsf_request_sizes"},
+        {test_tlsf_coalesce_both_sides, "test_tlsf_coalesce_both_sides"},
+        {test_tlsf_reallocate_in_place, "test_tlsf_reallocate_in_place"},
+    };
+
+    printf("Running TLSF tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll TLSF tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d TLSF tests failed.\n", failed);
+    return 1;
+}
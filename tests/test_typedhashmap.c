@@ -0,0 +1,375 @@
+//
+// Typed hash map tests - a uint64 -> uint32 instantiation of
+// ANV_HASHMAP_DEFINE checked against a model, Robin Hood placement and
+// backward-shift removal, growth and the per-map seed
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "containers/typedhashmap.h"
+#include "TestAssert.h"
+
+ANV_HASHMAP_DEFINE(IdCounts, uint64_t, uint32_t, ANV_HASHMAP_HASH_SCALAR, ANV_HASHMAP_EQ_SCALAR)
+
+#define MODEL_KEYS 1000
+
+// Spread over the whole key space so the high bits matter, with 0 and UINT64_MAX at the ends
+static uint64_t key_at(const size_t index)
+{
+    if (index == MODEL_KEYS - 1)
+    {
+        return UINT64_MAX;
+    }
+    return (uint64_t)index * 0x9E3779B97F4A7C15ull;
+}
+
+// The first key at or after *next whose home slot in 'map' is 'home'
+static uint64_t key_with_home(const IdCounts* map, const size_t home, uint64_t* next)
+{
+    while (IdCounts_home_slot(map, *next) != home)
+    {
+        (*next)++;
+    }
+    return (*next)++;
+}
+
+/**
+ * Every key must sit at its recorded distance from its home slot, and
+ * backward-shift removal must leave no key displaced past an empty slot.
+ */
+static int check_layout(const IdCounts* map)
+{
+    const size_t mask = map->capacity - 1;
+    size_t count = 0;
+    for (size_t i = 0; i < map->capacity; i++)
+    {
+        const uint8_t distance = map->distances[i];
+        const uint8_t next = map->distances[(i + 1) & mask];
+        if (distance == 0)
+        {
+            ASSERT(next <= 1);
+            continue;
+        }
+
+        ASSERT_EQ((i - IdCounts_home_slot(map, map->slots[i].key)) & mask, (size_t)distance - 1);
+        ASSERT(next <= distance + 1);
+        count++;
+    }
+    ASSERT_EQ(count, map->size);
+    return TEST_SUCCESS;
+}
+
+static int check_slot(const IdCounts* map, const size_t slot, const uint64_t key, const uint8_t distance)
+{
+    ASSERT_EQ(map->distances[slot], distance);
+    ASSERT_EQ(map->slots[slot].key, key);
+    return TEST_SUCCESS;
+}
+
+static int check_model(const IdCounts* map, const bool* present, const uint32_t* values)
+{
+    size_t expected = 0;
+    for (size_t i = 0; i < MODEL_KEYS; i++)
+    {
+        const uint32_t* value = IdCounts_get(map, key_at(i));
+        if (present[i])
+        {
+            ASSERT_NOT_NULL(value);
+            ASSERT_EQ(*value, values[i]);
+            expected++;
+        }
+        else
+        {
+            ASSERT_NULL(value);
+        }
+        ASSERT_EQ(IdCounts_contains_key(map, key_at(i)), present[i] ? 1 : 0);
+    }
+    ASSERT_EQ(IdCounts_size(map), expected);
+    return check_layout(map);
+}
+
+// put, entry and remove in fixed passes, checked against the model after each
+int test_typedhashmap_model(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    IdCounts* map = IdCounts_create(&alloc, 0);
+    ASSERT_NOT_NULL(map);
+    bool present[MODEL_KEYS] = {false};
+    uint32_t values[MODEL_KEYS] = {0};
+
+    for (size_t i = 0; i < MODEL_KEYS; i++)
+    {
+        ASSERT_EQ(IdCounts_put(map, key_at(i), (uint32_t)i), 0);
+        present[i] = true;
+        values[i] = (uint32_t)i;
+    }
+    ASSERT_EQ(check_model(map, present, values), TEST_SUCCESS);
+
+    // put on a present key replaces the value in place
+    for (size_t i = 0; i < MODEL_KEYS; i += 5)
+    {
+        ASSERT_EQ(IdCounts_put(map, key_at(i), 7), 0);
+        values[i] = 7;
+    }
+    ASSERT_EQ(check_model(map, present, values), TEST_SUCCESS);
+
+    // entry finds present keys without inserting
+    for (size_t i = 0; i < MODEL_KEYS; i += 2)
+    {
+        bool inserted = true;
+        uint32_t* value = IdCounts_entry(map, key_at(i), &inserted);
+        ASSERT_NOT_NULL(value);
+        ASSERT(!inserted);
+        *value += 1000;
+        values[i] += 1000;
+    }
+    ASSERT_EQ(check_model(map, present, values), TEST_SUCCESS);
+
+    for (size_t i = 0; i < MODEL_KEYS; i += 3)
+    {
+        ASSERT_EQ(IdCounts_remove(map, key_at(i)), 0);
+        ASSERT_EQ(IdCounts_remove(map, key_at(i)), -1);
+        present[i] = false;
+    }
+    ASSERT_EQ(check_model(map, present, values), TEST_SUCCESS);
+
+    // entry inserts removed keys back with a zeroed value
+    for (size_t i = 0; i < MODEL_KEYS; i += 6)
+    {
+        bool inserted = false;
+        uint32_t* value = IdCounts_entry(map, key_at(i), &inserted);
+        ASSERT_NOT_NULL(value);
+        ASSERT(inserted);
+        ASSERT_EQ(*value, 0);
+        *value = 42;
+        present[i] = true;
+        values[i] = 42;
+    }
+    ASSERT_EQ(check_model(map, present, values), TEST_SUCCESS);
+
+    IdCounts_clear(map);
+    ASSERT(IdCounts_is_empty(map));
+    ASSERT_NULL(IdCounts_get(map, key_at(1)));
+    ASSERT_EQ(IdCounts_put(map, key_at(1), 1), 0);
+    ASSERT_EQ(*IdCounts_get(map, key_at(1)), 1);
+
+    ASSERT_EQ(IdCounts_put(NULL, 1, 1), -1);
+    ASSERT_EQ(IdCounts_remove(NULL, 1), -1);
+    ASSERT_NULL(IdCounts_get(NULL, 1));
+    ASSERT_NULL(IdCounts_entry(NULL, 1, NULL));
+    ASSERT_NULL(IdCounts_create(NULL, 0));
+
+    IdCounts_destroy(map);
+    return TEST_SUCCESS;
+}
+
+// Inserts displace keys closer to home, and removal pulls the run back one slot
+int test_typedhashmap_robin_hood_layout(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    IdCounts* map = IdCounts_create(&alloc, 1);
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(map->capacity, 8);
+    const size_t last = map->capacity - 1;
+
+    uint64_t next = 0;
+    const uint64_t a = key_with_home(map, 2, &next);
+    const uint64_t b = key_with_home(map, 2, &next);
+    const uint64_t c = key_with_home(map, 3, &next);
+    const uint64_t d = key_with_home(map, last, &next);
+    const uint64_t e = key_with_home(map, last, &next);
+    ASSERT_EQ(IdCounts_put(map, a, 1), 0);
+    ASSERT_EQ(IdCounts_put(map, c, 3), 0);
+
+    // b ties with a at slot 2, then takes slot 3 from c, which is at home
+    ASSERT_EQ(IdCounts_put(map, b, 2), 0);
+    ASSERT_EQ(check_slot(map, 2, a, 1), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(map, 3, b, 2), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(map, 4, c, 2), TEST_SUCCESS);
+    ASSERT_EQ(map->slots[4].value, 3);
+
+    // A run starting in the last slot wraps to the first
+    ASSERT_EQ(IdCounts_put(map, d, 4), 0);
+    ASSERT_EQ(IdCounts_put(map, e, 5), 0);
+    ASSERT_EQ(check_slot(map, last, d, 1), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(map, 0, e, 2), TEST_SUCCESS);
+    ASSERT_EQ(check_layout(map), TEST_SUCCESS);
+
+    // Backward shift moves keys and values together
+    ASSERT_EQ(IdCounts_remove(map, a), 0);
+    ASSERT_EQ(check_slot(map, 2, b, 1), TEST_SUCCESS);
+    ASSERT_EQ(check_slot(map, 3, c, 1), TEST_SUCCESS);
+    ASSERT_EQ(map->distances[4], 0);
+    ASSERT_EQ(*IdCounts_get(map, b), 2);
+    ASSERT_EQ(*IdCounts_get(map, c), 3);
+
+    ASSERT_EQ(IdCounts_remove(map, d), 0);
+    ASSERT_EQ(check_slot(map, last, e, 1), TEST_SUCCESS);
+    ASSERT_EQ(map->distances[0], 0);
+    ASSERT_EQ(*IdCounts_get(map, e), 5);
+
+    // A key at home followed by another at home leaves a hole and shifts nothing
+    ASSERT_EQ(IdCounts_remove(map, b), 0);
+    ASSERT_EQ(map->distances[2], 0);
+    ASSERT_EQ(check_slot(map, 3, c, 1), TEST_SUCCESS);
+    ASSERT_EQ(IdCounts_size(map), 2);
+    ASSERT_EQ(check_layout(map), TEST_SUCCESS);
+
+    IdCounts_destroy(map);
+    return TEST_SUCCESS;
+}
+
+// The table doubles when a put would pass 7/8 load, keeping every value
+int test_typedhashmap_growth(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    IdCounts* map = IdCounts_create(&alloc, 0);
+    ASSERT_NOT_NULL(map);
+    const size_t capacity = map->capacity;
+    const size_t limit = capacity - capacity / 8;
+
+    for (size_t i = 0; i < limit; i++)
+    {
+        ASSERT_EQ(IdCounts_put(map, key_at(i), (uint32_t)i), 0);
+    }
+    ASSERT_EQ(map->capacity, capacity);
+
+    // Updating a present key at the limit does not grow the table
+    ASSERT_EQ(IdCounts_put(map, key_at(0), 100), 0);
+    ASSERT_NOT_NULL(IdCounts_entry(map, key_at(1), NULL));
+    ASSERT_EQ(map->capacity, capacity);
+
+    bool inserted = false;
+    uint32_t* value = IdCounts_entry(map, key_at(limit), &inserted);
+    ASSERT_NOT_NULL(value);
+    ASSERT(inserted);
+    *value = (uint32_t)limit;
+    ASSERT_EQ(map->capacity, capacity * 2);
+    ASSERT_EQ(IdCounts_size(map), limit + 1);
+    for (size_t i = 1; i <= limit; i++)
+    {
+        ASSERT_EQ(*IdCounts_get(map, key_at(i)), (uint32_t)i);
+    }
+    ASSERT_EQ(*IdCounts_get(map, key_at(0)), 100);
+    ASSERT_EQ(check_layout(map), TEST_SUCCESS);
+
+    // 1000 keys do not fit in 1024 slots at 7/8 load, so reserve takes 2048
+    ASSERT_EQ(IdCounts_reserve(map, MODEL_KEYS), 0);
+    ASSERT_EQ(map->capacity, 2048);
+    for (size_t i = 0; i < MODEL_KEYS; i++)
+    {
+        ASSERT_EQ(IdCounts_put(map, key_at(i), (uint32_t)i), 0);
+    }
+    ASSERT_EQ(map->capacity, 2048);
+    ASSERT_EQ(IdCounts_size(map), MODEL_KEYS);
+    ASSERT_EQ(check_layout(map), TEST_SUCCESS);
+    ASSERT_EQ(IdCounts_reserve(map, 10), 0);
+    ASSERT_EQ(map->capacity, 2048);
+
+    IdCounts_destroy(map);
+    return TEST_SUCCESS;
+}
+
+static uint64_t key_sum;
+static uint64_t value_sum;
+
+static void sum_entry(const uint64_t key, const uint32_t value)
+{
+    key_sum += key;
+    value_sum += value;
+}
+
+// Each map draws its own seed, so the same keys land in different slots
+int test_typedhashmap_per_map_seed(void)
+{
+    ANVAllocator alloc = anv_alloc_default();
+    IdCounts* first = IdCounts_create(&alloc, 100);
+    IdCounts* second = IdCounts_create(&alloc, 100);
+    ASSERT_NOT_NULL(first);
+    ASSERT_NOT_NULL(second);
+    ASSERT(first->seed != second->seed);
+    ASSERT_EQ(first->capacity, second->capacity);
+
+    uint64_t expected_keys = 0;
+    uint64_t expected_values = 0;
+    for (size_t i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(IdCounts_put(first, key_at(i), (uint32_t)i), 0);
+        ASSERT_EQ(IdCounts_put(second, key_at(i), (uint32_t)i), 0);
+        expected_keys += key_at(i);
+        expected_values += i;
+    }
+    ASSERT_EQ(check_layout(first), TEST_SUCCESS);
+    ASSERT_EQ(check_layout(second), TEST_SUCCESS);
+
+    size_t moved = 0;
+    for (size_t i = 0; i < 100; i++)
+    {
+        moved += IdCounts_home_slot(first, key_at(i)) != IdCounts_home_slot(second, key_at(i));
+    }
+    ASSERT(moved > 50);
+
+    // Copying one map into the other in slot order keeps every key and value
+    for (size_t i = 0; i < first->capacity; i++)
+    {
+        if (first->distances[i])
+        {
+            ASSERT_EQ(IdCounts_put(second, first->slots[i].key, first->slots[i].value + 1), 0);
+        }
+    }
+    ASSERT_EQ(IdCounts_size(second), 100);
+    ASSERT_EQ(check_layout(second), TEST_SUCCESS);
+
+    key_sum = 0;
+    value_sum = 0;
+    IdCounts_for_each(second, sum_entry);
+    ASSERT_EQ(key_sum, expected_keys);
+    ASSERT_EQ(value_sum, expected_values + 100);
+
+    IdCounts_destroy(second);
+    IdCounts_destroy(first);
+    return TEST_SUCCESS;
+}
+
+int main(void)
+{
+    typedef struct
+    {
+        int (*func)(void);
+        const char* name;
+    } TestCase;
+
+    TestCase tests[] = {
+        {test_typedhashmap_model, "test_typedhashmap_model"},
+        {test_typedhashmap_robin_hood_layout, "test_typedhashmap_robin_hood_layout"},
+        {test_typedhashmap_growth, "test_typedhashmap_growth"},
+        {test_typedhashmap_per_map_seed, "test_typedhashmap_per_map_seed"},
+    };
+
+    printf("Running TypedHashMap tests...\n");
+
+    int failed = 0;
+    const int num_tests = sizeof(tests) / sizeof(tests[0]);
+    for (int i = 0; i < num_tests; i++)
+    {
+        printf("Running %s... ", tests[i].name);
+        if (tests[i].func() != TEST_SUCCESS)
+        {
+            printf("FAILED\n");
+            failed++;
+        }
+        else
+        {
+            printf("PASSED\n");
+        }
+    }
+
+    if (failed == 0)
+    {
+        printf("\nAll TypedHashMap tests passed!\n");
+        return 0;
+    }
+
+    printf("\n%d TypedHashMap tests failed.\n", failed);
+    return 1;
+}